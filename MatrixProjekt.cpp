@@ -1,11 +1,1158 @@
 #include <iostream>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "matrix.h"
+#include "wyrazenie.h"
 #include "matrix.cpp"
+#include "pamiec.cpp"
+#include "cpu.cpp"
+#include "gemm.cpp"
+#include "strassen.cpp"
+#include "simd.cpp"
+#include "thread_pool.cpp"
+#include "transpozycja.cpp"
+#include "sparse_matrix.cpp"
+#include "structured_matrix.cpp"
+#include "bit_matrix.cpp"
+#include "potega.cpp"
+#include "arytmetyka.cpp"
+#include "losowanie.cpp"
+#include "serializacja.cpp"
+#include "tekst.cpp"
+#include "widok.cpp"
+#include "partia.cpp"
+#include "fixed_matrix.h"
 
 using namespace std;
 
+/// Liczba nieudanych sprawdzeń.
+static int bledy = 0;
+
+/**
+ * @brief Wypisuje wynik sprawdzenia @p opis i zlicza niepowodzenia.
+ */
+static void sprawdz(bool warunek, const string& opis) {
+    cout << (warunek ? "[OK]   " : "[BLAD] ") << opis << endl;
+    if (!warunek) ++bledy;
+}
+
+/**
+ * @brief Zwraca kolejną liczbę pseudolosową (splitmix64) ze stanu @p stan.
+ *
+ * Sprawdzenia używają własnego generatora, a nie rand(), żeby były
+ * powtarzalne i niezależne od ziarna ustawianego w main().
+ */
+static uint64_t nastepna(uint64_t& stan) {
+    uint64_t z = (stan += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/// Zwraca krótką nazwę typu elementów (do opisów sprawdzeń).
+template <typename T>
+static string nazwa_typu() {
+    if constexpr (is_same_v<T, int8_t>) return "int8";
+    else if constexpr (is_same_v<T, int16_t>) return "int16";
+    else if constexpr (is_same_v<T, int32_t>) return "int32";
+    else if constexpr (is_same_v<T, int64_t>) return "int64";
+    else if constexpr (is_same_v<T, float>) return "float";
+    else return "double";
+}
+
+/**
+ * @brief Wywołuje @c f.template operator()<T>() dla wszystkich sześciu
+ *        typów elementów biblioteki.
+ */
+template <typename F>
+static void dla_typow(F&& f) {
+    f.template operator()<int8_t>();
+    f.template operator()<int16_t>();
+    f.template operator()<int32_t>();
+    f.template operator()<int64_t>();
+    f.template operator()<float>();
+    f.template operator()<double>();
+}
+
+/**
+ * @brief Zwraca macierz @p w x @p k liczb całkowitych z [@p od, @p do_]
+ *        zapisanych w typie @p T.
+ *
+ * Dla małych liczb iloczyny i sumy są dokładne także w typach
+ * zmiennoprzecinkowych, więc wyniki można porównywać operatorem ==.
+ */
+template <typename T = int>
+static basic_matrix<T> losowa(ptrdiff_t w, ptrdiff_t k, uint64_t ziarno, int od = -9, int do_ = 9) {
+    basic_matrix<T> m(w, k);
+    const uint64_t zakres = static_cast<uint64_t>(static_cast<int64_t>(do_) - od + 1);
+    for (ptrdiff_t i = 0; i < w; ++i) {
+        for (ptrdiff_t j = 0; j < k; ++j) m(i, j) = static_cast<T>(od + static_cast<int64_t>(nastepna(ziarno) % zakres));
+    }
+    return m;
+}
+
+/**
+ * @brief Iloczyn wzorcowy: prosta potrójna pętla z akumulacją w @c int64_t
+ *        lub @c double.
+ */
+template <typename T>
+static basic_matrix<jadra::iloczyn_t<T>> iloczyn_wzorcowy(const basic_matrix<T>& a, const basic_matrix<T>& b) {
+    using W = jadra::iloczyn_t<T>;
+    using S = conditional_t<is_integral_v<T>, int64_t, double>;
+    basic_matrix<W> c(a.rows(), b.cols());
+    for (ptrdiff_t i = 0; i < a.rows(); ++i) {
+        for (ptrdiff_t j = 0; j < b.cols(); ++j) {
+            S s = 0;
+            for (ptrdiff_t p = 0; p < a.cols(); ++p) s += static_cast<S>(a(i, p)) * static_cast<S>(b(p, j));
+            c(i, j) = static_cast<W>(s);
+        }
+    }
+    return c;
+}
+
+/**
+ * @brief Iloczyn wzorcowy modulo 2^32 – tak zawija się przepełniony
+ *        iloczyn @c int, także dla pełnego zakresu wartości.
+ */
+static matrix iloczyn_zawijany(const matrix& a, const matrix& b) {
+    matrix c(a.rows(), b.cols());
+    for (ptrdiff_t i = 0; i < a.rows(); ++i) {
+        for (ptrdiff_t j = 0; j < b.cols(); ++j) {
+            uint32_t s = 0;
+            for (ptrdiff_t p = 0; p < a.cols(); ++p) s += static_cast<uint32_t>(a(i, p)) * static_cast<uint32_t>(b(p, j));
+            c(i, j) = static_cast<int>(s);
+        }
+    }
+    return c;
+}
+
+/// Zwraca kopię @p m w macierzy o odstępie między wierszami @c cols() + 3.
+template <typename T>
+static basic_matrix<T> z_odstepem(const basic_matrix<T>& m) {
+    basic_matrix<T> s;
+    s.alokuj(m.rows(), m.cols(), m.cols() + 3);
+    for (ptrdiff_t i = 0; i < m.rows(); ++i) {
+        for (ptrdiff_t j = 0; j < m.cols(); ++j) s(i, j) = m(i, j);
+    }
+    return s;
+}
+
+/// TEST 5: mnożenie macierzy blokowym silnikiem GEMM, rozmiary nieparzyste i skrajne.
+static void test_gemm() {
+    cout << "\n=== TEST 5: Mnozenie macierzy ===" << endl;
+    bool ok = true;
+    for (int n : { 1, 2, 7, 33, 65, 127, 200 }) {
+        matrix a = losowa(n, n, 1), b = losowa(n, n, 2);
+        const matrix wzor = iloczyn_wzorcowy(a, b);
+        ok = ok && (a * b) == wzor;
+    }
+    sprawdz(ok, "A * B: n = 1, 2, 7, 33, 65, 127, 200");
+}
+
+/// TEST 6: pula wątków – wynik nie zależy od liczby wątków.
+static void test_watki() {
+    cout << "\n=== TEST 6: Watki ===" << endl;
+    const int poprzednio = liczba_watkow();
+    const matrix a = losowa(300, 300, 9), b = losowa(300, 300, 10);
+    const matrix wzor = iloczyn_wzorcowy(a, b);
+    for (int n : { 1, 2, 4 }) {
+        ustaw_liczbe_watkow(n);
+        atomic<long long> suma{ 0 };
+        rownolegle_dla(0, 100001, 7, [&suma](long long od, long long do_) {
+            long long s = 0;
+            for (long long i = od; i < do_; ++i) s += i;
+            suma += s;
+        });
+        matrix c = a;
+        sprawdz(liczba_watkow() == n && (c * b) == wzor && suma == 100000LL * 100001 / 2,
+                "liczba watkow " + to_string(n) + ": iloczyn i rownolegle_dla");
+    }
+    ustaw_liczbe_watkow(poprzednio);
+}
+
+/// Zwraca macierz o elementach @p f(a[i][j], b[i][j]).
+template <typename F>
+static matrix elementowo(const matrix& a, const matrix& b, F f) {
+    matrix w(a.rows(), a.cols());
+    for (ptrdiff_t i = 0; i < a.rows(); ++i) {
+        for (ptrdiff_t j = 0; j < a.cols(); ++j) w.wstaw(i, j, f(a.pokaz(i, j), b.pokaz(i, j)));
+    }
+    return w;
+}
+
+/// TEST 7: działania elementowe (jądra SIMD), także dla rozmiarów z resztą.
+static void test_elementowe() {
+    cout << "\n=== TEST 7: Dzialania elementowe ===" << endl;
+    bool ok = true, porownania = true;
+    for (int n : { 1, 3, 5, 37, 65 }) {
+        const matrix a = losowa(n, n, 11), b = losowa(n, n, 12);
+        matrix x = a;
+        ok = ok && (x + b) == elementowo(a, b, [](int p, int q) { return p + q; });
+        x = a;
+        ok = ok && (x + 3) == elementowo(a, b, [](int p, int) { return p + 3; });
+        x = a;
+        ok = ok && (x - 3) == elementowo(a, b, [](int p, int) { return p - 3; });
+        x = a;
+        ok = ok && (x * 3) == elementowo(a, b, [](int p, int) { return p * 3; });
+        x = a;
+        ok = ok && x(2.7) == elementowo(a, b, [](int p, int) { return p + 2; });
+        x = a;
+        x++;
+        ok = ok && x == elementowo(a, b, [](int p, int) { return p + 1; });
+        x--;
+        ok = ok && x == a;
+        ok = ok && 10 - a == elementowo(a, b, [](int p, int) { return 10 - p; });
+        ok = ok && 2 * a == elementowo(a, b, [](int p, int) { return 2 * p; });
+
+        x = a;
+        x += 20;
+        porownania = porownania && x > a && a < x && !(a > a) && !(a < a) && !(x == a);
+    }
+    sprawdz(ok, "+, -, *, (), ++, --, 10 - A, 2 * A: n = 1, 3, 5, 37, 65");
+    sprawdz(porownania, "porownania >, <, ==");
+}
+
+/// TEST 8: przenoszenie macierzy i tymczasowe wyniki operatorów.
+static void test_przenoszenie() {
+    cout << "\n=== TEST 8: Przenoszenie ===" << endl;
+    const matrix a = losowa(17, 17, 13), b = losowa(17, 17, 14);
+    matrix x = a;
+    matrix y(move(x));
+    sprawdz(y == a && x.size() == 0 && x.capacity() == 0, "konstruktor przenoszacy");
+    x = move(y);
+    sprawdz(x == a && y.size() == 0, "przypisanie przenoszace");
+    y = b;
+    x.swap(y);
+    sprawdz(x == b && y == a, "swap");
+
+    const matrix wzor = elementowo(a, a, [](int p, int) { return 2 * (3 + p) - 1; });
+    sprawdz(2 * (3 + matrix(a)) - 1 == wzor, "2 * (3 + A) - 1 na obiekcie tymczasowym");
+    sprawdz(10 - matrix(a) == 10 - a, "10 - A na obiekcie tymczasowym");
+
+    x = a;
+    x * b;
+    sprawdz(x == iloczyn_wzorcowy(a, b), "A * B po zamianie bufora");
+    x = a;
+    x.dowroc();
+    x.dowroc();
+    sprawdz(x == a, "dowroc dwukrotnie");
+}
+
+/// TEST 9: leniwe wyrażenia macierzowe, także z iloczynem i aliasingiem.
+static void test_wyrazenia() {
+    cout << "\n=== TEST 9: Wyrazenia ===" << endl;
+    using wyrazenia::wyr;
+    const matrix a = losowa(45, 45, 15), b = losowa(45, 45, 16);
+    const matrix ab = iloczyn_wzorcowy(a, b);
+    const matrix suma = elementowo(a, b, [](int p, int q) { return (p + q) * 3 + 1; });
+    matrix c = (wyr(a) + b) * 3 + 1;
+    sprawdz(c == suma, "(A + B) * 3 + 1");
+
+    matrix d = a;
+    d = wyr(a) * b + d;
+    bool ok = d == elementowo(ab, a, [](int p, int q) { return p + q; });
+    d = a;
+    d += wyr(a) * b;
+    ok = ok && d == elementowo(ab, a, [](int p, int q) { return p + q; });
+    sprawdz(ok, "D = A * B + D i D += A * B");
+
+    d = a;
+    d = wyr(d) * b - 2;
+    sprawdz(d == elementowo(ab, ab, [](int p, int) { return p - 2; }), "D = D * B - 2 (cel jest czynnikiem)");
+
+    // pelny zakres int: akumulacja gemv (n = 1) zawija sie modulo 2^32 jak gemm
+    const matrix x = losowa(45, 1, 48, INT_MIN, INT_MAX), y0 = losowa(45, 1, 49, INT_MIN, INT_MAX);
+    matrix y = y0;
+    y += wyr(a) * x;
+    sprawdz(y == elementowo(iloczyn_zawijany(a, x), y0,
+                            [](int p, int q) { return static_cast<int>(static_cast<uint32_t>(p) + static_cast<uint32_t>(q)); }),
+            "Y += A * x: przepelnienie zawija sie modulo 2^32");
+}
+
+/// TEST 10: funkcje zwracające wynik i zapisujące go do podanej macierzy.
+static void test_funkcje() {
+    cout << "\n=== TEST 10: Funkcje arytmetyczne ===" << endl;
+    const matrix a = losowa(37, 37, 17), b = losowa(37, 37, 18);
+    const matrix a0 = a, b0 = b;
+    const matrix suma = elementowo(a, b, [](int p, int q) { return p + q; });
+    const matrix roznica = elementowo(a, b, [](int p, int q) { return p - q; });
+    const matrix ab = iloczyn_wzorcowy(a, b);
+    const matrix t = [&] {
+        matrix w(37);
+        for (int i = 0; i < 37; ++i) {
+            for (int j = 0; j < 37; ++j) w.wstaw(j, i, a.pokaz(i, j));
+        }
+        return w;
+    }();
+
+    bool ok = dodaj(a, b) == suma && odejmij(a, b) == roznica && pomnoz(a, b) == ab && transponuj(a) == t
+              && dodaj(a, 3) == elementowo(a, b, [](int p, int) { return p + 3; })
+              && pomnoz(a, 3) == elementowo(a, b, [](int p, int) { return p * 3; });
+    sprawdz(ok && a == a0 && b == b0, "dodaj, odejmij, pomnoz, transponuj nie zmieniaja argumentow");
+
+    matrix c(5);
+    ok = dodaj_do(c, a, b) == suma && odejmij_do(c, a, b) == roznica && pomnoz_do(c, a, b) == ab && transponuj_do(c, a) == t;
+    c = a;
+    ok = ok && pomnoz_do(c, c, b) == ab;
+    c = a;
+    ok = ok && transponuj_do(c, c) == t;
+    sprawdz(ok, "funkcje _do, takze gdy wynik jest argumentem");
+
+    c = a;
+    c += b;
+    ok = c == suma;
+    c -= b;
+    ok = ok && c == a;
+    c *= b;
+    sprawdz(ok && c == ab, "+=, -=, *= z macierza");
+}
+
+/// TEST 11: dostęp do elementów bez sprawdzania i ze sprawdzaniem zakresu.
+static void test_dostep() {
+    cout << "\n=== TEST 11: Dostep do elementow ===" << endl;
+    matrix a = losowa(7, 7, 19);
+    const matrix& s = a;
+    bool ok = true;
+    for (int i = 0; i < 7; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            ok = ok && s(i, j) == a.pokaz(i, j) && s.at(i, j) == a.pokaz(i, j) && s.row(i)[j] == a.pokaz(i, j)
+                 && s.row_ptr(i)[j] == a.pokaz(i, j) && s.data()[i * 7 + j] == a.pokaz(i, j);
+        }
+    }
+    sprawdz(ok && s.row(3).size() == 7, "operator(), at, row, row_ptr i data wskazuja te same elementy");
+
+    a(2, 5) = 100;
+    a.at(5, 2) = 200;
+    a.row(6)[0] = 300;
+    sprawdz(a.pokaz(2, 5) == 100 && a.pokaz(5, 2) == 200 && a.pokaz(6, 0) == 300, "zapis przez operator(), at i row");
+
+    int wyjatki = 0;
+    for (const auto& f : { +[](const matrix& m) { (void)m.at(7, 0); }, +[](const matrix& m) { (void)m.at(0, -1); },
+                           +[](const matrix& m) { (void)m.pokaz(-1, 0); } }) {
+        try {
+            f(a);
+        } catch (const out_of_range&) {
+            ++wyjatki;
+        }
+    }
+    sprawdz(wyjatki == 3, "at i pokaz poza zakresem - wyjatki");
+}
+
+/// TEST 12: transpozycja w miejscu i do nowej macierzy.
+static void test_transpozycja() {
+    cout << "\n=== TEST 12: Transpozycja ===" << endl;
+    bool ok = true;
+    for (int n : { 1, 7, 8, 9, 65, 131, 300 }) {
+        const matrix a = losowa(n, n, 20, -100, 100);
+        matrix t = a;
+        t.dowroc();
+        bool zgodne = true;
+        for (int i = 0; zgodne && i < n; ++i) {
+            for (int j = 0; j < n; ++j) zgodne = zgodne && t(j, i) == a(i, j);
+        }
+        ok = ok && zgodne && transponuj(a) == t && transponuj(t) == a;
+    }
+    sprawdz(ok, string("dowroc i transponuj (") + jadra::wariant_transpozycji() + "): n = 1, 7, 8, 9, 65, 131, 300");
+}
+
+/// TEST 13: macierze prostokątne, wiersze z odstępem, iloczyny macierz-wektor.
+static void test_prostokatne() {
+    cout << "\n=== TEST 13: Macierze prostokatne ===" << endl;
+    static constexpr int wymiary[][3] = {
+        { 1, 1, 1 }, { 7, 13, 5 }, { 33, 65, 17 }, { 127, 61, 129 }, { 129, 1, 77 }, { 1, 129, 77 }, { 200, 150, 1 }
+    };
+    bool ok = true, ok_odstep = true;
+    for (const auto& w : wymiary) {
+        const matrix a = losowa(w[0], w[2], 21), b = losowa(w[2], w[1], 22);
+        const matrix wzor = iloczyn_wzorcowy(a, b);
+        ok = ok && pomnoz(a, b) == wzor;
+        ok_odstep = ok_odstep && pomnoz(z_odstepem(a), z_odstepem(b)) == wzor;
+    }
+    sprawdz(ok, "pomnoz m x n x k: od 1x1x1 do 127x61x129, gemv (n = 1), gevm (m = 1)");
+    sprawdz(ok_odstep, "pomnoz: wiersze z odstepem");
+
+    // pelny zakres int: iloczyny gemv, gevm i gemm zawijaja sie modulo 2^32
+    ok = true;
+    for (const auto& w : { array<int, 3>{ 37, 1, 1001 }, array<int, 3>{ 1, 45, 1001 }, array<int, 3>{ 19, 23, 301 } }) {
+        const matrix a = losowa(w[0], w[2], 23, INT_MIN, INT_MAX), b = losowa(w[2], w[1], 24, INT_MIN, INT_MAX);
+        ok = ok && pomnoz(a, b) == iloczyn_zawijany(a, b);
+    }
+    sprawdz(ok, "gemv, gevm i gemm: przepelnienie zawija sie modulo 2^32");
+
+    const matrix a = losowa(13, 70, 25);
+    matrix t = a;
+    t.dowroc();
+    bool zgodne = t.rows() == 70 && t.cols() == 13;
+    for (int i = 0; zgodne && i < 13; ++i) {
+        for (int j = 0; j < 70; ++j) zgodne = zgodne && t(j, i) == a(i, j);
+    }
+    sprawdz(zgodne && transponuj(z_odstepem(a)) == t, "dowroc i transponuj macierzy 13x70");
+
+    matrix s;
+    s.alokuj(6, 5, 8);
+    s += 2;
+    sprawdz(s.rows() == 6 && s.stride() == 8 && !s.ciagla() && s(5, 4) == 2 && dodaj(s, s) == dodaj(z_odstepem(s), s),
+            "alokuj z odstepem 8, dzialania elementowe");
+    int d[] = { 1, 2, 3, 4, 5, 6 };
+    const matrix p(2, 3, d);
+    sprawdz(p.rows() == 2 && p.cols() == 3 && p(0, 2) == 3 && p(1, 0) == 4, "matrix(2, 3, tablica)");
+}
+
+/// TEST 14: mnożenie, działania elementowe i transpozycja dla wszystkich typów elementów.
+static void test_typy() {
+    cout << "\n=== TEST 14: Typy elementow ===" << endl;
+    dla_typow([]<typename T>() {
+        static constexpr int wymiary[][3] = {
+            { 1, 1, 1 }, { 7, 13, 5 }, { 33, 65, 17 }, { 127, 61, 129 }, { 129, 1, 77 }, { 1, 129, 77 }, { 200, 150, 1 }
+        };
+        bool ok = true, ok_odstep = true;
+        for (const auto& w : wymiary) {
+            const basic_matrix<T> a = losowa<T>(w[0], w[2], 26), b = losowa<T>(w[2], w[1], 27);
+            const auto wzor = iloczyn_wzorcowy(a, b);
+            ok = ok && pomnoz(a, b) == wzor;
+            ok_odstep = ok_odstep && pomnoz(z_odstepem(a), z_odstepem(b)) == wzor;
+        }
+        sprawdz(ok && ok_odstep, "pomnoz " + nazwa_typu<T>() + ": m x n x k od 1x1x1 do 127x61x129, takze z odstepem");
+
+        const basic_matrix<T> a = losowa<T>(37, 29, 28), b = losowa<T>(37, 29, 29);
+        const auto elementowo = [&](auto f) {
+            basic_matrix<T> w(37, 29);
+            for (int i = 0; i < 37; ++i) {
+                for (int j = 0; j < 29; ++j) w(i, j) = static_cast<T>(f(a(i, j), b(i, j)));
+            }
+            return w;
+        };
+        const auto suma = elementowo([](T x, T y) { return x + y; });
+        ok = dodaj(a, b) == suma && odejmij(a, b) == elementowo([](T x, T y) { return x - y; })
+             && pomnoz(a, T(3)) == elementowo([](T x, T) { return x * 3; })
+             && dodaj(a, T(3)) == elementowo([](T x, T) { return x + 3; })
+             && T(10) - a == elementowo([](T x, T) { return 10 - x; });
+        basic_matrix<T> x = z_odstepem(a);
+        x += b;
+        ok = ok && x == suma;
+        x -= b;
+        ok = ok && x == a;
+        const basic_matrix<T> e = wyrazenia::wyr(a) * T(2) + b - T(1);
+        ok = ok && e == elementowo([](T x, T y) { return x * 2 + y - 1; });
+        sprawdz(ok, "dzialania elementowe i wyrazenia " + nazwa_typu<T>());
+
+        ok = true;
+        for (int n : { 1, 7, 8, 65, 131 }) {
+            const basic_matrix<T> m = losowa<T>(n, n, 30, -100, 100);
+            basic_matrix<T> t = m;
+            t.dowroc();
+            bool zgodne = true;
+            for (int i = 0; zgodne && i < n; ++i) {
+                for (int j = 0; j < n; ++j) zgodne = zgodne && t(j, i) == m(i, j);
+            }
+            ok = ok && zgodne && transponuj(m) == t && transponuj(t) == m;
+        }
+        sprawdz(ok, "dowroc i transponuj " + nazwa_typu<T>() + ": n = 1, 7, 8, 65, 131");
+    });
+}
+
+/// TEST 15: rozmiary 64-bitowe, konstruktory i kontrola przepełnienia pojemności.
+static void test_rozmiary() {
+    cout << "\n=== TEST 15: Rozmiary ===" << endl;
+    matrix z(5, 0);
+    basic_matrix<int> p(0, 0);
+    sprawdz(z.rows() == 5 && z.cols() == 0 && p.size() == 0, "matrix(5, 0) i matrix(0, 0) - wymiary");
+    int t[] = { 1, 2, 3, 4 };
+    matrix a(2, t);
+    sprawdz(a(0, 1) == 2 && a(1, 0) == 3, "matrix(2, tablica)");
+
+    int wyjatki = 0;
+    try {
+        matrix b(2, nullptr);
+    } catch (const invalid_argument&) {
+        ++wyjatki;
+    }
+    try {
+        matrix b(-1, 2);
+    } catch (const invalid_argument&) {
+        ++wyjatki;
+    }
+    try {
+        matrix b(numeric_limits<ptrdiff_t>::max(), 2);
+    } catch (const length_error&) {
+        ++wyjatki;
+    }
+    try {
+        (void)jadra::pomnoz_rozmiary(ptrdiff_t(1) << 40, ptrdiff_t(1) << 40);
+    } catch (const length_error&) {
+        ++wyjatki;
+    }
+    sprawdz(wyjatki == 4, "matrix(2, nullptr), ujemny i zbyt duzy rozmiar, przepelnienie iloczynu - wyjatki");
+
+    // 6000 x 6000 bajtow przekracza prog blokow odwzorowanych z systemu
+    matrix_i8 d(6000, 6000);
+    d(5999, 5999) = 7;
+    d(0, 0) = 1;
+    sprawdz(d.size() == 6000 && d(5999, 5998) == 0 && d(5999, 5999) == 7,
+            string("macierz 36 MB (duze strony: ") + jadra::rodzaj_duzych_stron() + ")");
+}
+
+/**
+ * @brief Alokator zliczający przydziały, przekazujący je do
+ *        @ref jadra::alokator_wyrownany.
+ */
+class alokator_liczacy : public jadra::alokator {
+public:
+    atomic<int> przydzialow{ 0 }; ///< Liczba wywołań przydziel().
+    atomic<int> zywych{ 0 };      ///< Liczba niezwolnionych bloków.
+
+    void* przydziel(size_t bajtow) override {
+        ++przydzialow;
+        ++zywych;
+        return jadra::alokator_wyrownany().przydziel(bajtow);
+    }
+
+    void zwolnij(void* p, size_t bajtow) noexcept override {
+        if (p == nullptr) return;
+        --zywych;
+        jadra::alokator_wyrownany().zwolnij(p, bajtow);
+    }
+};
+
+/// TEST 16: alokatory – wyrównanie, pula bloków i alokator domyślny.
+static void test_alokatory() {
+    cout << "\n=== TEST 16: Alokatory ===" << endl;
+    alokator_liczacy licznik;
+    {
+        jadra::pula_pamieci pula(licznik);
+        const matrix_f64 a = losowa<double>(150, 130, 31), b = losowa<double>(130, 140, 32);
+        matrix_f64 x(a.rows(), a.cols(), pula), c(pula), t(pula);
+        bool ok = reinterpret_cast<uintptr_t>(x.data()) % 64 == 0;
+        int po_pierwszej = 0;
+        for (int i = 0; i < 20; ++i) {
+            x = a;
+            pomnoz_do(c, x, b);
+            transponuj_do(t, c);
+            dodaj_do(c, c, 1.0);
+            if (i == 0) po_pierwszej = licznik.przydzialow;
+        }
+        ok = ok && c == dodaj(iloczyn_wzorcowy(a, b), 1.0) && t == transponuj(iloczyn_wzorcowy(a, b));
+        sprawdz(ok && licznik.przydzialow == po_pierwszej, "pula_pamieci: petla bez nowych przydzialow, bloki wyrownane do 64");
+
+        {
+            matrix_f64 p(100, 100, pula);
+            p += 1.0;
+        }
+        const size_t zatrzymane = pula.zatrzymane();
+        const int przed = licznik.przydzialow;
+        {
+            matrix_f64 p(100, 100, pula);
+            sprawdz(zatrzymane > 0 && pula.zatrzymane() < zatrzymane && licznik.przydzialow == przed && p(99, 99) == 0.0,
+                    "pula_pamieci: ponowne uzycie zwolnionego bloku, wyzerowanego");
+        }
+        pula.oproznij();
+        sprawdz(pula.zatrzymane() == 0, "pula_pamieci: oproznij");
+    }
+    sprawdz(licznik.zywych == 0, "pula_pamieci: wszystkie bloki oddane zrodlu");
+
+    jadra::alokator& poprzedni = jadra::domyslny_alokator();
+    jadra::ustaw_domyslny_alokator(licznik);
+    const int przed = licznik.przydzialow;
+    {
+        matrix m(10, 10);
+        m += 1;
+        const matrix n = dodaj(m, m);
+        sprawdz(licznik.przydzialow == przed + 2 && n(9, 9) == 2, "ustaw_domyslny_alokator: nowe macierze i wyniki");
+    }
+    jadra::ustaw_domyslny_alokator(poprzedni);
+    sprawdz(licznik.zywych == 0, "alokator domyslny: bloki zwolnione");
+}
+
+/// TEST 17: zmiana rozmiaru z zachowaniem zawartości, rezerwacja pojemności.
+static void test_resize() {
+    cout << "\n=== TEST 17: Zmiana rozmiaru ===" << endl;
+    const matrix a = losowa(5, 7, 33);
+    matrix b = a;
+    b.resize(9, 4);
+    bool ok = b.rows() == 9 && b.cols() == 4;
+    for (ptrdiff_t i = 0; i < 9; ++i) {
+        for (ptrdiff_t j = 0; j < 4; ++j) ok = ok && b(i, j) == (i < 5 ? a(i, j) : 0);
+    }
+    sprawdz(ok, "resize zachowuje wspolny blok, nowe elementy sa zerami");
+
+    b.reserve(1000);
+    const int* d = b.data();
+    b.resize(20, 30);
+    sprawdz(b.capacity() >= 1000 && b.data() == d && b(0, 0) == a(0, 0) && b(4, 3) == a(4, 3) && b(19, 29) == 0,
+            "resize w zarezerwowanej pojemnosci bez realokacji");
+    b.shrink_to_fit();
+    sprawdz(b.capacity() == 600 && b.ciagla() && b(4, 3) == a(4, 3) && b(4, 4) == 0, "shrink_to_fit");
+
+    matrix s;
+    s.alokuj(6, 5, 8);
+    s.resize(6, 7);
+    sprawdz(s.stride() == 8 && s(5, 6) == 0, "resize w obrebie odstepu");
+
+    const matrix_f64 wzor = losowa<double>(40, 30, 34);
+    matrix_f64 n(40, 30, bez_zerowania);
+    for (ptrdiff_t i = 0; i < 40; ++i) {
+        for (ptrdiff_t j = 0; j < 30; ++j) n(i, j) = wzor(i, j);
+    }
+    sprawdz(n.rows() == 40 && n.cols() == 30 && n == wzor && transponuj(transponuj(n)) == wzor,
+            "konstruktor bez_zerowania, transpozycja bez zerowania wyniku");
+}
+
+/// TEST 18: algorytm Strassena wymuszony także dla małych macierzy.
+static void test_strassen() {
+    cout << "\n=== TEST 18: Strassen ===" << endl;
+    const auto algorytm = jadra::wybrany_algorytm_mnozenia();
+    const ptrdiff_t prog = jadra::prog_strassena();
+    jadra::ustaw_algorytm_mnozenia(jadra::algorytm_mnozenia::strassen);
+    jadra::ustaw_prog_strassena(16);
+    sprawdz(jadra::uzyj_strassena<int32_t>(100, 90, 110) && jadra::uzyj_strassena<double>(100, 90, 110),
+            "Strassen wlaczony (prog 16)");
+
+    dla_typow([]<typename T>() {
+        bool ok = true;
+        for (const auto& w : { array<ptrdiff_t, 3>{ 100, 90, 110 }, array<ptrdiff_t, 3>{ 257, 129, 193 } }) {
+            const basic_matrix<T> a = losowa<T>(w[0], w[2], 35), b = losowa<T>(w[2], w[1], 36);
+            ok = ok && pomnoz(a, b) == iloczyn_wzorcowy(a, b);
+        }
+        sprawdz(ok, "Strassen " + nazwa_typu<T>() + ": 100x90x110, 257x129x193");
+    });
+
+    // pelny zakres int: wynik zawija sie modulo 2^32 tak samo jak w petli klasycznej
+    const matrix a = losowa(131, 67, 37, INT_MIN, INT_MAX), b = losowa(67, 75, 38, INT_MIN, INT_MAX);
+    sprawdz(pomnoz(a, b) == iloczyn_zawijany(a, b), "Strassen int32: przepelnienie zawija sie jak w petli klasycznej");
+
+    jadra::ustaw_algorytm_mnozenia(algorytm);
+    jadra::ustaw_prog_strassena(prog);
+}
+
+/// TEST 19: macierze rzadkie w formatach COO, CSR i CSC.
+static void test_rzadkie() {
+    cout << "\n=== TEST 19: Macierze rzadkie ===" << endl;
+    dla_typow([]<typename T>() {
+        basic_matrix<T> g = losowa<T>(23, 31, 15), h = losowa<T>(31, 19, 16);
+        ptrdiff_t niezerowe = 0;
+        for (ptrdiff_t i = 0; i < 23; ++i) {
+            for (ptrdiff_t j = 0; j < 31; ++j) {
+                if ((i * 7 + j) % 3 != 0) g(i, j) = 0;
+                niezerowe += g(i, j) != 0;
+            }
+        }
+        for (ptrdiff_t i = 0; i < 31; ++i) {
+            for (ptrdiff_t j = 0; j < 19; ++j) {
+                if ((i + j * 5) % 4 != 0) h(i, j) = 0;
+            }
+        }
+        const basic_matrix<T> gesta = losowa<T>(31, 17, 17);
+        const auto wzor = iloczyn_wzorcowy(g, gesta);
+        bool ok = true;
+        for (format_rzadki f : { format_rzadki::coo, format_rzadki::csr, format_rzadki::csc }) {
+            const basic_sparse_matrix<T> s(g, f);
+            ok = ok && s.nnz() == niezerowe && s.gesta() == g && s(22, 30) == g(22, 30) && s(3, 1) == g(3, 1)
+                 && pomnoz(s, gesta) == wzor && transponuj(s).gesta() == transponuj(g);
+        }
+        sprawdz(ok, "rzadka " + nazwa_typu<T>() + ": COO, CSR, CSC, iloczyn z gesta, transpozycja");
+
+        const basic_sparse_matrix<T> a(g, format_rzadki::csr), b(h, format_rzadki::csr);
+        sprawdz(pomnoz(a, b).gesta() == iloczyn_wzorcowy(g, h), "rzadka * rzadka " + nazwa_typu<T>());
+    });
+
+    // pelny zakres int: iloczyny rzadkie zawijaja sie modulo 2^32 jak gesty gemm
+    matrix g = losowa(29, 41, 39, INT_MIN, INT_MAX);
+    for (ptrdiff_t i = 0; i < 29; ++i) {
+        for (ptrdiff_t j = 0; j < 41; ++j) {
+            if ((i + j) % 3 == 0) g(i, j) = 0;
+        }
+    }
+    const matrix h = losowa(41, 23, 40, INT_MIN, INT_MAX), v = losowa(41, 1, 41, INT_MIN, INT_MAX);
+    const sparse_matrix s(g, format_rzadki::csr), t(h, format_rzadki::csr);
+    sprawdz(pomnoz(s, h) == iloczyn_zawijany(g, h) && pomnoz(s, v) == iloczyn_zawijany(g, v)
+                && pomnoz(s, t).gesta() == iloczyn_zawijany(g, h),
+            "rzadka int32: przepelnienie zawija sie modulo 2^32");
+
+    // wskazniki rosnace ponad tablice indeksow, a potem malejace: wyjatek, a nie odczyt poza tablica
+    bool wyjatek = false;
+    try {
+        sparse_matrix z(2, 3, format_rzadki::csr, { 0, 5, 2 }, { 0, 1 }, { 1, 2 });
+    } catch (const invalid_argument&) {
+        wyjatek = true;
+    }
+    const sparse_matrix u(2, 3, format_rzadki::csr, { 0, 1, 2 }, { 2, 0 }, { 7, 8 });
+    sprawdz(wyjatek && u(0, 2) == 7 && u(1, 0) == 8, "rzadka z tablic: wskazniki poza tablica indeksow");
+}
+
+/// TEST 20: macierze diagonalne, wstęgowe i trójkątne razy gęste.
+static void test_strukturalne() {
+    cout << "\n=== TEST 20: Macierze strukturalne ===" << endl;
+    dla_typow([]<typename T>() {
+        const basic_matrix<T> m = losowa<T>(19, 19, 18), p = losowa<T>(19, 11, 19), l = losowa<T>(13, 19, 20);
+        // czesc m z elementami od <= j - i <= do_
+        const auto pasmo = [&m](ptrdiff_t od, ptrdiff_t do_) {
+            basic_matrix<T> w(19, 19);
+            for (ptrdiff_t i = 0; i < 19; ++i) {
+                for (ptrdiff_t j = 0; j < 19; ++j) {
+                    if (j - i >= od && j - i <= do_) w(i, j) = m(i, j);
+                }
+            }
+            return w;
+        };
+        const auto zgodna = [&](const auto& s, const basic_matrix<T>& g) {
+            return s.gesta() == g && pomnoz(s, p) == iloczyn_wzorcowy(g, p) && pomnoz(l, s) == iloczyn_wzorcowy(l, g);
+        };
+
+        bool ok = true;
+        for (ptrdiff_t k : { 0, 2, -3 }) ok = ok && zgodna(basic_diagonal_matrix<T>(m, k), pasmo(k, k));
+        sprawdz(ok, "diagonalna " + nazwa_typu<T>() + ": k = 0, 2, -3");
+        sprawdz(zgodna(basic_band_matrix<T>(m, 2, 3), pasmo(-2, 3)) && zgodna(basic_band_matrix<T>(m, 0, 0), pasmo(0, 0)),
+                "wstegowa " + nazwa_typu<T>() + ": kl = 2, ku = 3 i kl = ku = 0");
+        ok = zgodna(basic_triangular_matrix<T>(m, trojkat::dolna), pasmo(-18, 0))
+             && zgodna(basic_triangular_matrix<T>(m, trojkat::dolna, true), pasmo(-18, -1))
+             && zgodna(basic_triangular_matrix<T>(m, trojkat::gorna), pasmo(0, 18))
+             && zgodna(basic_triangular_matrix<T>(m, trojkat::gorna, true), pasmo(1, 18));
+        sprawdz(ok, "trojkatna " + nazwa_typu<T>() + ": dolna, gorna, scisle");
+    });
+
+    // wynik z odstepem miedzy wierszami: zerowane sa tylko elementy wierszy, nie cale dane
+    const matrix m = losowa(19, 19, 42), l = losowa(13, 19, 43);
+    const band_matrix w(m, 1, 2);
+    matrix c = z_odstepem(losowa(13, 19, 44)), d = z_odstepem(losowa(19, 19, 45));
+    pomnoz_do(c, l, w);
+    pomnoz_do(d, w, m);
+    sprawdz(c.stride() == 22 && c == iloczyn_wzorcowy(l, w.gesta()) && d.stride() == 22
+                && d == iloczyn_wzorcowy(w.gesta(), m),
+            "strukturalna: pomnoz_do do macierzy z odstepem");
+
+    // pelny zakres int: iloczyny strukturalne zawijaja sie modulo 2^32 jak gesty gemm
+    const matrix duza = losowa(19, 19, 46, INT_MIN, INT_MAX), p = losowa(19, 11, 47, INT_MIN, INT_MAX);
+    const band_matrix v(duza, 1, 2);
+    sprawdz(pomnoz(v, p) == iloczyn_zawijany(v.gesta(), p) && pomnoz(l, v) == iloczyn_zawijany(l, v.gesta()),
+            "strukturalna int32: przepelnienie zawija sie modulo 2^32");
+}
+
+/// TEST 21: macierze bitowe.
+static void test_bitowe() {
+    cout << "\n=== TEST 21: Macierze bitowe ===" << endl;
+    const matrix a = losowa<int>(70, 130, 21, 0, 1), b = losowa<int>(130, 67, 22, 0, 1);
+    const matrix c = iloczyn_wzorcowy(a, b);
+    matrix logiczny(70, 67), gf2(70, 67);
+    for (ptrdiff_t i = 0; i < 70; ++i) {
+        for (ptrdiff_t j = 0; j < 67; ++j) {
+            logiczny(i, j) = c(i, j) > 0;
+            gf2(i, j) = c(i, j) % 2;
+        }
+    }
+    const bit_matrix A(a), B(b);
+    sprawdz(A.gesta<int>() == a && A.transponowana().gesta<int>() == transponuj(a), "bit_matrix z macierzy gestej i z powrotem");
+    sprawdz(pomnoz_logicznie(A, B) == bit_matrix(logiczny), "iloczyn logiczny 70x130 * 130x67");
+    sprawdz(pomnoz_gf2(A, B) == bit_matrix(gf2), "iloczyn nad GF(2) 70x130 * 130x67");
+
+    // sciezka 0 -> 1 -> ... -> 99: domkniecie to wszystkie pary i < j
+    bit_matrix s(100, 100), g(100, 100);
+    for (ptrdiff_t i = 0; i < 99; ++i) s.wstaw(i, i + 1, true);
+    g.nad_przekatna();
+    bool ok = domkniecie_przechodnie(s) == g;
+    // cykl: z kazdego wierzcholka do kazdego
+    s.wstaw(99, 0, true);
+    ok = ok && domkniecie_przechodnie(s).liczba_jedynek() == 100 * 100;
+    sprawdz(ok, "domkniecie przechodnie sciezki i cyklu (n = 100)");
+}
+
+/// TEST 22: potęgi macierzy i iloczyny łańcuchowe.
+static void test_potega() {
+    cout << "\n=== TEST 22: Potegi i lancuchy ===" << endl;
+    dla_typow([]<typename T>() {
+        using S = conditional_t<is_integral_v<T>, int64_t, double>;
+        const basic_matrix<T> a = losowa<T>(9, 9, 23, -1, 1);
+        const basic_matrix<S> as(a);
+        basic_matrix<S> wzor(9);
+        wzor.przekatna();
+        bool ok = basic_matrix<S>(potega(a, 0)) == wzor;
+        for (unsigned long long k = 1; k <= 7; ++k) {
+            wzor = iloczyn_wzorcowy(wzor, as);
+            ok = ok && basic_matrix<S>(potega(a, k)) == wzor;
+        }
+        sprawdz(ok, "potega " + nazwa_typu<T>() + ": k = 0..7");
+
+        const basic_matrix<T> p = losowa<T>(5, 30, 24), q = losowa<T>(30, 2, 25), r = losowa<T>(2, 40, 26), s = losowa<T>(40, 3, 27);
+        wzor = iloczyn_wzorcowy(iloczyn_wzorcowy(iloczyn_wzorcowy(basic_matrix<S>(p), basic_matrix<S>(q)), basic_matrix<S>(r)),
+                                basic_matrix<S>(s));
+        sprawdz(basic_matrix<S>(pomnoz_lancuch(p, q, r, s)) == wzor, "pomnoz_lancuch " + nazwa_typu<T>() + ": 5x30x2x40x3");
+    });
+
+    // przyklad z Cormena: optymalny podzial A1..A6 to (A1 A2 A3)(A4 A5 A6)
+    const vector<ptrdiff_t> podzial = kolejnosc_mnozenia({ 30, 35, 15, 5, 10, 20, 25 });
+    sprawdz(podzial.size() == 36 && podzial[0 * 6 + 5] == 2 && podzial[0 * 6 + 2] == 0 && podzial[3 * 6 + 5] == 4,
+            "kolejnosc_mnozenia: przyklad CLRS");
+}
+
+/// TEST 23: mnożenie int32 z wynikiem 64-bitowym i modulo p.
+static void test_arytmetyka() {
+    cout << "\n=== TEST 23: Tryby arytmetyki ===" << endl;
+    const matrix_i32 a = losowa<int32_t>(13, 1000, 28, -(1 << 24) + 1, (1 << 24) - 1);
+    const matrix_i32 b = losowa<int32_t>(1000, 11, 29, -(1 << 24) + 1, (1 << 24) - 1);
+    sprawdz(pomnoz_szeroko(a, b) == iloczyn_wzorcowy(matrix_i64(a), matrix_i64(b)), "pomnoz_szeroko: |a|, |b| < 2^24, k = 1000");
+
+    for (int32_t p : { 7, 2147483647 }) {
+        const matrix_i32 x = losowa<int32_t>(17, 45, 30, numeric_limits<int32_t>::min(), numeric_limits<int32_t>::max());
+        const matrix_i32 y = losowa<int32_t>(45, 17, 31, numeric_limits<int32_t>::min(), numeric_limits<int32_t>::max());
+        matrix_i32 wzor(17, 17);
+        for (ptrdiff_t i = 0; i < 17; ++i) {
+            for (ptrdiff_t j = 0; j < 17; ++j) {
+                int64_t s = 0;
+                for (ptrdiff_t q = 0; q < 45; ++q) {
+                    const int64_t u = (int64_t(x(i, q)) % p + p) % p, v = (int64_t(y(q, j)) % p + p) % p;
+                    s = (s + u * v) % p;
+                }
+                wzor(i, j) = static_cast<int32_t>(s);
+            }
+        }
+        const matrix_i32 kwadrat = losowa<int32_t>(17, 17, 32, -1000, 1000);
+        matrix_i32 c = kwadrat;
+        pomnoz_modulo_do(c, c, pomnoz_modulo(x, y, p), p);
+        sprawdz(pomnoz_modulo(x, y, p) == wzor && c == pomnoz_modulo(kwadrat, wzor, p),
+                "pomnoz_modulo p = " + to_string(p) + ": ujemne argumenty, wynik w miejscu");
+    }
+}
+
+/// TEST 24: mnożenie int32 z nasyceniem, także gdy sumy nie mieszczą się w int64.
+static void test_nasycenie() {
+    cout << "\n=== TEST 24: Mnozenie z nasyceniem ===" << endl;
+    constexpr int32_t MIN = numeric_limits<int32_t>::min(), MAX = numeric_limits<int32_t>::max();
+    matrix_i32 x(1, 2);
+    x(0, 0) = MIN; x(0, 1) = MIN;
+    sprawdz(pomnoz_nasycajaco(x, transponuj(x))(0, 0) == MAX, "[MIN MIN] * [MIN MIN]^T = INT32_MAX");
+
+    // 101 * 2^60 zawija sie w int64 do liczby ujemnej
+    matrix_i32 a(1, 101), b(101, 1);
+    a += 1 << 30;
+    b += 1 << 30;
+    sprawdz(pomnoz_nasycajaco(a, b)(0, 0) == MAX, "suma 101 * 2^60 -> INT32_MAX");
+    b *= -1;
+    sprawdz(pomnoz_nasycajaco(a, b)(0, 0) == MIN, "suma -101 * 2^60 -> INT32_MIN");
+
+    // sumy czesciowe do 2^67, wynik dokladny 15
+    matrix_i32 c(1, 257), d(257, 1);
+    for (int p = 0; p < 256; ++p) {
+        c(0, p) = 1 << 30;
+        d(p, 0) = p < 128 ? 1 << 30 : -(1 << 30);
+    }
+    c(0, 256) = 3;
+    d(256, 0) = 5;
+    sprawdz(pomnoz_nasycajaco(c, d)(0, 0) == 15, "znoszace sie sumy 2^67 -> 15");
+
+    // losowe +-2^30: wynik to znak sumy (liczonej w double)
+    bool zgodne = true;
+    for (ptrdiff_t k : { 2, 101, 258 }) {
+        const matrix_i32 e = losowa<int32_t>(7, k, uint64_t(k), -(1 << 30), 1 << 30);
+        const matrix_i32 f = losowa<int32_t>(k, 9, uint64_t(k + 1), -(1 << 30), 1 << 30);
+        const matrix_i32 g = pomnoz_nasycajaco(e, f);
+        for (ptrdiff_t i = 0; i < 7; ++i) {
+            for (ptrdiff_t j = 0; j < 9; ++j) {
+                double suma = 0;
+                for (ptrdiff_t p = 0; p < k; ++p) suma += double(e(i, p)) * double(f(p, j));
+                zgodne = zgodne && g(i, j) == (suma > 0 ? MAX : MIN);
+            }
+        }
+    }
+    sprawdz(zgodne, "losowe +-2^30, k = 2, 101, 258");
+
+    const matrix_i32 h = losowa<int32_t>(37, 53, 1, -1000, 1000), q = losowa<int32_t>(53, 41, 2, -1000, 1000);
+    sprawdz(pomnoz_nasycajaco(h, q) == pomnoz(h, q), "male wartosci: jak zwykly iloczyn");
+
+    // n > 2^14: bufor jest dzielony takze po kolumnach
+    const matrix_i32 s = losowa<int32_t>(3, 5, 3, -1000, 1000), t = losowa<int32_t>(5, 16421, 4, -1000, 1000);
+    matrix_i32 u(2, 101), v(101, 16421);
+    u += 1 << 30;
+    for (ptrdiff_t p = 0; p < 101; ++p) {
+        for (ptrdiff_t j = 0; j < 16421; ++j) v(p, j) = j < 16384 ? 1 << 30 : -(1 << 30);
+    }
+    const matrix_i32 w = pomnoz_nasycajaco(u, v);
+    sprawdz(pomnoz_nasycajaco(s, t) == pomnoz(s, t) && w(1, 16383) == MAX && w(0, 16384) == MIN && w(1, 16420) == MIN,
+            "n = 16421: bloki kolumn, takze z plastrami k");
+}
+
+/// TEST 25: generator Philox i losowanie macierzy.
+static void test_losowanie() {
+    cout << "\n=== TEST 25: Losowanie ===" << endl;
+    philox g(42), h(42), i(43), j(42, 1);
+    int rozne_ziarno = 0, rozny_strumien = 0;
+    bool ok = true;
+    for (int n = 0; n < 1000; ++n) {
+        const uint32_t x = g();
+        ok = ok && x == h();
+        rozne_ziarno += x != i();
+        rozny_strumien += x != j();
+    }
+    sprawdz(ok, "philox: ten sam ciag dla tego samego ziarna");
+    sprawdz(rozne_ziarno > 990 && rozny_strumien > 990, "philox: inne ziarno lub strumien - inny ciag");
+    philox k(42), l(42);
+    k.discard(777);
+    for (int n = 0; n < 777; ++n) l();
+    ok = true;
+    for (int n = 0; n < 20; ++n) ok = ok && k() == l();
+    sprawdz(ok, "philox: discard(777)");
+
+    dla_typow([]<typename T>() {
+        basic_matrix<T> m(61, 47), n(61, 47);
+        losuj_jednostajnie(m, 33, T(-5), T(5));
+        losuj_jednostajnie(n, 33, T(-5), T(5));
+        bool zakres = true, od = false, do_ = false;
+        for (ptrdiff_t i = 0; i < 61; ++i) {
+            for (ptrdiff_t j = 0; j < 47; ++j) {
+                zakres = zakres && m(i, j) >= T(-5) && (is_integral_v<T> ? m(i, j) <= T(5) : m(i, j) < T(5));
+                od = od || m(i, j) < T(-4);
+                do_ = do_ || m(i, j) > T(4);
+            }
+        }
+        sprawdz(m == n && zakres && od && do_, "losuj_jednostajnie " + nazwa_typu<T>() + ": powtarzalnosc i zakres");
+    });
+
+    const int poprzednio = liczba_watkow();
+    matrix_f64 a(700, 500), b(700, 500), c(700, 500), d(700, 500);
+    ustaw_liczbe_watkow(1);
+    losuj_jednostajnie(a, 34, 0.0, 1.0);
+    losuj_normalnie(c, 35, 0.0, 1.0);
+    ustaw_liczbe_watkow(4);
+    losuj_jednostajnie(b, 34, 0.0, 1.0);
+    losuj_normalnie(d, 35, 0.0, 1.0);
+    ustaw_liczbe_watkow(poprzednio);
+    double suma = 0, kwadraty = 0;
+    for (ptrdiff_t i = 0; i < 700; ++i) {
+        for (ptrdiff_t j = 0; j < 500; ++j) {
+            suma += c(i, j);
+            kwadraty += c(i, j) * c(i, j);
+        }
+    }
+    const double srednia = suma / 350000, wariancja = kwadraty / 350000 - srednia * srednia;
+    sprawdz(a == b && c == d, "losowanie niezalezne od liczby watkow");
+    sprawdz(abs(srednia) < 0.01 && abs(wariancja - 1) < 0.01, "losuj_normalnie: srednia 0, wariancja 1");
+}
+
+/// TEST 26: zapis i odczyt binarny, odwzorowanie pliku w pamięci.
+static void test_binarne() {
+    cout << "\n=== TEST 26: Zapis binarny ===" << endl;
+    dla_typow([]<typename T>() {
+        const basic_matrix<T> m = losowa<T>(13, 7, 36, -100, 100), s = z_odstepem(m);
+        stringstream strumien;
+        zapisz_binarnie(m, strumien);
+        zapisz_binarnie(s, strumien);
+        zapisz_binarnie(basic_matrix<T>(0, 5), strumien);
+        const basic_matrix<T> a = wczytaj_binarnie<T>(strumien), b = wczytaj_binarnie<T>(strumien),
+                              c = wczytaj_binarnie<T>(strumien);
+
+        const string sciezka =
+            (filesystem::temp_directory_path() / ("macierz_test_" + nazwa_typu<T>() + ".bin")).string();
+        zapisz_binarnie(s, sciezka);
+        const bool plik = wczytaj_binarnie<T>(sciezka) == m && mapuj_macierz<T>(sciezka) == m;
+        filesystem::remove(sciezka);
+        sprawdz(a == m && b == m && c.rows() == 0 && c.cols() == 5 && plik,
+                "zapis binarny " + nazwa_typu<T>() + ": strumien, plik, mmap, macierz z odstepem i pusta");
+    });
+
+    stringstream strumien;
+    zapisz_binarnie(losowa<int32_t>(3, 3, 37), strumien);
+    bool wyjatek = false;
+    try {
+        (void)wczytaj_binarnie<float>(strumien);
+    } catch (const runtime_error&) {
+        wyjatek = true;
+    }
+    sprawdz(wyjatek, "odczyt int32 jako float - wyjatek");
+}
+
+/// TEST 27: formaty tekstowe.
+static void test_tekstowe() {
+    cout << "\n=== TEST 27: Zapis tekstowy ===" << endl;
+    dla_typow([]<typename T>() {
+        basic_matrix<T> m = losowa<T>(23, 17, 38, -100, 100);
+        if constexpr (is_floating_point_v<T>) losuj_jednostajnie(m, 39, T(-1), T(1));
+        bool ok = true;
+        for (format_tekstu f : { format_tekstu::odstepy, format_tekstu::csv, format_tekstu::matrix_market }) {
+            stringstream s;
+            zapisz_tekstowo(m, s, f);
+            ok = ok && parsuj_tekst<T>(s.str(), f) == m && wczytaj_tekstowo<T>(s, f) == m;
+        }
+        sprawdz(ok, "zapis i odczyt tekstowy " + nazwa_typu<T>() + ": odstepy, csv, Matrix Market");
+    });
+
+    const matrix_i32 k = parsuj_tekst<int32_t>("%%MatrixMarket matrix coordinate integer general\n"
+                                               "% komentarz\n"
+                                               "3 4 3\n"
+                                               "1 1 5\n"
+                                               "2 3 -7\n"
+                                               "3 4 9\n",
+                                               format_tekstu::matrix_market);
+    int32_t w[] = { 5, 0, 0, 0, 0, 0, -7, 0, 0, 0, 0, 9 };
+    sprawdz(k == matrix_i32(3, 4, w), "Matrix Market coordinate integer general");
+    const matrix_f64 s = parsuj_tekst<double>("%%MatrixMarket matrix coordinate real symmetric\n"
+                                              "3 3 2\n"
+                                              "2 1 1.5\n"
+                                              "3 3 -2\n",
+                                              format_tekstu::matrix_market);
+    double v[] = { 0, 1.5, 0, 1.5, 0, 0, 0, 0, -2 };
+    sprawdz(s == matrix_f64(3, 3, v), "Matrix Market coordinate real symmetric");
+    int32_t t[] = { 1, -2, 3, 4, 5, -6 };
+    sprawdz(parsuj_tekst<int32_t>("1,-2,3\r\n4,5,-6\r\n", format_tekstu::csv) == matrix_i32(2, 3, t)
+                && parsuj_tekst<int32_t>("  1 -2\t3\n\n4 5 -6") == matrix_i32(2, 3, t),
+            "csv z CRLF, odstepy z tabulacja i bez konca linii");
+
+    int wyjatki = 0;
+    for (const char* tekst : { "1 2\n3 x\n", "1 2\n3\n", "1 300\n" }) {
+        try {
+            (void)parsuj_tekst<int8_t>(tekst);
+        } catch (const runtime_error&) {
+            ++wyjatki;
+        }
+    }
+    sprawdz(wyjatki == 3, "bledny tekst, rozna dlugosc wierszy, liczba poza zakresem - wyjatki");
+}
+
+/// TEST 28: mnożenie widoków (podmacierzy i transpozycji).
+static void test_widoki() {
+    cout << "\n=== TEST 28: Widoki ===" << endl;
+    dla_typow([]<typename T>() {
+        using W = jadra::iloczyn_t<T>;
+        const basic_matrix<T> duza = losowa<T>(40, 50, 40);
+        const auto a = widok(duza).podmacierz(3, 5, 17, 21);
+        const auto b = widok(duza).podmacierz(10, 20, 13, 21).transpozycja();
+        const basic_matrix<W> wzor = iloczyn_wzorcowy(kopiuj(a), kopiuj(b));
+
+        basic_matrix<W> c(17, 13);
+        pomnoz_do(widok(c), a, b);
+        bool ok = c == wzor;
+        pomnoz_do(widok(c), a, b, true);
+        ok = ok && c == dodaj(wzor, wzor);
+
+        basic_matrix<W> d(20, 20);
+        pomnoz_do(widok(d).podmacierz(2, 3, 17, 13), a, b);
+        ok = ok && kopiuj(widok(as_const(d)).podmacierz(2, 3, 17, 13)) == wzor && d(0, 0) == 0 && d(19, 19) == 0;
+        sprawdz(ok, "pomnoz_do na widokach " + nazwa_typu<T>() + ": podmacierz * transpozycja, akumulacja");
+
+        basic_matrix<T> e(17, 21);
+        kopiuj_do(widok(e), a);
+        wypelnij(widok(e).kolumna(4), T(7));
+        ok = e(0, 4) == 7 && e(16, 4) == 7 && e(16, 5) == duza(19, 10) && e(0, 0) == duza(3, 5);
+        sprawdz(ok, "kopiuj_do i wypelnij kolumny " + nazwa_typu<T>());
+    });
+}
+
+/// TEST 29: operacje na widokach, których wynik nachodzi na argument.
+static void test_nachodzace_widoki() {
+    cout << "\n=== TEST 29: Nachodzace widoki ===" << endl;
+    for (ptrdiff_t n : { 9, 131 }) {
+        matrix S0(n);
+        losuj_jednostajnie(S0, 3, -50, 50);
+        matrix S = S0, X(n);
+        losuj_jednostajnie(X, 4, -5, 5);
+
+        transponuj_do(widok(S), widok(as_const(S)));
+        sprawdz(S == transponuj(S0), "transponuj_do(S, S)");
+
+        S = S0;
+        kopiuj_do(widok(S).podmacierz(1, 1, n - 1, n - 1), widok(as_const(S)).podmacierz(0, 0, n - 1, n - 1));
+        bool zgodne = true;
+        for (ptrdiff_t i = 1; i < n; ++i) {
+            for (ptrdiff_t j = 1; j < n; ++j) zgodne = zgodne && S(i, j) == S0(i - 1, j - 1);
+        }
+        sprawdz(zgodne, "kopiuj_do przesunietej podmacierzy");
+
+        S = S0;
+        kopiuj_do(widok(S), widok(as_const(S)).transpozycja());
+        sprawdz(S == transponuj(S0), "kopiuj_do(S, S^T)");
+
+        S = S0;
+        dodaj_do(widok(S), widok(as_const(X)), widok(as_const(S)).transpozycja());
+        sprawdz(S == dodaj(X, transponuj(S0)), "dodaj_do(S, X, S^T)");
+
+        S = S0;
+        pomnoz_do(widok(S), widok(as_const(S)), 3);
+        sprawdz(S == pomnoz(S0, 3), "pomnoz_do(S, S, 3) w miejscu");
+    }
+}
+
+/// TEST 30: partie małych macierzy.
+static void test_partie() {
+    cout << "\n=== TEST 30: Partie macierzy ===" << endl;
+    dla_typow([]<typename T>() {
+        vector<basic_matrix<T>> a, b;
+        for (uint64_t k = 0; k < 37; ++k) {
+            a.push_back(losowa<T>(5, 3, 100 + k));
+            b.push_back(losowa<T>(3, 4, 200 + k));
+        }
+        const matrix_batch<T> pa(a), pb(b);
+        const auto c = pomnoz(pa, pb);
+        const auto s = dodaj(pa, pa);
+        const auto t = transponuj(pa);
+        vector<T> bufor(37 * 15);
+        pa.zapisz(bufor.data());
+        matrix_batch<T> q(37, 5, 3);
+        q.wczytaj(bufor.data());
+
+        bool ok = c.size() == 37 && c.rows() == 5 && c.cols() == 4;
+        for (ptrdiff_t k = 0; k < 37; ++k) {
+            const basic_matrix<T>& x = a[static_cast<size_t>(k)];
+            ok = ok && c.macierz(k) == iloczyn_wzorcowy(x, b[static_cast<size_t>(k)]) && s.macierz(k) == dodaj(x, x)
+                 && t.macierz(k) == transponuj(x) && q.macierz(k) == x && bufor[static_cast<size_t>(k * 15 + 4)] == x(1, 1);
+        }
+        sprawdz(ok, "partia " + nazwa_typu<T>() + ": 37 macierzy 5x3 * 3x4, suma, transpozycja, zapis i odczyt");
+    });
+
+    // pelny zakres int: pelne pasma i reszta partii zawijaja sie modulo 2^32
+    vector<matrix> a, b;
+    for (uint64_t k = 0; k < 37; ++k) {
+        a.push_back(losowa(4, 6, 300 + k, INT_MIN, INT_MAX));
+        b.push_back(losowa(6, 3, 400 + k, INT_MIN, INT_MAX));
+    }
+    const matrix_batch<int> c = pomnoz(matrix_batch<int>(a), matrix_batch<int>(b));
+    bool ok = true;
+    for (size_t k = 0; k < 37; ++k) ok = ok && c.macierz(static_cast<ptrdiff_t>(k)) == iloczyn_zawijany(a[k], b[k]);
+    sprawdz(ok, "partia int32: przepelnienie zawija sie modulo 2^32");
+}
+
+/// TEST 31: macierze o rozmiarze ustalonym w czasie kompilacji.
+static void test_stale() {
+    cout << "\n=== TEST 31: Macierze o stalym rozmiarze ===" << endl;
+    constexpr fixed_matrix<int, 2, 3> a{ { 1, 2, 3 }, { 4, 5, 6 } };
+    constexpr fixed_matrix<int, 3, 2> b{ { 7, 8 }, { 9, 10 }, { 11, 12 } };
+    static_assert(pomnoz(a, b) == fixed_matrix<int, 2, 2>{ { 58, 64 }, { 139, 154 } });
+    static_assert(transponuj(a)(2, 1) == 6 && transponuj(a)(0, 1) == 4);
+    constexpr auto d = [] {
+        fixed_matrix<int, 3, 4> m;
+        const int t[] = { 1, 2, 3 };
+        m.diagonalna_k<1>(t);
+        return m;
+    }();
+    static_assert(d(0, 1) == 1 && d(2, 3) == 3 && d(0, 0) == 0);
+    sprawdz(pomnoz(a, b)(1, 1) == 154, "obliczenia w czasie kompilacji");
+
+    dla_typow([]<typename T>() {
+        const basic_matrix<T> x = losowa<T>(5, 7, 41), y = losowa<T>(7, 3, 42);
+        const fixed_matrix<T, 5, 7> fx(x);
+        const fixed_matrix<T, 7, 3> fy(y);
+        bool ok = fx.macierz() == x && pomnoz(fx, fy).macierz() == iloczyn_wzorcowy(x, y)
+                  && transponuj(fx).macierz() == transponuj(x) && kopiuj(widok(fx)) == x;
+        if constexpr (is_same_v<jadra::iloczyn_t<T>, T>) {
+            const basic_matrix<T> z = losowa<T>(7, 7, 43);
+            fixed_matrix<T, 5, 7> fz = fx;
+            fz *= fixed_matrix<T, 7, 7>(z);
+            ok = ok && fz.macierz() == iloczyn_wzorcowy(x, z);
+        }
+        sprawdz(ok, "fixed_matrix " + nazwa_typu<T>() + ": zgodnosc z macierza dynamiczna");
+    });
+}
+
 /**
  * @brief Program testujący klasę matrix.
  *
@@ -14,7 +1161,11 @@ using namespace std;
  *  - podstawowe operacje losowania i wzorców,
  *  - operatory arytmetyczne i macierzowe,
  *  - generowanie przekątnych,
- *  - test wydajności/rozmiaru dla macierzy 30x30.
+ *  - test wydajności/rozmiaru dla macierzy 30x30,
+ *  - sprawdzenia poszczególnych modułów (TEST 5 i dalsze) – wyniki są
+ *    porównywane z iloczynem wzorcowym lub znanymi wartościami.
+ *
+ * @return 0, jeśli wszystkie sprawdzenia się powiodły, w przeciwnym razie 1.
  */
 int main() {
     srand(static_cast<unsigned int>(time(NULL)));
@@ -66,10 +1217,40 @@ int main() {
 
         if (Big.size() == 30) cout << "TEST DUZEJ MACIERZY ZALICZONY." << endl;
 
+        test_gemm();
+        test_watki();
+        test_elementowe();
+        test_przenoszenie();
+        test_wyrazenia();
+        test_funkcje();
+        test_dostep();
+        test_transpozycja();
+        test_prostokatne();
+        test_typy();
+        test_rozmiary();
+        test_alokatory();
+        test_resize();
+        test_strassen();
+        test_rzadkie();
+        test_strukturalne();
+        test_bitowe();
+        test_potega();
+        test_arytmetyka();
+        test_nasycenie();
+        test_losowanie();
+        test_binarne();
+        test_tekstowe();
+        test_widoki();
+        test_nachodzace_widoki();
+        test_partie();
+        test_stale();
+
+        cout << "\n" << (bledy == 0 ? "WSZYSTKIE SPRAWDZENIA ZALICZONE." : "NIEUDANE SPRAWDZENIA: " + to_string(bledy)) << endl;
     }
     catch (const exception& e) {
         cerr << "WYJATEK: " << e.what() << endl;
+        ++bledy;
     }
 
-    return 0;
-}
\ No newline at end of file
+    return bledy == 0 ? 0 : 1;
+}
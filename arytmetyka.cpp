@@ -0,0 +1,129 @@
+#include "arytmetyka.h"
+#include "gemm.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Zwraca @p m, jeśli wszystkie jej elementy należą do [0, @p p);
+ *        w przeciwnym razie zapisuje do @p kopia elementy @p m modulo p
+ *        i zwraca @p kopia.
+ */
+const basic_matrix<int32_t>& sprowadz_modulo(const basic_matrix<int32_t>& m, int32_t p, basic_matrix<int32_t>& kopia) {
+    bool w_zakresie = true;
+    for (ptrdiff_t i = 0; i < m.rows() && w_zakresie; ++i) {
+        const int32_t* w = m.row_ptr(i);
+        w_zakresie = all_of(w, w + m.cols(), [p](int32_t x) { return x >= 0 && x < p; });
+    }
+    if (w_zakresie) return m;
+
+    kopia.alokuj(m.rows(), m.cols(), bez_zerowania);
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(m.cols(), 1));
+    rownolegle_dla(0, m.rows(), ziarno, [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const int32_t* z = m.row_ptr(static_cast<ptrdiff_t>(i));
+            int32_t* d = kopia.row_ptr(static_cast<ptrdiff_t>(i));
+            for (ptrdiff_t j = 0; j < m.cols(); ++j) {
+                const int32_t r = z[j] % p;
+                d[j] = r < 0 ? r + p : r;
+            }
+        }
+    });
+    return kopia;
+}
+
+} // namespace
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn a * b liczony w 64 bitach.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+basic_matrix<int64_t>& pomnoz_szeroko_do(basic_matrix<int64_t>& wynik, const basic_matrix<int32_t>& a,
+                                         const basic_matrix<int32_t>& b) {
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    wynik.alokuj(a.rows(), b.cols(), bez_zerowania);
+    jadra::gemm_szeroki(a.rows(), b.cols(), a.cols(), a.data(), a.stride(), b.data(), b.stride(),
+                        wynik.data(), wynik.stride());
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn a * b liczony w 64 bitach.
+ */
+basic_matrix<int64_t> pomnoz_szeroko(const basic_matrix<int32_t>& a, const basic_matrix<int32_t>& b) {
+    basic_matrix<int64_t> wynik(b.get_allocator());
+    pomnoz_szeroko_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn a * b z nasyceniem.
+ *
+ * Jeśli @p wynik jest jednym z argumentów, wynik jest liczony do macierzy
+ * tymczasowej.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+basic_matrix<int32_t>& pomnoz_nasycajaco_do(basic_matrix<int32_t>& wynik, const basic_matrix<int32_t>& a,
+                                            const basic_matrix<int32_t>& b) {
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    if (&wynik == &a || &wynik == &b) {
+        basic_matrix<int32_t> temp(wynik.get_allocator());
+        pomnoz_nasycajaco_do(temp, a, b);
+        wynik.swap(temp);
+        return wynik;
+    }
+    wynik.alokuj(a.rows(), b.cols(), bez_zerowania);
+    jadra::gemm_nasycajacy(a.rows(), b.cols(), a.cols(), a.data(), a.stride(), b.data(), b.stride(),
+                           wynik.data(), wynik.stride());
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn a * b z nasyceniem do zakresu @c int32_t.
+ */
+basic_matrix<int32_t> pomnoz_nasycajaco(const basic_matrix<int32_t>& a, const basic_matrix<int32_t>& b) {
+    basic_matrix<int32_t> wynik(b.get_allocator());
+    pomnoz_nasycajaco_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn a * b modulo @p p.
+ *
+ * Argumenty spoza [0, p) są najpierw kopiowane z redukcją.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows() lub p < 2.
+ */
+basic_matrix<int32_t>& pomnoz_modulo_do(basic_matrix<int32_t>& wynik, const basic_matrix<int32_t>& a,
+                                        const basic_matrix<int32_t>& b, int32_t p) {
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    if (p < 2) throw invalid_argument("Modul musi byc >= 2");
+    if (&wynik == &a || &wynik == &b) {
+        basic_matrix<int32_t> temp(wynik.get_allocator());
+        pomnoz_modulo_do(temp, a, b, p);
+        wynik.swap(temp);
+        return wynik;
+    }
+    basic_matrix<int32_t> kopia_a(a.get_allocator()), kopia_b(b.get_allocator());
+    const basic_matrix<int32_t>& ra = sprowadz_modulo(a, p, kopia_a);
+    const basic_matrix<int32_t>& rb = sprowadz_modulo(b, p, kopia_b);
+    wynik.alokuj(a.rows(), b.cols(), bez_zerowania);
+    jadra::gemm_modularny(ra.rows(), rb.cols(), ra.cols(), ra.data(), ra.stride(), rb.data(), rb.stride(),
+                          wynik.data(), wynik.stride(), p);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn a * b modulo @p p.
+ */
+basic_matrix<int32_t> pomnoz_modulo(const basic_matrix<int32_t>& a, const basic_matrix<int32_t>& b, int32_t p) {
+    basic_matrix<int32_t> wynik(b.get_allocator());
+    pomnoz_modulo_do(wynik, a, b, p);
+    return wynik;
+}
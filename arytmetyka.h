@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file arytmetyka.h
+ * @brief Mnożenie macierzy @c int32 z arytmetyką szeroką, nasycającą
+ *        i modularną.
+ *
+ * Zwykły iloczyn macierzy @c int32_t (@ref pomnoz, @c operator*) liczy
+ * modulo 2^32 – przy dużych k lub dużych wartościach wynik się zawija.
+ * Funkcje z tego pliku wybierają inną arytmetykę wyniku:
+ * - szeroką (@ref pomnoz_szeroko) – akumulator i wynik @c int64_t,
+ * - nasycającą (@ref pomnoz_nasycajaco) – dokładna suma iloczynów obcięta do
+ *   zakresu @c int32_t,
+ * - modularną (@ref pomnoz_modulo) – wynik modulo p.
+ *
+ * Wszystkie korzystają z algorytmu blokowego @ref jadra::gemm z własnymi
+ * mikrojądrami (zob. @ref jadra::gemm_szeroki, @ref jadra::gemm_nasycajacy,
+ * @ref jadra::gemm_modularny), więc działają w czasie zbliżonym do
+ * zwykłego mnożenia.
+ */
+
+#include "matrix.h"
+#include <cstdint>
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn a * b liczony w 64 bitach.
+ *
+ * @return Referencja do @p wynik.
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+basic_matrix<std::int64_t>& pomnoz_szeroko_do(basic_matrix<std::int64_t>& wynik,
+                                              const basic_matrix<std::int32_t>& a,
+                                              const basic_matrix<std::int32_t>& b);
+
+/**
+ * @brief Zwraca iloczyn a * b liczony w 64 bitach.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+basic_matrix<std::int64_t> pomnoz_szeroko(const basic_matrix<std::int32_t>& a, const basic_matrix<std::int32_t>& b);
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn a * b z nasyceniem do zakresu
+ *        @c int32_t.
+ *
+ * @param wynik Macierz wynikowa (może być @p a lub @p b).
+ * @return Referencja do @p wynik.
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+basic_matrix<std::int32_t>& pomnoz_nasycajaco_do(basic_matrix<std::int32_t>& wynik,
+                                                 const basic_matrix<std::int32_t>& a,
+                                                 const basic_matrix<std::int32_t>& b);
+
+/**
+ * @brief Zwraca iloczyn a * b z nasyceniem do zakresu @c int32_t.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+basic_matrix<std::int32_t> pomnoz_nasycajaco(const basic_matrix<std::int32_t>& a,
+                                             const basic_matrix<std::int32_t>& b);
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn a * b modulo @p p.
+ *
+ * Elementy argumentów mogą być dowolne (także ujemne) – są najpierw
+ * sprowadzane do [0, p). Wynik należy do [0, p).
+ *
+ * @param wynik Macierz wynikowa (może być @p a lub @p b).
+ * @param p Moduł (>= 2).
+ * @return Referencja do @p wynik.
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows() lub p < 2.
+ */
+basic_matrix<std::int32_t>& pomnoz_modulo_do(basic_matrix<std::int32_t>& wynik,
+                                             const basic_matrix<std::int32_t>& a,
+                                             const basic_matrix<std::int32_t>& b, std::int32_t p);
+
+/**
+ * @brief Zwraca iloczyn a * b modulo @p p.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows() lub p < 2.
+ */
+basic_matrix<std::int32_t> pomnoz_modulo(const basic_matrix<std::int32_t>& a,
+                                         const basic_matrix<std::int32_t>& b, std::int32_t p);
@@ -0,0 +1,389 @@
+#include "bit_matrix.h"
+#include "pamiec.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+using slowo = bit_matrix::word_type;
+
+/// Liczba wierszy drugiego czynnika łączonych w jedną tablicę M4RM.
+constexpr int GRUPA_M4RM = 8;
+
+/// Liczba słów kolumn wyniku obsługiwanych przez jedną tablicę M4RM
+/// (256 kombinacji po 16 słów = 32 KiB, tablica mieści się w L1/L2).
+constexpr ptrdiff_t PAS_M4RM = 16;
+
+/// Liczba wierszy wyniku w jednym zadaniu mnożenia.
+constexpr ptrdiff_t BLOK_WIERSZY_M4RM = 2048;
+
+/// Zwraca słowo z ustawionymi bitami [0, @p ile), 0 <= ile <= 64.
+constexpr slowo maska_bitow(ptrdiff_t ile) noexcept {
+    return ile >= bit_matrix::BITY_SLOWA ? ~slowo(0) : (slowo(1) << ile) - 1;
+}
+
+/**
+ * @brief Ustawia w wierszu @p w (o @p slow słowach) bity kolumn [0, @p ile)
+ *        i zeruje pozostałe.
+ */
+void ustaw_poczatek(slowo* w, ptrdiff_t slow, ptrdiff_t ile) {
+    const ptrdiff_t pelne = min(slow, ile / bit_matrix::BITY_SLOWA);
+    fill(w, w + pelne, ~slowo(0));
+    fill(w + pelne, w + slow, slowo(0));
+    if (pelne < slow) w[pelne] = maska_bitow(ile % bit_matrix::BITY_SLOWA);
+}
+
+/**
+ * @brief Iloczyn macierzy bitowych metodą czterech Rosjan.
+ *
+ * Kolumny wyniku są dzielone na pasy po @ref PAS_M4RM słów, a wiersze na
+ * bloki po @ref BLOK_WIERSZY_M4RM; każde zadanie (pas, blok) buduje własne
+ * tablice kombinacji. Dla grupy wierszy g .. g+7 macierzy @p b tablica[s]
+ * to suma (OR lub XOR) wierszy g + t dla bitów t ustawionych w s; bajt
+ * wiersza i macierzy @p a z kolumn g .. g+7 to właśnie indeks s.
+ *
+ * @tparam XOR true – suma XOR (GF(2)), false – OR (półpierścień logiczny).
+ */
+template <bool XOR>
+bit_matrix pomnoz_m4rm(const bit_matrix& a, const bit_matrix& b) {
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    const ptrdiff_t m = a.rows(), k = a.cols(), slow = b.stride();
+    bit_matrix c(m, b.cols());
+    if (m == 0 || k == 0 || slow == 0) return c;
+
+    const ptrdiff_t pasow = (slow + PAS_M4RM - 1) / PAS_M4RM;
+    const ptrdiff_t blokow = (m + BLOK_WIERSZY_M4RM - 1) / BLOK_WIERSZY_M4RM;
+    rownolegle_dla(0, pasow * blokow, 1, [&](long long z0, long long z1) {
+        vector<slowo> tablica(static_cast<size_t>(PAS_M4RM) << GRUPA_M4RM);
+        for (long long z = z0; z < z1; ++z) {
+            const ptrdiff_t w0 = static_cast<ptrdiff_t>(z % pasow) * PAS_M4RM;
+            const ptrdiff_t sz = min(slow, w0 + PAS_M4RM) - w0;
+            const ptrdiff_t i0 = static_cast<ptrdiff_t>(z / pasow) * BLOK_WIERSZY_M4RM;
+            const ptrdiff_t i1 = min(m, i0 + BLOK_WIERSZY_M4RM);
+            for (ptrdiff_t g = 0; g < k; g += GRUPA_M4RM) {
+                const int r = static_cast<int>(min<ptrdiff_t>(GRUPA_M4RM, k - g));
+                fill(tablica.begin(), tablica.begin() + sz, slowo(0));
+                for (unsigned s = 1; s < (1u << r); ++s) {
+                    const slowo* poprz = tablica.data() + (s & (s - 1)) * PAS_M4RM;
+                    const slowo* w = b.row_ptr(g + countr_zero(s)) + w0;
+                    slowo* t = tablica.data() + s * PAS_M4RM;
+                    for (ptrdiff_t q = 0; q < sz; ++q) t[q] = XOR ? poprz[q] ^ w[q] : poprz[q] | w[q];
+                }
+                // Bity za ostatnią kolumną a są zerami, więc bajt < 2^r.
+                const ptrdiff_t slowo_a = g / bit_matrix::BITY_SLOWA;
+                const int przesuniecie = static_cast<int>(g % bit_matrix::BITY_SLOWA);
+                for (ptrdiff_t i = i0; i < i1; ++i) {
+                    const auto s = static_cast<size_t>((a.row_ptr(i)[slowo_a] >> przesuniecie) & 0xFF);
+                    if (s == 0) continue;
+                    const slowo* t = tablica.data() + s * PAS_M4RM;
+                    slowo* d = c.row_ptr(i) + w0;
+                    for (ptrdiff_t q = 0; q < sz; ++q) {
+                        if constexpr (XOR) d[q] ^= t[q];
+                        else d[q] |= t[q];
+                    }
+                }
+            }
+        }
+    });
+    return c;
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy pustą macierz 0 x 0.
+ */
+bit_matrix::bit_matrix() : wierszy(0), kolumn(0), slow(0) {
+}
+
+/**
+ * @brief Tworzy macierz zerową @p wiersze x @p kolumny.
+ *
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ * @throw std::length_error jeśli rozmiar przekracza zakres.
+ */
+bit_matrix::bit_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny) : wierszy(wiersze), kolumn(kolumny) {
+    if (wiersze < 0 || kolumny < 0) throw invalid_argument("Rozmiar ujemny");
+    slow = (kolumny + BITY_SLOWA - 1) / BITY_SLOWA;
+    dane.assign(static_cast<size_t>(jadra::pomnoz_rozmiary(wiersze, slow)), slowo(0));
+}
+
+/**
+ * @brief Tworzy macierz z macierzy gęstej @p m (niezerowe elementy -> 1).
+ */
+template <typename T>
+bit_matrix::bit_matrix(const basic_matrix<T>& m) : bit_matrix(m.rows(), m.cols()) {
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(kolumn, 1));
+    rownolegle_dla(0, wierszy, ziarno, [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const T* z = m.row_ptr(static_cast<ptrdiff_t>(i));
+            slowo* w = row_ptr(static_cast<ptrdiff_t>(i));
+            for (ptrdiff_t j = 0; j < kolumn; ++j) {
+                w[j / BITY_SLOWA] |= slowo(z[j] != T(0)) << (j % BITY_SLOWA);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Zwraca komórkę (@p x, @p y).
+ *
+ * @throw std::out_of_range jeśli indeksy są poza zakresem.
+ */
+bool bit_matrix::operator()(ptrdiff_t x, ptrdiff_t y) const {
+    if (x < 0 || x >= wierszy || y < 0 || y >= kolumn) throw out_of_range("Indeks poza zakresem");
+    return (row_ptr(x)[y / BITY_SLOWA] >> (y % BITY_SLOWA)) & 1;
+}
+
+/**
+ * @brief Ustawia komórkę (@p x, @p y) na @p wartosc.
+ *
+ * @throw std::out_of_range jeśli indeksy są poza zakresem.
+ */
+bit_matrix& bit_matrix::wstaw(ptrdiff_t x, ptrdiff_t y, bool wartosc) {
+    if (x < 0 || x >= wierszy || y < 0 || y >= kolumn) throw out_of_range("Indeks poza zakresem");
+    slowo& w = row_ptr(x)[y / BITY_SLOWA];
+    const slowo bit = slowo(1) << (y % BITY_SLOWA);
+    w = wartosc ? w | bit : w & ~bit;
+    return *this;
+}
+
+/**
+ * @brief Zwraca liczbę jedynek w macierzy.
+ */
+ptrdiff_t bit_matrix::liczba_jedynek() const noexcept {
+    ptrdiff_t suma = 0;
+    for (slowo w : dane) suma += popcount(w);
+    return suma;
+}
+
+/**
+ * @brief Zwraca macierz gęstą o elementach 0 i 1.
+ */
+template <typename T>
+basic_matrix<T> bit_matrix::gesta() const {
+    basic_matrix<T> m(wierszy, kolumn, bez_zerowania);
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(kolumn, 1));
+    rownolegle_dla(0, wierszy, ziarno, [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const slowo* z = row_ptr(static_cast<ptrdiff_t>(i));
+            T* w = m.row_ptr(static_cast<ptrdiff_t>(i));
+            for (ptrdiff_t j = 0; j < kolumn; ++j) {
+                w[j] = static_cast<T>((z[j / BITY_SLOWA] >> (j % BITY_SLOWA)) & 1);
+            }
+        }
+    });
+    return m;
+}
+
+/**
+ * @brief Zeruje wszystkie komórki.
+ */
+bit_matrix& bit_matrix::zeruj() {
+    fill(dane.begin(), dane.end(), slowo(0));
+    return *this;
+}
+
+/**
+ * @brief Komórka (i, j) = (i + j) % 2: wiersze parzyste mają jedynki
+ *        w kolumnach nieparzystych i odwrotnie.
+ */
+bit_matrix& bit_matrix::szachownica() {
+    for (ptrdiff_t i = 0; i < wierszy; ++i) {
+        slowo* w = row_ptr(i);
+        fill(w, w + slow, i % 2 == 0 ? 0xAAAAAAAAAAAAAAAAull : 0x5555555555555555ull);
+    }
+    przytnij();
+    return *this;
+}
+
+/**
+ * @brief Tworzy macierz jednostkową.
+ */
+bit_matrix& bit_matrix::przekatna() {
+    zeruj();
+    for (ptrdiff_t i = 0; i < min(wierszy, kolumn); ++i) {
+        row_ptr(i)[i / BITY_SLOWA] = slowo(1) << (i % BITY_SLOWA);
+    }
+    return *this;
+}
+
+/**
+ * @brief Ustawia komórki (i, j) dla j < i na 1, pozostałe na 0.
+ */
+bit_matrix& bit_matrix::pod_przekatna() {
+    for (ptrdiff_t i = 0; i < wierszy; ++i) {
+        ustaw_poczatek(row_ptr(i), slow, min(i, kolumn));
+    }
+    return *this;
+}
+
+/**
+ * @brief Ustawia komórki (i, j) dla j > i na 1, pozostałe na 0
+ *        (dopełnienie pierwszych i + 1 kolumn).
+ */
+bit_matrix& bit_matrix::nad_przekatna() {
+    for (ptrdiff_t i = 0; i < wierszy; ++i) {
+        slowo* w = row_ptr(i);
+        ustaw_poczatek(w, slow, min(i + 1, kolumn));
+        for (ptrdiff_t q = 0; q < slow; ++q) w[q] = ~w[q];
+    }
+    przytnij();
+    return *this;
+}
+
+/**
+ * @brief Zwraca macierz transponowaną.
+ *
+ * Przegląda tylko ustawione bity (std::countr_zero), więc koszt to
+ * O(rows * stride + liczba_jedynek).
+ */
+bit_matrix bit_matrix::transponowana() const {
+    bit_matrix t(kolumn, wierszy);
+    for (ptrdiff_t i = 0; i < wierszy; ++i) {
+        const slowo* w = row_ptr(i);
+        const slowo bit = slowo(1) << (i % BITY_SLOWA);
+        const ptrdiff_t q_t = i / BITY_SLOWA;
+        for (ptrdiff_t q = 0; q < slow; ++q) {
+            for (slowo s = w[q]; s != 0; s &= s - 1) {
+                t.row_ptr(q * BITY_SLOWA + countr_zero(s))[q_t] |= bit;
+            }
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief Suma komórek (OR).
+ *
+ * @throw std::invalid_argument jeśli wymiary są różne.
+ */
+bit_matrix& bit_matrix::operator|=(const bit_matrix& m) {
+    if (wierszy != m.wierszy || kolumn != m.kolumn) throw invalid_argument("Rozne wymiary macierzy!");
+    for (size_t q = 0; q < dane.size(); ++q) dane[q] |= m.dane[q];
+    return *this;
+}
+
+/**
+ * @brief Iloczyn komórek (AND).
+ *
+ * @throw std::invalid_argument jeśli wymiary są różne.
+ */
+bit_matrix& bit_matrix::operator&=(const bit_matrix& m) {
+    if (wierszy != m.wierszy || kolumn != m.kolumn) throw invalid_argument("Rozne wymiary macierzy!");
+    for (size_t q = 0; q < dane.size(); ++q) dane[q] &= m.dane[q];
+    return *this;
+}
+
+/**
+ * @brief Różnica symetryczna komórek (XOR).
+ *
+ * @throw std::invalid_argument jeśli wymiary są różne.
+ */
+bit_matrix& bit_matrix::operator^=(const bit_matrix& m) {
+    if (wierszy != m.wierszy || kolumn != m.kolumn) throw invalid_argument("Rozne wymiary macierzy!");
+    for (size_t q = 0; q < dane.size(); ++q) dane[q] ^= m.dane[q];
+    return *this;
+}
+
+/**
+ * @brief Sprawdza, czy macierze mają te same wymiary i komórki.
+ */
+bool bit_matrix::operator==(const bit_matrix& m) const noexcept {
+    return wierszy == m.wierszy && kolumn == m.kolumn && dane == m.dane;
+}
+
+/**
+ * @brief Zeruje bity za ostatnią kolumną w każdym wierszu.
+ */
+void bit_matrix::przytnij() noexcept {
+    if (kolumn % BITY_SLOWA == 0) return;
+    const slowo maska = maska_bitow(kolumn % BITY_SLOWA);
+    for (ptrdiff_t i = 0; i < wierszy; ++i) row_ptr(i)[slow - 1] &= maska;
+}
+
+/**
+ * @brief Zwraca iloczyn logiczny (OR-AND) macierzy @p a i @p b.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+bit_matrix pomnoz_logicznie(const bit_matrix& a, const bit_matrix& b) {
+    return pomnoz_m4rm<false>(a, b);
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy @p a i @p b nad GF(2) (XOR-AND).
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+bit_matrix pomnoz_gf2(const bit_matrix& a, const bit_matrix& b) {
+    return pomnoz_m4rm<true>(a, b);
+}
+
+/**
+ * @brief Zwraca domknięcie przechodnie relacji @p a.
+ *
+ * Po kroku k wiersz i zawiera wszystkie wierzchołki osiągalne z i ścieżką,
+ * której wierzchołki pośrednie mają numery <= k. Wiersz k jest w kroku k
+ * tylko czytany (dodanie go do samego siebie niczego nie zmienia, więc
+ * jest pomijane), a pozostałe wiersze są niezależne – przetwarzamy je
+ * równolegle.
+ *
+ * @throw std::invalid_argument jeśli @p a nie jest kwadratowa.
+ */
+bit_matrix domkniecie_przechodnie(const bit_matrix& a) {
+    if (a.rows() != a.cols()) throw invalid_argument("Macierz nie jest kwadratowa");
+    bit_matrix r = a;
+    const ptrdiff_t n = r.rows(), slow = r.stride();
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(slow * bit_matrix::BITY_SLOWA, 1));
+    for (ptrdiff_t k = 0; k < n; ++k) {
+        const slowo* wk = r.row_ptr(k);
+        const ptrdiff_t qk = k / bit_matrix::BITY_SLOWA;
+        const slowo bit = slowo(1) << (k % bit_matrix::BITY_SLOWA);
+        rownolegle_dla(0, n, ziarno, [&](long long i0, long long i1) {
+            for (long long i = i0; i < i1; ++i) {
+                slowo* w = r.row_ptr(static_cast<ptrdiff_t>(i));
+                if (i == k || (w[qk] & bit) == 0) continue;
+                for (ptrdiff_t q = 0; q < slow; ++q) w[q] |= wk[q];
+            }
+        });
+    }
+    return r;
+}
+
+/**
+ * @brief Wypisuje macierz w formacie jak dla @ref basic_matrix; strumień nie
+ *        jest opróżniany po wierszach.
+ */
+ostream& operator<<(ostream& o, const bit_matrix& m) {
+    for (ptrdiff_t i = 0; i < m.rows(); ++i) {
+        o << "| ";
+        for (ptrdiff_t j = 0; j < m.cols(); ++j) {
+            o << setw(4) << int(m(i, j)) << " ";
+        }
+        o << "|\n";
+    }
+    return o;
+}
+
+/**
+ * @brief Jawne konkretyzacje konwersji z i do macierzy gęstych typu @p T.
+ */
+#define MACIERZ_INSTANCJA_BITOWA(T)                               \
+    template bit_matrix::bit_matrix(const basic_matrix<T>&);      \
+    template basic_matrix<T> bit_matrix::gesta<T>() const;
+
+MACIERZ_INSTANCJA_BITOWA(int8_t)
+MACIERZ_INSTANCJA_BITOWA(int16_t)
+MACIERZ_INSTANCJA_BITOWA(int32_t)
+MACIERZ_INSTANCJA_BITOWA(int64_t)
+MACIERZ_INSTANCJA_BITOWA(float)
+MACIERZ_INSTANCJA_BITOWA(double)
+
+#undef MACIERZ_INSTANCJA_BITOWA
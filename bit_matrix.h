@@ -0,0 +1,177 @@
+#pragma once
+
+/**
+ * @file bit_matrix.h
+ * @brief Macierz zero-jedynkowa upakowana po 64 komórki w słowie.
+ *
+ * Wzorce @c szachownica, @c przekatna, @c pod_przekatna i @c nad_przekatna
+ * oraz macierze sąsiedztwa grafów zawierają tylko zera i jedynki; w
+ * @ref basic_matrix każda komórka zajmuje cały element (np. 32 bity dla
+ * @c int), tu – jeden bit. Wiersz to @c stride() słów 64-bitowych, bit
+ * j % 64 słowa j / 64 odpowiada kolumnie j; bity za ostatnią kolumną są
+ * zawsze zerami.
+ *
+ * Mnożenie działa w jednym z dwóch półpierścieni:
+ * - logicznym (OR-AND, @ref pomnoz_logicznie) – osiągalność w grafach,
+ * - ciała GF(2) (XOR-AND, @ref pomnoz_gf2) – algebra liniowa modulo 2.
+ *
+ * Oba używają metody czterech Rosjan (M4RM): dla każdej grupy 8 wierszy
+ * drugiego czynnika tworzona jest tablica 256 kombinacji tych wierszy,
+ * a każdy bajt wiersza pierwszego czynnika wybiera z niej jedną kombinację
+ * – zamiast 8 operacji na wierszach wykonywana jest jedna.
+ */
+
+#include "matrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+/**
+ * @class bit_matrix
+ * @brief Macierz zero-jedynkowa przechowywana bitowo.
+ */
+class bit_matrix {
+public:
+    /// Typ słowa przechowującego 64 komórki.
+    using word_type = std::uint64_t;
+
+    /// Typ wymiarów i indeksów.
+    using size_type = std::ptrdiff_t;
+
+    /// Liczba komórek w słowie.
+    static constexpr size_type BITY_SLOWA = 64;
+
+    /// Tworzy pustą macierz 0 x 0.
+    bit_matrix();
+
+    /**
+     * @brief Tworzy macierz zerową @p wiersze x @p kolumny.
+     *
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     * @throw std::length_error jeśli rozmiar przekracza zakres.
+     */
+    bit_matrix(size_type wiersze, size_type kolumny);
+
+    /**
+     * @brief Tworzy macierz z macierzy gęstej @p m: niezerowe elementy
+     *        stają się jedynkami.
+     */
+    template <typename T>
+    explicit bit_matrix(const basic_matrix<T>& m);
+
+    /// Zwraca liczbę wierszy.
+    size_type rows() const noexcept { return wierszy; }
+
+    /// Zwraca liczbę kolumn.
+    size_type cols() const noexcept { return kolumn; }
+
+    /// Zwraca liczbę słów w wierszu.
+    size_type stride() const noexcept { return slow; }
+
+    /// Zwraca wskaźnik na pierwsze słowo wiersza @p i.
+    word_type* row_ptr(size_type i) noexcept { return dane.data() + i * slow; }
+
+    /// Zwraca wskaźnik na pierwsze słowo wiersza @p i (wersja const).
+    const word_type* row_ptr(size_type i) const noexcept { return dane.data() + i * slow; }
+
+    /**
+     * @brief Zwraca komórkę (@p x, @p y).
+     *
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    bool operator()(size_type x, size_type y) const;
+
+    /**
+     * @brief Ustawia komórkę (@p x, @p y) na @p wartosc.
+     *
+     * @return Referencja do *this.
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    bit_matrix& wstaw(size_type x, size_type y, bool wartosc);
+
+    /// Zwraca liczbę jedynek w macierzy.
+    size_type liczba_jedynek() const noexcept;
+
+    /**
+     * @brief Zwraca macierz gęstą o elementach 0 i 1.
+     *
+     * @tparam T Typ elementów wyniku.
+     */
+    template <typename T = int>
+    basic_matrix<T> gesta() const;
+
+    /// Zeruje wszystkie komórki.
+    bit_matrix& zeruj();
+
+    /// Komórka (i, j) = (i + j) % 2 (jak @ref basic_matrix::szachownica).
+    bit_matrix& szachownica();
+
+    /// Macierz jednostkowa (jak @ref basic_matrix::przekatna).
+    bit_matrix& przekatna();
+
+    /// Jedynki pod główną przekątną (jak @ref basic_matrix::pod_przekatna).
+    bit_matrix& pod_przekatna();
+
+    /// Jedynki nad główną przekątną (jak @ref basic_matrix::nad_przekatna).
+    bit_matrix& nad_przekatna();
+
+    /// Zwraca macierz transponowaną.
+    bit_matrix transponowana() const;
+
+    /**
+     * @name Operacje na komórkach
+     *
+     * Suma (OR), iloczyn (AND) i różnica symetryczna (XOR) komórek
+     * o tych samych indeksach.
+     *
+     * @throw std::invalid_argument jeśli wymiary są różne.
+     * @{
+     */
+    bit_matrix& operator|=(const bit_matrix& m);
+    bit_matrix& operator&=(const bit_matrix& m);
+    bit_matrix& operator^=(const bit_matrix& m);
+    /** @} */
+
+    /// Sprawdza, czy macierze mają te same wymiary i komórki.
+    bool operator==(const bit_matrix& m) const noexcept;
+
+private:
+    /// Zeruje bity za ostatnią kolumną w każdym wierszu.
+    void przytnij() noexcept;
+
+    size_type wierszy;            ///< Liczba wierszy.
+    size_type kolumn;             ///< Liczba kolumn.
+    size_type slow;               ///< Liczba słów w wierszu.
+    std::vector<word_type> dane;  ///< Wiersze, po @c slow słów.
+};
+
+/**
+ * @brief Zwraca iloczyn logiczny: C(i, j) = OR po p z A(i, p) AND B(p, j).
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+bit_matrix pomnoz_logicznie(const bit_matrix& a, const bit_matrix& b);
+
+/**
+ * @brief Zwraca iloczyn nad GF(2): C(i, j) = XOR po p z A(i, p) AND B(p, j).
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+bit_matrix pomnoz_gf2(const bit_matrix& a, const bit_matrix& b);
+
+/**
+ * @brief Zwraca domknięcie przechodnie relacji @p a (macierzy sąsiedztwa):
+ *        C(i, j) = 1, jeśli z i do j prowadzi ścieżka o długości >= 1.
+ *
+ * Algorytm Warshalla na całych wierszach: dla każdego k wiersz k jest
+ * dodawany (OR) do wierszy i z C(i, k) = 1 – O(n^3 / 64).
+ *
+ * @throw std::invalid_argument jeśli @p a nie jest kwadratowa.
+ */
+bit_matrix domkniecie_przechodnie(const bit_matrix& a);
+
+/**
+ * @brief Wypisuje macierz w formacie jak dla @ref basic_matrix.
+ */
+std::ostream& operator<<(std::ostream& o, const bit_matrix& m);
@@ -0,0 +1,156 @@
+#include "cpu.h"
+
+#ifdef MACIERZ_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef MACIERZ_X86
+/**
+ * @brief Wykonuje instrukcję CPUID dla liścia @p liscie i podliścia @p podliscie.
+ *
+ * @param liscie Numer liścia (EAX).
+ * @param podliscie Numer podliścia (ECX).
+ * @param r Tablica na wynik: EAX, EBX, ECX, EDX.
+ */
+void cpuid(unsigned liscie, unsigned podliscie, unsigned r[4]) {
+#if defined(_MSC_VER)
+    int t[4];
+    __cpuidex(t, static_cast<int>(liscie), static_cast<int>(podliscie));
+    for (int i = 0; i < 4; ++i) r[i] = static_cast<unsigned>(t[i]);
+#else
+    __cpuid_count(liscie, podliscie, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+/**
+ * @brief Odczytuje rejestr XCR0 (stany rejestrów zachowywane przez system).
+ *
+ * @return Wartość XCR0.
+ */
+unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+}
+
+/**
+ * @brief Wykrywa rozszerzenia SIMD obsługiwane przez procesor i system.
+ *
+ * @param info Struktura uzupełniana o flagi rozszerzeń.
+ */
+void czytaj_rozszerzenia(cpu_info& info) {
+    unsigned r[4];
+    cpuid(0, 0, r);
+    const unsigned max_liscie = r[0];
+    if (max_liscie < 1) return;
+
+    cpuid(1, 0, r);
+    info.sse42 = (r[2] & (1u << 19)) && (r[2] & (1u << 20));
+    const bool osxsave = (r[2] & (1u << 27)) != 0;
+    const bool avx = (r[2] & (1u << 28)) != 0;
+    const bool fma = (r[2] & (1u << 12)) != 0;
+    if (!osxsave || !avx) return;
+
+    const unsigned long long xcr0 = xgetbv0();
+    const bool stan_avx = (xcr0 & 0x6) == 0x6;
+    const bool stan_avx512 = (xcr0 & 0xE6) == 0xE6;
+    if (!stan_avx) return;
+    info.fma = fma;
+    if (max_liscie < 7) return;
+
+    cpuid(7, 0, r);
+    info.avx2 = (r[1] & (1u << 5)) != 0;
+    info.avx512f = stan_avx512 && (r[1] & (1u << 16)) != 0;
+    info.avx512bw = info.avx512f && (r[1] & (1u << 30)) != 0;
+    info.avx512vnni = info.avx512bw && (r[2] & (1u << 11)) != 0;
+    info.avx512dq = info.avx512f && (r[1] & (1u << 17)) != 0;
+}
+
+/**
+ * @brief Odczytuje rozmiary pamięci podręcznej z liścia deterministycznych
+ *        parametrów cache (4 u Intela, 0x8000001D u AMD).
+ *
+ * @param liscie Numer liścia CPUID.
+ * @param info Struktura uzupełniana o znalezione rozmiary.
+ * @return true jeśli znaleziono co najmniej jeden poziom pamięci podręcznej.
+ */
+bool czytaj_cache(unsigned liscie, cpu_info& info) {
+    unsigned r[4];
+    cpuid(liscie & 0x80000000u, 0, r);
+    if (r[0] < liscie) return false;
+
+    bool znaleziono = false;
+    for (unsigned sub = 0; sub < 16; ++sub) {
+        cpuid(liscie, sub, r);
+        unsigned typ = r[0] & 0x1F;
+        if (typ == 0) break;
+        if (typ != 1 && typ != 3) continue; // tylko dane i zunifikowana
+
+        unsigned poziom = (r[0] >> 5) & 0x7;
+        long long drogi = ((r[1] >> 22) & 0x3FF) + 1;
+        long long partycje = ((r[1] >> 12) & 0x3FF) + 1;
+        long long linia = (r[1] & 0xFFF) + 1;
+        long long zbiory = static_cast<long long>(r[2]) + 1;
+        long long bajty = drogi * partycje * linia * zbiory;
+        if (bajty > 0x7FFFFFFF) bajty = 0x7FFFFFFF;
+
+        if (poziom == 1) info.l1d = static_cast<int>(bajty);
+        else if (poziom == 2) info.l2 = static_cast<int>(bajty);
+        else if (poziom == 3) info.l3 = static_cast<int>(bajty);
+        znaleziono = true;
+    }
+    return znaleziono;
+}
+#endif
+
+/**
+ * @brief Wykrywa parametry procesora.
+ *
+ * @return Wypełniona struktura @ref cpu_info.
+ */
+cpu_info wykryj() {
+    cpu_info info{ 0, 0, 0, false, false, false, false, false, false, false };
+
+#ifdef MACIERZ_X86
+    if (!czytaj_cache(4, info)) czytaj_cache(0x8000001Du, info);
+    czytaj_rozszerzenia(info);
+#elif defined(_SC_LEVEL1_DCACHE_SIZE)
+    long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l1 > 0) info.l1d = static_cast<int>(l1);
+    if (l2 > 0) info.l2 = static_cast<int>(l2);
+    if (l3 > 0) info.l3 = static_cast<int>(l3);
+#endif
+
+    if (info.l1d <= 0) info.l1d = 32 * 1024;
+    if (info.l2 <= 0) info.l2 = 1024 * 1024;
+    if (info.l3 <= 0) info.l3 = 8 * 1024 * 1024;
+    return info;
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca parametry procesora (wykrywane raz, przy pierwszym wywołaniu).
+ *
+ * @return Referencja do statycznej struktury z parametrami.
+ */
+const cpu_info& procesor() {
+    static const cpu_info info = wykryj();
+    return info;
+}
\ No newline at end of file
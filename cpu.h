@@ -0,0 +1,103 @@
+#pragma once
+
+/**
+ * @file cpu.h
+ * @brief Informacje o procesorze wykrywane w czasie działania programu.
+ *
+ * Parametry są odczytywane jednokrotnie (przy pierwszym wywołaniu
+ * @ref procesor()) i wykorzystywane przez jądra obliczeniowe do doboru
+ * rozmiarów bloków oraz do wyboru wariantu SIMD.
+ */
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+/// Zdefiniowane, gdy kompilujemy na procesor x86 / x86-64.
+#define MACIERZ_X86 1
+#endif
+
+/**
+ * @def MACIERZ_CEL
+ * @brief Pozwala użyć w funkcji instrukcji z podanego rozszerzenia (np. "avx2")
+ *        bez kompilowania całego programu pod to rozszerzenie.
+ *
+ * MSVC nie wymaga atrybutu – intrynsyki są dostępne zawsze.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define MACIERZ_CEL(x) __attribute__((target(x)))
+#else
+#define MACIERZ_CEL(x)
+#endif
+
+/**
+ * @def MACIERZ_WSTAW
+ * @brief Wymusza wstawienie funkcji w miejsce wywołania.
+ *
+ * Ogólna pętla wywoływana z kilku funkcji z różnymi @ref MACIERZ_CEL jest
+ * wtedy kompilowana osobno z rozszerzeniami każdej z nich, zamiast jako
+ * jedna wspólna funkcja bez rozszerzeń.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define MACIERZ_WSTAW inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define MACIERZ_WSTAW __forceinline
+#else
+#define MACIERZ_WSTAW inline
+#endif
+
+/**
+ * @def MACIERZ_SPLASZCZ
+ * @brief Wstawia w funkcję wszystkie wywołania z jej ciała, rekurencyjnie –
+ *        pętle rozwijane szablonami (lambdy wywoływane dla kolejnych
+ *        indeksów) stają się jednym ciągiem instrukcji.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define MACIERZ_SPLASZCZ __attribute__((flatten))
+#else
+#define MACIERZ_SPLASZCZ
+#endif
+
+/**
+ * @def MACIERZ_IVDEP
+ * @brief Zapewnia kompilator, że tablice w następnej pętli na siebie nie
+ *        nachodzą, więc pętlę można zwektoryzować bez sprawdzania aliasów.
+ */
+#if defined(__GNUC__) && !defined(__clang__)
+#define MACIERZ_IVDEP _Pragma("GCC ivdep")
+#elif defined(__clang__)
+#define MACIERZ_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(_MSC_VER)
+#define MACIERZ_IVDEP __pragma(loop(ivdep))
+#else
+#define MACIERZ_IVDEP
+#endif
+
+/**
+ * @struct cpu_info
+ * @brief Parametry procesora istotne dla jąder obliczeniowych.
+ */
+struct cpu_info {
+    int l1d; ///< Rozmiar pamięci podręcznej L1 danych (w bajtach).
+    int l2;  ///< Rozmiar pamięci podręcznej L2 (w bajtach).
+    int l3;  ///< Rozmiar pamięci podręcznej L3 (w bajtach).
+
+    bool sse42;       ///< Procesor obsługuje SSE4.2 (w tym SSE4.1).
+    bool avx2;        ///< Procesor i system obsługują AVX2.
+    bool avx512f;     ///< Procesor i system obsługują AVX-512F.
+    bool fma;         ///< Procesor i system obsługują FMA3.
+    bool avx512bw;    ///< Procesor i system obsługują AVX-512BW (operacje na 8/16 bitach).
+    bool avx512vnni;  ///< Procesor i system obsługują AVX-512 VNNI (vpdpwssd).
+    bool avx512dq;    ///< Procesor i system obsługują AVX-512DQ (m.in. vpmullq na 64 bitach).
+};
+
+/**
+ * @brief Zwraca parametry procesora, na którym działa program.
+ *
+ * Na procesorach x86 rozmiary pamięci podręcznej są odczytywane instrukcją
+ * CPUID (liście 4 i 0x8000001D). Jeśli nie da się ich ustalić, przyjmowane
+ * są typowe wartości (32 KiB / 1 MiB / 8 MiB).
+ *
+ * Rozszerzenia AVX są zgłaszane tylko wtedy, gdy system operacyjny zachowuje
+ * odpowiednie rejestry (sprawdzane instrukcją XGETBV).
+ *
+ * @return Referencja do statycznej struktury z parametrami.
+ */
+const cpu_info& procesor();
\ No newline at end of file
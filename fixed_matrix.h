@@ -0,0 +1,428 @@
+#pragma once
+
+/**
+ * @file fixed_matrix.h
+ * @brief Macierze o wymiarach znanych w czasie kompilacji.
+ *
+ * @ref fixed_matrix przechowuje elementy w sobie (na stosie lub w obiekcie
+ * zawierającym), bez przydziału pamięci. Wszystkie operacje są @c constexpr,
+ * a pętle iloczynu, transpozycji i wzorców są rozwijane w całości przez
+ * szablony (@ref jadra::rozwin) – dla macierzy 2 x 2 ... 16 x 16 kompilator
+ * widzi ciąg działań na stałych indeksach, który wektoryzuje bez pętli.
+ * Tablice budowane dotąd przy starcie programu mogą być liczone w czasie
+ * kompilacji:
+ * @code
+ * constexpr auto I = fixed_matrix<int, 4>().przekatna();
+ * constexpr auto S = fixed_matrix<int, 4>().szachownica();
+ * constexpr auto P = pomnoz(S, S + I);
+ * static_assert(P(0, 0) == 2);
+ * @endcode
+ *
+ * Z macierzą dynamiczną @ref basic_matrix współpracuje przez konstruktor
+ * @ref fixed_matrix::fixed_matrix(const basic_matrix<T>&),
+ * @ref fixed_matrix::macierz i widoki @ref widok (@ref matrix_view).
+ */
+
+#include "matrix.h"
+#include "cpu.h"
+#include "gemm.h"
+#include "widok.h"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace jadra {
+
+/**
+ * @brief Wywołuje @p f(I) dla I = 0 ... @p N - 1, gdzie I jest
+ *        @c std::integral_constant – pętla rozwinięta w czasie kompilacji.
+ */
+template <std::ptrdiff_t N, typename F>
+constexpr void rozwin(F&& f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<std::ptrdiff_t, static_cast<std::ptrdiff_t>(I)>{}), ...);
+    }(std::make_index_sequence<static_cast<std::size_t>(N)>{});
+}
+
+} // namespace jadra
+
+/**
+ * @class fixed_matrix
+ * @brief Macierz @p W x @p K o elementach przechowywanych w obiekcie.
+ *
+ * Elementy leżą wierszami, bez odstępów (@c stride() == @c cols()).
+ *
+ * @tparam T Typ elementów.
+ * @tparam W Liczba wierszy.
+ * @tparam K Liczba kolumn (domyślnie macierz kwadratowa).
+ */
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K = W>
+class fixed_matrix {
+    static_assert(W > 0 && K > 0, "Wymiary macierzy musza byc dodatnie");
+
+public:
+    /// Typ elementów macierzy.
+    using value_type = T;
+
+    /// Typ wymiarów i indeksów.
+    using size_type = std::ptrdiff_t;
+
+    /// Tworzy macierz zerową.
+    constexpr fixed_matrix() = default;
+
+    /**
+     * @brief Tworzy macierz z listy wierszy, np. @c {{1, 2}, {3, 4}}.
+     *
+     * @throw std::invalid_argument jeśli liczba wierszy lub długość
+     *        któregoś wiersza nie zgadza się z wymiarami (w czasie kompilacji
+     *        – błąd kompilacji).
+     */
+    constexpr fixed_matrix(std::initializer_list<std::initializer_list<T>> wiersze) {
+        if (static_cast<size_type>(wiersze.size()) != W) throw std::invalid_argument("Rozne wymiary macierzy!");
+        T* d = dane;
+        for (const auto& w : wiersze) {
+            if (static_cast<size_type>(w.size()) != K) throw std::invalid_argument("Rozne wymiary macierzy!");
+            d = std::copy(w.begin(), w.end(), d);
+        }
+    }
+
+    /**
+     * @brief Tworzy macierz z tablicy @p t (@c W * K elementów wierszami).
+     *
+     * @throw std::invalid_argument jeśli @p t == nullptr.
+     */
+    constexpr explicit fixed_matrix(const T* t) {
+        if (t == nullptr) throw std::invalid_argument("Tablica zrodlowa jest null");
+        std::copy(t, t + W * K, dane);
+    }
+
+    /**
+     * @brief Tworzy macierz z kopii macierzy dynamicznej @p m.
+     *
+     * @throw std::invalid_argument jeśli wymiary @p m są inne niż W x K.
+     */
+    explicit fixed_matrix(const basic_matrix<T>& m) {
+        if (m.rows() != W || m.cols() != K) throw std::invalid_argument("Rozne wymiary macierzy!");
+        for (size_type i = 0; i < W; ++i) std::copy(m.row_ptr(i), m.row_ptr(i) + K, dane + i * K);
+    }
+
+    /// Zwraca kopię macierzy jako macierz dynamiczną.
+    basic_matrix<T> macierz() const { return basic_matrix<T>(W, K, dane); }
+
+    /// Zwraca liczbę wierszy.
+    static constexpr size_type rows() noexcept { return W; }
+
+    /// Zwraca liczbę kolumn.
+    static constexpr size_type cols() noexcept { return K; }
+
+    /// Zwraca liczbę elementów.
+    static constexpr size_type size() noexcept { return W * K; }
+
+    /// Zwraca odstęp wierszy (równy liczbie kolumn).
+    static constexpr size_type stride() noexcept { return K; }
+
+    /// Zwraca wskaźnik na pierwszy element.
+    constexpr T* data() noexcept { return dane; }
+
+    /// Zwraca wskaźnik na pierwszy element (wersja const).
+    constexpr const T* data() const noexcept { return dane; }
+
+    /// Zwraca wskaźnik na początek wiersza @p i (bez sprawdzania indeksu).
+    constexpr T* row_ptr(size_type i) noexcept { return dane + i * K; }
+
+    /// Zwraca wskaźnik na początek wiersza @p i (wersja const).
+    constexpr const T* row_ptr(size_type i) const noexcept { return dane + i * K; }
+
+    /**
+     * @brief Szybki dostęp do elementu (i, j).
+     *
+     * Indeksy są sprawdzane zgodnie z @ref MACIERZ_SPRAWDZAJ_INDEKSY.
+     */
+    constexpr T& operator()(size_type i, size_type j) {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+        if (i < 0 || i >= W || j < 0 || j >= K) throw std::out_of_range("Indeks poza zakresem");
+#endif
+        return dane[i * K + j];
+    }
+
+    /// Szybki dostęp do elementu (i, j) (wersja const).
+    constexpr const T& operator()(size_type i, size_type j) const {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+        if (i < 0 || i >= W || j < 0 || j >= K) throw std::out_of_range("Indeks poza zakresem");
+#endif
+        return dane[i * K + j];
+    }
+
+    /**
+     * @brief Dostęp do elementu (x, y) ze sprawdzaniem indeksów.
+     *
+     * @throw std::out_of_range jeśli indeks jest poza zakresem.
+     */
+    constexpr T& at(size_type x, size_type y) {
+        if (x < 0 || x >= W || y < 0 || y >= K) throw std::out_of_range("Indeks poza zakresem");
+        return dane[x * K + y];
+    }
+
+    /// Dostęp do elementu (x, y) ze sprawdzaniem indeksów (wersja const).
+    constexpr const T& at(size_type x, size_type y) const {
+        if (x < 0 || x >= W || y < 0 || y >= K) throw std::out_of_range("Indeks poza zakresem");
+        return dane[x * K + y];
+    }
+
+    /**
+     * @brief Wypełnia macierz wzorem szachownicy 0/1: element (i, j) = (i + j) % 2.
+     *
+     * @return Referencja do *this.
+     */
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& szachownica() {
+        jadra::rozwin<W>([&](auto i) {
+            jadra::rozwin<K>([&](auto j) { dane[i * K + j] = static_cast<T>((i + j) % 2); });
+        });
+        return *this;
+    }
+
+    /**
+     * @brief Tworzy macierz jednostkową (dla prostokątnej – jedynki na
+     *        min(W, K) pierwszych pozycjach przekątnej).
+     *
+     * @return Referencja do *this.
+     */
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& przekatna() {
+        jadra::rozwin<W>([&](auto i) {
+            jadra::rozwin<K>([&](auto j) { dane[i * K + j] = static_cast<T>(i == j ? 1 : 0); });
+        });
+        return *this;
+    }
+
+    /**
+     * @brief Wypełnia elementy poniżej głównej przekątnej jedynkami, pozostałe zerami.
+     *
+     * @return Referencja do *this.
+     */
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& pod_przekatna() {
+        jadra::rozwin<W>([&](auto i) {
+            jadra::rozwin<K>([&](auto j) { dane[i * K + j] = static_cast<T>(i > j ? 1 : 0); });
+        });
+        return *this;
+    }
+
+    /**
+     * @brief Wypełnia elementy powyżej głównej przekątnej jedynkami, pozostałe zerami.
+     *
+     * @return Referencja do *this.
+     */
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& nad_przekatna() {
+        jadra::rozwin<W>([&](auto i) {
+            jadra::rozwin<K>([&](auto j) { dane[i * K + j] = static_cast<T>(j > i ? 1 : 0); });
+        });
+        return *this;
+    }
+
+    /**
+     * @brief Zeruje macierz i ustawia przekątną przesuniętą o @p P według
+     *        tablicy @p t (@p P > 0 – powyżej głównej, @p P < 0 – poniżej).
+     *
+     * @param t Tablica wartości przekątnej (długość równa liczbie jej elementów).
+     * @return Referencja do *this.
+     * @note Jeśli @p t == nullptr, metoda nic nie robi.
+     */
+    template <size_type P>
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& diagonalna_k(const T* t) {
+        static_assert(P > -W && P < K, "Przekatna poza macierza");
+        if (t == nullptr) return *this;
+        constexpr size_type w0 = P < 0 ? -P : 0;
+        constexpr size_type k0 = P > 0 ? P : 0;
+        constexpr size_type dlugosc = std::min(W - w0, K - k0);
+        jadra::rozwin<W * K>([&](auto e) { dane[e] = T(0); });
+        jadra::rozwin<dlugosc>([&](auto e) { dane[(w0 + e) * K + k0 + e] = t[e]; });
+        return *this;
+    }
+
+    /**
+     * @brief Zeruje macierz i ustawia główną przekątną według tablicy @p t
+     *        (co najmniej min(W, K) elementów).
+     *
+     * @return Referencja do *this.
+     * @note Jeśli @p t == nullptr, metoda nic nie robi.
+     */
+    constexpr fixed_matrix& diagonalna(const T* t) { return diagonalna_k<0>(t); }
+
+    /**
+     * @brief Transponuje macierz kwadratową w miejscu.
+     *
+     * @return Referencja do *this.
+     */
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& dowroc()
+        requires(W == K)
+    {
+        jadra::rozwin<W>([&](auto i) {
+            jadra::rozwin<K>([&](auto j) {
+                if (i < j) std::swap(dane[i * K + j], dane[j * K + i]);
+            });
+        });
+        return *this;
+    }
+
+    /// Dodaje @p a do każdego elementu.
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& operator+=(T a) {
+        jadra::rozwin<W * K>([&](auto e) { dane[e] = static_cast<T>(dane[e] + a); });
+        return *this;
+    }
+
+    /// Odejmuje @p a od każdego elementu.
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& operator-=(T a) {
+        jadra::rozwin<W * K>([&](auto e) { dane[e] = static_cast<T>(dane[e] - a); });
+        return *this;
+    }
+
+    /// Mnoży każdy element przez @p a.
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& operator*=(T a) {
+        jadra::rozwin<W * K>([&](auto e) { dane[e] = static_cast<T>(dane[e] * a); });
+        return *this;
+    }
+
+    /// Dodaje macierz @p m element po elemencie.
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& operator+=(const fixed_matrix& m) {
+        jadra::rozwin<W * K>([&](auto e) { dane[e] = static_cast<T>(dane[e] + m.dane[e]); });
+        return *this;
+    }
+
+    /// Odejmuje macierz @p m element po elemencie.
+    MACIERZ_SPLASZCZ constexpr fixed_matrix& operator-=(const fixed_matrix& m) {
+        jadra::rozwin<W * K>([&](auto e) { dane[e] = static_cast<T>(dane[e] - m.dane[e]); });
+        return *this;
+    }
+
+    /**
+     * @brief Mnoży macierz przez macierz kwadratową @p m (this = this * m).
+     *
+     * Dostępne, gdy iloczyn ma typ @p T (zob. @ref jadra::iloczyn_t).
+     */
+    constexpr fixed_matrix& operator*=(const fixed_matrix<T, K, K>& m)
+        requires std::is_same_v<jadra::iloczyn_t<T>, T>;
+
+    /// Porównuje macierze element po elemencie.
+    MACIERZ_SPLASZCZ constexpr bool operator==(const fixed_matrix& m) const {
+        bool rowne = true;
+        jadra::rozwin<W * K>([&](auto e) { rowne = rowne && dane[e] == m.dane[e]; });
+        return rowne;
+    }
+
+private:
+    T dane[W * K] = {}; ///< Elementy macierzy wierszami.
+};
+
+/**
+ * @brief Zwraca iloczyn macierzy @p a i @p b; pętle są rozwinięte w całości.
+ *
+ * Iloczyny macierzy 8- i 16-bitowych są liczone i zwracane w 32 bitach
+ * (jak @ref pomnoz dla @ref basic_matrix).
+ */
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t P, std::ptrdiff_t K>
+MACIERZ_SPLASZCZ constexpr fixed_matrix<jadra::iloczyn_t<T>, W, K> pomnoz(const fixed_matrix<T, W, P>& a,
+                                                                          const fixed_matrix<T, P, K>& b) {
+    using R = jadra::iloczyn_t<T>;
+    fixed_matrix<R, W, K> c;
+    R* w = c.data();
+    const T* x = a.data();
+    const T* y = b.data();
+    jadra::rozwin<W>([&](auto i) {
+        jadra::rozwin<P>([&](auto p) {
+            const R s = static_cast<R>(x[i * P + p]);
+            jadra::rozwin<K>([&](auto j) { w[i * K + j] = static_cast<R>(w[i * K + j] + s * static_cast<R>(y[p * K + j])); });
+        });
+    });
+    return c;
+}
+
+/// Zwraca macierz transponowaną do @p a.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+MACIERZ_SPLASZCZ constexpr fixed_matrix<T, K, W> transponuj(const fixed_matrix<T, W, K>& a) {
+    fixed_matrix<T, K, W> c;
+    T* w = c.data();
+    const T* x = a.data();
+    jadra::rozwin<W>([&](auto i) {
+        jadra::rozwin<K>([&](auto j) { w[j * W + i] = x[i * K + j]; });
+    });
+    return c;
+}
+
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+constexpr fixed_matrix<T, W, K>& fixed_matrix<T, W, K>::operator*=(const fixed_matrix<T, K, K>& m)
+    requires std::is_same_v<jadra::iloczyn_t<T>, T>
+{
+    return *this = pomnoz(*this, m);
+}
+
+/// Zwraca iloczyn macierzy @p a i @p b (zob. @ref pomnoz).
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t P, std::ptrdiff_t K>
+constexpr fixed_matrix<jadra::iloczyn_t<T>, W, K> operator*(const fixed_matrix<T, W, P>& a,
+                                                            const fixed_matrix<T, P, K>& b) {
+    return pomnoz(a, b);
+}
+
+/// Zwraca sumę macierzy @p a i @p b.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+constexpr fixed_matrix<T, W, K> operator+(fixed_matrix<T, W, K> a, const fixed_matrix<T, W, K>& b) {
+    return a += b;
+}
+
+/// Zwraca różnicę macierzy @p a i @p b.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+constexpr fixed_matrix<T, W, K> operator-(fixed_matrix<T, W, K> a, const fixed_matrix<T, W, K>& b) {
+    return a -= b;
+}
+
+/// Zwraca macierz @p m z liczbą @p s dodaną do każdego elementu.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+constexpr fixed_matrix<T, W, K> operator+(fixed_matrix<T, W, K> m, std::type_identity_t<T> s) {
+    return m += s;
+}
+
+/// Zwraca macierz @p m z liczbą @p s odjętą od każdego elementu.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+constexpr fixed_matrix<T, W, K> operator-(fixed_matrix<T, W, K> m, std::type_identity_t<T> s) {
+    return m -= s;
+}
+
+/// Zwraca macierz @p m z każdym elementem pomnożonym przez @p s.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+constexpr fixed_matrix<T, W, K> operator*(fixed_matrix<T, W, K> m, std::type_identity_t<T> s) {
+    return m *= s;
+}
+
+/// Zwraca macierz @p m z każdym elementem pomnożonym przez @p s.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+constexpr fixed_matrix<T, W, K> operator*(std::type_identity_t<T> s, fixed_matrix<T, W, K> m) {
+    return m *= s;
+}
+
+/// Zwraca widok całej macierzy @p m.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+matrix_view<T> widok(fixed_matrix<T, W, K>& m) noexcept {
+    return matrix_view<T>(m.data(), W, K);
+}
+
+/// Zwraca widok tylko do odczytu całej macierzy @p m.
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+matrix_view<const T> widok(const fixed_matrix<T, W, K>& m) noexcept {
+    return matrix_view<const T>(m.data(), W, K);
+}
+
+/**
+ * @brief Wypisuje macierz w formacie jak dla @ref basic_matrix.
+ */
+template <typename T, std::ptrdiff_t W, std::ptrdiff_t K>
+std::ostream& operator<<(std::ostream& o, const fixed_matrix<T, W, K>& m) {
+    for (std::ptrdiff_t i = 0; i < W; ++i) {
+        o << "| ";
+        for (std::ptrdiff_t j = 0; j < K; ++j) o << std::setw(4) << +m(i, j) << " ";
+        o << "|\n";
+    }
+    return o;
+}
@@ -0,0 +1,1404 @@
+#include "gemm.h"
+#include "cpu.h"
+#include "strassen.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef MACIERZ_X86
+#include <immintrin.h>
+#endif
+
+namespace jadra {
+
+namespace {
+
+/// Poniżej tej liczby operacji mnożenia (m*n*k) pakowanie się nie opłaca.
+constexpr long long PROG_MALEJ = 48LL * 48 * 48;
+
+/**
+ * @brief Cechy mnożenia dla typu elementów @p T.
+ *
+ * - @c pak – typ elementów spakowanych paneli,
+ * - @c wyn – typ akumulatora i wyniku,
+ * - @c KROK – liczba kolejnych wartości k zapisywanych obok siebie w panelu
+ *   (2 dla typów 8/16-bitowych: pary są mnożone instrukcją vpmaddwd).
+ */
+template <typename T>
+struct cechy {
+    using pak = T;
+    using wyn = iloczyn_t<T>;
+    static constexpr int KROK = 1;
+};
+
+template <>
+struct cechy<std::int8_t> {
+    using pak = std::int16_t;
+    using wyn = std::int32_t;
+    static constexpr int KROK = 2;
+};
+
+template <>
+struct cechy<std::int16_t> : cechy<std::int8_t> {};
+
+/// Wskaźnik na mikrojądro dla typu @p T.
+template <typename T>
+using mikrojadro_t = void (*)(int kc, const typename cechy<T>::pak* ap, const typename cechy<T>::pak* bp,
+                              iloczyn_t<T>* c, long long ldc, int mr, int nr, bool akumuluj);
+
+/**
+ * @brief Dobiera rozmiary bloków do rozmiarów pamięci podręcznej.
+ *
+ * - panel B (kc x NR) zajmuje około połowy L1,
+ * - blok A (mc x kc) zajmuje około połowy L2,
+ * - blok B (kc x nc) zajmuje około połowy L3.
+ *
+ * @param el Rozmiar elementu spakowanych paneli (w bajtach).
+ * @return Wyznaczone parametry.
+ */
+parametry_gemm wyznacz_parametry(int el) {
+    const cpu_info& cpu = procesor();
+
+    int kc = cpu.l1d / 2 / (NR * el);
+    kc = std::clamp(kc / 8 * 8, 64, 1024);
+
+    int mc = cpu.l2 / 2 / (kc * el);
+    mc = std::clamp(mc / MR * MR, MR * 4, 1024);
+
+    int nc = cpu.l3 / 2 / (kc * el);
+    nc = std::clamp(nc / NR * NR, NR * 4, 8192);
+
+    return parametry_gemm{ mc, kc, nc };
+}
+
+/**
+ * @brief Prosta pętla i-p-j dla małych macierzy.
+ *
+ * Najgłębsza pętla przechodzi po ciągłych wierszach B i C, dzięki czemu
+ * kompilator może ją zwektoryzować. Typ wyniku @p W może być szerszy niż
+ * @ref iloczyn_t (zob. @ref gemm_szeroki). Wyniki całkowite są liczone
+ * modulo 2^N, jak w mikrojądrach.
+ */
+template <typename T, typename W>
+void gemm_maly(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+               const T* a, std::ptrdiff_t lda,
+               const T* b, std::ptrdiff_t ldb,
+               W* c, std::ptrdiff_t ldc,
+               bool akumuluj) {
+    for (std::ptrdiff_t i = 0; i < m; ++i) {
+        W* wc = c + i * ldc;
+        if (!akumuluj) std::fill(wc, wc + n, W(0));
+        const T* wa = a + i * lda;
+        for (std::ptrdiff_t p = 0; p < k; ++p) {
+            const W aip = wa[p];
+            const T* wb = b + p * ldb;
+            for (std::ptrdiff_t j = 0; j < n; ++j) wc[j] = dodaj_iloczyn(wc[j], aip, static_cast<W>(wb[j]));
+        }
+    }
+}
+
+/**
+ * @brief Pakuje blok A (mc x kc) do paneli po MR wierszy.
+ *
+ * W panelu element (i, p) leży pod indeksem (p / KROK) * MR * KROK + i * KROK
+ * + p % KROK (dla KROK == 1: p * MR + i). Brakujące wiersze ostatniego
+ * panelu i brakująca ostatnia wartość k pary są uzupełniane zerami.
+ */
+template <typename T>
+void pakuj_a(int mc, int kc, const T* a, std::ptrdiff_t lda, typename cechy<T>::pak* ap) {
+    constexpr int KROK = cechy<T>::KROK;
+    const int kc_pelne = (kc + KROK - 1) / KROK * KROK;
+    for (int ir = 0; ir < mc; ir += MR) {
+        const int mr = std::min(MR, mc - ir);
+        for (int p = 0; p < kc_pelne; p += KROK) {
+            for (int i = 0; i < MR; ++i) {
+                for (int r = 0; r < KROK; ++r) {
+                    ap[p * MR + i * KROK + r] =
+                        i < mr && p + r < kc ? a[(ir + i) * lda + p + r] : T(0);
+                }
+            }
+        }
+        ap += MR * kc_pelne;
+    }
+}
+
+/**
+ * @brief Pakuje blok B (kc x nc) do paneli po NR kolumn.
+ *
+ * W panelu element (p, j) leży pod indeksem (p / KROK) * NR * KROK + j * KROK
+ * + p % KROK (dla KROK == 1: p * NR + j). Brakujące kolumny ostatniego
+ * panelu są uzupełniane zerami.
+ */
+template <typename T>
+void pakuj_b(int kc, int nc, const T* b, std::ptrdiff_t ldb, typename cechy<T>::pak* bp) {
+    constexpr int KROK = cechy<T>::KROK;
+    const int kc_pelne = (kc + KROK - 1) / KROK * KROK;
+    for (int jr = 0; jr < nc; jr += NR) {
+        const int nr = std::min(NR, nc - jr);
+        for (int p = 0; p < kc_pelne; p += KROK) {
+            for (int r = 0; r < KROK; ++r) {
+                auto* wp = bp + p * NR + r;
+                if (p + r < kc) {
+                    const T* wb = b + (p + r) * ldb + jr;
+                    for (int j = 0; j < nr; ++j) wp[j * KROK] = wb[j];
+                }
+                else {
+                    for (int j = 0; j < nr; ++j) wp[j * KROK] = 0;
+                }
+                for (int j = nr; j < NR; ++j) wp[j * KROK] = 0;
+            }
+        }
+        bp += NR * kc_pelne;
+    }
+}
+
+/**
+ * @brief Zapisuje (lub dodaje) blok MR x NR z bufora @p acc do C,
+ *        obcinając go do @p mr x @p nr.
+ */
+template <typename W>
+void zapisz_blok(const W (&acc)[MR][NR], W* c, long long ldc, int mr, int nr, bool akumuluj) {
+    for (int i = 0; i < mr; ++i) {
+        W* wc = c + i * ldc;
+        if (akumuluj) {
+            for (int j = 0; j < nr; ++j) wc[j] = dodaj_iloczyn(wc[j], W(1), acc[i][j]);
+        }
+        else {
+            for (int j = 0; j < nr; ++j) wc[j] = acc[i][j];
+        }
+    }
+}
+
+/**
+ * @brief Mikrojądro skalarne: liczy blok MR x NR wyniku w zmiennych
+ *        lokalnych i zapisuje go do C.
+ *
+ * @param kc Głębokość (długość paneli, wielokrotność KROK).
+ * @param ap Spakowany panel A (kc x MR).
+ * @param bp Spakowany panel B (kc x NR).
+ * @param c Lewy górny róg bloku w C.
+ * @param ldc Odległość między wierszami C.
+ * @param mr Liczba faktycznie zapisywanych wierszy (<= MR).
+ * @param nr Liczba faktycznie zapisywanych kolumn (<= NR).
+ * @param akumuluj Czy dodawać wynik do C zamiast go nadpisywać.
+ */
+template <typename T, typename W = iloczyn_t<T>>
+void mikrojadro_skalarne(int kc, const typename cechy<T>::pak* ap, const typename cechy<T>::pak* bp,
+                         W* c, long long ldc, int mr, int nr, bool akumuluj) {
+    constexpr int KROK = cechy<T>::KROK;
+    W acc[MR][NR] = {};
+    for (int p = 0; p < kc; p += KROK) {
+        const auto* wb = bp + p * NR;
+        const auto* wa = ap + p * MR;
+        for (int i = 0; i < MR; ++i) {
+            for (int r = 0; r < KROK; ++r) {
+                const W ai = wa[i * KROK + r];
+                for (int j = 0; j < NR; ++j) acc[i][j] = dodaj_iloczyn(acc[i][j], ai, static_cast<W>(wb[j * KROK + r]));
+            }
+        }
+    }
+    zapisz_blok(acc, c, ldc, mr, nr, akumuluj);
+}
+
+#ifdef MACIERZ_X86
+
+// ---------------------------------------------------------------------------
+// Mikrojądra wektorowe
+//
+// Opis typu wektora (S) podaje: typy pak i wyn, typ rejestru V, liczbę
+// wyników w rejestrze SZER, KROK oraz operacje zero, laduj (SZER * KROK
+// elementów panelu B), rozglos (KROK elementów panelu A na cały rejestr),
+// fma (c + a * b, dla par: suma iloczynów par) i zapisz.
+// ---------------------------------------------------------------------------
+
+struct avx2_i32 {
+    using pak = int;
+    using wyn = int;
+    using V = __m256i;
+    static constexpr int SZER = 8;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx2") static V zero() { return _mm256_setzero_si256(); }
+    MACIERZ_CEL("avx2") static V laduj(const pak* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    MACIERZ_CEL("avx2") static V rozglos(const pak* p) { return _mm256_set1_epi32(*p); }
+    MACIERZ_CEL("avx2") static V fma(V a, V b, V c) { return _mm256_add_epi32(c, _mm256_mullo_epi32(a, b)); }
+    MACIERZ_CEL("avx2") static void zapisz(wyn* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+};
+
+struct avx2_i16 {
+    using pak = std::int16_t;
+    using wyn = std::int32_t;
+    using V = __m256i;
+    static constexpr int SZER = 8;
+    static constexpr int KROK = 2;
+    MACIERZ_CEL("avx2") static V zero() { return _mm256_setzero_si256(); }
+    MACIERZ_CEL("avx2") static V laduj(const pak* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    MACIERZ_CEL("avx2") static V rozglos(const pak* p) {
+        std::int32_t para;
+        std::memcpy(&para, p, sizeof(para));
+        return _mm256_set1_epi32(para);
+    }
+    MACIERZ_CEL("avx2") static V fma(V a, V b, V c) { return _mm256_add_epi32(c, _mm256_madd_epi16(a, b)); }
+    MACIERZ_CEL("avx2") static void zapisz(wyn* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+};
+
+struct avx2_f32 {
+    using pak = float;
+    using wyn = float;
+    using V = __m256;
+    static constexpr int SZER = 8;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx2,fma") static V zero() { return _mm256_setzero_ps(); }
+    MACIERZ_CEL("avx2,fma") static V laduj(const pak* p) { return _mm256_loadu_ps(p); }
+    MACIERZ_CEL("avx2,fma") static V rozglos(const pak* p) { return _mm256_broadcast_ss(p); }
+    MACIERZ_CEL("avx2,fma") static V fma(V a, V b, V c) { return _mm256_fmadd_ps(a, b, c); }
+    MACIERZ_CEL("avx2,fma") static void zapisz(wyn* p, V v) { _mm256_storeu_ps(p, v); }
+};
+
+struct avx2_f64 {
+    using pak = double;
+    using wyn = double;
+    using V = __m256d;
+    static constexpr int SZER = 4;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx2,fma") static V zero() { return _mm256_setzero_pd(); }
+    MACIERZ_CEL("avx2,fma") static V laduj(const pak* p) { return _mm256_loadu_pd(p); }
+    MACIERZ_CEL("avx2,fma") static V rozglos(const pak* p) { return _mm256_broadcast_sd(p); }
+    MACIERZ_CEL("avx2,fma") static V fma(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    MACIERZ_CEL("avx2,fma") static void zapisz(wyn* p, V v) { _mm256_storeu_pd(p, v); }
+};
+
+struct avx512_i32 {
+    using pak = int;
+    using wyn = int;
+    using V = __m512i;
+    static constexpr int SZER = 16;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx512f") static V zero() { return _mm512_setzero_si512(); }
+    MACIERZ_CEL("avx512f") static V laduj(const pak* p) { return _mm512_loadu_si512(p); }
+    MACIERZ_CEL("avx512f") static V rozglos(const pak* p) { return _mm512_set1_epi32(*p); }
+    MACIERZ_CEL("avx512f") static V fma(V a, V b, V c) { return _mm512_add_epi32(c, _mm512_mullo_epi32(a, b)); }
+    MACIERZ_CEL("avx512f") static void zapisz(wyn* p, V v) { _mm512_storeu_si512(p, v); }
+};
+
+struct avx512_i16 {
+    using pak = std::int16_t;
+    using wyn = std::int32_t;
+    using V = __m512i;
+    static constexpr int SZER = 16;
+    static constexpr int KROK = 2;
+    MACIERZ_CEL("avx512f,avx512bw") static V zero() { return _mm512_setzero_si512(); }
+    MACIERZ_CEL("avx512f,avx512bw") static V laduj(const pak* p) { return _mm512_loadu_si512(p); }
+    MACIERZ_CEL("avx512f,avx512bw") static V rozglos(const pak* p) {
+        std::int32_t para;
+        std::memcpy(&para, p, sizeof(para));
+        return _mm512_set1_epi32(para);
+    }
+    MACIERZ_CEL("avx512f,avx512bw") static V fma(V a, V b, V c) { return _mm512_add_epi32(c, _mm512_madd_epi16(a, b)); }
+    MACIERZ_CEL("avx512f,avx512bw") static void zapisz(wyn* p, V v) { _mm512_storeu_si512(p, v); }
+};
+
+struct avx512_vnni_i16 : avx512_i16 {
+    MACIERZ_CEL("avx512f,avx512bw,avx512vnni") static V fma(V a, V b, V c) { return _mm512_dpwssd_epi32(c, a, b); }
+};
+
+struct avx512_f32 {
+    using pak = float;
+    using wyn = float;
+    using V = __m512;
+    static constexpr int SZER = 16;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx512f") static V zero() { return _mm512_setzero_ps(); }
+    MACIERZ_CEL("avx512f") static V laduj(const pak* p) { return _mm512_loadu_ps(p); }
+    MACIERZ_CEL("avx512f") static V rozglos(const pak* p) { return _mm512_set1_ps(*p); }
+    MACIERZ_CEL("avx512f") static V fma(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+    MACIERZ_CEL("avx512f") static void zapisz(wyn* p, V v) { _mm512_storeu_ps(p, v); }
+};
+
+struct avx512_f64 {
+    using pak = double;
+    using wyn = double;
+    using V = __m512d;
+    static constexpr int SZER = 8;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx512f") static V zero() { return _mm512_setzero_pd(); }
+    MACIERZ_CEL("avx512f") static V laduj(const pak* p) { return _mm512_loadu_pd(p); }
+    MACIERZ_CEL("avx512f") static V rozglos(const pak* p) { return _mm512_set1_pd(*p); }
+    MACIERZ_CEL("avx512f") static V fma(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    MACIERZ_CEL("avx512f") static void zapisz(wyn* p, V v) { _mm512_storeu_pd(p, v); }
+};
+
+// Mnożenie z szerokim akumulatorem: liczby int32 są rozszerzane do 64 bitów
+// przy ładowaniu panelu B, a vpmuldq mnoży młodsze 32 bity każdej pary
+// w dokładny iloczyn 64-bitowy. Instrukcje AVX-512 bez maski są wywoływane
+// w wersji maskz z pełną maską (GCC 12 ostrzega przy nich o niezainicjowanym
+// rejestrze źródłowym).
+
+struct avx2_i32_i64 {
+    using pak = int;
+    using wyn = std::int64_t;
+    using V = __m256i;
+    static constexpr int SZER = 4;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx2") static V zero() { return _mm256_setzero_si256(); }
+    MACIERZ_CEL("avx2") static V laduj(const pak* p) {
+        return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    }
+    MACIERZ_CEL("avx2") static V rozglos(const pak* p) { return _mm256_set1_epi64x(*p); }
+    MACIERZ_CEL("avx2") static V fma(V a, V b, V c) { return _mm256_add_epi64(c, _mm256_mul_epi32(a, b)); }
+    MACIERZ_CEL("avx2") static void zapisz(wyn* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+};
+
+struct avx512_i32_i64 {
+    using pak = int;
+    using wyn = std::int64_t;
+    using V = __m512i;
+    static constexpr int SZER = 8;
+    static constexpr int KROK = 1;
+    MACIERZ_CEL("avx512f") static V zero() { return _mm512_setzero_si512(); }
+    MACIERZ_CEL("avx512f") static V laduj(const pak* p) {
+        return _mm512_maskz_cvtepi32_epi64(0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+    }
+    MACIERZ_CEL("avx512f") static V rozglos(const pak* p) { return _mm512_set1_epi64(*p); }
+    MACIERZ_CEL("avx512f") static V fma(V a, V b, V c) { return _mm512_add_epi64(c, _mm512_maskz_mul_epi32(0xFF, a, b)); }
+    MACIERZ_CEL("avx512f") static void zapisz(wyn* p, V v) { _mm512_storeu_si512(p, v); }
+};
+
+// Ciało jest zawsze wstawiane do funkcji z odpowiednim MACIERZ_CEL, więc
+// ostrzeżenia GCC o ABI wektorów w funkcji bez rozszerzeń nie dotyczą go.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+/**
+ * @brief Mikrojądro wektorowe: blok MR x NR liczony w przebiegach po 2
+ *        rejestry na wiersz (dla AVX2: 8 akumulatorów + 2 rejestry B
+ *        mieści się w 16 rejestrach).
+ *
+ * Parametry jak w @ref mikrojadro_skalarne. Funkcja jest wstawiana
+ * (@ref MACIERZ_WSTAW) do mikrojąder zdefiniowanych przez
+ * @ref MACIERZ_MIKROJADRO, więc każdy wariant jest kompilowany tylko
+ * z rozszerzeniami, które sprawdza @ref wybierz_mikrojadro.
+ */
+template <typename S>
+MACIERZ_WSTAW void mikrojadro_wektorowe(int kc, const typename S::pak* ap, const typename S::pak* bp,
+                                        typename S::wyn* c, long long ldc, int mr, int nr, bool akumuluj) {
+    constexpr int W = 2;
+    constexpr int SZEROKOSC = S::SZER * W;
+    alignas(64) typename S::wyn acc[MR][NR];
+    for (int q = 0; q < NR; q += SZEROKOSC) {
+        typename S::V s[MR][W];
+        for (int i = 0; i < MR; ++i) {
+            for (int w = 0; w < W; ++w) s[i][w] = S::zero();
+        }
+        for (int p = 0; p < kc; p += S::KROK) {
+            const typename S::pak* wb = bp + p * NR + q * S::KROK;
+            const typename S::pak* wa = ap + p * MR;
+            typename S::V b[W];
+            for (int w = 0; w < W; ++w) b[w] = S::laduj(wb + w * S::SZER * S::KROK);
+            for (int i = 0; i < MR; ++i) {
+                const typename S::V a = S::rozglos(wa + i * S::KROK);
+                for (int w = 0; w < W; ++w) s[i][w] = S::fma(a, b[w], s[i][w]);
+            }
+        }
+        for (int i = 0; i < MR; ++i) {
+            for (int w = 0; w < W; ++w) S::zapisz(&acc[i][q + w * S::SZER], s[i][w]);
+        }
+    }
+    zapisz_blok(acc, c, ldc, mr, nr, akumuluj);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @def MACIERZ_MIKROJADRO
+ * @brief Definiuje mikrojądro @p nazwa dla opisu wektora @p S, kompilowane
+ *        z rozszerzeniami @p cel – tymi samymi, które sprawdza wybór jądra.
+ */
+#define MACIERZ_MIKROJADRO(nazwa, S, cel)                                                                  \
+    MACIERZ_CEL(cel) void nazwa(int kc, const S::pak* ap, const S::pak* bp, S::wyn* c, long long ldc, int mr, \
+                                int nr, bool akumuluj) {                                                    \
+        mikrojadro_wektorowe<S>(kc, ap, bp, c, ldc, mr, nr, akumuluj);                                      \
+    }
+
+MACIERZ_MIKROJADRO(mikrojadro_avx2_i32, avx2_i32, "avx2")
+MACIERZ_MIKROJADRO(mikrojadro_avx2_i16, avx2_i16, "avx2")
+MACIERZ_MIKROJADRO(mikrojadro_avx2_f32, avx2_f32, "avx2,fma")
+MACIERZ_MIKROJADRO(mikrojadro_avx2_f64, avx2_f64, "avx2,fma")
+MACIERZ_MIKROJADRO(mikrojadro_avx2_i32_i64, avx2_i32_i64, "avx2")
+MACIERZ_MIKROJADRO(mikrojadro_avx512_i32, avx512_i32, "avx512f")
+MACIERZ_MIKROJADRO(mikrojadro_avx512_i16, avx512_i16, "avx512f,avx512bw")
+MACIERZ_MIKROJADRO(mikrojadro_avx512_vnni_i16, avx512_vnni_i16, "avx512f,avx512bw,avx512vnni")
+MACIERZ_MIKROJADRO(mikrojadro_avx512_f32, avx512_f32, "avx512f")
+MACIERZ_MIKROJADRO(mikrojadro_avx512_f64, avx512_f64, "avx512f")
+MACIERZ_MIKROJADRO(mikrojadro_avx512_i32_i64, avx512_i32_i64, "avx512f")
+
+#undef MACIERZ_MIKROJADRO
+
+#endif // MACIERZ_X86
+
+/**
+ * @brief Mikrojądro i jego nazwa wybrane dla typu @p T.
+ */
+template <typename T>
+struct wybrane_mikrojadro {
+    mikrojadro_t<T> f;
+    const char* nazwa;
+};
+
+/**
+ * @brief Wybiera najlepsze mikrojądro dla typu @p T obsługiwane przez procesor.
+ */
+template <typename T>
+wybrane_mikrojadro<T> wybierz_mikrojadro() {
+#ifdef MACIERZ_X86
+    const cpu_info& cpu = procesor();
+    if constexpr (std::is_same_v<T, int>) {
+        if (cpu.avx512f) return { mikrojadro_avx512_i32, "avx512" };
+        if (cpu.avx2) return { mikrojadro_avx2_i32, "avx2" };
+    }
+    else if constexpr (cechy<T>::KROK == 2) {
+        if (cpu.avx512bw && cpu.avx512vnni) return { mikrojadro_avx512_vnni_i16, "avx512vnni" };
+        if (cpu.avx512bw) return { mikrojadro_avx512_i16, "avx512" };
+        if (cpu.avx2) return { mikrojadro_avx2_i16, "avx2" };
+    }
+    else if constexpr (std::is_same_v<T, float>) {
+        if (cpu.avx512f) return { mikrojadro_avx512_f32, "avx512" };
+        if (cpu.avx2 && cpu.fma) return { mikrojadro_avx2_f32, "avx2" };
+    }
+    else if constexpr (std::is_same_v<T, double>) {
+        if (cpu.avx512f) return { mikrojadro_avx512_f64, "avx512" };
+        if (cpu.avx2 && cpu.fma) return { mikrojadro_avx2_f64, "avx2" };
+    }
+#endif
+    return { mikrojadro_skalarne<T>, "skalarny" };
+}
+
+/**
+ * @brief Zwraca mikrojądro dla typu @p T (wybierane raz, przy pierwszym wywołaniu).
+ */
+template <typename T>
+const wybrane_mikrojadro<T>& mikrojadro() {
+    static const wybrane_mikrojadro<T> wybrane = wybierz_mikrojadro<T>();
+    return wybrane;
+}
+
+/**
+ * @brief Zwraca bufor na spakowany blok A, prywatny dla bieżącego wątku.
+ *
+ * Bufor jest powiększany w razie potrzeby i używany ponownie przez kolejne
+ * wywołania, więc zadania puli wątków nie alokują pamięci.
+ *
+ * @param bajtow Wymagany rozmiar (w bajtach).
+ * @return Wskaźnik na bufor.
+ */
+void* bufor_watku(size_t bajtow) {
+    thread_local std::unique_ptr<long long[]> bufor;
+    thread_local size_t pojemnosc = 0;
+    const size_t slow = (bajtow + sizeof(long long) - 1) / sizeof(long long);
+    if (pojemnosc < slow) {
+        bufor.reset(new long long[slow]);
+        pojemnosc = slow;
+    }
+    return bufor.get();
+}
+
+/**
+ * @brief Bufor na spakowany blok B pożyczany z puli na czas jednego mnożenia.
+ *
+ * Zwolnione bufory wracają do puli, więc kolejne mnożenia (także wywołane
+ * z zadań puli wątków, gdy inne mnożenie czeka na wynik) nie alokują pamięci.
+ * Bufory są wspólne dla wszystkich typów elementów.
+ */
+class pozyczony_bufor {
+public:
+    explicit pozyczony_bufor(size_t bajtow) : pojemnosc(0) {
+        const size_t rozmiar = (bajtow + sizeof(long long) - 1) / sizeof(long long);
+        std::lock_guard<std::mutex> lk(mutex_puli());
+        auto& wolne = wolne_bufory();
+        for (auto it = wolne.begin(); it != wolne.end(); ++it) {
+            if (it->second >= rozmiar) {
+                dane = std::move(it->first);
+                pojemnosc = it->second;
+                wolne.erase(it);
+                return;
+            }
+        }
+        dane.reset(new long long[rozmiar]);
+        pojemnosc = rozmiar;
+    }
+
+    ~pozyczony_bufor() {
+        std::lock_guard<std::mutex> lk(mutex_puli());
+        wolne_bufory().emplace_back(std::move(dane), pojemnosc);
+    }
+
+    pozyczony_bufor(const pozyczony_bufor&) = delete;
+    pozyczony_bufor& operator=(const pozyczony_bufor&) = delete;
+
+    void* get() const { return dane.get(); }
+
+private:
+    std::unique_ptr<long long[]> dane; ///< Pożyczony bufor.
+    size_t pojemnosc;                  ///< Jego rozmiar (liczba słów 8-bajtowych).
+
+    static std::mutex& mutex_puli() {
+        static std::mutex m;
+        return m;
+    }
+
+    static std::vector<std::pair<std::unique_ptr<long long[]>, size_t>>& wolne_bufory() {
+        static std::vector<std::pair<std::unique_ptr<long long[]>, size_t>> wolne;
+        return wolne;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Jądra macierz-wektor
+// ---------------------------------------------------------------------------
+
+/// Liczba kolumn y przetwarzanych naraz w gevm (fragment y mieści się w L1).
+constexpr int BLOK_GEVM = 2048;
+
+template <typename T>
+iloczyn_t<T> iloczyn_skalarny_skalarny(const T* a, const T* x, long long k) {
+    iloczyn_t<T> s = 0;
+    for (long long p = 0; p < k; ++p) s = dodaj_iloczyn(s, static_cast<iloczyn_t<T>>(a[p]), static_cast<iloczyn_t<T>>(x[p]));
+    return s;
+}
+
+template <typename T>
+void dodaj_wielokrotnosc_skalarny(iloczyn_t<T>* y, const T* b, int n, iloczyn_t<T> s) {
+    for (int j = 0; j < n; ++j) y[j] = dodaj_iloczyn(y[j], s, static_cast<iloczyn_t<T>>(b[j]));
+}
+
+#ifdef MACIERZ_X86
+
+MACIERZ_CEL("avx2")
+int iloczyn_skalarny_avx2(const int* a, const int* x, long long k) {
+    __m256i s0 = _mm256_setzero_si256();
+    __m256i s1 = _mm256_setzero_si256();
+    long long p = 0;
+    for (; p + 16 <= k; p += 16) {
+        __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + p));
+        __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + p + 8));
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + p));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + p + 8));
+        s0 = _mm256_add_epi32(s0, _mm256_mullo_epi32(a0, x0));
+        s1 = _mm256_add_epi32(s1, _mm256_mullo_epi32(a1, x1));
+    }
+    __m256i s = _mm256_add_epi32(s0, s1);
+    __m128i h = _mm_add_epi32(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+    h = _mm_add_epi32(h, _mm_shuffle_epi32(h, 0x4E));
+    h = _mm_add_epi32(h, _mm_shuffle_epi32(h, 0xB1));
+    int wynik = _mm_cvtsi128_si32(h);
+    for (; p < k; ++p) wynik = dodaj_iloczyn(wynik, a[p], x[p]);
+    return wynik;
+}
+
+MACIERZ_CEL("avx2")
+void dodaj_wielokrotnosc_avx2(int* y, const int* b, int n, int s) {
+    const __m256i vs = _mm256_set1_epi32(s);
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + j));
+        __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + j + 8));
+        __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j + 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + j), _mm256_add_epi32(y0, _mm256_mullo_epi32(b0, vs)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + j + 8), _mm256_add_epi32(y1, _mm256_mullo_epi32(b1, vs)));
+    }
+    for (; j < n; ++j) y[j] = dodaj_iloczyn(y[j], s, b[j]);
+}
+
+#endif // MACIERZ_X86
+
+/**
+ * @brief Jądra wektorowe dla typu @p T.
+ */
+template <typename T>
+struct jadra_wektorowe {
+    /// Zwraca sumę a[p] * x[p] dla p z [0, k).
+    iloczyn_t<T> (*iloczyn_skalarny)(const T* a, const T* x, long long k);
+    /// y[j] += s * b[j] dla j z [0, n).
+    void (*dodaj_wielokrotnosc)(iloczyn_t<T>* y, const T* b, int n, iloczyn_t<T> s);
+};
+
+/**
+ * @brief Zwraca jądra wektorowe (wybierane raz, przy pierwszym wywołaniu).
+ *
+ * Dla int wariant AVX2, dla pozostałych typów pętle skalarne.
+ */
+template <typename T>
+const jadra_wektorowe<T>& wektorowe() {
+    static const jadra_wektorowe<T> wybrane = [] {
+#ifdef MACIERZ_X86
+        if constexpr (std::is_same_v<T, int>) {
+            if (procesor().avx2) return jadra_wektorowe<T>{ iloczyn_skalarny_avx2, dodaj_wielokrotnosc_avx2 };
+        }
+#endif
+        return jadra_wektorowe<T>{ iloczyn_skalarny_skalarny<T>, dodaj_wielokrotnosc_skalarny<T> };
+    }();
+    return wybrane;
+}
+
+// ---------------------------------------------------------------------------
+// Mnożenie z szerokim akumulatorem i mnożenie modulo p
+// ---------------------------------------------------------------------------
+
+/// Mikrojądro mnożenia int32 z wynikiem int64.
+using mikrojadro_szerokie_t = void (*)(int kc, const int* ap, const int* bp, std::int64_t* c, long long ldc,
+                                       int mr, int nr, bool akumuluj);
+
+/**
+ * @brief Wybiera mikrojądro mnożenia z szerokim akumulatorem (raz).
+ */
+mikrojadro_szerokie_t mikrojadro_szerokie() {
+    static const mikrojadro_szerokie_t wybrane = [] {
+#ifdef MACIERZ_X86
+        const cpu_info& cpu = procesor();
+        if (cpu.avx512f) return mikrojadro_szerokie_t(mikrojadro_avx512_i32_i64);
+        if (cpu.avx2) return mikrojadro_szerokie_t(mikrojadro_avx2_i32_i64);
+#endif
+        return mikrojadro_szerokie_t(mikrojadro_skalarne<int, std::int64_t>);
+    }();
+    return wybrane;
+}
+
+/**
+ * @brief Stałe redukcji modulo p (2 <= p < 2^31).
+ *
+ * Akumulatory są 64-bitowe bez znaku. Iloczyny elementów z [0, p) są
+ * mniejsze niż (p - 1)^2 < 2^62, więc po redukcji leniwej (akumulator
+ * < 2^63 + p) można dodać @c co_ile kolejnych iloczynów bez przepełnienia.
+ * Redukcja leniwa odejmuje @c prog (wielokrotność p bliską 2^63), gdy
+ * akumulator jest >= @c prog; dokładną resztę liczy dopiero zapis do C
+ * (redukcja Barretta).
+ */
+struct modul {
+    std::uint64_t p;       ///< Moduł.
+    std::uint64_t barrett; ///< floor((2^64 - 1) / p).
+    std::uint64_t prog;    ///< p * floor(2^63 / p).
+    int co_ile;            ///< Liczba iloczynów między redukcjami leniwymi.
+};
+
+/**
+ * @brief Wyznacza stałe redukcji dla modułu @p p.
+ */
+modul przygotuj_modul(std::int32_t p) {
+    const std::uint64_t up = static_cast<std::uint64_t>(p);
+    const std::uint64_t pol = std::uint64_t(1) << 63;
+    const std::uint64_t max_iloczyn = (up - 1) * (up - 1);
+    const std::uint64_t co_ile = max_iloczyn == 0 ? (1u << 20) : std::min<std::uint64_t>((pol - up) / max_iloczyn, 1u << 20);
+    return modul{ up, ~std::uint64_t(0) / up, pol / up * up, static_cast<int>(co_ile) };
+}
+
+/**
+ * @brief Zwraca starsze 64 bity iloczynu @p a * @p b.
+ */
+inline std::uint64_t mnoz_wysokie(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(a, b);
+#else
+    const std::uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32, b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+    const std::uint64_t srodek = (a0 * b0 >> 32) + (a1 * b0 & 0xFFFFFFFFu) + a0 * b1;
+    return a1 * b1 + (a1 * b0 >> 32) + (srodek >> 32);
+#endif
+}
+
+/**
+ * @brief Zwraca @p x mod p (redukcja Barretta).
+ */
+inline std::uint64_t redukuj(std::uint64_t x, const modul& mod) {
+    std::uint64_t r = x - mnoz_wysokie(x, mod.barrett) * mod.p;
+    while (r >= mod.p) r -= mod.p;
+    return r;
+}
+
+/**
+ * @brief Redukuje akumulatory modulo p i zapisuje (lub dodaje modulo p)
+ *        blok MR x NR do C, obcinając go do @p mr x @p nr.
+ */
+void zapisz_blok_modulo(const std::uint64_t (&acc)[MR][NR], int* c, long long ldc, int mr, int nr, bool akumuluj,
+                        const modul& mod) {
+    for (int i = 0; i < mr; ++i) {
+        int* wc = c + i * ldc;
+        for (int j = 0; j < nr; ++j) {
+            std::uint64_t r = redukuj(acc[i][j], mod);
+            if (akumuluj) {
+                r += static_cast<std::uint32_t>(wc[j]);
+                if (r >= mod.p) r -= mod.p;
+            }
+            wc[j] = static_cast<int>(r);
+        }
+    }
+}
+
+/// Mikrojądro mnożenia modulo p (elementy A, B i C w [0, p)).
+using mikrojadro_modularne_t = void (*)(int kc, const int* ap, const int* bp, int* c, long long ldc,
+                                        int mr, int nr, bool akumuluj, const modul& mod);
+
+/**
+ * @brief Mikrojądro skalarne mnożenia modulo p.
+ *
+ * Parametry jak w @ref mikrojadro_skalarne; @p mod – stałe redukcji.
+ */
+void mikrojadro_modularne_skalarne(int kc, const int* ap, const int* bp, int* c, long long ldc,
+                                   int mr, int nr, bool akumuluj, const modul& mod) {
+    std::uint64_t acc[MR][NR] = {};
+    for (int p = 0; p < kc;) {
+        const int koniec = std::min(kc, p + mod.co_ile);
+        for (; p < koniec; ++p) {
+            const int* wb = bp + p * NR;
+            const int* wa = ap + p * MR;
+            for (int i = 0; i < MR; ++i) {
+                const std::uint64_t ai = static_cast<std::uint32_t>(wa[i]);
+                for (int j = 0; j < NR; ++j) acc[i][j] += ai * static_cast<std::uint32_t>(wb[j]);
+            }
+        }
+        for (int i = 0; i < MR; ++i) {
+            for (int j = 0; j < NR; ++j) acc[i][j] -= acc[i][j] >= mod.prog ? mod.prog : 0;
+        }
+    }
+    zapisz_blok_modulo(acc, c, ldc, mr, nr, akumuluj, mod);
+}
+
+#ifdef MACIERZ_X86
+
+/**
+ * @brief Mikrojądro AVX2 mnożenia modulo p: iloczyny vpmuludq, redukcja
+ *        leniwa porównaniem ze znakiem po przesunięciu o 2^63 (AVX2 nie
+ *        ma porównań 64-bitowych bez znaku).
+ */
+MACIERZ_CEL("avx2")
+void mikrojadro_modularne_avx2(int kc, const int* ap, const int* bp, int* c, long long ldc,
+                               int mr, int nr, bool akumuluj, const modul& mod) {
+    constexpr int SZER = 4;
+    constexpr int W = 2;
+    alignas(64) std::uint64_t acc[MR][NR];
+    const __m256i znak = _mm256_set1_epi64x(static_cast<long long>(std::uint64_t(1) << 63));
+    const __m256i prog = _mm256_set1_epi64x(static_cast<long long>(mod.prog));
+    const __m256i prog_znak = _mm256_xor_si256(_mm256_sub_epi64(prog, _mm256_set1_epi64x(1)), znak);
+    for (int q = 0; q < NR; q += SZER * W) {
+        __m256i s[MR][W];
+        for (int i = 0; i < MR; ++i) {
+            for (int w = 0; w < W; ++w) s[i][w] = _mm256_setzero_si256();
+        }
+        for (int p = 0; p < kc;) {
+            const int koniec = std::min(kc, p + mod.co_ile);
+            for (; p < koniec; ++p) {
+                const int* wb = bp + p * NR + q;
+                const int* wa = ap + p * MR;
+                __m256i b[W];
+                for (int w = 0; w < W; ++w) {
+                    b[w] = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(wb + w * SZER)));
+                }
+                for (int i = 0; i < MR; ++i) {
+                    const __m256i a = _mm256_set1_epi64x(static_cast<std::uint32_t>(wa[i]));
+                    for (int w = 0; w < W; ++w) s[i][w] = _mm256_add_epi64(s[i][w], _mm256_mul_epu32(a, b[w]));
+                }
+            }
+            for (int i = 0; i < MR; ++i) {
+                for (int w = 0; w < W; ++w) {
+                    const __m256i wiekszy = _mm256_cmpgt_epi64(_mm256_xor_si256(s[i][w], znak), prog_znak);
+                    s[i][w] = _mm256_sub_epi64(s[i][w], _mm256_and_si256(wiekszy, prog));
+                }
+            }
+        }
+        for (int i = 0; i < MR; ++i) {
+            for (int w = 0; w < W; ++w) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&acc[i][q + w * SZER]), s[i][w]);
+            }
+        }
+    }
+    zapisz_blok_modulo(acc, c, ldc, mr, nr, akumuluj, mod);
+}
+
+/**
+ * @brief Mikrojądro AVX-512 mnożenia modulo p: cały blok MR x NR
+ *        w 16 rejestrach, redukcja leniwa maskowanym odejmowaniem.
+ */
+MACIERZ_CEL("avx512f")
+void mikrojadro_modularne_avx512(int kc, const int* ap, const int* bp, int* c, long long ldc,
+                                 int mr, int nr, bool akumuluj, const modul& mod) {
+    constexpr int SZER = 8;
+    constexpr int W = NR / SZER;
+    alignas(64) std::uint64_t acc[MR][NR];
+    const __m512i prog = _mm512_set1_epi64(static_cast<long long>(mod.prog));
+    __m512i s[MR][W];
+    for (int i = 0; i < MR; ++i) {
+        for (int w = 0; w < W; ++w) s[i][w] = _mm512_setzero_si512();
+    }
+    for (int p = 0; p < kc;) {
+        const int koniec = std::min(kc, p + mod.co_ile);
+        for (; p < koniec; ++p) {
+            const int* wb = bp + p * NR;
+            const int* wa = ap + p * MR;
+            __m512i b[W];
+            for (int w = 0; w < W; ++w) {
+                b[w] = _mm512_maskz_cvtepu32_epi64(0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(wb + w * SZER)));
+            }
+            for (int i = 0; i < MR; ++i) {
+                const __m512i a = _mm512_set1_epi64(static_cast<std::uint32_t>(wa[i]));
+                for (int w = 0; w < W; ++w) s[i][w] = _mm512_add_epi64(s[i][w], _mm512_maskz_mul_epu32(0xFF, a, b[w]));
+            }
+        }
+        for (int i = 0; i < MR; ++i) {
+            for (int w = 0; w < W; ++w) {
+                const __mmask8 wiekszy = _mm512_cmpge_epu64_mask(s[i][w], prog);
+                s[i][w] = _mm512_mask_sub_epi64(s[i][w], wiekszy, s[i][w], prog);
+            }
+        }
+    }
+    for (int i = 0; i < MR; ++i) {
+        for (int w = 0; w < W; ++w) _mm512_storeu_si512(&acc[i][w * SZER], s[i][w]);
+    }
+    zapisz_blok_modulo(acc, c, ldc, mr, nr, akumuluj, mod);
+}
+
+/**
+ * @brief Zawęża liczby int64 do int32 z nasyceniem (vpmovsqd).
+ */
+MACIERZ_CEL("avx512f")
+void zawez_nasycajaco_avx512(const std::int64_t* z, int* d, long long liczba) {
+    long long i = 0;
+    for (; i + 8 <= liczba; i += 8) {
+        const __m512i x = _mm512_loadu_si512(z + i);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm512_maskz_cvtsepi64_epi32(0xFF, x));
+    }
+    if (i < liczba) {
+        const __mmask8 maska = static_cast<__mmask8>((1u << (liczba - i)) - 1);
+        _mm512_mask_cvtsepi64_storeu_epi32(d + i, maska, _mm512_maskz_loadu_epi64(maska, z + i));
+    }
+}
+
+#endif // MACIERZ_X86
+
+/**
+ * @brief Zawęża liczby int64 do int32 z nasyceniem (wariant skalarny).
+ */
+void zawez_nasycajaco_skalarne(const std::int64_t* z, int* d, long long liczba) {
+    constexpr std::int64_t MIN = std::numeric_limits<int>::min(), MAX = std::numeric_limits<int>::max();
+    for (long long i = 0; i < liczba; ++i) d[i] = static_cast<int>(std::clamp(z[i], MIN, MAX));
+}
+
+/// Największa dopuszczalna suma modułów iloczynów jednego plastra k (2^62).
+constexpr std::uint64_t GRANICA_PLASTRA = std::uint64_t(1) << 62;
+
+/**
+ * @brief Zwraca największy moduł elementu macierzy @p w x @p k (0 dla
+ *        pustej); |INT32_MIN| = 2^31 jest reprezentowany dokładnie.
+ */
+std::uint64_t najwiekszy_modul(std::ptrdiff_t w, std::ptrdiff_t k, const std::int32_t* x, std::ptrdiff_t ld) {
+    std::uint64_t wynik = 0;
+    for (std::ptrdiff_t i = 0; i < w; ++i) {
+        const std::int32_t* r = x + i * ld;
+        std::uint32_t maks = 0;
+        for (std::ptrdiff_t p = 0; p < k; ++p) {
+            const std::uint32_t u = static_cast<std::uint32_t>(r[p]);
+            maks = std::max(maks, r[p] < 0 ? 0u - u : u);
+        }
+        wynik = std::max<std::uint64_t>(wynik, maks);
+    }
+    return wynik;
+}
+
+/**
+ * @brief Dodaje sumy plastra @p z (|z| <= 2^62) do akumulatorów
+ *        126-bitowych: wartość = @p nadmiar * 2^62 + @p reszta, gdzie
+ *        0 <= reszta < 2^62, więc dodawanie nigdy nie przepełnia int64.
+ */
+void dodaj_plaster(const std::int64_t* z, std::int64_t* reszta, std::int64_t* nadmiar, long long liczba) {
+    constexpr std::int64_t MASKA = (std::int64_t(1) << 62) - 1;
+    for (long long i = 0; i < liczba; ++i) {
+        const std::int64_t s = reszta[i] + z[i];
+        reszta[i] = s & MASKA;
+        nadmiar[i] += s >> 62;
+    }
+}
+
+/**
+ * @brief Zawęża akumulatory z @ref dodaj_plaster do int32 z nasyceniem.
+ */
+void zawez_akumulator(const std::int64_t* reszta, const std::int64_t* nadmiar, int* d, long long liczba) {
+    constexpr std::int64_t MIN = std::numeric_limits<int>::min(), MAX = std::numeric_limits<int>::max();
+    for (long long i = 0; i < liczba; ++i) {
+        if (nadmiar[i] > 0) d[i] = static_cast<int>(MAX);
+        else if (nadmiar[i] < -1) d[i] = static_cast<int>(MIN);
+        else {
+            // nadmiar 0 lub -1: wartość mieści się w [-2^62, 2^62)
+            const std::int64_t x = nadmiar[i] == 0 ? reszta[i] : reszta[i] - (std::int64_t(1) << 62);
+            d[i] = static_cast<int>(std::clamp(x, MIN, MAX));
+        }
+    }
+}
+
+/**
+ * @brief Wybiera mikrojądro mnożenia modulo p (raz).
+ */
+mikrojadro_modularne_t mikrojadro_modularne() {
+    static const mikrojadro_modularne_t wybrane = [] {
+#ifdef MACIERZ_X86
+        const cpu_info& cpu = procesor();
+        if (cpu.avx512f) return mikrojadro_modularne_t(mikrojadro_modularne_avx512);
+        if (cpu.avx2) return mikrojadro_modularne_t(mikrojadro_modularne_avx2);
+#endif
+        return mikrojadro_modularne_t(mikrojadro_modularne_skalarne);
+    }();
+    return wybrane;
+}
+
+/**
+ * @brief Wybiera wariant zawężania z nasyceniem (raz).
+ */
+auto zawez_nasycajaco() {
+    using zawezanie_t = void (*)(const std::int64_t*, int*, long long);
+    static const zawezanie_t wybrane = [] {
+#ifdef MACIERZ_X86
+        if (procesor().avx512f) return zawezanie_t(zawez_nasycajaco_avx512);
+#endif
+        return zawezanie_t(zawez_nasycajaco_skalarne);
+    }();
+    return wybrane;
+}
+
+/**
+ * @brief Prosta pętla i-p-j mnożenia modulo p dla małych macierzy.
+ *
+ * Wiersz wyniku jest akumulowany w 64-bitowym buforze wątku z redukcją
+ * leniwą co @c mod.co_ile wartości p.
+ */
+void gemm_maly_modularny(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                         const int* a, std::ptrdiff_t lda,
+                         const int* b, std::ptrdiff_t ldb,
+                         int* c, std::ptrdiff_t ldc,
+                         bool akumuluj, const modul& mod) {
+    auto* acc = static_cast<std::uint64_t*>(bufor_watku(static_cast<size_t>(n) * sizeof(std::uint64_t)));
+    for (std::ptrdiff_t i = 0; i < m; ++i) {
+        std::fill(acc, acc + n, std::uint64_t(0));
+        const int* wa = a + i * lda;
+        for (std::ptrdiff_t p = 0; p < k;) {
+            const std::ptrdiff_t koniec = std::min<std::ptrdiff_t>(k, p + mod.co_ile);
+            for (; p < koniec; ++p) {
+                const std::uint64_t aip = static_cast<std::uint32_t>(wa[p]);
+                const int* wb = b + p * ldb;
+                for (std::ptrdiff_t j = 0; j < n; ++j) acc[j] += aip * static_cast<std::uint32_t>(wb[j]);
+            }
+            for (std::ptrdiff_t j = 0; j < n; ++j) acc[j] -= acc[j] >= mod.prog ? mod.prog : 0;
+        }
+        int* wc = c + i * ldc;
+        for (std::ptrdiff_t j = 0; j < n; ++j) {
+            std::uint64_t r = redukuj(acc[j], mod);
+            if (akumuluj) {
+                r += static_cast<std::uint32_t>(wc[j]);
+                if (r >= mod.p) r -= mod.p;
+            }
+            wc[j] = static_cast<int>(r);
+        }
+    }
+}
+
+/**
+ * @brief Algorytm blokowy z pakowaniem paneli (pętle jc - pc - ic - jr - ir).
+ *
+ * Dla każdej pary (jc, pc) blok B jest pakowany równolegle (po panelach NR),
+ * a następnie wynik jest dzielony na kafelki (blok wierszy ic x zakres kolumn),
+ * które wątki puli liczą niezależnie, każdy z własnym spakowanym blokiem A.
+ * Blok MR x NR wyniku liczy @p jadro (wywoływane jak @ref mikrojadro_t), więc
+ * ten sam schemat obsługuje mnożenie z szerokim akumulatorem i modulo p.
+ */
+template <typename T, typename C, typename J>
+void gemm_blokowy(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                  const T* a, std::ptrdiff_t lda,
+                  const T* b, std::ptrdiff_t ldb,
+                  C* c, std::ptrdiff_t ldc,
+                  bool akumuluj, J jadro) {
+    using P = typename cechy<T>::pak;
+    constexpr int KROK = cechy<T>::KROK;
+    const parametry_gemm par = parametry(static_cast<int>(sizeof(P)));
+    const int mc_max = static_cast<int>(std::min<std::ptrdiff_t>(par.mc, (m + MR - 1) / MR * MR));
+    const int kc_max = static_cast<int>(std::min<std::ptrdiff_t>(par.kc, (k + KROK - 1) / KROK * KROK));
+    const int nc_max = static_cast<int>(std::min<std::ptrdiff_t>(par.nc, (n + NR - 1) / NR * NR));
+
+    pozyczony_bufor bufor_b(static_cast<size_t>(kc_max) * nc_max * sizeof(P));
+    P* const pb = static_cast<P*>(bufor_b.get());
+
+    for (std::ptrdiff_t jc = 0; jc < n; jc += par.nc) {
+        const int nc = static_cast<int>(std::min<std::ptrdiff_t>(par.nc, n - jc));
+        const int paneli_b = (nc + NR - 1) / NR;
+
+        // Podział wyniku na kafelki: bloki wierszy po mc oraz zakresy paneli B,
+        // tak aby każdy wątek dostał kilka kafelków do wykonania.
+        const long long blokow_m = (m + par.mc - 1) / par.mc;
+        const long long cel = 4 * liczba_watkow();
+        const int blokow_n = static_cast<int>(std::clamp<long long>((cel + blokow_m - 1) / blokow_m, 1, paneli_b));
+        const int paneli_na_kafelek = (paneli_b + blokow_n - 1) / blokow_n;
+        const int kafelkow_n = (paneli_b + paneli_na_kafelek - 1) / paneli_na_kafelek;
+
+        for (std::ptrdiff_t pc = 0; pc < k; pc += par.kc) {
+            const int kc = static_cast<int>(std::min<std::ptrdiff_t>(par.kc, k - pc));
+            const int kc_pelne = (kc + KROK - 1) / KROK * KROK;
+            const bool dodaj = akumuluj || pc > 0;
+            const T* blok_b = b + pc * ldb + jc;
+
+            rownolegle_dla(0, paneli_b, 16, [&](long long p0, long long p1) {
+                for (long long p = p0; p < p1; ++p) {
+                    const int jr = static_cast<int>(p) * NR;
+                    pakuj_b(kc, std::min(NR, nc - jr), blok_b + jr, ldb,
+                            pb + static_cast<long long>(jr) * kc_pelne);
+                }
+            });
+
+            rownolegle_dla(0, blokow_m * kafelkow_n, 1, [&](long long t0, long long t1) {
+                P* bufor_a = static_cast<P*>(bufor_watku(static_cast<size_t>(mc_max) * kc_max * sizeof(P)));
+                for (long long t = t0; t < t1; ++t) {
+                    const std::ptrdiff_t ic = t / kafelkow_n * par.mc;
+                    const int mc = static_cast<int>(std::min<std::ptrdiff_t>(par.mc, m - ic));
+                    const int jr_od = static_cast<int>(t % kafelkow_n) * paneli_na_kafelek * NR;
+                    const int jr_do = std::min(nc, jr_od + paneli_na_kafelek * NR);
+                    pakuj_a(mc, kc, a + ic * lda + pc, lda, bufor_a);
+
+                    for (int jr = jr_od; jr < jr_do; jr += NR) {
+                        const int nr = std::min(NR, nc - jr);
+                        const P* bp = pb + static_cast<long long>(jr) * kc_pelne;
+                        for (int ir = 0; ir < mc; ir += MR) {
+                            const int mr = std::min(MR, mc - ir);
+                            const P* ap = bufor_a + static_cast<long long>(ir) * kc_pelne;
+                            C* blok_c = c + (ic + ir) * ldc + jc + jr;
+                            jadro(kc_pelne, ap, bp, blok_c, ldc, mr, nr, dodaj);
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+/**
+ * @brief Mnożenie liczb int32 z inną niż zawijająca arytmetyką wyniku.
+ *
+ * Wybór wariantu jak w @ref gemm_klasyczny (bez osobnych jąder gemv/gevm):
+ * małe zadania i wąskie B liczy @p maly (pasy wierszy równolegle),
+ * pozostałe – algorytm blokowy z mikrojądrem @p jadro.
+ */
+template <typename C, typename M, typename J>
+void gemm_z_arytmetyka(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                       const int* a, std::ptrdiff_t lda,
+                       const int* b, std::ptrdiff_t ldb,
+                       C* c, std::ptrdiff_t ldc,
+                       bool akumuluj, M maly, J jadro) {
+    if (m <= 0 || n <= 0) return;
+    if (k <= 0) {
+        if (!akumuluj) {
+            for (std::ptrdiff_t i = 0; i < m; ++i) std::fill(c + i * ldc, c + i * ldc + n, C(0));
+        }
+        return;
+    }
+
+    if (m * n <= (PROG_MALEJ - 1) / k) {
+        maly(m, n, k, a, lda, b, ldb, c, ldc, akumuluj);
+    }
+    else if (n < NR) {
+        const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / (static_cast<long long>(n) * k));
+        rownolegle_dla(0, m, ziarno, [=](long long i0, long long i1) {
+            maly(i1 - i0, n, k, a + i0 * lda, lda, b, ldb, c + i0 * ldc, ldc, akumuluj);
+        });
+    }
+    else {
+        gemm_blokowy(m, n, k, a, lda, b, ldb, c, ldc, akumuluj, jadro);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca rozmiary bloków dla elementów o rozmiarze @p rozmiar_elementu
+ *        (wyznaczane raz dla każdego rozmiaru).
+ *
+ * @param rozmiar_elementu Rozmiar elementu spakowanych paneli (w bajtach).
+ * @return Parametry.
+ */
+parametry_gemm parametry(int rozmiar_elementu) {
+    static const parametry_gemm par[4] = { wyznacz_parametry(1), wyznacz_parametry(2),
+                                           wyznacz_parametry(4), wyznacz_parametry(8) };
+    switch (rozmiar_elementu) {
+    case 1: return par[0];
+    case 2: return par[1];
+    case 4: return par[2];
+    case 8: return par[3];
+    default: return wyznacz_parametry(rozmiar_elementu);
+    }
+}
+
+/**
+ * @brief Iloczyn macierz-wektor: y = A * x lub y += A * x.
+ *
+ * Każdy element y to iloczyn skalarny wiersza A z wektorem x; wiersze są
+ * dzielone między wątki. Wektor x z odstępem różnym od 1 jest najpierw
+ * kopiowany do ciągłej tablicy.
+ */
+template <typename T>
+void gemv(std::ptrdiff_t m, std::ptrdiff_t k,
+          const T* a, std::ptrdiff_t lda,
+          const T* x, std::ptrdiff_t incx,
+          iloczyn_t<T>* y, std::ptrdiff_t incy,
+          bool akumuluj) {
+    if (m <= 0) return;
+    std::vector<T> kopia_x;
+    if (incx != 1 && k > 0) {
+        kopia_x.resize(static_cast<size_t>(k));
+        for (std::ptrdiff_t p = 0; p < k; ++p) kopia_x[p] = x[p * incx];
+        x = kopia_x.data();
+    }
+    const auto iloczyn_skalarny = wektorowe<T>().iloczyn_skalarny;
+    const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / std::max<long long>(k, 1));
+    rownolegle_dla(0, m, ziarno, [=](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const iloczyn_t<T> s = k > 0 ? iloczyn_skalarny(a + i * lda, x, k) : iloczyn_t<T>(0);
+            iloczyn_t<T>& yi = y[i * incy];
+            yi = akumuluj ? dodaj_iloczyn(yi, s, iloczyn_t<T>(1)) : s;
+        }
+    });
+}
+
+/**
+ * @brief Iloczyn wektor-macierz: y = x * B lub y += x * B.
+ *
+ * y jest sumą wierszy B ważonych elementami x. Kolumny są dzielone między
+ * wątki, a w obrębie wątku przetwarzane blokami po @c BLOK_GEVM, by
+ * fragment y pozostawał w L1 podczas przechodzenia po wierszach B.
+ */
+template <typename T>
+void gevm(std::ptrdiff_t k, std::ptrdiff_t n,
+          const T* x, std::ptrdiff_t incx,
+          const T* b, std::ptrdiff_t ldb,
+          iloczyn_t<T>* y,
+          bool akumuluj) {
+    if (n <= 0) return;
+    const auto dodaj_wielokrotnosc = wektorowe<T>().dodaj_wielokrotnosc;
+    const long long ziarno = std::max(256LL, PROG_ROWNOLEGLY / std::max<long long>(k, 1));
+    rownolegle_dla(0, n, ziarno, [=](long long j0, long long j1) {
+        for (long long jb = j0; jb < j1; jb += BLOK_GEVM) {
+            const int dl = static_cast<int>(std::min<long long>(BLOK_GEVM, j1 - jb));
+            if (!akumuluj) std::fill(y + jb, y + jb + dl, iloczyn_t<T>(0));
+            for (std::ptrdiff_t p = 0; p < k; ++p) {
+                const iloczyn_t<T> xp = x[p * incx];
+                if (xp != 0) dodaj_wielokrotnosc(y + jb, b + p * ldb + jb, dl, xp);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Mnożenie macierzy algorytmem klasycznym: C = A * B lub C += A * B.
+ *
+ * Wybiera wariant algorytmu na podstawie kształtu i rozmiaru zadania:
+ * - n == 1 – @ref gemv, m == 1 – @ref gevm,
+ * - małe zadania – prosta pętla,
+ * - wąskie B (n < NR) – prosta pętla na pasach wierszy, równolegle
+ *   (pakowanie do paneli po NR kolumn marnowałoby pracę),
+ * - pozostałe – algorytm blokowy z pakowaniem.
+ */
+template <typename T>
+void gemm_klasyczny(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                    const T* a, std::ptrdiff_t lda,
+                    const T* b, std::ptrdiff_t ldb,
+                    iloczyn_t<T>* c, std::ptrdiff_t ldc,
+                    bool akumuluj) {
+    if (m <= 0 || n <= 0) return;
+    if (k <= 0) {
+        if (!akumuluj) {
+            for (std::ptrdiff_t i = 0; i < m; ++i) {
+                std::fill(c + i * ldc, c + i * ldc + n, iloczyn_t<T>(0));
+            }
+        }
+        return;
+    }
+
+    if (n == 1) {
+        gemv(m, k, a, lda, b, ldb, c, ldc, akumuluj);
+    }
+    else if (m == 1) {
+        gevm(k, n, a, 1, b, ldb, c, akumuluj);
+    }
+    else if (m * n <= (PROG_MALEJ - 1) / k) {
+        gemm_maly(m, n, k, a, lda, b, ldb, c, ldc, akumuluj);
+    }
+    else if (n < NR) {
+        const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / (static_cast<long long>(n) * k));
+        rownolegle_dla(0, m, ziarno, [=](long long i0, long long i1) {
+            gemm_maly(i1 - i0, n, k, a + i0 * lda, lda, b, ldb, c + i0 * ldc, ldc, akumuluj);
+        });
+    }
+    else {
+        gemm_blokowy(m, n, k, a, lda, b, ldb, c, ldc, akumuluj, mikrojadro<T>().f);
+    }
+}
+
+/**
+ * @brief Mnożenie macierzy: C = A * B lub C += A * B.
+ *
+ * Nadpisywanie C przez duże iloczyny może trafić do algorytmu Strassena
+ * (zob. @ref uzyj_strassena); pozostałe przypadki liczy
+ * @ref gemm_klasyczny.
+ */
+template <typename T>
+void gemm(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+          const T* a, std::ptrdiff_t lda,
+          const T* b, std::ptrdiff_t ldb,
+          iloczyn_t<T>* c, std::ptrdiff_t ldc,
+          bool akumuluj) {
+    if constexpr (std::is_same_v<iloczyn_t<T>, T>) {
+        if (!akumuluj && uzyj_strassena<T>(m, n, k)) {
+            strassen(m, n, k, a, lda, b, ldb, c, ldc);
+            return;
+        }
+    }
+    gemm_klasyczny(m, n, k, a, lda, b, ldb, c, ldc, akumuluj);
+}
+
+/**
+ * @brief Mnożenie liczb int32 z 64-bitowym akumulatorem i wynikiem.
+ *
+ * Mikrojądra (AVX-512 / AVX2) rozszerzają panel B do 64 bitów przy
+ * ładowaniu i mnożą instrukcją vpmuldq; liczą o połowę mniej wyników na
+ * rejestr niż jądro int32.
+ */
+void gemm_szeroki(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                  const std::int32_t* a, std::ptrdiff_t lda,
+                  const std::int32_t* b, std::ptrdiff_t ldb,
+                  std::int64_t* c, std::ptrdiff_t ldc,
+                  bool akumuluj) {
+    const auto maly = [](auto... argumenty) { gemm_maly(argumenty...); };
+    gemm_z_arytmetyka(m, n, k, a, lda, b, ldb, c, ldc, akumuluj, maly, mikrojadro_szerokie());
+}
+
+/**
+ * @brief Mnożenie liczb int32 z wynikiem zawężonym do int32 z nasyceniem.
+ *
+ * Bloki wyniku (pasy wierszy, a dla bardzo szerokich macierzy także
+ * kolumn) są liczone przez @ref gemm_szeroki do bufora tymczasowego
+ * (najwyżej 2^22 elementów), a następnie zawężane
+ * instrukcją vpmovsqd (AVX-512) lub pętlą skalarną.
+ *
+ * Jeśli suma k iloczynów może nie zmieścić się w int64 (k * max|a| *
+ * max|b| > 2^62), wymiar k jest dzielony na plastry, których sumy się
+ * mieszczą, a sumy plastrów są dodawane do akumulatora 126-bitowego
+ * (@ref dodaj_plaster) i zawężane na końcu (@ref zawez_akumulator).
+ */
+void gemm_nasycajacy(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                     const std::int32_t* a, std::ptrdiff_t lda,
+                     const std::int32_t* b, std::ptrdiff_t ldb,
+                     std::int32_t* c, std::ptrdiff_t ldc) {
+    if (m <= 0 || n <= 0) return;
+    const std::uint64_t iloczyn_max = najwiekszy_modul(m, k, a, lda) * najwiekszy_modul(k, n, b, ldb);
+    const std::ptrdiff_t plaster =
+        iloczyn_max == 0 ? k : static_cast<std::ptrdiff_t>(std::min<std::uint64_t>(
+                                   static_cast<std::uint64_t>(std::max<std::ptrdiff_t>(k, 1)),
+                                   std::max<std::uint64_t>(1, GRANICA_PLASTRA / iloczyn_max)));
+
+    // blok pas x szer wyniku mieści się w buforze 2^22 elementów; pas ma
+    // co najmniej 256 wierszy, więc bardzo szerokie macierze dzielimy też po n
+    constexpr std::ptrdiff_t BUFOR = std::ptrdiff_t(1) << 22;
+    const std::ptrdiff_t szer = std::min<std::ptrdiff_t>(n, BUFOR / 256);
+    const std::ptrdiff_t pas = std::min(m, BUFOR / szer);
+    std::vector<std::int64_t> bufor(static_cast<size_t>(pas * szer));
+    const auto zawez = zawez_nasycajaco();
+    if (plaster >= k) {
+        for (std::ptrdiff_t j0 = 0; j0 < n; j0 += szer) {
+            const std::ptrdiff_t kolumn = std::min(szer, n - j0);
+            const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / static_cast<long long>(kolumn));
+            for (std::ptrdiff_t i0 = 0; i0 < m; i0 += pas) {
+                const std::ptrdiff_t wierszy = std::min(pas, m - i0);
+                gemm_szeroki(wierszy, kolumn, k, a + i0 * lda, lda, b + j0, ldb, bufor.data(), kolumn);
+                rownolegle_dla(0, wierszy, ziarno, [&](long long r0, long long r1) {
+                    for (long long r = r0; r < r1; ++r) zawez(bufor.data() + r * kolumn, c + (i0 + r) * ldc + j0, kolumn);
+                });
+            }
+        }
+        return;
+    }
+
+    std::vector<std::int64_t> reszta(bufor.size()), nadmiar(bufor.size());
+    for (std::ptrdiff_t j0 = 0; j0 < n; j0 += szer) {
+        const std::ptrdiff_t kolumn = std::min(szer, n - j0);
+        const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / static_cast<long long>(kolumn));
+        for (std::ptrdiff_t i0 = 0; i0 < m; i0 += pas) {
+            const std::ptrdiff_t wierszy = std::min(pas, m - i0);
+            std::fill(reszta.begin(), reszta.end(), 0);
+            std::fill(nadmiar.begin(), nadmiar.end(), 0);
+            for (std::ptrdiff_t p0 = 0; p0 < k; p0 += plaster) {
+                const std::ptrdiff_t kc = std::min(plaster, k - p0);
+                gemm_szeroki(wierszy, kolumn, kc, a + i0 * lda + p0, lda, b + p0 * ldb + j0, ldb, bufor.data(), kolumn);
+                rownolegle_dla(0, wierszy, ziarno, [&](long long r0, long long r1) {
+                    dodaj_plaster(bufor.data() + r0 * kolumn, reszta.data() + r0 * kolumn, nadmiar.data() + r0 * kolumn,
+                                  (r1 - r0) * kolumn);
+                });
+            }
+            rownolegle_dla(0, wierszy, ziarno, [&](long long r0, long long r1) {
+                for (long long r = r0; r < r1; ++r) {
+                    zawez_akumulator(reszta.data() + r * kolumn, nadmiar.data() + r * kolumn, c + (i0 + r) * ldc + j0,
+                                     kolumn);
+                }
+            });
+        }
+    }
+}
+
+/**
+ * @brief Mnożenie modulo p z redukcją leniwą w mikrojądrze
+ *        (zob. @ref modul) i redukcją Barretta przy zapisie bloku.
+ */
+void gemm_modularny(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                    const std::int32_t* a, std::ptrdiff_t lda,
+                    const std::int32_t* b, std::ptrdiff_t ldb,
+                    std::int32_t* c, std::ptrdiff_t ldc,
+                    std::int32_t p, bool akumuluj) {
+    const modul mod = przygotuj_modul(p);
+    const mikrojadro_modularne_t f = mikrojadro_modularne();
+    const auto maly = [&mod](std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k, const int* a, std::ptrdiff_t lda,
+                             const int* b, std::ptrdiff_t ldb, int* c, std::ptrdiff_t ldc, bool akumuluj) {
+        gemm_maly_modularny(m, n, k, a, lda, b, ldb, c, ldc, akumuluj, mod);
+    };
+    const auto jadro = [&mod, f](int kc, const int* ap, const int* bp, int* c, long long ldc, int mr, int nr,
+                                 bool akumuluj) { f(kc, ap, bp, c, ldc, mr, nr, akumuluj, mod); };
+    gemm_z_arytmetyka(m, n, k, a, lda, b, ldb, c, ldc, akumuluj, maly, jadro);
+}
+
+/**
+ * @brief Zwraca nazwę wariantu mikrojądra wybranego dla typu @p T.
+ */
+template <typename T>
+const char* wariant_gemm() {
+    return mikrojadro<T>().nazwa;
+}
+
+#define MACIERZ_INSTANCJA_GEMM(T)                                                                             \
+    template void gemm<T>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t, const T*, std::ptrdiff_t,           \
+                          const T*, std::ptrdiff_t, iloczyn_t<T>*, std::ptrdiff_t, bool);                     \
+    template void gemm_klasyczny<T>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t, const T*, std::ptrdiff_t, \
+                                    const T*, std::ptrdiff_t, iloczyn_t<T>*, std::ptrdiff_t, bool);           \
+    template void gemv<T>(std::ptrdiff_t, std::ptrdiff_t, const T*, std::ptrdiff_t, const T*, std::ptrdiff_t, \
+                          iloczyn_t<T>*, std::ptrdiff_t, bool);                                               \
+    template void gevm<T>(std::ptrdiff_t, std::ptrdiff_t, const T*, std::ptrdiff_t, const T*, std::ptrdiff_t, \
+                          iloczyn_t<T>*, bool);                                                               \
+    template const char* wariant_gemm<T>();
+
+MACIERZ_INSTANCJA_GEMM(std::int8_t)
+MACIERZ_INSTANCJA_GEMM(std::int16_t)
+MACIERZ_INSTANCJA_GEMM(std::int32_t)
+MACIERZ_INSTANCJA_GEMM(std::int64_t)
+MACIERZ_INSTANCJA_GEMM(float)
+MACIERZ_INSTANCJA_GEMM(double)
+
+#undef MACIERZ_INSTANCJA_GEMM
+
+} // namespace jadra
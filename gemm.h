@@ -0,0 +1,248 @@
+#pragma once
+
+/**
+ * @file gemm.h
+ * @brief Silnik mnożenia macierzy (GEMM) używany przez @ref matrix.
+ *
+ * Dla małych macierzy stosowana jest prosta pętla i-p-j na surowych
+ * wskaźnikach. Dla większych – algorytm blokowy: fragmenty A i B są
+ * pakowane do ciągłych paneli, rozmiary bloków są dobierane do pamięci
+ * podręcznej L1/L2/L3, a najgłębsza pętla to mikrojądro liczące w rejestrach
+ * blok @ref jadra::MR x @ref jadra::NR wyniku.
+ *
+ * Duże iloczyny macierzy całkowitoliczbowych są domyślnie liczone
+ * algorytmem Strassena-Winograda (zob. strassen.h), którego rekurencja
+ * kończy się na algorytmie blokowym.
+ *
+ * Iloczyny macierz-wektor i wektor-macierz mają osobne jądra
+ * (@ref jadra::gemv, @ref jadra::gevm), ograniczone przepustowością pamięci
+ * zamiast mocy obliczeniowej.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace jadra {
+
+/// Liczba wierszy bloku wyniku liczonego przez mikrojądro.
+constexpr int MR = 4;
+
+/// Liczba kolumn bloku wyniku liczonego przez mikrojądro.
+constexpr int NR = 32;
+
+/**
+ * @struct typ_iloczynu
+ * @brief Typ elementów wyniku mnożenia macierzy o elementach @p T.
+ *
+ * Iloczyny macierzy 8- i 16-bitowych są akumulowane i zwracane jako
+ * 32-bitowe; dla pozostałych typów wynik ma typ argumentów.
+ */
+template <typename T>
+struct typ_iloczynu {
+    using typ = T;
+};
+
+template <>
+struct typ_iloczynu<std::int8_t> {
+    using typ = std::int32_t;
+};
+
+template <>
+struct typ_iloczynu<std::int16_t> {
+    using typ = std::int32_t;
+};
+
+/// Skrót: typ elementów wyniku mnożenia macierzy o elementach @p T.
+template <typename T>
+using iloczyn_t = typename typ_iloczynu<T>::typ;
+
+/**
+ * @brief Zwraca @p a + @p b * @p c; dla typów całkowitych modulo 2^N,
+ *        jak w mikrojądrach wektorowych (bez przepełnienia typu ze znakiem).
+ *
+ * Wspólne dla wszystkich jąder mnożących, dzięki czemu iloczyny gęste,
+ * rzadkie, strukturalne i wsadowe dają te same bity także po przepełnieniu.
+ */
+template <typename W>
+inline W dodaj_iloczyn(W a, W b, W c) {
+    if constexpr (std::is_integral_v<W>) {
+        // Typy węższe od int byłyby promowane do int – liczymy co najmniej na unsigned.
+        using U = std::common_type_t<std::make_unsigned_t<W>, unsigned>;
+        return static_cast<W>(static_cast<U>(a) + static_cast<U>(b) * static_cast<U>(c));
+    } else {
+        return a + b * c;
+    }
+}
+
+/**
+ * @struct parametry_gemm
+ * @brief Rozmiary bloków algorytmu blokowego.
+ */
+struct parametry_gemm {
+    int mc; ///< Liczba wierszy bloku A (blok A ma zmieścić się w L2).
+    int kc; ///< Głębokość bloku (panel B kc x NR ma zmieścić się w L1).
+    int nc; ///< Liczba kolumn bloku B (blok kc x nc ma zmieścić się w L3).
+};
+
+/**
+ * @brief Zwraca rozmiary bloków dobrane do pamięci podręcznej procesora.
+ *
+ * @param rozmiar_elementu Rozmiar (w bajtach) elementu spakowanych paneli.
+ * @return Wyznaczone parametry.
+ */
+parametry_gemm parametry(int rozmiar_elementu = static_cast<int>(sizeof(int)));
+
+/**
+ * @brief Mnożenie macierzy: C = A * B lub C += A * B.
+ *
+ * Macierze są przechowywane wierszami; @p lda, @p ldb, @p ldc to odległości
+ * (w elementach) między początkami kolejnych wierszy.
+ * Bufor @p c nie może nachodzić na @p a ani @p b.
+ *
+ * Wersje dostępne dla @c int8_t, @c int16_t, @c int32_t, @c int64_t,
+ * @c float i @c double. Mikrojądra:
+ * - int32 – AVX2 / AVX-512 (vpmulld),
+ * - int8 / int16 – pary elementów mnożone przez vpmaddwd (AVX2, AVX-512BW)
+ *   lub vpdpwssd (AVX-512 VNNI) z akumulacją 32-bitową,
+ * - float / double – FMA (AVX2 + FMA3, AVX-512),
+ * - int64 – wariant skalarny.
+ *
+ * Jeśli C jest nadpisywana, a wymiary są dostatecznie duże, mnożenie
+ * wykonuje @ref strassen (zob. @ref uzyj_strassena, @ref ustaw_algorytm_mnozenia).
+ *
+ * @tparam T Typ elementów A i B.
+ * @param m Liczba wierszy A i C.
+ * @param n Liczba kolumn B i C.
+ * @param k Liczba kolumn A i wierszy B.
+ * @param a Dane macierzy A (m x k).
+ * @param lda Odległość między wierszami A.
+ * @param b Dane macierzy B (k x n).
+ * @param ldb Odległość między wierszami B.
+ * @param c Dane macierzy wynikowej C (m x n).
+ * @param ldc Odległość między wierszami C.
+ * @param akumuluj Jeśli true, wynik jest dodawany do C; w przeciwnym razie C
+ *        jest nadpisywana (jej poprzednia zawartość nie jest czytana).
+ */
+template <typename T>
+void gemm(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+          const T* a, std::ptrdiff_t lda,
+          const T* b, std::ptrdiff_t ldb,
+          iloczyn_t<T>* c, std::ptrdiff_t ldc,
+          bool akumuluj = false);
+
+/**
+ * @brief Mnożenie macierzy zawsze algorytmem klasycznym (bez Strassena).
+ *
+ * Parametry i wymagania jak w @ref gemm.
+ */
+template <typename T>
+void gemm_klasyczny(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                    const T* a, std::ptrdiff_t lda,
+                    const T* b, std::ptrdiff_t ldb,
+                    iloczyn_t<T>* c, std::ptrdiff_t ldc,
+                    bool akumuluj = false);
+
+/**
+ * @brief Iloczyn macierz-wektor: y = A * x lub y += A * x.
+ *
+ * @tparam T Typ elementów A i x.
+ * @param m Liczba wierszy A (długość y).
+ * @param k Liczba kolumn A (długość x).
+ * @param a Dane macierzy A (m x k).
+ * @param lda Odległość między wierszami A.
+ * @param x Wektor x.
+ * @param incx Odległość między kolejnymi elementami x.
+ * @param y Wektor wynikowy y (nie może nachodzić na @p a ani @p x).
+ * @param incy Odległość między kolejnymi elementami y.
+ * @param akumuluj Jeśli true, wynik jest dodawany do y.
+ */
+template <typename T>
+void gemv(std::ptrdiff_t m, std::ptrdiff_t k,
+          const T* a, std::ptrdiff_t lda,
+          const T* x, std::ptrdiff_t incx,
+          iloczyn_t<T>* y, std::ptrdiff_t incy,
+          bool akumuluj = false);
+
+/**
+ * @brief Iloczyn wektor-macierz: y = x * B lub y += x * B.
+ *
+ * @tparam T Typ elementów x i B.
+ * @param k Liczba wierszy B (długość x).
+ * @param n Liczba kolumn B (długość y, elementy y leżą obok siebie).
+ * @param x Wektor x.
+ * @param incx Odległość między kolejnymi elementami x.
+ * @param b Dane macierzy B (k x n).
+ * @param ldb Odległość między wierszami B.
+ * @param y Wektor wynikowy y (nie może nachodzić na @p x ani @p b).
+ * @param akumuluj Jeśli true, wynik jest dodawany do y.
+ */
+template <typename T>
+void gevm(std::ptrdiff_t k, std::ptrdiff_t n,
+          const T* x, std::ptrdiff_t incx,
+          const T* b, std::ptrdiff_t ldb,
+          iloczyn_t<T>* y,
+          bool akumuluj = false);
+
+/**
+ * @name Mnożenie liczb int32 bez zawijania wyniku
+ *
+ * Parametry @p m, @p n, @p k, @p a, @p lda, @p b, @p ldb, @p c, @p ldc
+ * i @p akumuluj – jak w @ref gemm. Czas działania jest zbliżony do
+ * zwykłego mnożenia int32: ten sam algorytm blokowy, inne mikrojądra.
+ * @{
+ */
+
+/**
+ * @brief C = A * B lub C += A * B z akumulatorem i wynikiem 64-bitowym.
+ *
+ * Wynik jest dokładny, dopóki sumy częściowe mieszczą się w @c int64_t
+ * (np. dla |a|, |b| < 2^24 i k < 2^15).
+ */
+void gemm_szeroki(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                  const std::int32_t* a, std::ptrdiff_t lda,
+                  const std::int32_t* b, std::ptrdiff_t ldb,
+                  std::int64_t* c, std::ptrdiff_t ldc,
+                  bool akumuluj = false);
+
+/**
+ * @brief C = A * B z nasyceniem: elementy wyniku spoza zakresu @c int32_t
+ *        są zastępowane przez INT32_MIN lub INT32_MAX.
+ *
+ * Nasycana jest dokładna suma iloczynów, a nie kolejne sumy częściowe,
+ * więc wynik nie zależy od kolejności dodawania i jest poprawny dla
+ * wszystkich wartości int32 i każdego k. Gdy suma może nie zmieścić się
+ * w @c int64_t, jest liczona plastrami k w akumulatorze szerszym niż 64
+ * bity (wolniej, proporcjonalnie do liczby plastrów).
+ */
+void gemm_nasycajacy(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                     const std::int32_t* a, std::ptrdiff_t lda,
+                     const std::int32_t* b, std::ptrdiff_t ldb,
+                     std::int32_t* c, std::ptrdiff_t ldc);
+
+/**
+ * @brief C = A * B lub C += A * B modulo @p p.
+ *
+ * Elementy A i B (oraz C przy akumulacji) muszą należeć do [0, p);
+ * wynik też należy do [0, p). Iloczyny są akumulowane w 64 bitach
+ * i redukowane leniwie (co kilka kroków pętli k, tym rzadziej, im
+ * mniejszy moduł), a dokładna reszta jest liczona raz na blok wyniku.
+ *
+ * @param p Moduł, 2 <= p < 2^31.
+ */
+void gemm_modularny(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                    const std::int32_t* a, std::ptrdiff_t lda,
+                    const std::int32_t* b, std::ptrdiff_t ldb,
+                    std::int32_t* c, std::ptrdiff_t ldc,
+                    std::int32_t p, bool akumuluj = false);
+
+/** @} */
+
+/**
+ * @brief Zwraca nazwę wariantu mikrojądra wybranego dla typu @p T
+ *        ("avx512vnni", "avx512", "avx2" lub "skalarny").
+ */
+template <typename T>
+const char* wariant_gemm();
+
+} // namespace jadra
@@ -0,0 +1,415 @@
+#include "losowanie.h"
+#include "cpu.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef MACIERZ_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Philox4x32-10
+//
+// Runda: (x0, x1, x2, x3) -> (hi(M1*x2) ^ x1 ^ k0, lo(M1*x2),
+//                             hi(M0*x0) ^ x3 ^ k1, lo(M0*x0)),
+// przed każdą rundą poza pierwszą klucz (k0, k1) rośnie o (W0, W1).
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+constexpr int PHILOX_RUNDY = 10;
+
+/// Liczba elementów losowanych naraz przez jeden wątek (bufory na stosie).
+constexpr long long PORCJA_LOSOWANIA = 1024;
+
+/**
+ * @brief Zwraca blok Philox4x32-10 dla licznika (x0, x1, x2, x3) i klucza
+ *        (k0, k1).
+ */
+inline array<uint32_t, 4> philox_runda(uint32_t x0, uint32_t x1, uint32_t x2, uint32_t x3, uint32_t k0,
+                                       uint32_t k1) noexcept {
+    for (int r = 0; r < PHILOX_RUNDY; ++r) {
+        if (r > 0) {
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        const uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * x0;
+        const uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * x2;
+        x0 = static_cast<uint32_t>(p1 >> 32) ^ x1 ^ k0;
+        x1 = static_cast<uint32_t>(p1);
+        x2 = static_cast<uint32_t>(p0 >> 32) ^ x3 ^ k1;
+        x3 = static_cast<uint32_t>(p0);
+    }
+    return { x0, x1, x2, x3 };
+}
+
+/**
+ * @brief Typ jądra zapisującego do @p w 2 * @p blokow słów 64-bitowych:
+ *        bloki @p pierwszy .. @p pierwszy + @p blokow - 1 strumienia 0.
+ */
+using generator_blokow_t = void (*)(uint64_t* w, uint64_t pierwszy, long long blokow, uint64_t ziarno);
+
+void generuj_bloki_skalarnie(uint64_t* w, uint64_t pierwszy, long long blokow, uint64_t ziarno) {
+    for (long long b = 0; b < blokow; ++b) {
+        const uint64_t c = pierwszy + static_cast<uint64_t>(b);
+        const array<uint32_t, 4> x = philox_runda(static_cast<uint32_t>(c), static_cast<uint32_t>(c >> 32), 0, 0,
+                                                  static_cast<uint32_t>(ziarno), static_cast<uint32_t>(ziarno >> 32));
+        w[2 * b] = x[0] | static_cast<uint64_t>(x[1]) << 32;
+        w[2 * b + 1] = x[2] | static_cast<uint64_t>(x[3]) << 32;
+    }
+}
+
+#ifdef MACIERZ_X86
+
+// W wariantach wektorowych każdy blok zajmuje jedną 64-bitową kolumnę
+// rejestrów x0..x3: vpmuludq mnoży dolne połowy kolumn i daje od razu
+// pełny iloczyn 64-bitowy. Górne połowy kolumn x0 i x2 są po rundzie
+// śmieciami, ale czyta je tylko vpmuludq; zeruje się je przy zapisie.
+// Resztę bloków liczy wariant skalarny wywoływany jako skok (tail call),
+// przed którym GCC nie wstawia vzeroupper – bez jawnego wywołania kod SSE
+// po powrocie (np. sin/cos z libm) działa kilkakrotnie wolniej.
+
+MACIERZ_CEL("avx2")
+void generuj_bloki_avx2(uint64_t* w, uint64_t pierwszy, long long blokow, uint64_t ziarno) {
+    const __m256i m0 = _mm256_set1_epi64x(PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi64x(PHILOX_M1);
+    const __m256i krok = _mm256_set_epi64x(3, 2, 1, 0);
+    const __m256i dolne = _mm256_set1_epi64x(0xFFFFFFFFLL);
+    long long b = 0;
+    for (; b + 4 <= blokow; b += 4) {
+        const __m256i c =
+            _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(pierwszy + static_cast<uint64_t>(b))), krok);
+        __m256i x0 = c, x1 = _mm256_srli_epi64(c, 32), x2 = _mm256_setzero_si256(), x3 = _mm256_setzero_si256();
+        uint32_t k0 = static_cast<uint32_t>(ziarno), k1 = static_cast<uint32_t>(ziarno >> 32);
+        for (int r = 0; r < PHILOX_RUNDY; ++r) {
+            if (r > 0) {
+                k0 += PHILOX_W0;
+                k1 += PHILOX_W1;
+            }
+            const __m256i p0 = _mm256_mul_epu32(x0, m0);
+            const __m256i p1 = _mm256_mul_epu32(x2, m1);
+            x0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), x1), _mm256_set1_epi64x(k0));
+            x1 = p1;
+            x2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), x3), _mm256_set1_epi64x(k1));
+            x3 = p0;
+        }
+        const __m256i s0 = _mm256_or_si256(_mm256_and_si256(x0, dolne), _mm256_slli_epi64(x1, 32));
+        const __m256i s1 = _mm256_or_si256(_mm256_and_si256(x2, dolne), _mm256_slli_epi64(x3, 32));
+        const __m256i lo = _mm256_unpacklo_epi64(s0, s1);
+        const __m256i hi = _mm256_unpackhi_epi64(s0, s1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(w + 2 * b), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(w + 2 * b + 4), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    _mm256_zeroupper();
+    generuj_bloki_skalarnie(w + 2 * b, pierwszy + static_cast<uint64_t>(b), blokow - b, ziarno);
+}
+
+// Przesunięcia i vpmuludq w wersji maskz z pełną maską: przy wersjach bez
+// maski GCC 12 ostrzega o niezainicjowanym rejestrze wewnątrz intrynsyku.
+MACIERZ_CEL("avx512f")
+void generuj_bloki_avx512(uint64_t* w, uint64_t pierwszy, long long blokow, uint64_t ziarno) {
+    const __m512i m0 = _mm512_set1_epi64(PHILOX_M0);
+    const __m512i m1 = _mm512_set1_epi64(PHILOX_M1);
+    const __m512i krok = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i dolne = _mm512_set1_epi64(0xFFFFFFFFLL);
+    // Przeplot słów s0 (indeksy 0..7) i s1 (8..15): s0[0], s1[0], s0[1], ...
+    const __m512i przeplot_lo = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+    const __m512i przeplot_hi = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+    long long b = 0;
+    for (; b + 8 <= blokow; b += 8) {
+        const __m512i c =
+            _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(pierwszy + static_cast<uint64_t>(b))), krok);
+        __m512i x0 = c, x1 = _mm512_maskz_srli_epi64(0xFF, c, 32), x2 = _mm512_setzero_si512(), x3 = _mm512_setzero_si512();
+        uint32_t k0 = static_cast<uint32_t>(ziarno), k1 = static_cast<uint32_t>(ziarno >> 32);
+        for (int r = 0; r < PHILOX_RUNDY; ++r) {
+            if (r > 0) {
+                k0 += PHILOX_W0;
+                k1 += PHILOX_W1;
+            }
+            const __m512i p0 = _mm512_maskz_mul_epu32(0xFF, x0, m0);
+            const __m512i p1 = _mm512_maskz_mul_epu32(0xFF, x2, m1);
+            x0 = _mm512_ternarylogic_epi64(_mm512_maskz_srli_epi64(0xFF, p1, 32), x1, _mm512_set1_epi64(k0), 0x96);
+            x1 = p1;
+            x2 = _mm512_ternarylogic_epi64(_mm512_maskz_srli_epi64(0xFF, p0, 32), x3, _mm512_set1_epi64(k1), 0x96);
+            x3 = p0;
+        }
+        const __m512i s0 = _mm512_ternarylogic_epi64(x0, dolne, _mm512_maskz_slli_epi64(0xFF, x1, 32), 0xEA);
+        const __m512i s1 = _mm512_ternarylogic_epi64(x2, dolne, _mm512_maskz_slli_epi64(0xFF, x3, 32), 0xEA);
+        _mm512_storeu_si512(w + 2 * b, _mm512_permutex2var_epi64(s0, przeplot_lo, s1));
+        _mm512_storeu_si512(w + 2 * b + 8, _mm512_permutex2var_epi64(s0, przeplot_hi, s1));
+    }
+    _mm256_zeroupper();
+    generuj_bloki_skalarnie(w + 2 * b, pierwszy + static_cast<uint64_t>(b), blokow - b, ziarno);
+}
+
+#endif // MACIERZ_X86
+
+struct wybrany_generator {
+    generator_blokow_t f;
+    const char* nazwa;
+};
+
+/// Zwraca najlepszy wariant generatora bloków (wybierany raz).
+const wybrany_generator& generator_blokow() {
+    static const wybrany_generator wybrany = [] {
+#ifdef MACIERZ_X86
+        const cpu_info& cpu = procesor();
+        if (cpu.avx512f) return wybrany_generator{ generuj_bloki_avx512, "avx512" };
+        if (cpu.avx2) return wybrany_generator{ generuj_bloki_avx2, "avx2" };
+#endif
+        return wybrany_generator{ generuj_bloki_skalarnie, "skalarny" };
+    }();
+    return wybrany;
+}
+
+// ---------------------------------------------------------------------------
+// Zamiana słów losowych na liczby z rozkładu
+// ---------------------------------------------------------------------------
+
+/// Zwraca górne 64 bity iloczynu @p a * @p b.
+inline uint64_t gorna_polowa_iloczynu(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(a, b);
+#else
+    const uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32, b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+    const uint64_t srodek = (a0 * b0 >> 32) + (a1 * b0 & 0xFFFFFFFFu) + a0 * b1;
+    return a1 * b1 + (a1 * b0 >> 32) + (srodek >> 32);
+#endif
+}
+
+/**
+ * @brief v[i] = liczba z [od, do_] (typy całkowite) lub [od, do_)
+ *        (zmiennoprzecinkowe) wyznaczona ze słowa w[i].
+ *
+ * Liczba całkowita to floor(w * długość / 2^64); przy długości do 2^32
+ * liczona dwoma iloczynami 32 x 32 bity, które kompilator wektoryzuje.
+ * Liczba zmiennoprzecinkowa powstaje z bitów mantysy: 1.m - 1 należy do
+ * [0, 1) i jest skalowana do przedziału (bez FMA, więc wynik nie zależy od
+ * wariantu).
+ */
+template <typename T>
+inline void przeksztalc_jednostajnie(T* v, const uint64_t* w, long long liczba, T od, T do_) {
+    if constexpr (is_integral_v<T>) {
+        const uint64_t poczatek = static_cast<uint64_t>(static_cast<int64_t>(od));
+        // 0 oznacza pełny zakres 2^64 (tylko dla int64_t).
+        const uint64_t dlugosc = static_cast<uint64_t>(static_cast<int64_t>(do_)) - poczatek + 1;
+        if (dlugosc != 0 && dlugosc <= 0xFFFFFFFFu) {
+            const uint32_t d32 = static_cast<uint32_t>(dlugosc);
+            for (long long i = 0; i < liczba; ++i) {
+                const uint64_t gora = static_cast<uint64_t>(static_cast<uint32_t>(w[i] >> 32)) * d32;
+                const uint64_t dol = static_cast<uint64_t>(static_cast<uint32_t>(w[i])) * d32;
+                v[i] = static_cast<T>(poczatek + ((gora + (dol >> 32)) >> 32));
+            }
+        } else {
+            for (long long i = 0; i < liczba; ++i) {
+                const uint64_t r = dlugosc == 0 ? w[i] : gorna_polowa_iloczynu(w[i], dlugosc);
+                v[i] = static_cast<T>(poczatek + r);
+            }
+        }
+    } else {
+        using U = conditional_t<is_same_v<T, float>, uint32_t, uint64_t>;
+        constexpr int MANTYSA = numeric_limits<T>::digits - 1;
+        const U jeden = bit_cast<U>(T(1));
+        const T szerokosc = do_ - od;
+        for (long long i = 0; i < liczba; ++i) {
+            const U bity = jeden | static_cast<U>(w[i] >> (64 - MANTYSA));
+            const T x = od + (bit_cast<T>(bity) - T(1)) * szerokosc;
+            v[i] = x < do_ ? x : od;
+        }
+    }
+}
+
+/**
+ * @brief v[i], v[i + 1] = para liczb z N(srednia, odchylenie^2) wyznaczona
+ *        metodą Boxa-Mullera ze słów w[i], w[i + 1] (@p liczba parzysta).
+ */
+template <typename T>
+void przeksztalc_normalnie(T* v, const uint64_t* w, long long liczba, double srednia, double odchylenie) {
+    constexpr double DWA_PI = 6.283185307179586476925286766559;
+    const auto na_typ = [](double z) {
+        if constexpr (is_integral_v<T>) {
+            if (z >= static_cast<double>(numeric_limits<T>::max())) return numeric_limits<T>::max();
+            if (z <= static_cast<double>(numeric_limits<T>::min())) return numeric_limits<T>::min();
+            return static_cast<T>(llround(z));
+        } else {
+            return static_cast<T>(z);
+        }
+    };
+    for (long long i = 0; i + 1 < liczba; i += 2) {
+        const double u1 = static_cast<double>((w[i] >> 11) + 1) * 0x1p-53;  // (0, 1]
+        const double u2 = static_cast<double>(w[i + 1] >> 11) * 0x1p-53;    // [0, 1)
+        const double r = odchylenie * sqrt(-2.0 * log(u1));
+        v[i] = na_typ(srednia + r * cos(DWA_PI * u2));
+        v[i + 1] = na_typ(srednia + r * sin(DWA_PI * u2));
+    }
+}
+
+#ifdef MACIERZ_X86
+
+template <typename T>
+MACIERZ_CEL("avx2")
+void przeksztalc_jednostajnie_avx2(T* v, const uint64_t* w, long long liczba, T od, T do_) {
+    przeksztalc_jednostajnie(v, w, liczba, od, do_);
+}
+
+#endif // MACIERZ_X86
+
+template <typename T>
+void przeksztalc_jednostajnie_ogolne(T* v, const uint64_t* w, long long liczba, T od, T do_) {
+    przeksztalc_jednostajnie(v, w, liczba, od, do_);
+}
+
+/// Zwraca wariant @ref przeksztalc_jednostajnie dla procesora.
+template <typename T>
+auto przeksztalcenie_jednostajne() -> void (*)(T*, const uint64_t*, long long, T, T) {
+#ifdef MACIERZ_X86
+    if (procesor().avx2) return przeksztalc_jednostajnie_avx2<T>;
+#endif
+    return przeksztalc_jednostajnie_ogolne<T>;
+}
+
+/**
+ * @brief Wypełnia macierz liczbami losowymi: element o numerze e
+ *        (wierszami) dostaje wartość wyznaczoną przez @p przeksztalc ze
+ *        słowa e generatora.
+ *
+ * Fragmenty po @ref PROG_ROWNOLEGLY elementów są wypełniane równolegle,
+ * porcjami po @ref PORCJA_LOSOWANIA elementów: porcja słów, porcja
+ * wartości, kopia do wierszy. Porcje zaczynają się od parzystych numerów,
+ * więc każdy blok generatora trafia w całości do jednej porcji.
+ */
+template <typename T, typename F>
+void wypelnij_losowo(T* d, ptrdiff_t m, ptrdiff_t n, ptrdiff_t ld, uint64_t ziarno, F przeksztalc) {
+    const long long liczba = static_cast<long long>(m) * n;
+    if (liczba == 0) return;
+    const generator_blokow_t generuj = generator_blokow().f;
+    const long long fragmentow = (liczba + PROG_ROWNOLEGLY - 1) / PROG_ROWNOLEGLY;
+    rownolegle_dla(0, fragmentow, 1, [&](long long f0, long long f1) {
+        uint64_t slowa[PORCJA_LOSOWANIA];
+        T wartosci[PORCJA_LOSOWANIA];
+        const long long koniec = min(liczba, f1 * PROG_ROWNOLEGLY);
+        for (long long b = f0 * PROG_ROWNOLEGLY; b < koniec; b += PORCJA_LOSOWANIA) {
+            const long long ile = min(PORCJA_LOSOWANIA, koniec - b);
+            const long long blokow = (ile + 1) / 2;
+            generuj(slowa, static_cast<uint64_t>(b / 2), blokow, ziarno);
+            przeksztalc(wartosci, slowa, 2 * blokow);
+            long long i = b / n, j = b % n;
+            for (long long k = 0; k < ile; j = 0, ++i) {
+                const long long odcinek = min<long long>(n - j, ile - k);
+                copy(wartosci + k, wartosci + k + odcinek, d + i * ld + j);
+                k += odcinek;
+            }
+        }
+    });
+}
+
+} // namespace
+
+philox::philox(uint64_t ziarno, uint64_t strumien) noexcept
+    : klucz(ziarno), nr_strumienia(strumien), licznik(0), bufor{}, pozycja(4) {}
+
+/**
+ * @brief Zwraca kolejne słowo bieżącego bloku, w razie potrzeby wyznaczając
+ *        następny blok.
+ */
+philox::result_type philox::operator()() noexcept {
+    if (pozycja == 4) {
+        bufor = blok(licznik++, nr_strumienia, klucz);
+        pozycja = 0;
+    }
+    return bufor[static_cast<size_t>(pozycja++)];
+}
+
+/**
+ * @brief Pomija @p liczba wyników: przesuwa licznik bloków i pozycję
+ *        w bloku.
+ */
+void philox::discard(unsigned long long liczba) noexcept {
+    const unsigned long long w_buforze = static_cast<unsigned long long>(4 - pozycja);
+    if (liczba <= w_buforze) {
+        pozycja += static_cast<int>(liczba);
+        return;
+    }
+    liczba -= w_buforze;
+    licznik += (liczba - 1) / 4;
+    bufor = blok(licznik++, nr_strumienia, klucz);
+    pozycja = static_cast<int>((liczba - 1) % 4) + 1;
+}
+
+/**
+ * @brief Zwraca blok Philox4x32-10: licznik (@p licznik, @p strumien),
+ *        klucz @p ziarno.
+ */
+array<uint32_t, 4> philox::blok(uint64_t licznik, uint64_t strumien, uint64_t ziarno) noexcept {
+    return philox_runda(static_cast<uint32_t>(licznik), static_cast<uint32_t>(licznik >> 32),
+                        static_cast<uint32_t>(strumien), static_cast<uint32_t>(strumien >> 32),
+                        static_cast<uint32_t>(ziarno), static_cast<uint32_t>(ziarno >> 32));
+}
+
+namespace jadra {
+
+/**
+ * @brief Wypełnia macierz liczbami z rozkładu jednostajnego.
+ *
+ * @throw std::invalid_argument jeśli @p do_ < @p od.
+ */
+template <typename T>
+void losuj_jednostajnie(T* d, ptrdiff_t m, ptrdiff_t n, ptrdiff_t ld, uint64_t ziarno, T od, T do_) {
+    if (!(od <= do_)) throw invalid_argument("Pusty przedzial losowania");
+    const auto przeksztalc = przeksztalcenie_jednostajne<T>();
+    wypelnij_losowo(d, m, n, ld, ziarno,
+                    [=](T* v, const uint64_t* w, long long liczba) { przeksztalc(v, w, liczba, od, do_); });
+}
+
+/**
+ * @brief Wypełnia macierz liczbami z rozkładu normalnego.
+ *
+ * @throw std::invalid_argument jeśli @p odchylenie < 0.
+ */
+template <typename T>
+void losuj_normalnie(T* d, ptrdiff_t m, ptrdiff_t n, ptrdiff_t ld, uint64_t ziarno, double srednia,
+                     double odchylenie) {
+    if (!(odchylenie >= 0)) throw invalid_argument("Ujemne odchylenie standardowe");
+    wypelnij_losowo(d, m, n, ld, ziarno, [=](T* v, const uint64_t* w, long long liczba) {
+        przeksztalc_normalnie(v, w, liczba, srednia, odchylenie);
+    });
+}
+
+/**
+ * @brief Zwraca nazwę wariantu generatora bloków.
+ */
+const char* wariant_losowania() {
+    return generator_blokow().nazwa;
+}
+
+/**
+ * @brief Jawne konkretyzacje losowania dla typu @p T.
+ */
+#define MACIERZ_INSTANCJA_LOSOWANIA(T)                                                                          \
+    template void losuj_jednostajnie<T>(T*, std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t, std::uint64_t, T, T); \
+    template void losuj_normalnie<T>(T*, std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t, std::uint64_t, double,   \
+                                     double);
+
+MACIERZ_INSTANCJA_LOSOWANIA(int8_t)
+MACIERZ_INSTANCJA_LOSOWANIA(int16_t)
+MACIERZ_INSTANCJA_LOSOWANIA(int32_t)
+MACIERZ_INSTANCJA_LOSOWANIA(int64_t)
+MACIERZ_INSTANCJA_LOSOWANIA(float)
+MACIERZ_INSTANCJA_LOSOWANIA(double)
+
+#undef MACIERZ_INSTANCJA_LOSOWANIA
+
+} // namespace jadra
@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * @file losowanie.h
+ * @brief Szybkie, powtarzalne wypełnianie macierzy liczbami losowymi.
+ *
+ * Źródłem losowości jest generator licznikowy Philox4x32-10 (Salmon i in.,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3"): blok 128 losowych bitów
+ * jest funkcją numeru bloku i ziarna, bez stanu przechodzącego z jednego
+ * wywołania do następnego. Element o numerze e (numeracja wierszami,
+ * niezależna od @c stride()) dostaje 64 bity z bloku e / 2, więc:
+ * - wynik zależy tylko od ziarna i wymiarów – nie od liczby wątków ani
+ *   podziału pracy,
+ * - fragmenty macierzy mogą być wypełniane równolegle i w dowolnej
+ *   kolejności,
+ * - bloki są liczone wektorowo (AVX-512 / AVX2, 8 lub 4 bloki naraz).
+ *
+ * Liczby całkowite z przedziału [od, do] są wyznaczane mnożeniem
+ * 64-bitowej liczby losowej przez długość przedziału (bez dzielenia
+ * modulo), więc nierównomierność jest rzędu długość / 2^64.
+ */
+
+#include "matrix.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class philox
+ * @brief Generator Philox4x32-10 spełniający wymagania
+ *        @c UniformRandomBitGenerator (np. dla @c std::uniform_int_distribution).
+ *
+ * Kolejne wywołania zwracają słowa bloków 0, 1, 2, ... strumienia
+ * @p strumien; różne strumienie tego samego ziarna są niezależne.
+ */
+class philox {
+public:
+    /// Typ zwracanych liczb.
+    using result_type = std::uint32_t;
+
+    /**
+     * @brief Tworzy generator o ziarnie @p ziarno, ustawiony na początek
+     *        strumienia @p strumien.
+     */
+    explicit philox(std::uint64_t ziarno, std::uint64_t strumien = 0) noexcept;
+
+    /// Najmniejsza zwracana wartość.
+    static constexpr result_type min() noexcept { return 0; }
+
+    /// Największa zwracana wartość.
+    static constexpr result_type max() noexcept { return 0xFFFFFFFFu; }
+
+    /// Zwraca następne 32 losowe bity.
+    result_type operator()() noexcept;
+
+    /// Pomija @p liczba kolejnych wyników (w czasie stałym).
+    void discard(unsigned long long liczba) noexcept;
+
+    /**
+     * @brief Zwraca blok numer @p licznik strumienia @p strumien dla
+     *        ziarna @p ziarno.
+     */
+    static std::array<std::uint32_t, 4> blok(std::uint64_t licznik, std::uint64_t strumien,
+                                             std::uint64_t ziarno) noexcept;
+
+private:
+    std::uint64_t klucz;                ///< Ziarno.
+    std::uint64_t nr_strumienia;        ///< Numer strumienia.
+    std::uint64_t licznik;              ///< Numer następnego bloku.
+    std::array<std::uint32_t, 4> bufor; ///< Ostatnio wyznaczony blok.
+    int pozycja;                        ///< Indeks następnego słowa w @c bufor (4 – pusty).
+};
+
+namespace jadra {
+
+/**
+ * @brief Wypełnia macierz @p m x @p n (wiersze co @p ld elementów)
+ *        liczbami z rozkładu jednostajnego.
+ *
+ * Dla typów całkowitych – z przedziału [@p od, @p do_], dla
+ * zmiennoprzecinkowych – z [@p od, @p do_).
+ *
+ * @throw std::invalid_argument jeśli @p do_ < @p od.
+ */
+template <typename T>
+void losuj_jednostajnie(T* d, std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t ld, std::uint64_t ziarno, T od,
+                        T do_);
+
+/**
+ * @brief Wypełnia macierz @p m x @p n (wiersze co @p ld elementów)
+ *        liczbami z rozkładu normalnego N(@p srednia, @p odchylenie^2).
+ *
+ * Liczby są wyznaczane metodą Boxa-Mullera; dla typów całkowitych są
+ * zaokrąglane i obcinane do zakresu typu.
+ *
+ * @throw std::invalid_argument jeśli @p odchylenie < 0.
+ */
+template <typename T>
+void losuj_normalnie(T* d, std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t ld, std::uint64_t ziarno,
+                     double srednia, double odchylenie);
+
+/**
+ * @brief Zwraca nazwę wariantu generatora bloków ("avx512", "avx2" lub
+ *        "skalarny").
+ */
+const char* wariant_losowania();
+
+} // namespace jadra
+
+/**
+ * @brief Wypełnia @p m liczbami z rozkładu jednostajnego na [@p od, @p do_]
+ *        (dla typów zmiennoprzecinkowych – [@p od, @p do_)).
+ *
+ * Ta sama macierz, ziarno i przedział dają zawsze ten sam wynik.
+ *
+ * @return Referencja do @p m.
+ * @throw std::invalid_argument jeśli @p do_ < @p od.
+ */
+template <typename T>
+basic_matrix<T>& losuj_jednostajnie(basic_matrix<T>& m, std::uint64_t ziarno, T od, T do_) {
+    jadra::losuj_jednostajnie(m.data(), m.rows(), m.cols(), m.stride(), ziarno, od, do_);
+    return m;
+}
+
+/**
+ * @brief Wypełnia @p m liczbami z rozkładu normalnego
+ *        N(@p srednia, @p odchylenie^2).
+ *
+ * @return Referencja do @p m.
+ * @throw std::invalid_argument jeśli @p odchylenie < 0.
+ */
+template <typename T>
+basic_matrix<T>& losuj_normalnie(basic_matrix<T>& m, std::uint64_t ziarno, double srednia, double odchylenie) {
+    jadra::losuj_normalnie(m.data(), m.rows(), m.cols(), m.stride(), ziarno, srednia, odchylenie);
+    return m;
+}
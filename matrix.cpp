@@ -1,136 +1,605 @@
 #include "matrix.h"
+#include "wyrazenie.h"
+#include "gemm.h"
+#include "simd.h"
+#include "transpozycja.h"
+#include "thread_pool.h"
+#include "losowanie.h"
+#include "tekst.h"
 #include <iostream>
 #include <algorithm>
 #include <stdexcept>
 #include <iomanip>
+#include <locale>
 #include <cstdlib>
 #include <ctime>
+#include <atomic>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace std;
 
+namespace {
+
+/**
+ * @brief Wywołuje @p f(i) dla każdego i z [0, @p liczba).
+ *
+ * Dla dużych macierzy przedział jest dzielony na fragmenty wykonywane
+ * równolegle w globalnej puli wątków.
+ *
+ * @param liczba Liczba elementów.
+ * @param f Funkcja wywoływana dla indeksu elementu.
+ */
+template <typename F>
+void dla_elementow(long long liczba, F f) {
+    rownolegle_dla(0, liczba, PROG_ROWNOLEGLY, [&f](long long b, long long e) {
+        for (long long i = b; i < e; ++i) f(i);
+    });
+}
+
+/**
+ * @brief Wywołuje @p f(b, e) dla fragmentów [b, e) przedziału [0, @p liczba).
+ *
+ * Przeznaczone dla jąder z @ref jadra::elementowe, które przetwarzają
+ * cały fragment naraz.
+ *
+ * @param liczba Liczba elementów.
+ * @param f Funkcja wywoływana dla fragmentu.
+ */
+template <typename F>
+void dla_fragmentow(long long liczba, F f) {
+    rownolegle_dla(0, liczba, PROG_ROWNOLEGLY, f);
+}
+
+/**
+ * @brief Wywołuje @p f(i) dla każdego wiersza i z [0, @p wiersze).
+ *
+ * Wiersze są dzielone między wątki tak, by każdy fragment obejmował
+ * co najmniej @ref PROG_ROWNOLEGLY elementów.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn (długość wiersza).
+ * @param f Funkcja wywoływana dla indeksu wiersza.
+ */
+template <typename F>
+void dla_wierszy(ptrdiff_t wiersze, ptrdiff_t kolumny, F f) {
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(kolumny, 1));
+    rownolegle_dla(0, wiersze, ziarno, [&f](long long b, long long e) {
+        for (long long i = b; i < e; ++i) f(static_cast<ptrdiff_t>(i));
+    });
+}
+
+/**
+ * @brief Wywołuje @p f(w, j, dlugosc) dla ciągłych odcinków macierzy
+ *        @p wiersze x @p kolumny.
+ *
+ * Odcinek zaczyna się w wierszu @c w i kolumnie @c j. Jeśli wszystkie
+ * macierze biorące udział w operacji są ciągłe (@p ciagle), cała macierz
+ * jest jednym odcinkiem dzielonym na fragmenty (wtedy @c w == 0, a @c j
+ * jest indeksem w płaskiej tablicy); w przeciwnym razie odcinkami są
+ * wiersze. W obu przypadkach element odcinka leży pod adresem
+ * @c dane + w * stride() + j.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param ciagle Czy wszystkie macierze operacji są ciągłe.
+ * @param f Funkcja wywoływana dla odcinka.
+ */
+template <typename F>
+void dla_odcinkow(ptrdiff_t wiersze, ptrdiff_t kolumny, bool ciagle, F f) {
+    if (ciagle) {
+        dla_fragmentow(wiersze * kolumny, [&f](long long b, long long e) {
+            f(0LL, b, e - b);
+        });
+    }
+    else {
+        dla_wierszy(wiersze, kolumny, [&f, kolumny](ptrdiff_t i) {
+            f(static_cast<long long>(i), 0LL, static_cast<long long>(kolumny));
+        });
+    }
+}
+
+/**
+ * @brief Sprawdza, czy @p warunek(w, j, dlugosc) zachodzi dla każdego odcinka
+ *        (zob. @ref dla_odcinkow).
+ *
+ * Fragmenty wykonywane równolegle kończą pracę, gdy tylko któryś z nich
+ * znajdzie odcinek niespełniający warunku.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param ciagle Czy obie porównywane macierze są ciągłe.
+ * @param warunek Predykat wywoływany dla odcinka.
+ * @return true jeśli warunek jest spełniony dla wszystkich odcinków.
+ */
+template <typename P>
+bool dla_wszystkich(ptrdiff_t wiersze, ptrdiff_t kolumny, bool ciagle, P warunek) {
+    atomic<bool> spelniony(true);
+    dla_odcinkow(wiersze, kolumny, ciagle, [&](long long w, long long j, long long dl) {
+        if (!spelniony.load(memory_order_relaxed)) return;
+        if (!warunek(w, j, dl)) spelniony.store(false, memory_order_relaxed);
+    });
+    return spelniony.load();
+}
+
+/**
+ * @brief Kopiuje elementy macierzy @p z do @p d (obie o wymiarach
+ *        @p wiersze x @p kolumny, z odstępami wierszy @p ldd i @p ldz).
+ */
+template <typename T>
+void kopiuj(ptrdiff_t wiersze, ptrdiff_t kolumny, T* d, long long ldd, const T* z, long long ldz) {
+    dla_odcinkow(wiersze, kolumny, ldd == kolumny && ldz == kolumny, [=](long long w, long long j, long long dl) {
+        copy(z + w * ldz + j, z + w * ldz + j + dl, d + w * ldd + j);
+    });
+}
+
+/**
+ * @brief Zeruje prostokąt [@p w0, @p w1) x [@p k0, @p k1) macierzy @p d
+ *        z odstępem wierszy @p ld.
+ */
+template <typename T>
+void zeruj_obszar(T* d, long long ld, ptrdiff_t w0, ptrdiff_t w1, ptrdiff_t k0, ptrdiff_t k1) {
+    if (w0 >= w1 || k0 >= k1) return;
+    dla_wierszy(w1 - w0, k1 - k0, [=](ptrdiff_t i) {
+        T* wiersz = d + (w0 + i) * ld;
+        fill(wiersz + k0, wiersz + k1, T(0));
+    });
+}
+
+/**
+ * @brief Składa 64-bitowe ziarno z kolejnych wyników @c rand() (każdy ma
+ *        co najmniej 15 losowych bitów).
+ */
+uint64_t ziarno_z_rand() {
+    uint64_t ziarno = 0;
+    for (int r = 0; r < 5; ++r) ziarno = (ziarno << 15) ^ static_cast<uint64_t>(rand());
+    return ziarno;
+}
+
+} // namespace
+
 /**
  * @brief Konstruktor domyślny.
  *
  * Inicjalizuje pustą macierz:
- * - n = 0
+ * - wierszy = kolumn = ld = 0
  * - pojemnosc = 0
  * - dane = nullptr
+ * - alok = @ref jadra::domyslny_alokator
+ */
+template <typename T>
+basic_matrix<T>::basic_matrix() : basic_matrix(jadra::domyslny_alokator()) {
+}
+
+/**
+ * @brief Tworzy pustą macierz z alokatorem @p a.
+ *
+ * @param a Alokator.
  */
-matrix::matrix() : n(0), pojemnosc(0), dane(nullptr) {
+template <typename T>
+basic_matrix<T>::basic_matrix(jadra::alokator& a) : wierszy(0), kolumn(0), ld(0), pojemnosc(0), dane(nullptr), alok(&a) {
 }
 
 /**
  * @brief Konstruktor z rozmiarem.
  *
- * Tworzy macierz @p n x @p n i wywołuje @ref matrix::alokuj "alokuj(n)".
+ * Tworzy macierz @p n x @p n i wywołuje @ref basic_matrix::alokuj "alokuj(n)".
  *
  * @param n Rozmiar macierzy.
  * @throw std::invalid_argument jeśli @p n < 0.
  */
-matrix::matrix(int n) : n(0), pojemnosc(0), dane(nullptr) {
+template <typename T>
+basic_matrix<T>::basic_matrix(ptrdiff_t n) : basic_matrix() {
     if (n < 0) throw invalid_argument("Rozmiar ujemny");
     alokuj(n);
 }
 
 /**
- * @brief Konstruktor z rozmiarem i tablicą danych.
+ * @brief Konstruktor macierzy prostokątnej.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ */
+template <typename T>
+basic_matrix<T>::basic_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny) : basic_matrix() {
+    alokuj(wiersze, kolumny);
+}
+
+/**
+ * @brief Konstruktor macierzy prostokątnej z alokatorem.
  *
- * Tworzy macierz @p n x @p n oraz kopiuje @p n*n elementów z tablicy @p t.
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param a Alokator.
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ */
+template <typename T>
+basic_matrix<T>::basic_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, jadra::alokator& a) : basic_matrix(a) {
+    alokuj(wiersze, kolumny);
+}
+
+/**
+ * @brief Konstruktor macierzy prostokątnej bez zerowania elementów.
  *
- * @param n Rozmiar macierzy.
- * @param t Wskaźnik na tablicę o rozmiarze co najmniej @p n*@p n.
- * @throw std::invalid_argument jeśli @p n <= 0 lub @p t == nullptr.
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ */
+template <typename T>
+basic_matrix<T>::basic_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, bez_zerowania_t) : basic_matrix() {
+    alokuj(wiersze, kolumny, bez_zerowania);
+}
+
+/**
+ * @brief Konstruktor macierzy prostokątnej z tablicą danych.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param t Tablica o rozmiarze co najmniej @p wiersze*@p kolumny (wierszami).
+ * @throw std::invalid_argument jeśli wymiar nie jest dodatni lub @p t == nullptr.
  */
-matrix::matrix(int n, int* t) : n(0), pojemnosc(0), dane(nullptr) {
-    if (n <= 0) throw invalid_argument("Rozmiar musi byc dodatni");
+template <typename T>
+basic_matrix<T>::basic_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, const T* t) : basic_matrix() {
+    if (wiersze <= 0 || kolumny <= 0) throw invalid_argument("Rozmiar musi byc dodatni");
     if (t == nullptr) throw invalid_argument("Tablica zrodlowa jest null");
 
-    alokuj(n);
-    for (int i = 0; i < n * n; ++i) {
-        dane[i] = t[i];
-    }
+    alokuj(wiersze, kolumny, bez_zerowania);
+    T* d = dane.get();
+    dla_elementow(wiersze * kolumny, [d, t](long long i) { d[i] = t[i]; });
+}
+
+/**
+ * @brief Konstruktor przejmujący tablicę @p d.
+ *
+ * Pojemność macierzy to @p wiersze * @p odstep elementów.
+ *
+ * @throw std::invalid_argument jeśli wymiar jest ujemny, @p odstep < @p kolumny
+ *        lub @p d jest pusta przy niezerowym rozmiarze.
+ */
+template <typename T>
+basic_matrix<T>::basic_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, ptrdiff_t odstep, jadra::tablica<T> d,
+                              jadra::alokator& a)
+    : basic_matrix(a) {
+    if (wiersze < 0 || kolumny < 0) throw invalid_argument("Rozmiar ujemny");
+    if (odstep < kolumny) throw invalid_argument("Odstep wierszy mniejszy niz liczba kolumn");
+    const ptrdiff_t liczba = jadra::pomnoz_rozmiary(wiersze, odstep);
+    if (d == nullptr && liczba > 0) throw invalid_argument("Tablica zrodlowa jest null");
+    dane = std::move(d);
+    wierszy = wiersze;
+    kolumn = kolumny;
+    ld = odstep;
+    pojemnosc = liczba;
 }
 
 /**
  * @brief Konstruktor kopiujący.
  *
- * Alokuje nową pamięć i kopiuje dane z macierzy @p m.
+ * Alokuje nową pamięć (z alokatora @p m) i kopiuje dane z macierzy @p m.
  *
  * @param m Macierz źródłowa.
  */
-matrix::matrix(const matrix& m) : n(0), pojemnosc(0), dane(nullptr) {
-    if (m.n > 0) {
-        alokuj(m.n);
-        for (int i = 0; i < n * n; ++i) {
-            dane[i] = m.dane[i];
-        }
+template <typename T>
+basic_matrix<T>::basic_matrix(const basic_matrix<T>& m) : basic_matrix(*m.alok) {
+    if (m.wierszy > 0 || m.kolumn > 0) {
+        alokuj(m.wierszy, m.kolumn, bez_zerowania);
+        kopiuj(wierszy, kolumn, dane.get(), ld, m.dane.get(), m.ld);
     }
 }
 
+/**
+ * @brief Konstruktor przenoszący.
+ *
+ * Przejmuje pamięć macierzy @p m; @p m staje się pustą macierzą.
+ *
+ * @param m Macierz źródłowa.
+ */
+template <typename T>
+basic_matrix<T>::basic_matrix(basic_matrix<T>&& m) noexcept
+    : wierszy(m.wierszy), kolumn(m.kolumn), ld(m.ld), pojemnosc(m.pojemnosc), dane(std::move(m.dane)), alok(m.alok) {
+    m.wierszy = m.kolumn = m.ld = 0;
+    m.pojemnosc = 0;
+}
+
 /**
  * @brief Destruktor.
  *
  * Pamięć zwalnia się automatycznie dzięki std::unique_ptr.
  */
-matrix::~matrix() {
+template <typename T>
+basic_matrix<T>::~basic_matrix() {
 }
 
 /**
  * @brief Operator przypisania.
  *
- * Kopiuje rozmiar i zawartość macierzy @p m do *this.
+ * Kopiuje wymiary i zawartość macierzy @p m do *this.
  *
  * @param m Macierz źródłowa.
  * @return Referencja do *this.
  */
-matrix& matrix::operator=(const matrix& m) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator=(const basic_matrix<T>& m) {
     if (this == &m) {
         return *this;
     }
-    alokuj(m.n);
-    for (int i = 0; i < n * n; ++i) {
-        dane[i] = m.dane[i];
-    }
+    alokuj(m.wierszy, m.kolumn, bez_zerowania);
+    kopiuj(wierszy, kolumn, dane.get(), ld, m.dane.get(), m.ld);
     return *this;
 }
 
+/**
+ * @brief Przenoszący operator przypisania.
+ *
+ * Zamienia pamięć *this i @p m; stara pamięć *this zostanie zwolniona
+ * razem z @p m (albo użyta ponownie, jeśli @p m będzie dalej używana).
+ *
+ * @param m Macierz źródłowa.
+ * @return Referencja do *this.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator=(basic_matrix<T>&& m) noexcept {
+    swap(m);
+    return *this;
+}
+
+/**
+ * @brief Zamienia zawartość z macierzą @p m (bez kopiowania danych).
+ *
+ * @param m Macierz, z którą następuje zamiana.
+ */
+template <typename T>
+void basic_matrix<T>::swap(basic_matrix<T>& m) noexcept {
+    std::swap(wierszy, m.wierszy);
+    std::swap(kolumn, m.kolumn);
+    std::swap(ld, m.ld);
+    std::swap(pojemnosc, m.pojemnosc);
+    dane.swap(m.dane);
+    std::swap(alok, m.alok);
+}
+
 /**
  * @brief Alokuje/realokuje pamięć dla macierzy.
  *
- * Jeżeli @p nowe_n*@p nowe_n jest większe niż aktualna pojemność,
- * alokowana jest nowa tablica (wyzerowana). W przeciwnym razie
- * tylko zmienia się rozmiar @p n.
+ * Równoważne @ref alokuj(size_type, size_type) "alokuj(nowe_n, nowe_n)".
  *
  * @param nowe_n Nowy rozmiar macierzy.
  * @return Referencja do *this.
  * @throw std::invalid_argument jeśli @p nowe_n < 0.
  */
-matrix& matrix::alokuj(int nowe_n) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::alokuj(ptrdiff_t nowe_n) {
     if (nowe_n < 0) throw invalid_argument("Rozmiar ujemny");
+    return alokuj(nowe_n, nowe_n);
+}
 
-    int wymagana_pamiec = nowe_n * nowe_n;
+/**
+ * @brief Alokuje/realokuje pamięć dla macierzy @p wiersze x @p kolumny.
+ *
+ * Jeśli macierz ma już te wymiary, nic się nie zmienia (zachowany jest
+ * też jej odstęp wierszy). W przeciwnym razie wiersze będą leżały jeden za
+ * drugim.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::alokuj(ptrdiff_t wiersze, ptrdiff_t kolumny) {
+    if (wiersze == wierszy && kolumny == kolumn && dane != nullptr) return *this;
+    return alokuj(wiersze, kolumny, kolumny);
+}
+
+/**
+ * @brief Alokuje/realokuje pamięć dla macierzy z wierszami co @p odstep.
+ *
+ * Jeżeli @p wiersze*@p odstep jest większe niż aktualna pojemność,
+ * alokowana jest nowa tablica (wyzerowana). W przeciwnym razie
+ * tylko zmieniają się wymiary.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param odstep Odległość między początkami wierszy.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli wymiar jest ujemny lub @p odstep < @p kolumny.
+ * @throw std::length_error jeśli liczba elementów przekracza zakres.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::alokuj(ptrdiff_t wiersze, ptrdiff_t kolumny, ptrdiff_t odstep) {
+    return alokuj_pamiec(wiersze, kolumny, odstep, true);
+}
+
+/**
+ * @brief Alokuje/realokuje pamięć dla macierzy @p wiersze x @p kolumny
+ *        bez zerowania.
+ *
+ * Jak @ref alokuj(size_type, size_type); nowa tablica nie jest zerowana.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::alokuj(ptrdiff_t wiersze, ptrdiff_t kolumny, bez_zerowania_t) {
+    if (wiersze == wierszy && kolumny == kolumn && dane != nullptr) return *this;
+    return alokuj_pamiec(wiersze, kolumny, kolumny, false);
+}
+
+/**
+ * @brief Realokuje pamięć, jeśli @p wiersze*@p odstep przekracza pojemność,
+ *        i ustawia wymiary.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param odstep Odległość między początkami wierszy.
+ * @param zeruj Czy zerować nowo przydzieloną tablicę.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli wymiar jest ujemny lub @p odstep < @p kolumny.
+ * @throw std::length_error jeśli liczba elementów przekracza zakres.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::alokuj_pamiec(ptrdiff_t wiersze, ptrdiff_t kolumny, ptrdiff_t odstep, bool zeruj) {
+    if (wiersze < 0 || kolumny < 0) throw invalid_argument("Rozmiar ujemny");
+    if (odstep < kolumny) throw invalid_argument("Odstep wierszy mniejszy niz liczba kolumn");
+
+    const ptrdiff_t wymagana_pamiec = jadra::pomnoz_rozmiary(wiersze, odstep);
     if (dane == nullptr || wymagana_pamiec > pojemnosc) {
-        dane.reset(new int[wymagana_pamiec]());
-        pojemnosc = wymagana_pamiec;
+        przydziel_pamiec(wymagana_pamiec, zeruj);
     }
 
-    n = nowe_n;
+    wierszy = wiersze;
+    kolumn = kolumny;
+    ld = odstep;
     return *this;
 }
 
+/**
+ * @brief Zastępuje tablicę danych nową tablicą @p liczba elementów.
+ *
+ * Stara tablica jest zwalniana przed przydziałem nowej (mniejsze zużycie
+ * szczytowe, a pula może od razu oddać ten sam blok), więc wymiary są
+ * zerowane – po wyjątku macierz jest pusta.
+ *
+ * @param liczba Liczba elementów nowej tablicy.
+ * @param zeruj Czy wypełnić nową tablicę zerami.
+ */
+template <typename T>
+void basic_matrix<T>::przydziel_pamiec(ptrdiff_t liczba, bool zeruj) {
+    dane.reset();
+    wierszy = kolumn = ld = pojemnosc = 0;
+    dane = jadra::przydziel_tablice<T>(*alok, liczba);
+    pojemnosc = liczba;
+    if (zeruj) {
+        T* d = dane.get();
+        dla_fragmentow(liczba, [d](long long b, long long e) { fill(d + b, d + e, T(0)); });
+    }
+}
+
+/**
+ * @brief Zmienia wymiary macierzy, zachowując zawartość wspólnego bloku.
+ *
+ * Jeśli @p kolumny <= @c stride() i @p wiersze*@c stride() mieści się
+ * w pojemności, wymiary zmieniają się w miejscu i zerowane są tylko
+ * odsłonięte elementy. Jeśli w pojemności mieści się @p wiersze*@p kolumny,
+ * wiersze są przestawiane w tej samej tablicy na odstęp @p kolumny
+ * (np. po @ref reserve). W przeciwnym razie tworzona jest nowa (niezerowana)
+ * tablica: wspólny blok jest kopiowany, a reszta zerowana, więc każdy
+ * element jest zapisywany dokładnie raz.
+ *
+ * @param wiersze Nowa liczba wierszy.
+ * @param kolumny Nowa liczba kolumn.
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ * @throw std::length_error jeśli liczba elementów przekracza zakres.
+ */
+template <typename T>
+void basic_matrix<T>::resize(ptrdiff_t wiersze, ptrdiff_t kolumny) {
+    if (wiersze < 0 || kolumny < 0) throw invalid_argument("Rozmiar ujemny");
+    if (wiersze == wierszy && kolumny == kolumn && dane != nullptr) return;
+
+    const ptrdiff_t stare_w = wierszy, stare_k = kolumn;
+    const ptrdiff_t wspolne_w = min(wiersze, stare_w), wspolne_k = min(kolumny, stare_k);
+    if (dane != nullptr && kolumny <= ld && jadra::pomnoz_rozmiary(wiersze, ld) <= pojemnosc) {
+        wierszy = wiersze;
+        kolumn = kolumny;
+        zeruj_obszar(dane.get(), ld, 0, wspolne_w, wspolne_k, kolumny);
+        zeruj_obszar(dane.get(), ld, wspolne_w, wiersze, 0, kolumny);
+        return;
+    }
+    if (dane != nullptr && jadra::pomnoz_rozmiary(wiersze, kolumny) <= pojemnosc) {
+        // Wiersze są przestawiane w miejscu na odstęp kolumny: przy większym
+        // odstępie od ostatniego wiersza, przy mniejszym – od pierwszego, by
+        // nie nadpisać jeszcze nieprzeniesionych danych.
+        T* d = dane.get();
+        if (kolumny > ld) {
+            for (ptrdiff_t i = wspolne_w - 1; i > 0; --i) {
+                move_backward(d + i * ld, d + i * ld + wspolne_k, d + i * kolumny + wspolne_k);
+            }
+        }
+        else {
+            for (ptrdiff_t i = 1; i < wspolne_w; ++i) {
+                move(d + i * ld, d + i * ld + wspolne_k, d + i * kolumny);
+            }
+        }
+        wierszy = wiersze;
+        kolumn = ld = kolumny;
+        zeruj_obszar(d, ld, 0, wspolne_w, wspolne_k, kolumny);
+        zeruj_obszar(d, ld, wspolne_w, wiersze, 0, kolumny);
+        return;
+    }
+
+    basic_matrix<T> nowa(*alok);
+    nowa.alokuj(wiersze, kolumny, bez_zerowania);
+    kopiuj(wspolne_w, wspolne_k, nowa.dane.get(), nowa.ld, dane.get(), ld);
+    zeruj_obszar(nowa.dane.get(), nowa.ld, 0, wspolne_w, wspolne_k, kolumny);
+    zeruj_obszar(nowa.dane.get(), nowa.ld, wspolne_w, wiersze, 0, kolumny);
+    swap(nowa);
+}
+
+/**
+ * @brief Rezerwuje pamięć na co najmniej @p liczba elementów, zachowując
+ *        wymiary, odstęp i zawartość.
+ *
+ * @param liczba Minimalna pojemność.
+ * @throw std::invalid_argument jeśli @p liczba < 0.
+ */
+template <typename T>
+void basic_matrix<T>::reserve(ptrdiff_t liczba) {
+    if (liczba < 0) throw invalid_argument("Rozmiar ujemny");
+    if (dane != nullptr && liczba <= pojemnosc) return;
+
+    jadra::tablica<T> nowe = jadra::przydziel_tablice<T>(*alok, liczba);
+    if (dane != nullptr) kopiuj(wierszy, kolumn, nowe.get(), ld, dane.get(), ld);
+    dane = std::move(nowe);
+    pojemnosc = liczba;
+}
+
+/**
+ * @brief Zmniejsza pojemność do @c rows()*cols() elementów, zachowując
+ *        zawartość; wiersze stają się ciągłe.
+ */
+template <typename T>
+void basic_matrix<T>::shrink_to_fit() {
+    const ptrdiff_t liczba = wierszy * kolumn;
+    if (dane == nullptr || (pojemnosc == liczba && ld == kolumn)) return;
+
+    jadra::tablica<T> nowe = jadra::przydziel_tablice<T>(*alok, liczba);
+    kopiuj(wierszy, kolumn, nowe.get(), kolumn, dane.get(), ld);
+    dane = std::move(nowe);
+    pojemnosc = liczba;
+    ld = kolumn;
+}
+
 /**
  * @brief Przelicza indeks (x, y) na indeks jednowymiarowy.
  *
  * @param x Indeks wiersza.
  * @param y Indeks kolumny.
  * @return Indeks w jednowymiarowej tablicy @c dane.
- * @throw std::out_of_range jeśli indeksy są poza zakresem 0..n-1.
+ * @throw std::out_of_range jeśli indeksy są poza zakresem.
  */
-int matrix::indeks(int x, int y) const {
-    if (x < 0 || x >= n || y < 0 || y >= n) {
+template <typename T>
+ptrdiff_t basic_matrix<T>::indeks(ptrdiff_t x, ptrdiff_t y) const {
+    if (x < 0 || x >= wierszy || y < 0 || y >= kolumn) {
         throw out_of_range("Indeks poza zakresem");
     }
-    return x * n + y;
+    return x * ld + y;
+}
+
+/**
+ * @brief Zeruje wszystkie elementy macierzy.
+ *
+ * Dla dużych macierzy zerowanie jest wykonywane równolegle.
+ */
+template <typename T>
+void basic_matrix<T>::zeruj_pamiec() {
+    T* d = dane.get();
+    const long long s = ld;
+    dla_odcinkow(wierszy, kolumn, ciagla(), [d, s](long long w, long long j, long long dl) {
+        fill(d + w * s + j, d + w * s + j + dl, T(0));
+    });
 }
 
 /**
@@ -142,7 +611,8 @@ int matrix::indeks(int x, int y) const {
  * @return Referencja do *this.
  * @throw std::out_of_range jeśli indeksy są nieprawidłowe.
  */
-matrix& matrix::wstaw(int x, int y, int wartosc) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::wstaw(ptrdiff_t x, ptrdiff_t y, T wartosc) {
     dane[indeks(x, y)] = wartosc;
     return *this;
 }
@@ -155,17 +625,56 @@ matrix& matrix::wstaw(int x, int y, int wartosc) {
  * @return Wartość w danym miejscu.
  * @throw std::out_of_range jeśli indeksy są nieprawidłowe.
  */
-int matrix::pokaz(int x, int y) const {
+template <typename T>
+T basic_matrix<T>::pokaz(ptrdiff_t x, ptrdiff_t y) const {
+    return dane[indeks(x, y)];
+}
+
+/**
+ * @brief Zwraca referencję do elementu (x, y) ze sprawdzeniem zakresu.
+ *
+ * @param x Indeks wiersza.
+ * @param y Indeks kolumny.
+ * @return Referencja do elementu.
+ * @throw std::out_of_range jeśli indeksy są nieprawidłowe.
+ */
+template <typename T>
+T& basic_matrix<T>::at(ptrdiff_t x, ptrdiff_t y) {
     return dane[indeks(x, y)];
 }
 
+/**
+ * @brief Zwraca referencję do elementu (x, y) ze sprawdzeniem zakresu.
+ *
+ * @param x Indeks wiersza.
+ * @param y Indeks kolumny.
+ * @return Stała referencja do elementu.
+ * @throw std::out_of_range jeśli indeksy są nieprawidłowe.
+ */
+template <typename T>
+const T& basic_matrix<T>::at(ptrdiff_t x, ptrdiff_t y) const {
+    return dane[indeks(x, y)];
+}
+
+/**
+ * @brief Zgłasza wyjątek dla nieprawidłowego indeksu (używane przez
+ *        sprawdzające wersje szybkiego dostępu).
+ *
+ * @throw std::out_of_range zawsze.
+ */
+template <typename T>
+void basic_matrix<T>::poza_zakresem() {
+    throw out_of_range("Indeks poza zakresem");
+}
+
 /**
  * @brief Zwraca rozmiar macierzy.
  *
- * @return Aktualny rozmiar @c n.
+ * @return Liczba wierszy (rozmiar macierzy kwadratowej).
  */
-int matrix::size() const {
-    return n;
+template <typename T>
+ptrdiff_t basic_matrix<T>::size() const {
+    return wierszy;
 }
 
 /**
@@ -173,19 +682,23 @@ int matrix::size() const {
  *
  * @return Liczba elementów, na jaką jest zaalokowana tablica @c dane.
  */
-int matrix::capacity() const {
+template <typename T>
+ptrdiff_t basic_matrix<T>::capacity() const {
     return pojemnosc;
 }
 
 /**
  * @brief Losowo wypełnia całą macierz wartościami 0..9.
  *
+ * Macierz jest wypełniana generatorem Philox (@ref jadra::losuj_jednostajnie
+ * – równolegle i wektorowo) z ziarnem złożonym z wyników @c rand(), więc
+ * wynik nadal zależy tylko od @c srand() (a nie od liczby wątków).
+ *
  * @return Referencja do *this.
  */
-matrix& matrix::losuj() {
-    for (int i = 0; i < n * n; ++i) {
-        dane[i] = rand() % 10;
-    }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::losuj() {
+    jadra::losuj_jednostajnie(dane.get(), wierszy, kolumn, ld, ziarno_z_rand(), T(0), T(9));
     return *this;
 }
 
@@ -193,14 +706,21 @@ matrix& matrix::losuj() {
  * @brief Losowo modyfikuje @p x elementów macierzy.
  *
  * W każdej iteracji losowany jest indeks i wstawiana wartość 0..9.
+ * Liczby pochodzą z generatora @ref philox z ziarnem z @c rand().
  *
  * @param x Liczba modyfikacji.
  * @return Referencja do *this.
  */
-matrix& matrix::losuj(int x) {
-    for (int k = 0; k < x; ++k) {
-        int losowy_idx = rand() % (n * n);
-        dane[losowy_idx] = rand() % 10;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::losuj(ptrdiff_t x) {
+    if (wierszy == 0 || kolumn == 0) return *this;
+    philox generator(ziarno_z_rand());
+    uniform_int_distribution<long long> losowy_indeks(0, static_cast<long long>(wierszy) * kolumn - 1);
+    uniform_int_distribution<int> losowa_wartosc(0, 9);
+    for (ptrdiff_t k = 0; k < x; ++k) {
+        const long long losowy_idx = losowy_indeks(generator);
+        dane[indeks(static_cast<ptrdiff_t>(losowy_idx / kolumn), static_cast<ptrdiff_t>(losowy_idx % kolumn))] =
+            static_cast<T>(losowa_wartosc(generator));
     }
     return *this;
 }
@@ -208,19 +728,22 @@ matrix& matrix::losuj(int x) {
 /**
  * @brief Transponuje macierz (zamienia wiersze z kolumnami).
  *
- * Tworzy pomocniczą macierz @c temp o tym samym rozmiarze
- * i przepisuje elementy na pozycje (j,i).
+ * Ciągła macierz kwadratowa jest transponowana w miejscu, przez zamianę
+ * bloków (@ref jadra::transponuj), bez pamięci pomocniczej. Macierz
+ * prostokątna (lub z dopełnionymi wierszami) jest transponowana do macierzy
+ * pomocniczej, której pamięć następnie przejmuje.
  *
  * @return Referencja do *this.
  */
-matrix& matrix::dowroc() {
-    matrix temp(n);
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            temp.wstaw(j, i, pokaz(i, j));
-        }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::dowroc() {
+    if (wierszy == kolumn && ciagla()) {
+        jadra::transponuj(wierszy, dane.get());
+        return *this;
     }
-    *this = temp;
+    basic_matrix<T> temp(*alok);
+    transponuj_do(temp, *this);
+    swap(temp);
     return *this;
 }
 
@@ -231,12 +754,14 @@ matrix& matrix::dowroc() {
  *
  * @return Referencja do *this.
  */
-matrix& matrix::szachownica() {
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            wstaw(i, j, (i + j) % 2);
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::szachownica() {
+    dla_wierszy(wierszy, kolumn, [this](ptrdiff_t i) {
+        T* w = row_ptr(i);
+        for (ptrdiff_t j = 0; j < kolumn; ++j) {
+            w[j] = static_cast<T>((i + j) % 2);
         }
-    }
+    });
     return *this;
 }
 
@@ -247,11 +772,12 @@ matrix& matrix::szachownica() {
  *
  * @return Referencja do *this.
  */
-matrix& matrix::przekatna() {
-    for (int i = 0; i < n * n; ++i) dane[i] = 0;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::przekatna() {
+    zeruj_pamiec();
 
-    for (int i = 0; i < n; ++i) {
-        wstaw(i, i, 1);
+    for (ptrdiff_t i = 0; i < min(wierszy, kolumn); ++i) {
+        (*this)(i, i) = T(1);
     }
     return *this;
 }
@@ -263,12 +789,14 @@ matrix& matrix::przekatna() {
  *
  * @return Referencja do *this.
  */
-matrix& matrix::pod_przekatna() {
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            wstaw(i, j, (i > j ? 1 : 0));
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::pod_przekatna() {
+    dla_wierszy(wierszy, kolumn, [this](ptrdiff_t i) {
+        T* w = row_ptr(i);
+        for (ptrdiff_t j = 0; j < kolumn; ++j) {
+            w[j] = static_cast<T>(i > j ? 1 : 0);
         }
-    }
+    });
     return *this;
 }
 
@@ -279,12 +807,14 @@ matrix& matrix::pod_przekatna() {
  *
  * @return Referencja do *this.
  */
-matrix& matrix::nad_przekatna() {
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            wstaw(i, j, (j > i ? 1 : 0));
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::nad_przekatna() {
+    dla_wierszy(wierszy, kolumn, [this](ptrdiff_t i) {
+        T* w = row_ptr(i);
+        for (ptrdiff_t j = 0; j < kolumn; ++j) {
+            w[j] = static_cast<T>(j > i ? 1 : 0);
         }
-    }
+    });
     return *this;
 }
 
@@ -294,14 +824,15 @@ matrix& matrix::nad_przekatna() {
  * Cała macierz jest wcześniej zerowana. Jeśli @p t == nullptr
  * metoda nie wykonuje żadnych zmian.
  *
- * @param t Tablica wartości przekątnej (o długości co najmniej @c n).
+ * @param t Tablica wartości przekątnej (o długości co najmniej min(wierszy, kolumn)).
  * @return Referencja do *this.
  */
-matrix& matrix::diagonalna(int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::diagonalna(T* t) {
     if (t == nullptr) return *this;
-    for (int i = 0; i < n * n; ++i) dane[i] = 0;
+    zeruj_pamiec();
 
-    for (int i = 0; i < n; ++i) wstaw(i, i, t[i]);
+    for (ptrdiff_t i = 0; i < min(wierszy, kolumn); ++i) (*this)(i, i) = t[i];
     return *this;
 }
 
@@ -316,15 +847,16 @@ matrix& matrix::diagonalna(int* t) {
  * @param t Tablica wartości przekątnej.
  * @return Referencja do *this.
  */
-matrix& matrix::diagonalna_k(int k, int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::diagonalna_k(ptrdiff_t k, T* t) {
     if (t == nullptr) return *this;
-    for (int i = 0; i < n * n; ++i) dane[i] = 0;
+    zeruj_pamiec();
     if (k >= 0) {
-        for (int i = 0; i < n - k; ++i) wstaw(i, i + k, t[i]);
+        for (ptrdiff_t i = 0; i < min(wierszy, kolumn - k); ++i) (*this)(i, i + k) = t[i];
     }
     else {
-        int p = -k;
-        for (int i = 0; i < n - p; ++i) wstaw(i + p, i, t[i]);
+        ptrdiff_t p = -k;
+        for (ptrdiff_t i = 0; i < min(wierszy - p, kolumn); ++i) (*this)(i + p, i) = t[i];
     }
     return *this;
 }
@@ -332,30 +864,32 @@ matrix& matrix::diagonalna_k(int k, int* t) {
 /**
  * @brief Ustawia wartości w kolumnie @p x według tablicy @p t.
  *
- * @param x Indeks kolumny (0..n-1).
- * @param t Tablica wartości o długości co najmniej @c n.
+ * @param x Indeks kolumny (0..kolumn-1).
+ * @param t Tablica wartości o długości co najmniej @c wierszy.
  * @return Referencja do *this.
  * @throw std::out_of_range jeśli @p x jest poza zakresem.
  */
-matrix& matrix::kolumna(int x, int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::kolumna(ptrdiff_t x, T* t) {
     if (t == nullptr) return *this;
-    if (x < 0 || x >= n) throw out_of_range("Zly indeks kolumny");
-    for (int i = 0; i < n; ++i) wstaw(i, x, t[i]);
+    if (x < 0 || x >= kolumn) throw out_of_range("Zly indeks kolumny");
+    for (ptrdiff_t i = 0; i < wierszy; ++i) (*this)(i, x) = t[i];
     return *this;
 }
 
 /**
  * @brief Ustawia wartości w wierszu @p y według tablicy @p t.
  *
- * @param y Indeks wiersza (0..n-1).
- * @param t Tablica wartości o długości co najmniej @c n.
+ * @param y Indeks wiersza (0..wierszy-1).
+ * @param t Tablica wartości o długości co najmniej @c kolumn.
  * @return Referencja do *this.
  * @throw std::out_of_range jeśli @p y jest poza zakresem.
  */
-matrix& matrix::wiersz(int y, int* t) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::wiersz(ptrdiff_t y, T* t) {
     if (t == nullptr) return *this;
-    if (y < 0 || y >= n) throw out_of_range("Zly indeks wiersza");
-    for (int j = 0; j < n; ++j) wstaw(y, j, t[j]);
+    if (y < 0 || y >= wierszy) throw out_of_range("Zly indeks wiersza");
+    copy(t, t + kolumn, row_ptr(y));
     return *this;
 }
 
@@ -365,8 +899,13 @@ matrix& matrix::wiersz(int y, int* t) {
  * @param a Dodawana wartość.
  * @return Referencja do *this.
  */
-matrix& matrix::operator+(int a) {
-    for (int i = 0; i < n * n; ++i) dane[i] += a;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator+(T a) {
+    T* d = dane.get();
+    const long long s = ld;
+    dla_odcinkow(wierszy, kolumn, ciagla(), [d, a, s](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().dodaj_skalar(d + w * s + j, dl, a);
+    });
     return *this;
 }
 
@@ -376,8 +915,13 @@ matrix& matrix::operator+(int a) {
  * @param a Odejmowana wartość.
  * @return Referencja do *this.
  */
-matrix& matrix::operator-(int a) {
-    for (int i = 0; i < n * n; ++i) dane[i] -= a;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator-(T a) {
+    T* d = dane.get();
+    const long long s = ld;
+    dla_odcinkow(wierszy, kolumn, ciagla(), [d, a, s](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().dodaj_skalar(d + w * s + j, dl, static_cast<T>(-a));
+    });
     return *this;
 }
 
@@ -387,8 +931,13 @@ matrix& matrix::operator-(int a) {
  * @param a Mnożnik.
  * @return Referencja do *this.
  */
-matrix& matrix::operator*(int a) {
-    for (int i = 0; i < n * n; ++i) dane[i] *= a;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator*(T a) {
+    T* d = dane.get();
+    const long long s = ld;
+    dla_odcinkow(wierszy, kolumn, ciagla(), [d, a, s](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().mnoz_skalar(d + w * s + j, dl, a);
+    });
     return *this;
 }
 
@@ -399,84 +948,142 @@ matrix& matrix::operator*(int a) {
  * @return Referencja do *this.
  * @throw std::invalid_argument jeśli rozmiary są różne.
  */
-matrix& matrix::operator+(const matrix& m) {
-    if (n != m.n) throw invalid_argument("Rozne wymiary macierzy!");
-    for (int i = 0; i < n * n; ++i) dane[i] += m.dane[i];
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator+(const basic_matrix<T>& m) {
+    if (wierszy != m.wierszy || kolumn != m.kolumn) throw invalid_argument("Rozne wymiary macierzy!");
+    T* d = dane.get();
+    const T* z = m.dane.get();
+    const long long sd = ld, sz = m.ld;
+    dla_odcinkow(wierszy, kolumn, ciagla() && m.ciagla(), [d, z, sd, sz](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().dodaj(d + w * sd + j, z + w * sz + j, dl);
+    });
     return *this;
 }
 
 /**
  * @brief Mnoży macierz przez inną macierz (mnożenie macierzowe, in-place).
  *
- * Wynik przechowywany jest w pomocniczej tablicy, a następnie
- * kopiowany do @c dane.
+ * Wynik liczony jest przez @ref jadra::gemm do pomocniczej tablicy,
+ * która następnie zastępuje @c dane (dzięki temu działa także A * A).
+ * Macierz m x k pomnożona przez k x n staje się macierzą m x n.
+ * Dla elementów 8- i 16-bitowych wynik jest zawężany do @p T
+ * (pełny wynik – zob. @ref pomnoz).
  *
  * @param m Drugi czynnik.
  * @return Referencja do *this (zawiera wynik).
- * @throw std::invalid_argument jeśli rozmiary są różne.
+ * @throw std::invalid_argument jeśli wymiary są niezgodne.
  */
-matrix& matrix::operator*(const matrix& m) {
-    if (n != m.n) throw invalid_argument("Rozne wymiary macierzy!");
-    auto wynik = std::make_unique<int[]>(n * n);
-
-    for (int w = 0; w < n; ++w) {
-        for (int k = 0; k < n; ++k) {
-            int suma = 0;
-            for (int i = 0; i < n; ++i) {
-                suma += pokaz(w, i) * m.pokaz(i, k);
-            }
-            wynik[w * n + k] = suma;
-        }
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator*(const basic_matrix<T>& m) {
+    if (kolumn != m.wierszy) throw invalid_argument("Rozne wymiary macierzy!");
+    if constexpr (!is_same_v<jadra::iloczyn_t<T>, T>) {
+        // Iloczyn liczony w 32 bitach i zawężany do T (zob. wyrazenia::iloczyn).
+        return *this = wyrazenia::wyr(*this) * m;
     }
-    for (int i = 0; i < n * n; ++i) dane[i] = wynik[i];
+    else {
+        const ptrdiff_t nowe_kolumny = m.kolumn;
+        const ptrdiff_t liczba = jadra::pomnoz_rozmiary(wierszy, nowe_kolumny);
+        jadra::tablica<T> wynik = jadra::przydziel_tablice<T>(*alok, liczba);
 
-    return *this;
+        jadra::gemm(wierszy, nowe_kolumny, kolumn, dane.get(), ld, m.dane.get(), m.ld, wynik.get(), nowe_kolumny);
+        dane.swap(wynik);
+        pojemnosc = liczba;
+        kolumn = ld = nowe_kolumny;
+
+        return *this;
+    }
 }
 
 /**
  * @brief Dodaje stałą @p a do macierzy (operator przypisania).
  *
- * Równoważne wywołaniu @ref matrix::operator+ "(a)".
+ * Równoważne wywołaniu @ref basic_matrix::operator+ "(a)".
  *
  * @param a Dodawana wartość.
  * @return Referencja do *this.
  */
-matrix& matrix::operator+=(int a) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator+=(T a) {
     return *this + a;
 }
 
 /**
  * @brief Odejmuje stałą @p a od macierzy (operator przypisania).
  *
- * Równoważne wywołaniu @ref matrix::operator- "(a)".
+ * Równoważne wywołaniu @ref basic_matrix::operator- "(a)".
  *
  * @param a Odejmowana wartość.
  * @return Referencja do *this.
  */
-matrix& matrix::operator-=(int a) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator-=(T a) {
     return *this - a;
 }
 
 /**
  * @brief Mnoży macierz przez stałą @p a (operator przypisania).
  *
- * Równoważne wywołaniu @ref matrix::operator* "(a)".
+ * Równoważne wywołaniu @ref basic_matrix::operator* "(a)".
  *
  * @param a Mnożnik.
  * @return Referencja do *this.
  */
-matrix& matrix::operator*=(int a) {
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator*=(T a) {
     return *this * a;
 }
 
+/**
+ * @brief Dodaje do macierzy inną macierz (operator przypisania).
+ *
+ * @param m Macierz dodawana.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli rozmiary są różne.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator+=(const basic_matrix<T>& m) {
+    return *this + m;
+}
+
+/**
+ * @brief Odejmuje od macierzy inną macierz (operator przypisania).
+ *
+ * Liczone jedną pętlą przez wyrażenie @c wyr(*this) - m.
+ *
+ * @param m Macierz odejmowana.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli rozmiary są różne.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator-=(const basic_matrix<T>& m) {
+    return *this = wyrazenia::wyr(*this) - m;
+}
+
+/**
+ * @brief Mnoży macierz przez inną macierz (operator przypisania).
+ *
+ * @param m Drugi czynnik.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli rozmiary są różne.
+ */
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator*=(const basic_matrix<T>& m) {
+    return *this * m;
+}
+
 /**
  * @brief Postinkrementacja (m++) – zwiększa każdy element o 1.
  *
  * @param dummy Nie używany; wymagany przez składnię postinkrementacji.
  * @return Referencja do *this po zwiększeniu elementów.
  */
-matrix& matrix::operator++(int) {
-    for (int i = 0; i < n * n; ++i) dane[i]++;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator++(int) {
+    T* d = dane.get();
+    const long long s = ld;
+    dla_odcinkow(wierszy, kolumn, ciagla(), [d, s](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().dodaj_skalar(d + w * s + j, dl, T(1));
+    });
     return *this;
 }
 
@@ -486,38 +1093,56 @@ matrix& matrix::operator++(int) {
  * @param dummy Nie używany; wymagany przez składnię postdekrementacji.
  * @return Referencja do *this po zmniejszeniu elementów.
  */
-matrix& matrix::operator--(int) {
-    for (int i = 0; i < n * n; ++i) dane[i]--;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator--(int) {
+    T* d = dane.get();
+    const long long s = ld;
+    dla_odcinkow(wierszy, kolumn, ciagla(), [d, s](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().dodaj_skalar(d + w * s + j, dl, static_cast<T>(-1));
+    });
     return *this;
 }
 
 /**
- * @brief Operator funkcyjny – dodaje do wszystkich elementów wartość @p a (rzutowaną na int).
+ * @brief Operator funkcyjny – dodaje do wszystkich elementów wartość @p a (rzutowaną na @p T).
  *
- * @param a Wartość typu double, rzutowana na int.
+ * @param a Wartość typu double, rzutowana na @p T.
  * @return Referencja do *this.
  */
-matrix& matrix::operator()(double a) {
-    int val = static_cast<int>(a);
-    for (int i = 0; i < n * n; ++i) dane[i] += val;
+template <typename T>
+basic_matrix<T>& basic_matrix<T>::operator()(double a) {
+    const T val = static_cast<T>(a);
+    T* d = dane.get();
+    const long long s = ld;
+    dla_odcinkow(wierszy, kolumn, ciagla(), [d, val, s](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().dodaj_skalar(d + w * s + j, dl, val);
+    });
     return *this;
 }
 
 /**
  * @brief Sprawdza równość dwóch macierzy.
  *
- * Macierze są równe, jeśli rozmiary są takie same
+ * Macierze są równe, jeśli wymiary są takie same
  * i wszystkie odpowiadające sobie elementy są identyczne.
  *
  * @param m Macierz porównywana.
  * @return true jeśli macierze są równe, w przeciwnym razie false.
  */
-bool matrix::operator==(const matrix& m) const {
-    if (n != m.n) return false;
-    for (int i = 0; i < n * n; ++i) {
-        if (dane[i] != m.dane[i]) return false;
-    }
-    return true;
+template <typename T>
+bool basic_matrix<T>::operator==(const basic_matrix<T>& m) const {
+    if (wierszy != m.wierszy || kolumn != m.kolumn) return false;
+    const T* a = dane.get();
+    const T* b = m.dane.get();
+    const long long sa = ld, sb = m.ld;
+    return dla_wszystkich(wierszy, kolumn, ciagla() && m.ciagla(), [a, b, sa, sb](long long w, long long j, long long dl) {
+        const T* x = a + w * sa + j;
+        const T* y = b + w * sb + j;
+        for (long long i = 0; i < dl; ++i) {
+            if (!(x[i] == y[i])) return false;
+        }
+        return true;
+    });
 }
 
 /**
@@ -529,12 +1154,20 @@ bool matrix::operator==(const matrix& m) const {
  * @param m Macierz porównywana.
  * @return true jeśli *this > m, w przeciwnym razie false.
  */
-bool matrix::operator>(const matrix& m) const {
-    if (n != m.n) return false;
-    for (int i = 0; i < n * n; ++i) {
-        if (dane[i] <= m.dane[i]) return false;
-    }
-    return true;
+template <typename T>
+bool basic_matrix<T>::operator>(const basic_matrix<T>& m) const {
+    if (wierszy != m.wierszy || kolumn != m.kolumn) return false;
+    const T* a = dane.get();
+    const T* b = m.dane.get();
+    const long long sa = ld, sb = m.ld;
+    return dla_wszystkich(wierszy, kolumn, ciagla() && m.ciagla(), [a, b, sa, sb](long long w, long long j, long long dl) {
+        const T* x = a + w * sa + j;
+        const T* y = b + w * sb + j;
+        for (long long i = 0; i < dl; ++i) {
+            if (!(x[i] > y[i])) return false;
+        }
+        return true;
+    });
 }
 
 /**
@@ -546,12 +1179,20 @@ bool matrix::operator>(const matrix& m) const {
  * @param m Macierz porównywana.
  * @return true jeśli *this < m, w przeciwnym razie false.
  */
-bool matrix::operator<(const matrix& m) const {
-    if (n != m.n) return false;
-    for (int i = 0; i < n * n; ++i) {
-        if (dane[i] >= m.dane[i]) return false;
-    }
-    return true;
+template <typename T>
+bool basic_matrix<T>::operator<(const basic_matrix<T>& m) const {
+    if (wierszy != m.wierszy || kolumn != m.kolumn) return false;
+    const T* a = dane.get();
+    const T* b = m.dane.get();
+    const long long sa = ld, sb = m.ld;
+    return dla_wszystkich(wierszy, kolumn, ciagla() && m.ciagla(), [a, b, sa, sb](long long w, long long j, long long dl) {
+        const T* x = a + w * sa + j;
+        const T* y = b + w * sb + j;
+        for (long long i = 0; i < dl; ++i) {
+            if (!(x[i] < y[i])) return false;
+        }
+        return true;
+    });
 }
 
 /**
@@ -563,12 +1204,28 @@ bool matrix::operator<(const matrix& m) const {
  * @param m Macierz.
  * @return Nowa macierz zawierająca wynik.
  */
-matrix operator+(int a, const matrix& m) {
-    matrix wynik = m;
+template <typename T>
+basic_matrix<T> operator+(type_identity_t<T> a, const basic_matrix<T>& m) {
+    basic_matrix<T> wynik = m;
     wynik + a;
     return wynik;
 }
 
+/**
+ * @brief Dodawanie skalaru do macierzy tymczasowej: a + m.
+ *
+ * Dodaje @p a do elementów @p m w miejscu i zwraca ją przez przeniesienie.
+ *
+ * @param a Skalar.
+ * @param m Macierz tymczasowa.
+ * @return Macierz zawierająca wynik.
+ */
+template <typename T>
+basic_matrix<T> operator+(type_identity_t<T> a, basic_matrix<T>&& m) {
+    m + a;
+    return std::move(m);
+}
+
 /**
  * @brief Mnożenie skalaru przez macierz: a * m.
  *
@@ -578,30 +1235,71 @@ matrix operator+(int a, const matrix& m) {
  * @param m Macierz.
  * @return Nowa macierz zawierająca wynik.
  */
-matrix operator*(int a, const matrix& m) {
-    matrix wynik = m;
+template <typename T>
+basic_matrix<T> operator*(type_identity_t<T> a, const basic_matrix<T>& m) {
+    basic_matrix<T> wynik = m;
     wynik* a;
     return wynik;
 }
 
+/**
+ * @brief Mnożenie skalaru przez macierz tymczasową: a * m.
+ *
+ * Mnoży elementy @p m przez @p a w miejscu i zwraca ją przez przeniesienie.
+ *
+ * @param a Skalar.
+ * @param m Macierz tymczasowa.
+ * @return Macierz zawierająca wynik.
+ */
+template <typename T>
+basic_matrix<T> operator*(type_identity_t<T> a, basic_matrix<T>&& m) {
+    m* a;
+    return std::move(m);
+}
+
 /**
  * @brief Odejmowanie macierzy od skalaru: a - m.
  *
- * Tworzy nową macierz tego samego rozmiaru co @p m,
+ * Tworzy nową macierz o tych samych wymiarach co @p m,
  * gdzie każdy element jest równy (a - m[i]).
  *
  * @param a Skalar.
  * @param m Macierz.
  * @return Nowa macierz zawierająca wynik.
  */
-matrix operator-(int a, const matrix& m) {
-    matrix wynik(m.n);
-    for (int i = 0; i < m.n * m.n; ++i) {
-        wynik.dane[i] = a - m.dane[i];
-    }
+template <typename T>
+basic_matrix<T> operator-(type_identity_t<T> a, const basic_matrix<T>& m) {
+    basic_matrix<T> wynik(m.get_allocator());
+    wynik.alokuj(m.rows(), m.cols(), bez_zerowania);
+    T* d = wynik.data();
+    const T* z = m.data();
+    const long long sd = wynik.stride(), sz = m.stride();
+    dla_odcinkow(m.rows(), m.cols(), m.ciagla(), [d, z, a, sd, sz](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().skalar_minus(d + w * sd + j, z + w * sz + j, dl, a);
+    });
     return wynik;
 }
 
+/**
+ * @brief Odejmowanie macierzy tymczasowej od skalaru: a - m.
+ *
+ * Zastępuje elementy @p m wartościami (a - m[i]) w miejscu i zwraca ją
+ * przez przeniesienie.
+ *
+ * @param a Skalar.
+ * @param m Macierz tymczasowa.
+ * @return Macierz zawierająca wynik.
+ */
+template <typename T>
+basic_matrix<T> operator-(type_identity_t<T> a, basic_matrix<T>&& m) {
+    T* d = m.data();
+    const long long s = m.stride();
+    dla_odcinkow(m.rows(), m.cols(), m.ciagla(), [d, a, s](long long w, long long j, long long dl) {
+        jadra::elementowe<T>().skalar_minus(d + w * s + j, d + w * s + j, dl, a);
+    });
+    return std::move(m);
+}
+
 /**
  * @brief Wypisuje macierz na strumień w czytelnym formacie.
  *
@@ -610,17 +1308,216 @@ matrix operator-(int a, const matrix& m) {
  * |    a    b    c |
  * @endcode
  *
+ * Przy domyślnym formatowaniu strumienia (flagi, locale "C") wiersze są
+ * składane w buforze przez @ref jadra::formatuj_liczbe i wysyłane porcjami
+ * po około 64 KiB; w przeciwnym razie każdy element przechodzi przez
+ * @c operator<< strumienia. Strumień nie jest opróżniany po wierszach.
+ *
  * @param o Strumień wyjściowy.
  * @param m Macierz do wypisania.
  * @return Referencja do strumienia @p o.
  */
-ostream& operator<<(ostream& o, const matrix& m) {
-    for (int i = 0; i < m.n; ++i) {
-        o << "| ";
-        for (int j = 0; j < m.n; ++j) {
-            o << setw(4) << m.pokaz(i, j) << " ";
+template <typename T>
+ostream& operator<<(ostream& o, const basic_matrix<T>& m) {
+    constexpr size_t PORCJA_WYPISANIA = size_t(1) << 16;
+    const int precyzja = static_cast<int>(o.precision());
+    const bool domyslny_format = (o.flags() & ~ios::skipws) == ios::dec && o.width() == 0 && precyzja >= 1 &&
+                                 precyzja <= 17 && o.getloc() == locale::classic();
+    if (!domyslny_format) {
+        for (ptrdiff_t i = 0; i < m.rows(); ++i) {
+            o << "| ";
+            const T* w = m.row_ptr(i);
+            for (ptrdiff_t j = 0; j < m.cols(); ++j) {
+                o << setw(4) << +w[j] << " ";
+            }
+            o << "|\n";
         }
-        o << "|" << endl;
+        return o;
     }
+
+    string bufor;
+    char liczba[jadra::MAKS_DLUGOSC_LICZBY];
+    for (ptrdiff_t i = 0; i < m.rows(); ++i) {
+        bufor += "| ";
+        const T* w = m.row_ptr(i);
+        for (ptrdiff_t j = 0; j < m.cols(); ++j) {
+            const char* koniec = jadra::formatuj_liczbe(liczba, +w[j], precyzja);
+            const ptrdiff_t dlugosc = koniec - liczba;
+            if (dlugosc < 4) bufor.append(static_cast<size_t>(4 - dlugosc), ' ');
+            bufor.append(liczba, static_cast<size_t>(dlugosc));
+            bufor += ' ';
+        }
+        bufor += "|\n";
+        if (bufor.size() >= PORCJA_WYPISANIA) {
+            o.write(bufor.data(), static_cast<streamsize>(bufor.size()));
+            bufor.clear();
+        }
+    }
+    o.write(bufor.data(), static_cast<streamsize>(bufor.size()));
     return o;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Zapisuje do @p wynik sumę a + b (jedna pętla, bez alokacji,
+ *        jeśli pojemność @p wynik wystarcza).
+ */
+template <typename T>
+basic_matrix<T>& dodaj_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, const basic_matrix<T>& b) {
+    return wynik = wyrazenia::wyr(a) + b;
+}
+
+/**
+ * @brief Zapisuje do @p wynik różnicę a - b.
+ */
+template <typename T>
+basic_matrix<T>& odejmij_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, const basic_matrix<T>& b) {
+    return wynik = wyrazenia::wyr(a) - b;
+}
+
+/**
+ * @brief Zapisuje do @p wynik macierz @p a powiększoną o stałą @p s.
+ */
+template <typename T>
+basic_matrix<T>& dodaj_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, type_identity_t<T> s) {
+    return wynik = wyrazenia::wyr(a) + s;
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn a * b (GEMM bezpośrednio do @p wynik;
+ *        bufor tymczasowy tylko, gdy @p wynik jest jednym z czynników).
+ *
+ * Dla elementów 8- i 16-bitowych @p wynik ma inny typ niż czynniki, więc
+ * nie może być żadnym z nich – GEMM zapisuje wtedy wynik od razu do niego.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik, const basic_matrix<T>& a, const basic_matrix<T>& b) {
+    if constexpr (is_same_v<jadra::iloczyn_t<T>, T>) {
+        return wynik = wyrazenia::wyr(a) * b;
+    }
+    else {
+        if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+        wynik.alokuj(a.rows(), b.cols(), bez_zerowania);
+        jadra::gemm(a.rows(), b.cols(), a.cols(), a.data(), a.stride(), b.data(), b.stride(),
+                    wynik.data(), wynik.stride());
+        return wynik;
+    }
+}
+
+/**
+ * @brief Zapisuje do @p wynik macierz @p a pomnożoną przez stałą @p s.
+ */
+template <typename T>
+basic_matrix<T>& pomnoz_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, type_identity_t<T> s) {
+    return wynik = wyrazenia::wyr(a) * s;
+}
+
+/**
+ * @brief Zapisuje do @p wynik macierz transponowaną do @p a.
+ *
+ * Jeśli @p wynik i @p a to ta sama macierz, wywołuje @ref basic_matrix::dowroc.
+ * Kopiowanie odbywa się blokami, by zapisy i odczyty trafiały w pamięć
+ * podręczną.
+ */
+template <typename T>
+basic_matrix<T>& transponuj_do(basic_matrix<T>& wynik, const basic_matrix<T>& a) {
+    if (&wynik == &a) return wynik.dowroc();
+
+    wynik.alokuj(a.cols(), a.rows(), bez_zerowania);
+    jadra::transponuj(a.rows(), a.cols(), a.data(), a.stride(), wynik.data(), wynik.stride());
+    return wynik;
+}
+
+/**
+ * @brief Zwraca sumę a + b jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> dodaj(const basic_matrix<T>& a, const basic_matrix<T>& b) {
+    basic_matrix<T> wynik(a.get_allocator());
+    dodaj_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca różnicę a - b jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> odejmij(const basic_matrix<T>& a, const basic_matrix<T>& b) {
+    basic_matrix<T> wynik(a.get_allocator());
+    odejmij_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca macierz @p a powiększoną o stałą @p s jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> dodaj(const basic_matrix<T>& a, type_identity_t<T> s) {
+    basic_matrix<T> wynik(a.get_allocator());
+    dodaj_do(wynik, a, s);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzowy a * b jako nową macierz.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(a.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca macierz @p a pomnożoną przez stałą @p s jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> pomnoz(const basic_matrix<T>& a, type_identity_t<T> s) {
+    basic_matrix<T> wynik(a.get_allocator());
+    pomnoz_do(wynik, a, s);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca macierz transponowaną do @p a jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> transponuj(const basic_matrix<T>& a) {
+    basic_matrix<T> wynik(a.get_allocator());
+    transponuj_do(wynik, a);
+    return wynik;
+}
+
+/**
+ * @brief Jawne konkretyzacje klasy i funkcji dla obsługiwanych typów elementów.
+ */
+#define MACIERZ_INSTANCJA(T)                                                                                     \
+    template class basic_matrix<T>;                                                                              \
+    template basic_matrix<T> operator+(type_identity_t<T>, const basic_matrix<T>&);                          \
+    template basic_matrix<T> operator+(type_identity_t<T>, basic_matrix<T>&&);                               \
+    template basic_matrix<T> operator-(type_identity_t<T>, const basic_matrix<T>&);                          \
+    template basic_matrix<T> operator-(type_identity_t<T>, basic_matrix<T>&&);                               \
+    template basic_matrix<T> operator*(type_identity_t<T>, const basic_matrix<T>&);                          \
+    template basic_matrix<T> operator*(type_identity_t<T>, basic_matrix<T>&&);                               \
+    template ostream& operator<<(ostream&, const basic_matrix<T>&);                                          \
+    template basic_matrix<T>& dodaj_do<T>(basic_matrix<T>&, const basic_matrix<T>&, const basic_matrix<T>&);     \
+    template basic_matrix<T>& odejmij_do<T>(basic_matrix<T>&, const basic_matrix<T>&, const basic_matrix<T>&);   \
+    template basic_matrix<T>& dodaj_do<T>(basic_matrix<T>&, const basic_matrix<T>&, type_identity_t<T>);          \
+    template basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do<T>(basic_matrix<jadra::iloczyn_t<T>>&,                  \
+                                                             const basic_matrix<T>&, const basic_matrix<T>&);    \
+    template basic_matrix<T>& pomnoz_do<T>(basic_matrix<T>&, const basic_matrix<T>&, type_identity_t<T>);         \
+    template basic_matrix<T>& transponuj_do<T>(basic_matrix<T>&, const basic_matrix<T>&);                        \
+    template basic_matrix<T> dodaj<T>(const basic_matrix<T>&, const basic_matrix<T>&);                           \
+    template basic_matrix<T> odejmij<T>(const basic_matrix<T>&, const basic_matrix<T>&);                         \
+    template basic_matrix<T> dodaj<T>(const basic_matrix<T>&, type_identity_t<T>);                               \
+    template basic_matrix<jadra::iloczyn_t<T>> pomnoz<T>(const basic_matrix<T>&, const basic_matrix<T>&);        \
+    template basic_matrix<T> pomnoz<T>(const basic_matrix<T>&, type_identity_t<T>);                              \
+    template basic_matrix<T> transponuj<T>(const basic_matrix<T>&);
+
+MACIERZ_INSTANCJA(int8_t)
+MACIERZ_INSTANCJA(int16_t)
+MACIERZ_INSTANCJA(int32_t)
+MACIERZ_INSTANCJA(int64_t)
+MACIERZ_INSTANCJA(float)
+MACIERZ_INSTANCJA(double)
+
+#undef MACIERZ_INSTANCJA
@@ -1,30 +1,106 @@
 #pragma once
 
+#include "gemm.h"
+#include "pamiec.h"
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
+#include <span>
+#include <type_traits>
 
 /**
- * @class matrix
- * @brief Klasa reprezentująca kwadratową macierz liczb całkowitych.
+ * @def MACIERZ_SPRAWDZAJ_INDEKSY
+ * @brief Polityka sprawdzania indeksów w szybkim dostępie
+ *        (@c basic_matrix::operator()(size_type, size_type), @c basic_matrix::row).
  *
- * Macierz jest przechowywana w postaci jednowymiarowej tablicy `int`
- * zaalokowanej dynamicznie, o rozmiarze @p n x @p n.
+ * Domyślnie 1 w kompilacji debug (@c _DEBUG), 0 w release. Można ją
+ * nadpisać flagą kompilatora, np. @c -DMACIERZ_SPRAWDZAJ_INDEKSY=1.
+ * Metody @c at, @c wstaw i @c pokaz sprawdzają indeksy zawsze.
+ */
+#ifndef MACIERZ_SPRAWDZAJ_INDEKSY
+#ifdef _DEBUG
+#define MACIERZ_SPRAWDZAJ_INDEKSY 1
+#else
+#define MACIERZ_SPRAWDZAJ_INDEKSY 0
+#endif
+#endif
+
+namespace wyrazenia {
+template <typename E> struct wyrazenie;
+}
+
+/**
+ * @struct bez_zerowania_t
+ * @brief Znacznik wyboru alokacji bez zerowania pamięci.
+ *
+ * Nowa pamięć ma wtedy zawartość nieokreśloną – przeznaczone dla kodu, który
+ * zaraz nadpisze całą macierz (np. @c losuj(), iloczyn, kopia), by uniknąć
+ * zbędnego przejścia po pamięci.
+ */
+struct bez_zerowania_t {
+    explicit bez_zerowania_t() = default;
+};
+
+/// Wartość znacznika @ref bez_zerowania_t, np. @c matrix(n, n, bez_zerowania).
+inline constexpr bez_zerowania_t bez_zerowania{};
+
+
+/**
+ * @class basic_matrix
+ * @brief Klasa reprezentująca prostokątną macierz o elementach typu @p T.
+ *
+ * Macierz @c rows() x @c cols() jest przechowywana wierszami w jednowymiarowej
+ * tablicy elementów @p T zaalokowanej dynamicznie (wyrównanej do 64 bajtów,
+ * duże macierze – na dużych stronach). Pamięć pochodzi z alokatora
+ * (@ref jadra::alokator) podanego przy konstrukcji lub domyślnego – np. z puli
+ * @ref jadra::pula_pamieci, która ponownie wykorzystuje bloki macierzy
+ * tymczasowych (zob. pamiec.h). Kolejne wiersze zaczynają się co
+ * @c stride() elementów (@c stride() >= @c cols(); domyślnie wiersze leżą
+ * w pamięci jeden za drugim). Macierz kwadratowa n x n to przypadek
+ * szczególny – metody opisane jako "n x n" dotyczą właśnie jej.
+ * Wymiary i indeksy są typu @ref size_type (@c std::ptrdiff_t), więc
+ * macierz może mieć więcej niż 2^31 elementów.
  *
  * Klasa udostępnia:
- * - różne konstruktory (domyślny, z rozmiarem, z tablicą, kopiujący),
- * - metody do alokacji/realokacji pamięci,
+ * - różne konstruktory (domyślny, z rozmiarem, z tablicą, kopiujący, przenoszący),
+ * - metody do alokacji/realokacji pamięci i zmiany rozmiaru z zachowaniem
+ *   zawartości (@ref resize, @ref reserve, @ref shrink_to_fit),
  * - metody do wstawiania i odczytywania elementów,
  * - funkcje generujące różne wzorce (szachownica, przekątne itd.),
  * - operatory arytmetyczne i porównania.
+ *
+ * Obsługiwane typy elementów: @c int8_t, @c int16_t, @c int32_t, @c int64_t,
+ * @c float i @c double (zob. aliasy @ref matrix, @ref matrix_i8 itd.).
+ * Mnożenie macierzowe korzysta z jąder SIMD właściwych dla typu, a duże
+ * iloczyny macierzy całkowitoliczbowych – z algorytmu Strassena-Winograda
+ * (zob. strassen.h); iloczyn macierzy 8- i 16-bitowych jest akumulowany
+ * w 32 bitach (zob. @ref pomnoz).
+ *
+ * @tparam T Typ elementów.
  */
-class matrix {
+template <typename T>
+class basic_matrix {
 public:
+    /// Typ elementów macierzy.
+    using value_type = T;
+
+    /// Typ wymiarów, indeksów i pojemności (64-bitowy na platformach 64-bitowych).
+    using size_type = std::ptrdiff_t;
+
     /**
      * @brief Konstruktor domyślny.
      *
      * Tworzy "pustą" macierz o rozmiarze 0 i pojemności 0.
      */
-    matrix();
+    basic_matrix();
+
+    /**
+     * @brief Tworzy pustą macierz pobierającą pamięć z alokatora @p a.
+     *
+     * @param a Alokator (musi żyć dłużej niż macierz).
+     */
+    explicit basic_matrix(jadra::alokator& a);
 
     /**
      * @brief Konstruktor z rozmiarem.
@@ -35,27 +111,133 @@ public:
      * @param n Rozmiar macierzy (liczba wierszy i kolumn).
      * @throw std::invalid_argument jeśli @p n < 0.
      */
-    matrix(int n);
+    basic_matrix(size_type n);
+
+    /**
+     * @brief Konstruktor macierzy prostokątnej.
+     *
+     * Tworzy macierz @p wiersze x @p kolumny wypełnioną zerami.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    basic_matrix(size_type wiersze, size_type kolumny);
+
+    /**
+     * @brief Konstruktor macierzy prostokątnej z alokatorem.
+     *
+     * Tworzy macierz @p wiersze x @p kolumny wypełnioną zerami; pamięć
+     * (także przy późniejszych realokacjach) pochodzi z alokatora @p a.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param a Alokator (musi żyć dłużej niż macierz).
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    basic_matrix(size_type wiersze, size_type kolumny, jadra::alokator& a);
+
+    /**
+     * @brief Konstruktor macierzy prostokątnej bez zerowania elementów.
+     *
+     * Tworzy macierz @p wiersze x @p kolumny o nieokreślonej zawartości;
+     * przed odczytem trzeba ją całą zapisać.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    basic_matrix(size_type wiersze, size_type kolumny, bez_zerowania_t);
+
+    /**
+     * @brief Konstruktor macierzy prostokątnej z tablicą danych.
+     *
+     * Kopiuje @p wiersze * @p kolumny elementów (wierszami) z tablicy @p t.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param t Wskaźnik na tablicę źródłową.
+     * @throw std::invalid_argument jeśli któryś wymiar nie jest dodatni
+     *        lub @p t == nullptr.
+     */
+    basic_matrix(size_type wiersze, size_type kolumny, const T* t);
 
     /**
      * @brief Konstruktor z rozmiarem i tablicą danych.
      *
      * Tworzy macierz @p n x @p n i kopiuje dane z tablicy @p t.
      *
+     * Przyjmuje tylko wskaźniki (i @c nullptr) – liczba całkowita, np.
+     * literał 0 w @c matrix(n, 0), wybiera konstruktor
+     * @ref basic_matrix(size_type, size_type).
+     *
      * @param n Rozmiar macierzy.
      * @param t Wskaźnik na tablicę źródłową o rozmiarze @p n * @p n.
      * @throw std::invalid_argument jeśli @p n <= 0 lub @p t == nullptr.
      */
-    matrix(int n, int* t);
+    template <typename P>
+        requires(!std::is_integral_v<P> && std::is_convertible_v<P, const T*>)
+    basic_matrix(size_type n, P t) : basic_matrix(n, n, static_cast<const T*>(t)) {}
+
+    /**
+     * @brief Konstruktor przejmujący gotową tablicę danych (bez kopiowania).
+     *
+     * Pozwala używać jako macierzy pamięci spoza alokatora macierzy, np.
+     * pliku zmapowanego przez @ref mapuj_macierz. Tablica jest zwalniana
+     * przez swój zwalniacz; późniejsze realokacje korzystają z alokatora
+     * @p a.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param odstep Odległość między początkami wierszy (>= @p kolumny).
+     * @param d Tablica co najmniej @p wiersze * @p odstep elementów.
+     * @param a Alokator (musi żyć dłużej niż macierz).
+     * @throw std::invalid_argument jeśli wymiar jest ujemny,
+     *        @p odstep < @p kolumny lub @p d jest pusta przy niezerowym
+     *        rozmiarze.
+     */
+    basic_matrix(size_type wiersze, size_type kolumny, size_type odstep, jadra::tablica<T> d,
+                 jadra::alokator& a = jadra::domyslny_alokator());
 
     /**
      * @brief Konstruktor kopiujący.
      *
-     * Tworzy kopię danej macierzy @p m.
+     * Tworzy kopię danej macierzy @p m (korzystającą z tego samego alokatora).
+     *
+     * @param m Macierz źródłowa.
+     */
+    basic_matrix(const basic_matrix& m);
+
+    /**
+     * @brief Konstruktor przenoszący.
+     *
+     * Przejmuje pamięć macierzy @p m bez kopiowania danych.
+     * Po operacji @p m jest pustą macierzą (rozmiar i pojemność 0).
+     *
+     * @param m Macierz źródłowa.
+     */
+    basic_matrix(basic_matrix&& m) noexcept;
+
+    /**
+     * @brief Konstruktor konwertujący z macierzy o innym typie elementów.
+     *
+     * Każdy element jest rzutowany (@c static_cast) na @p T.
      *
+     * @tparam U Typ elementów macierzy źródłowej.
      * @param m Macierz źródłowa.
      */
-    matrix(const matrix& m);
+    template <typename U>
+    explicit basic_matrix(const basic_matrix<U>& m);
+
+    /**
+     * @brief Konstruktor z leniwego wyrażenia (zob. wyrazenie.h).
+     *
+     * Oblicza wyrażenie jedną pętlą (lub przez GEMM dla iloczynów).
+     *
+     * @param e Wyrażenie.
+     */
+    template <typename E>
+    basic_matrix(const wyrazenia::wyrazenie<E>& e);
 
     /**
      * @brief Destruktor.
@@ -63,7 +245,7 @@ public:
      * Pamięć jest zarządzana przez std::unique_ptr, więc
      * zwalnianie odbywa się automatycznie.
      */
-    ~matrix();
+    ~basic_matrix();
 
     /**
      * @brief Operator przypisania.
@@ -73,7 +255,50 @@ public:
      * @param m Macierz źródłowa.
      * @return Referencja do *this.
      */
-    matrix& operator=(const matrix& m);
+    basic_matrix& operator=(const basic_matrix& m);
+
+    /**
+     * @brief Przenoszący operator przypisania.
+     *
+     * Zamienia pamięć *this z pamięcią @p m (bez kopiowania danych).
+     * Po operacji @p m zawiera dotychczasową zawartość *this.
+     *
+     * @param m Macierz źródłowa.
+     * @return Referencja do *this.
+     */
+    basic_matrix& operator=(basic_matrix&& m) noexcept;
+
+    /**
+     * @brief Zamienia zawartość (wymiary, pojemność, dane i alokator)
+     *        z macierzą @p m.
+     *
+     * @param m Macierz, z którą następuje zamiana.
+     */
+    void swap(basic_matrix& m) noexcept;
+
+    /**
+     * @brief Przypisuje macierzy wynik leniwego wyrażenia (zob. wyrazenie.h).
+     *
+     * Macierz może występować w wyrażeniu po prawej stronie.
+     *
+     * @param e Wyrażenie.
+     * @return Referencja do *this.
+     */
+    template <typename E>
+    basic_matrix& operator=(const wyrazenia::wyrazenie<E>& e);
+
+    /**
+     * @brief Dodaje do macierzy wynik leniwego wyrażenia (zob. wyrazenie.h).
+     *
+     * Iloczyn macierzowy (@c C += wyr(A) * B) jest akumulowany bezpośrednio
+     * przez GEMM, bez bufora pośredniego.
+     *
+     * @param e Wyrażenie.
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli rozmiary są różne.
+     */
+    template <typename E>
+    basic_matrix& operator+=(const wyrazenia::wyrazenie<E>& e);
 
     /**
      * @brief Alokuje lub realokuje pamięć dla macierzy.
@@ -87,18 +312,102 @@ public:
      * @return Referencja do *this.
      * @throw std::invalid_argument jeśli @p n < 0.
      */
-    matrix& alokuj(int n);
+    basic_matrix& alokuj(size_type n);
+
+    /**
+     * @brief Alokuje lub realokuje pamięć dla macierzy @p wiersze x @p kolumny.
+     *
+     * Zasady jak dla @ref alokuj(size_type). Wiersze leżą w pamięci jeden za
+     * drugim (@c stride() == @p kolumny); jeśli macierz ma już te wymiary,
+     * nic się nie zmienia.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    basic_matrix& alokuj(size_type wiersze, size_type kolumny);
+
+    /**
+     * @brief Alokuje macierz @p wiersze x @p kolumny z wierszami co
+     *        @p odstep elementów.
+     *
+     * Dopełnienie wierszy (np. do wielokrotności szerokości rejestru SIMD)
+     * pozwala wyrównać początki wierszy i uniknąć konfliktów w pamięci
+     * podręcznej przy kolumnach o długości będącej potęgą dwójki.
+     * Zawartość macierzy po zmianie odstępu jest nieokreślona.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param odstep Odległość (w elementach) między początkami wierszy.
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli wymiar jest ujemny lub
+     *        @p odstep < @p kolumny.
+     * @throw std::length_error jeśli @p wiersze * @p odstep elementów nie
+     *        mieści się w przestrzeni adresowej.
+     */
+    basic_matrix& alokuj(size_type wiersze, size_type kolumny, size_type odstep);
+
+    /**
+     * @brief Alokuje lub realokuje pamięć dla macierzy @p wiersze x @p kolumny
+     *        bez zerowania nowej pamięci.
+     *
+     * Jak @ref alokuj(size_type, size_type), ale zawartość macierzy po
+     * realokacji jest nieokreślona.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    basic_matrix& alokuj(size_type wiersze, size_type kolumny, bez_zerowania_t);
+
+    /**
+     * @brief Zmienia wymiary macierzy, zachowując jej zawartość.
+     *
+     * Elementy wspólnego lewego górnego bloku zachowują swoje wartości,
+     * nowe elementy są zerami. Jeśli nowa macierz mieści się w pojemności,
+     * zmiana odbywa się w tej samej tablicy (zerowane są tylko nowe
+     * elementy); w przeciwnym razie macierz jest przenoszona do nowej
+     * tablicy z ciągłymi wierszami.
+     *
+     * @param wiersze Nowa liczba wierszy.
+     * @param kolumny Nowa liczba kolumn.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     * @throw std::length_error jeśli liczba elementów przekracza zakres.
+     */
+    void resize(size_type wiersze, size_type kolumny);
+
+    /**
+     * @brief Rezerwuje pamięć na co najmniej @p liczba elementów.
+     *
+     * Wymiary, odstęp i zawartość macierzy się nie zmieniają; późniejsze
+     * @ref alokuj lub @ref resize mieszczące się w pojemności nie
+     * realokują pamięci.
+     *
+     * @param liczba Minimalna pojemność (w elementach).
+     * @throw std::invalid_argument jeśli @p liczba < 0.
+     */
+    void reserve(size_type liczba);
+
+    /**
+     * @brief Zmniejsza pojemność do @c rows()*cols() elementów.
+     *
+     * Zawartość jest zachowana, a wiersze po operacji leżą w pamięci
+     * jeden za drugim.
+     */
+    void shrink_to_fit();
 
     /**
      * @brief Wstawia wartość do komórki (x, y).
      *
-     * @param x Indeks wiersza (0 <= x < size()).
-     * @param y Indeks kolumny (0 <= y < size()).
+     * @param x Indeks wiersza (0 <= x < rows()).
+     * @param y Indeks kolumny (0 <= y < cols()).
      * @param wartosc Wstawiana wartość.
      * @return Referencja do *this.
      * @throw std::out_of_range jeśli indeksy są poza zakresem.
      */
-    matrix& wstaw(int x, int y, int wartosc);
+    basic_matrix& wstaw(size_type x, size_type y, T wartosc);
 
     /**
      * @brief Zwraca wartość z komórki (x, y).
@@ -108,30 +417,151 @@ public:
      * @return Wartość w komórce (x, y).
      * @throw std::out_of_range jeśli indeksy są poza zakresem.
      */
-    int pokaz(int x, int y) const;
+    T pokaz(size_type x, size_type y) const;
+
+    /**
+     * @brief Szybki dostęp do elementu (i, j).
+     *
+     * Indeksy są sprawdzane tylko przy włączonej polityce
+     * @ref MACIERZ_SPRAWDZAJ_INDEKSY; w release jest to zwykłe odwołanie
+     * do tablicy, które kompilator może wektoryzować.
+     *
+     * @param i Indeks wiersza.
+     * @param j Indeks kolumny.
+     * @return Referencja do elementu.
+     */
+    T& operator()(size_type i, size_type j);
+
+    /**
+     * @brief Szybki dostęp do elementu (i, j) (wersja stała).
+     *
+     * @param i Indeks wiersza.
+     * @param j Indeks kolumny.
+     * @return Stała referencja do elementu.
+     */
+    const T& operator()(size_type i, size_type j) const;
+
+    /**
+     * @brief Dostęp do elementu (x, y) ze sprawdzeniem zakresu.
+     *
+     * @param x Indeks wiersza.
+     * @param y Indeks kolumny.
+     * @return Referencja do elementu.
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    T& at(size_type x, size_type y);
+
+    /**
+     * @brief Dostęp do elementu (x, y) ze sprawdzeniem zakresu (wersja stała).
+     *
+     * @param x Indeks wiersza.
+     * @param y Indeks kolumny.
+     * @return Stała referencja do elementu.
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    const T& at(size_type x, size_type y) const;
+
+    /**
+     * @brief Zwraca wskaźnik na dane macierzy (wierszami, co @c stride()
+     *        elementów) – dla jąder obliczeniowych.
+     *
+     * @return Wskaźnik na pierwszy element (nullptr dla pustej macierzy).
+     */
+    T* data() noexcept { return dane.get(); }
+
+    /**
+     * @brief Zwraca wskaźnik na ciągłe dane macierzy (wersja stała).
+     *
+     * @return Wskaźnik na pierwszy element (nullptr dla pustej macierzy).
+     */
+    const T* data() const noexcept { return dane.get(); }
+
+    /**
+     * @brief Zwraca wskaźnik na początek wiersza @p i (bez sprawdzania zakresu).
+     *
+     * @param i Indeks wiersza.
+     * @return Wskaźnik na element (i, 0).
+     */
+    T* row_ptr(size_type i) noexcept { return dane.get() + i * ld; }
+
+    /**
+     * @brief Zwraca wskaźnik na początek wiersza @p i (wersja stała).
+     *
+     * @param i Indeks wiersza.
+     * @return Wskaźnik na element (i, 0).
+     */
+    const T* row_ptr(size_type i) const noexcept { return dane.get() + i * ld; }
+
+    /**
+     * @brief Zwraca wiersz @p i jako @c std::span.
+     *
+     * Indeks jest sprawdzany według polityki @ref MACIERZ_SPRAWDZAJ_INDEKSY.
+     *
+     * @param i Indeks wiersza.
+     * @return Widok na @c cols() elementów wiersza.
+     */
+    std::span<T> row(size_type i);
+
+    /**
+     * @brief Zwraca wiersz @p i jako @c std::span (wersja stała).
+     *
+     * @param i Indeks wiersza.
+     * @return Widok na @c cols() elementów wiersza.
+     */
+    std::span<const T> row(size_type i) const;
 
     /**
-     * @brief Zwraca aktualny rozmiar macierzy.
+     * @brief Zwraca aktualny rozmiar macierzy kwadratowej.
      *
-     * @return Rozmiar (liczba wierszy/kolumn).
+     * @return Rozmiar (liczba wierszy/kolumn); dla macierzy prostokątnej –
+     *         liczba wierszy.
      */
-    int size() const;
+    size_type size() const;
+
+    /**
+     * @brief Zwraca liczbę wierszy.
+     */
+    size_type rows() const noexcept { return wierszy; }
+
+    /**
+     * @brief Zwraca liczbę kolumn.
+     */
+    size_type cols() const noexcept { return kolumn; }
+
+    /**
+     * @brief Zwraca odległość (w elementach) między początkami kolejnych
+     *        wierszy (wiodący wymiar).
+     */
+    size_type stride() const noexcept { return ld; }
+
+    /**
+     * @brief Sprawdza, czy wiersze leżą w pamięci jeden za drugim
+     *        (@c stride() == @c cols()).
+     */
+    bool ciagla() const noexcept { return ld == kolumn; }
 
     /**
      * @brief Zwraca aktualną pojemność (liczbę zaalokowanych elementów).
      *
-     * @return Pojemność tablicy danych (co najmniej @c size()*size()).
+     * @return Pojemność tablicy danych (co najmniej @c rows()*stride()).
      */
-    int capacity() const;
+    size_type capacity() const;
+
+    /**
+     * @brief Zwraca alokator, z którego macierz pobiera pamięć.
+     */
+    jadra::alokator& get_allocator() const noexcept { return *alok; }
 
     /**
      * @brief Losowo wypełnia całą macierz.
      *
-     * Każdy element przyjmuje wartość z zakresu [0, 9].
+     * Każdy element przyjmuje wartość z zakresu [0, 9]. Wynik zależy od
+     * @c srand(); wypełnianie z jawnym ziarnem, przedziałem i rozkładem –
+     * zob. @ref losuj_jednostajnie i @ref losuj_normalnie (losowanie.h).
      *
      * @return Referencja do *this.
      */
-    matrix& losuj();
+    basic_matrix& losuj();
 
     /**
      * @brief Losowo zmienia @p x elementów macierzy.
@@ -141,16 +571,17 @@ public:
      * @param x Liczba losowych modyfikacji.
      * @return Referencja do *this.
      */
-    matrix& losuj(int x);
+    basic_matrix& losuj(size_type x);
 
     /**
      * @brief Transponuje macierz.
      *
-     * Zamienia wiersze z kolumnami.
+     * Zamienia wiersze z kolumnami. Ciągła macierz kwadratowa jest
+     * transponowana w miejscu; prostokątna – przez bufor pomocniczy.
      *
      * @return Referencja do *this.
      */
-    matrix& dowroc();
+    basic_matrix& dowroc();
 
     /**
      * @brief Wypełnia macierz wzorem szachownicy 0/1.
@@ -159,16 +590,17 @@ public:
      *
      * @return Referencja do *this.
      */
-    matrix& szachownica();
+    basic_matrix& szachownica();
 
     /**
      * @brief Tworzy macierz jednostkową.
      *
-     * Wszystkie elementy są zerowane, a na głównej przekątnej ustawiana jest 1.
+     * Wszystkie elementy są zerowane, a na głównej przekątnej ustawiana jest 1
+     * (dla macierzy prostokątnej – na min(rows(), cols()) pierwszych pozycjach).
      *
      * @return Referencja do *this.
      */
-    matrix& przekatna();
+    basic_matrix& przekatna();
 
     /**
      * @brief Wypełnia elementy poniżej głównej przekątnej jedynkami.
@@ -177,7 +609,7 @@ public:
      *
      * @return Referencja do *this.
      */
-    matrix& pod_przekatna();
+    basic_matrix& pod_przekatna();
 
     /**
      * @brief Wypełnia elementy powyżej głównej przekątnej jedynkami.
@@ -186,18 +618,18 @@ public:
      *
      * @return Referencja do *this.
      */
-    matrix& nad_przekatna();
+    basic_matrix& nad_przekatna();
 
     /**
      * @brief Ustawia przekątną główną według zadanej tablicy.
      *
      * Cała macierz jest wcześniej zerowana.
      *
-     * @param t Tablica długości co najmniej @c size(), zawierająca wartości przekątnej.
+     * @param t Tablica długości co najmniej min(rows(), cols()), zawierająca wartości przekątnej.
      * @return Referencja do *this.
      * @note Jeśli @p t == nullptr, metoda nic nie robi.
      */
-    matrix& diagonalna(int* t);
+    basic_matrix& diagonalna(T* t);
 
     /**
      * @brief Ustawia przekątną przesuniętą o @p k według tablicy @p t.
@@ -208,33 +640,33 @@ public:
      * - Jeśli @p k == 0, działa jak diagonalna().
      *
      * @param k Przesunięcie przekątnej względem głównej.
-     * @param t Tablica wartości przekątnej (długość co najmniej size() - abs(k)).
+     * @param t Tablica wartości przekątnej (długość równa liczbie elementów tej przekątnej).
      * @return Referencja do *this.
      * @note Jeśli @p t == nullptr, metoda nic nie robi.
      */
-    matrix& diagonalna_k(int k, int* t);
+    basic_matrix& diagonalna_k(size_type k, T* t);
 
     /**
      * @brief Ustawia wartości w kolumnie @p x na podstawie tablicy @p t.
      *
-     * @param x Indeks kolumny (0 <= x < size()).
-     * @param t Tablica o długości co najmniej @c size().
+     * @param x Indeks kolumny (0 <= x < cols()).
+     * @param t Tablica o długości co najmniej @c rows().
      * @return Referencja do *this.
      * @throw std::out_of_range jeśli indeks kolumny jest nieprawidłowy.
      * @note Jeśli @p t == nullptr, metoda nic nie robi.
      */
-    matrix& kolumna(int x, int* t);
+    basic_matrix& kolumna(size_type x, T* t);
 
     /**
      * @brief Ustawia wartości w wierszu @p y na podstawie tablicy @p t.
      *
-     * @param y Indeks wiersza (0 <= y < size()).
-     * @param t Tablica o długości co najmniej @c size().
+     * @param y Indeks wiersza (0 <= y < rows()).
+     * @param t Tablica o długości co najmniej @c cols().
      * @return Referencja do *this.
      * @throw std::out_of_range jeśli indeks wiersza jest nieprawidłowy.
      * @note Jeśli @p t == nullptr, metoda nic nie robi.
      */
-    matrix& wiersz(int y, int* t);
+    basic_matrix& wiersz(size_type y, T* t);
 
     /**
      * @brief Dodaje stałą @p a do wszystkich elementów macierzy (modyfikuje obiekt).
@@ -242,7 +674,7 @@ public:
      * @param a Dodawana wartość.
      * @return Referencja do *this.
      */
-    matrix& operator+(int a);
+    basic_matrix& operator+(T a);
 
     /**
      * @brief Odejmuje stałą @p a od wszystkich elementów macierzy (modyfikuje obiekt).
@@ -250,7 +682,7 @@ public:
      * @param a Odejmowana wartość.
      * @return Referencja do *this.
      */
-    matrix& operator-(int a);
+    basic_matrix& operator-(T a);
 
     /**
      * @brief Mnoży wszystkie elementy macierzy przez stałą @p a (modyfikuje obiekt).
@@ -258,7 +690,7 @@ public:
      * @param a Mnożnik.
      * @return Referencja do *this.
      */
-    matrix& operator*(int a);
+    basic_matrix& operator*(T a);
 
     /**
      * @brief Dodaje do macierzy inną macierz (element po elemencie).
@@ -269,18 +701,20 @@ public:
      * @return Referencja do *this.
      * @throw std::invalid_argument jeśli rozmiary macierzy są różne.
      */
-    matrix& operator+(const matrix& m);
+    basic_matrix& operator+(const basic_matrix& m);
 
     /**
      * @brief Mnożenie macierzy przez macierz.
      *
-     * Wynik nadpisuje bieżącą macierz (*this).
+     * Wynik nadpisuje bieżącą macierz (*this). Dla *this o wymiarach m x k
+     * i @p m o wymiarach k x n wynik ma wymiary m x n.
      *
      * @param m Drugi czynnik (macierz).
      * @return Referencja do *this (zawiera wynik mnożenia).
-     * @throw std::invalid_argument jeśli rozmiary macierzy są różne.
+     * @throw std::invalid_argument jeśli liczba kolumn *this jest różna
+     *        od liczby wierszy @p m.
      */
-    matrix& operator*(const matrix& m);
+    basic_matrix& operator*(const basic_matrix& m);
 
     /**
      * @brief Operator przypisania dodawania ze stałą.
@@ -290,7 +724,7 @@ public:
      * @param a Dodawana wartość.
      * @return Referencja do *this.
      */
-    matrix& operator+=(int a);
+    basic_matrix& operator+=(T a);
 
     /**
      * @brief Operator przypisania odejmowania ze stałą.
@@ -300,7 +734,7 @@ public:
      * @param a Odejmowana wartość.
      * @return Referencja do *this.
      */
-    matrix& operator-=(int a);
+    basic_matrix& operator-=(T a);
 
     /**
      * @brief Operator przypisania mnożenia przez stałą.
@@ -310,7 +744,38 @@ public:
      * @param a Mnożnik.
      * @return Referencja do *this.
      */
-    matrix& operator*=(int a);
+    basic_matrix& operator*=(T a);
+
+    /**
+     * @brief Dodaje do macierzy inną macierz (in-place).
+     *
+     * Równoważne wywołaniu @c *this + m.
+     *
+     * @param m Macierz dodawana.
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli rozmiary macierzy są różne.
+     */
+    basic_matrix& operator+=(const basic_matrix& m);
+
+    /**
+     * @brief Odejmuje od macierzy inną macierz (in-place).
+     *
+     * @param m Macierz odejmowana.
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli rozmiary macierzy są różne.
+     */
+    basic_matrix& operator-=(const basic_matrix& m);
+
+    /**
+     * @brief Mnoży macierz przez inną macierz (in-place).
+     *
+     * Równoważne wywołaniu @c *this * m.
+     *
+     * @param m Drugi czynnik.
+     * @return Referencja do *this (zawiera wynik mnożenia).
+     * @throw std::invalid_argument jeśli wymiary czynników są niezgodne.
+     */
+    basic_matrix& operator*=(const basic_matrix& m);
 
     /**
      * @brief Operator postinkrementacji (m++).
@@ -320,7 +785,7 @@ public:
      * @param dummy Parametr fikcyjny wymagany przez składnię postinkrementacji.
      * @return Referencja do *this (po zwiększeniu).
      */
-    matrix& operator++(int dummy);
+    basic_matrix& operator++(int dummy);
 
     /**
      * @brief Operator postdekrementacji (m--).
@@ -330,28 +795,28 @@ public:
      * @param dummy Parametr fikcyjny wymagany przez składnię postdekrementacji.
      * @return Referencja do *this (po zmniejszeniu).
      */
-    matrix& operator--(int dummy);
+    basic_matrix& operator--(int dummy);
 
     /**
      * @brief Operator funkcyjny.
      *
-     * Dodaje do każdego elementu rzutowaną na int wartość @p a.
+     * Dodaje do każdego elementu rzutowaną na @p T wartość @p a.
      *
-     * @param a Wartość typu double, rzutowana na int.
+     * @param a Wartość typu double, rzutowana na @p T.
      * @return Referencja do *this.
      */
-    matrix& operator()(double a);
+    basic_matrix& operator()(double a);
 
     /**
      * @brief Operator porównania na równość.
      *
-     * Dwie macierze są równe, jeśli mają ten sam rozmiar
+     * Dwie macierze są równe, jeśli mają te same wymiary
      * i wszystkie odpowiadające sobie elementy są identyczne.
      *
      * @param m Macierz porównywana.
      * @return true jeśli macierze są równe, w przeciwnym razie false.
      */
-    bool operator==(const matrix& m) const;
+    bool operator==(const basic_matrix& m) const;
 
     /**
      * @brief Operator "większy niż".
@@ -362,7 +827,7 @@ public:
      * @param m Macierz porównywana.
      * @return true jeśli @c *this jest "większa" od @p m, w przeciwnym razie false.
      */
-    bool operator>(const matrix& m) const;
+    bool operator>(const basic_matrix& m) const;
 
     /**
      * @brief Operator "mniejszy niż".
@@ -373,78 +838,343 @@ public:
      * @param m Macierz porównywana.
      * @return true jeśli @c *this jest "mniejsza" od @p m, w przeciwnym razie false.
      */
-    bool operator<(const matrix& m) const;
+    bool operator<(const basic_matrix& m) const;
 
-    /**
-     * @brief Dodawanie skalaru z lewej strony: a + m.
-     *
-     * Tworzy kopię macierzy @p m i dodaje do każdego elementu @p a.
-     *
-     * @param a Skalar.
-     * @param m Macierz.
-     * @return Nowa macierz zawierająca wynik dodawania.
-     */
-    friend matrix operator+(int a, const matrix& m);
+private:
+    size_type wierszy;       ///< Liczba wierszy.
+    size_type kolumn;        ///< Liczba kolumn.
+    size_type ld;            ///< Odległość między początkami wierszy (>= kolumn).
+    size_type pojemnosc;     ///< Aktualna pojemność zaalokowanej tablicy (liczba elementów).
+    jadra::tablica<T> dane;  ///< Zaalokowane dane macierzy (zob. pamiec.h).
+    jadra::alokator* alok;   ///< Alokator dostarczający pamięć @c dane.
 
     /**
-     * @brief Odejmowanie macierzy od skalaru: a - m.
-     *
-     * Tworzy nową macierz o tym samym rozmiarze co @p m,
-     * gdzie każdy element jest równy (a - m[i]).
+     * @brief Przelicza indeks dwuwymiarowy (x, y) na indeks jednowymiarowy.
      *
-     * @param a Skalar.
-     * @param m Macierz.
-     * @return Nowa macierz zawierająca wynik odejmowania.
+     * @param x Indeks wiersza.
+     * @param y Indeks kolumny.
+     * @return Indeks w jednowymiarowej tablicy @c dane.
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
      */
-    friend matrix operator-(int a, const matrix& m);
+    size_type indeks(size_type x, size_type y) const;
 
     /**
-     * @brief Mnożenie skalaru przez macierz: a * m.
-     *
-     * Tworzy kopię macierzy @p m i mnoży każdy element przez @p a.
-     *
-     * @param a Skalar.
-     * @param m Macierz.
-     * @return Nowa macierz zawierająca wynik mnożenia.
+     * @brief Zastępuje tablicę danych nową tablicą @p liczba elementów,
+     *        opcjonalnie wyzerowaną (wymiary są zerowane).
      */
-    friend matrix operator*(int a, const matrix& m);
+    void przydziel_pamiec(size_type liczba, bool zeruj);
 
     /**
-     * @brief Operator strumieniowy wypisania macierzy.
-     *
-     * Wypisuje macierz w formacie:
-     * @code
-     * |    1    2 |
-     * |    3    4 |
-     * @endcode
-     *
-     * @param o Strumień wyjściowy.
-     * @param m Macierz do wypisania.
-     * @return Referencja do strumienia @p o.
+     * @brief Wspólna część metod @ref alokuj: realokuje pamięć, jeśli
+     *        pojemność jest za mała, i ustawia wymiary.
      */
-    friend std::ostream& operator<<(std::ostream& o, const matrix& m);
-
-private:
-    int n;                     ///< Aktualny rozmiar macierzy (n x n).
-    int pojemnosc;             ///< Aktualna pojemność zaalokowanej tablicy (liczba elementów).
-    std::unique_ptr<int[]> dane; ///< Wskaźnik na zaalokowane dane macierzy.
+    basic_matrix& alokuj_pamiec(size_type wiersze, size_type kolumny, size_type odstep, bool zeruj);
 
     /**
-     * @brief Przelicza indeks dwuwymiarowy (x, y) na indeks jednowymiarowy.
-     *
-     * @param x Indeks wiersza.
-     * @param y Indeks kolumny.
-     * @return Indeks w jednowymiarowej tablicy @c dane.
-     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     * @brief Zeruje wszystkie elementy macierzy
+     *        (równolegle dla dużych macierzy).
      */
-    int indeks(int x, int y) const;
+    void zeruj_pamiec();
 
     /**
-     * @brief Zeruje pamięć do przechowywania macierzy.
+     * @brief Zgłasza wyjątek dla indeksu poza zakresem.
      *
-     * Deklaracja pomocniczej metody; w aktualnej implementacji nie jest używana.
+     * Wydzielone z metod inline, aby nie powiększały kodu pętli.
      *
-     * @param nowy_rozmiar Docelowy rozmiar (liczba elementów).
+     * @throw std::out_of_range zawsze.
      */
-    void zeruj_pamiec(int nowy_rozmiar);
-};
\ No newline at end of file
+    [[noreturn]] static void poza_zakresem();
+};
+
+template <typename T>
+inline T& basic_matrix<T>::operator()(size_type i, size_type j) {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+    if (i < 0 || i >= wierszy || j < 0 || j >= kolumn) poza_zakresem();
+#endif
+    return row_ptr(i)[j];
+}
+
+template <typename T>
+inline const T& basic_matrix<T>::operator()(size_type i, size_type j) const {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+    if (i < 0 || i >= wierszy || j < 0 || j >= kolumn) poza_zakresem();
+#endif
+    return row_ptr(i)[j];
+}
+
+template <typename T>
+inline std::span<T> basic_matrix<T>::row(size_type i) {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+    if (i < 0 || i >= wierszy) poza_zakresem();
+#endif
+    return { row_ptr(i), static_cast<size_t>(kolumn) };
+}
+
+template <typename T>
+inline std::span<const T> basic_matrix<T>::row(size_type i) const {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+    if (i < 0 || i >= wierszy) poza_zakresem();
+#endif
+    return { row_ptr(i), static_cast<size_t>(kolumn) };
+}
+
+template <typename T>
+template <typename U>
+basic_matrix<T>::basic_matrix(const basic_matrix<U>& m) : basic_matrix(m.get_allocator()) {
+    alokuj(m.rows(), m.cols(), bez_zerowania);
+    for (size_type i = 0; i < wierszy; ++i) {
+        const U* z = m.row_ptr(i);
+        T* d = row_ptr(i);
+        for (size_type j = 0; j < kolumn; ++j) d[j] = static_cast<T>(z[j]);
+    }
+}
+
+/**
+ * @name Aliasy typów macierzy
+ * @{
+ */
+using matrix = basic_matrix<int>;              ///< Macierz liczb @c int (domyślna).
+using matrix_i8 = basic_matrix<std::int8_t>;   ///< Macierz liczb 8-bitowych.
+using matrix_i16 = basic_matrix<std::int16_t>; ///< Macierz liczb 16-bitowych.
+using matrix_i32 = basic_matrix<std::int32_t>; ///< Macierz liczb 32-bitowych.
+using matrix_i64 = basic_matrix<std::int64_t>; ///< Macierz liczb 64-bitowych.
+using matrix_f32 = basic_matrix<float>;        ///< Macierz liczb @c float.
+using matrix_f64 = basic_matrix<double>;       ///< Macierz liczb @c double.
+/** @} */
+
+/**
+ * @name Operatory ze skalarem po lewej stronie
+ *
+ * Skalar jest typu elementów macierzy (@c std::type_identity_t wyłącza go
+ * z dedukcji, więc np. @c 2 * macierz_f64 działa bez rzutowania).
+ * @{
+ */
+
+/**
+ * @brief Dodawanie skalaru z lewej strony: a + m.
+ *
+ * Tworzy kopię macierzy @p m i dodaje do każdego elementu @p a.
+ *
+ * @param a Skalar.
+ * @param m Macierz.
+ * @return Nowa macierz zawierająca wynik dodawania.
+ */
+template <typename T>
+basic_matrix<T> operator+(std::type_identity_t<T> a, const basic_matrix<T>& m);
+
+/**
+ * @brief Dodawanie skalaru do macierzy tymczasowej: a + m.
+ *
+ * Wynik jest liczony w pamięci @p m, bez alokacji.
+ *
+ * @param a Skalar.
+ * @param m Macierz tymczasowa.
+ * @return Macierz zawierająca wynik (przejęta pamięć @p m).
+ */
+template <typename T>
+basic_matrix<T> operator+(std::type_identity_t<T> a, basic_matrix<T>&& m);
+
+/**
+ * @brief Odejmowanie macierzy od skalaru: a - m.
+ *
+ * Tworzy nową macierz o tym samym rozmiarze co @p m,
+ * gdzie każdy element jest równy (a - m[i]).
+ *
+ * @param a Skalar.
+ * @param m Macierz.
+ * @return Nowa macierz zawierająca wynik odejmowania.
+ */
+template <typename T>
+basic_matrix<T> operator-(std::type_identity_t<T> a, const basic_matrix<T>& m);
+
+/**
+ * @brief Odejmowanie macierzy tymczasowej od skalaru: a - m.
+ *
+ * Wynik jest liczony w pamięci @p m, bez alokacji.
+ *
+ * @param a Skalar.
+ * @param m Macierz tymczasowa.
+ * @return Macierz zawierająca wynik (przejęta pamięć @p m).
+ */
+template <typename T>
+basic_matrix<T> operator-(std::type_identity_t<T> a, basic_matrix<T>&& m);
+
+/**
+ * @brief Mnożenie skalaru przez macierz: a * m.
+ *
+ * Tworzy kopię macierzy @p m i mnoży każdy element przez @p a.
+ *
+ * @param a Skalar.
+ * @param m Macierz.
+ * @return Nowa macierz zawierająca wynik mnożenia.
+ */
+template <typename T>
+basic_matrix<T> operator*(std::type_identity_t<T> a, const basic_matrix<T>& m);
+
+/**
+ * @brief Mnożenie skalaru przez macierz tymczasową: a * m.
+ *
+ * Wynik jest liczony w pamięci @p m, bez alokacji.
+ *
+ * @param a Skalar.
+ * @param m Macierz tymczasowa.
+ * @return Macierz zawierająca wynik (przejęta pamięć @p m).
+ */
+template <typename T>
+basic_matrix<T> operator*(std::type_identity_t<T> a, basic_matrix<T>&& m);
+
+/** @} */
+
+/**
+ * @brief Operator strumieniowy wypisania macierzy.
+ *
+ * Wypisuje macierz w formacie:
+ * @code
+ * |    1    2 |
+ * |    3    4 |
+ * @endcode
+ * Elementy 8-bitowe są wypisywane jako liczby, nie znaki.
+ *
+ * @param o Strumień wyjściowy.
+ * @param m Macierz do wypisania.
+ * @return Referencja do strumienia @p o.
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& o, const basic_matrix<T>& m);
+
+/**
+ * @name Operacje bez efektów ubocznych
+ *
+ * Operatory klasy @ref basic_matrix modyfikują lewy argument. Poniższe funkcje
+ * nie zmieniają argumentów:
+ * - wersje zwracające wartość (np. @ref pomnoz) tworzą nową macierz,
+ * - wersje z parametrem wyjściowym (np. @ref pomnoz_do) zapisują wynik
+ *   do macierzy @p wynik, używając ponownie jej pamięci, jeśli pojemność
+ *   wystarcza – w pętli nie alokują więc pamięci.
+ *
+ * Macierz @p wynik może być jednym z argumentów; dla mnożenia macierzowego
+ * wymaga to wtedy bufora tymczasowego.
+ * @{
+ */
+
+/**
+ * @brief Zapisuje do @p wynik sumę a + b.
+ *
+ * @param wynik Macierz wynikowa.
+ * @param a Pierwszy składnik.
+ * @param b Drugi składnik.
+ * @return Referencja do @p wynik.
+ * @throw std::invalid_argument jeśli rozmiary @p a i @p b są różne.
+ */
+template <typename T>
+basic_matrix<T>& dodaj_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zapisuje do @p wynik różnicę a - b.
+ *
+ * @param wynik Macierz wynikowa.
+ * @param a Odjemna.
+ * @param b Odjemnik.
+ * @return Referencja do @p wynik.
+ * @throw std::invalid_argument jeśli rozmiary @p a i @p b są różne.
+ */
+template <typename T>
+basic_matrix<T>& odejmij_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zapisuje do @p wynik macierz @p a powiększoną o stałą @p s.
+ *
+ * @param wynik Macierz wynikowa.
+ * @param a Macierz.
+ * @param s Dodawana stała.
+ * @return Referencja do @p wynik.
+ */
+template <typename T>
+basic_matrix<T>& dodaj_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, std::type_identity_t<T> s);
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzowy a * b.
+ *
+ * Dla @p a o wymiarach m x k i @p b o wymiarach k x n wynik ma wymiary
+ * m x n. Iloczyny macierz-wektor (n == 1) i wektor-macierz (m == 1) są
+ * liczone osobnymi jądrami (@ref jadra::gemv, @ref jadra::gevm).
+ *
+ * Iloczyn macierzy 8- i 16-bitowych ma elementy @c int32_t (akumulacja
+ * bez przepełnienia dla typowych rozmiarów); w pozostałych przypadkach
+ * typ wyniku jest typem argumentów.
+ *
+ * @param wynik Macierz wynikowa.
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @return Referencja do @p wynik.
+ * @throw std::invalid_argument jeśli wymiary @p a i @p b są niezgodne.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik, const basic_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zapisuje do @p wynik macierz @p a pomnożoną przez stałą @p s.
+ *
+ * @param wynik Macierz wynikowa.
+ * @param a Macierz.
+ * @param s Mnożnik.
+ * @return Referencja do @p wynik.
+ */
+template <typename T>
+basic_matrix<T>& pomnoz_do(basic_matrix<T>& wynik, const basic_matrix<T>& a, std::type_identity_t<T> s);
+
+/**
+ * @brief Zapisuje do @p wynik macierz transponowaną do @p a.
+ *
+ * @param wynik Macierz wynikowa.
+ * @param a Macierz transponowana.
+ * @return Referencja do @p wynik.
+ */
+template <typename T>
+basic_matrix<T>& transponuj_do(basic_matrix<T>& wynik, const basic_matrix<T>& a);
+
+/**
+ * @brief Zwraca sumę a + b jako nową macierz.
+ *
+ * @throw std::invalid_argument jeśli rozmiary są różne.
+ */
+template <typename T>
+basic_matrix<T> dodaj(const basic_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zwraca różnicę a - b jako nową macierz.
+ *
+ * @throw std::invalid_argument jeśli rozmiary są różne.
+ */
+template <typename T>
+basic_matrix<T> odejmij(const basic_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zwraca macierz @p a powiększoną o stałą @p s jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> dodaj(const basic_matrix<T>& a, std::type_identity_t<T> s);
+
+/**
+ * @brief Zwraca iloczyn macierzowy a * b jako nową macierz.
+ *
+ * Typ elementów wyniku – jak dla @ref pomnoz_do.
+ *
+ * @throw std::invalid_argument jeśli wymiary są niezgodne.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zwraca macierz @p a pomnożoną przez stałą @p s jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> pomnoz(const basic_matrix<T>& a, std::type_identity_t<T> s);
+
+/**
+ * @brief Zwraca macierz transponowaną do @p a jako nową macierz.
+ */
+template <typename T>
+basic_matrix<T> transponuj(const basic_matrix<T>& a);
+
+/** @} */
@@ -0,0 +1,327 @@
+#include "pamiec.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace jadra {
+
+namespace {
+
+std::atomic<const char*> ostatni_rodzaj{ "brak" }; ///< Zwracane przez rodzaj_duzych_stron().
+
+/**
+ * @brief Alokator przekazujący każde żądanie do @ref przydziel / @ref zwolnij.
+ */
+class alokator_systemowy : public alokator {
+public:
+    void* przydziel(std::size_t bajtow) override { return jadra::przydziel(bajtow); }
+    void zwolnij(void* p, std::size_t bajtow) noexcept override { jadra::zwolnij(p, bajtow); }
+};
+
+alokator_systemowy systemowy;                  ///< Zwracany przez alokator_wyrownany().
+std::atomic<alokator*> domyslny{ &systemowy }; ///< Zwracany przez domyslny_alokator().
+
+/**
+ * @brief Sprawdza, czy duże strony są włączone (zmienna środowiskowa
+ *        @c MACIERZE_DUZE_STRONY różna od "0"; odczytywana raz).
+ */
+bool duze_strony_wlaczone() {
+    static const bool wlaczone = [] {
+        bool w = true;
+#ifdef _MSC_VER
+        char* wartosc = nullptr;
+        size_t dlugosc = 0;
+        if (_dupenv_s(&wartosc, &dlugosc, "MACIERZE_DUZE_STRONY") == 0 && wartosc != nullptr) {
+            w = std::atoi(wartosc) != 0;
+            std::free(wartosc);
+        }
+#else
+        if (const char* wartosc = std::getenv("MACIERZE_DUZE_STRONY")) w = std::atoi(wartosc) != 0;
+#endif
+        return w;
+    }();
+    return wlaczone;
+}
+
+/// Zaokrągla @p x w górę do wielokrotności @p k (potęgi dwójki).
+inline std::size_t zaokraglij(std::size_t x, std::size_t k) {
+    return (x + k - 1) & ~(k - 1);
+}
+
+#if defined(_WIN32)
+
+/**
+ * @brief Mapuje duży blok przez @c VirtualAlloc – na dużych stronach, jeśli
+ *        proces ma do nich uprawnienie.
+ */
+void* mapuj_duzy(std::size_t bajtow) {
+    if (duze_strony_wlaczone()) {
+        const SIZE_T strona = GetLargePageMinimum();
+        if (strona != 0) {
+            void* p = VirtualAlloc(nullptr, zaokraglij(bajtow, strona),
+                                   MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (p != nullptr) {
+                ostatni_rodzaj = "large pages";
+                return p;
+            }
+        }
+    }
+    void* p = VirtualAlloc(nullptr, bajtow, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (p == nullptr) throw std::bad_alloc();
+    ostatni_rodzaj = "zwykle";
+    return p;
+}
+
+void odmapuj_duzy(void* p, std::size_t) noexcept {
+    VirtualFree(p, 0, MEM_RELEASE);
+}
+
+#elif defined(__linux__)
+
+/// Rozmiar dużej strony (2 MiB na x86-64 i większości konfiguracji ARM64).
+constexpr std::size_t DUZA_STRONA = std::size_t(2) << 20;
+
+/**
+ * @brief Mapuje duży blok przez @c mmap: najpierw z jawnymi stronami
+ *        @c MAP_HUGETLB, potem zwykły obszar wyrównany do 2 MiB oznaczony
+ *        @c MADV_HUGEPAGE.
+ *
+ * Długość mapowania to zawsze @p bajtow zaokrąglone do 2 MiB, więc
+ * @ref odmapuj_duzy nie musi wiedzieć, który wariant został użyty.
+ */
+void* mapuj_duzy(std::size_t bajtow) {
+    const std::size_t dl = zaokraglij(bajtow, DUZA_STRONA);
+    const bool duze = duze_strony_wlaczone();
+#ifdef MAP_HUGETLB
+    if (duze) {
+        int flagi = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+        flagi |= 21 << MAP_HUGE_SHIFT;
+#endif
+        void* p = mmap(nullptr, dl, PROT_READ | PROT_WRITE, flagi, -1, 0);
+        if (p != MAP_FAILED) {
+            ostatni_rodzaj = "hugetlb";
+            return p;
+        }
+    }
+#endif
+    // Nadmiarowe mapowanie, z którego wycinany jest obszar wyrównany do 2 MiB –
+    // tylko taki jądro może obsłużyć przezroczystymi dużymi stronami.
+    void* surowy = mmap(nullptr, dl + DUZA_STRONA, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (surowy == MAP_FAILED) throw std::bad_alloc();
+    char* poczatek = static_cast<char*>(surowy);
+    char* p = reinterpret_cast<char*>(zaokraglij(reinterpret_cast<std::uintptr_t>(poczatek), DUZA_STRONA));
+    if (p > poczatek) munmap(poczatek, static_cast<std::size_t>(p - poczatek));
+    char* koniec = poczatek + dl + DUZA_STRONA;
+    if (koniec > p + dl) munmap(p + dl, static_cast<std::size_t>(koniec - (p + dl)));
+
+    const char* rodzaj = "zwykle";
+#ifdef MADV_HUGEPAGE
+    if (duze && madvise(p, dl, MADV_HUGEPAGE) == 0) rodzaj = "przezroczyste";
+#endif
+    ostatni_rodzaj = rodzaj;
+    return p;
+}
+
+void odmapuj_duzy(void* p, std::size_t bajtow) noexcept {
+    munmap(p, zaokraglij(bajtow, DUZA_STRONA));
+}
+
+#endif
+
+} // namespace
+
+/**
+ * @brief Mnoży dwa nieujemne rozmiary ze sprawdzeniem przepełnienia.
+ */
+std::ptrdiff_t pomnoz_rozmiary(std::ptrdiff_t a, std::ptrdiff_t b) {
+    if (a < 0 || b < 0) throw std::length_error("Rozmiar ujemny");
+    if (a != 0 && b > PTRDIFF_MAX / a) throw std::length_error("Rozmiar macierzy przekracza zakres");
+    return a * b;
+}
+
+/**
+ * @brief Przydziela wyrównany blok.
+ *
+ * Małe bloki pochodzą z wyrównanego @c operator new; duże są mapowane od
+ * systemu, który przydziela strony fizycznie dopiero przy pierwszym zapisie.
+ */
+void* przydziel(std::size_t bajtow) {
+#if defined(_WIN32) || defined(__linux__)
+    if (bajtow >= PROG_DUZYCH_STRON) return mapuj_duzy(bajtow);
+#endif
+    return ::operator new(bajtow, std::align_val_t(WYROWNANIE));
+}
+
+/**
+ * @brief Zwalnia blok w sposób odpowiadający temu, jak został przydzielony.
+ */
+void zwolnij(void* p, std::size_t bajtow) noexcept {
+    if (p == nullptr) return;
+#if defined(_WIN32) || defined(__linux__)
+    if (bajtow >= PROG_DUZYCH_STRON) {
+        odmapuj_duzy(p, bajtow);
+        return;
+    }
+#endif
+    ::operator delete(p, std::align_val_t(WYROWNANIE));
+}
+
+/**
+ * @brief Zwraca rodzaj stron ostatniej dużej alokacji.
+ */
+const char* rodzaj_duzych_stron() {
+    return ostatni_rodzaj.load();
+}
+
+/**
+ * @brief Zwraca alokator przydzielający bloki prosto od systemu.
+ */
+alokator& alokator_wyrownany() {
+    return systemowy;
+}
+
+/**
+ * @brief Zwraca alokator domyślny dla nowych macierzy.
+ */
+alokator& domyslny_alokator() {
+    return *domyslny.load();
+}
+
+/**
+ * @brief Ustawia alokator domyślny dla nowych macierzy.
+ */
+void ustaw_domyslny_alokator(alokator& a) {
+    domyslny.store(&a);
+}
+
+/**
+ * @brief Tworzy pustą pulę pobierającą bloki z @p zrodlo.
+ */
+pula_pamieci::pula_pamieci(alokator& zrodlo, std::size_t limit)
+    : zrodlo(zrodlo), limit(limit), zatrzymanych(0) {
+}
+
+/**
+ * @brief Oddaje zatrzymane bloki źródłu.
+ */
+pula_pamieci::~pula_pamieci() {
+    oproznij();
+}
+
+/**
+ * @brief Wyznacza klasę rozmiaru.
+ *
+ * Bloki do @ref WYROWNANIE bajtów mają klasę 0. Dla 2^k < @p bajtow <= 2^(k+1)
+ * klasy to 2^k + q * 2^(k-2), q = 1..4 (numer 4k + q - 1).
+ */
+int pula_pamieci::klasa(std::size_t& bajtow) {
+    if (bajtow <= WYROWNANIE) {
+        bajtow = WYROWNANIE;
+        return 0;
+    }
+    const int k = static_cast<int>(std::bit_width(bajtow - 1)) - 1;
+    const std::size_t baza = std::size_t(1) << k;
+    const std::size_t krok = baza / 4;
+    const std::size_t q = (bajtow - baza + krok - 1) / krok;
+    bajtow = baza + q * krok;
+    return 4 * k + static_cast<int>(q) - 1;
+}
+
+/**
+ * @brief Zwraca rozmiar bloków klasy @p k (odwrotność @ref klasa).
+ */
+std::size_t pula_pamieci::rozmiar_klasy(int k) {
+    if (k == 0) return WYROWNANIE;
+    const std::size_t baza = std::size_t(1) << (k / 4);
+    return baza + static_cast<std::size_t>(k % 4 + 1) * (baza / 4);
+}
+
+/**
+ * @brief Oddaje wolny blok klasy rozmiaru @p bajtow albo pobiera nowy ze źródła.
+ */
+void* pula_pamieci::przydziel(std::size_t bajtow) {
+    const int k = klasa(bajtow);
+    {
+        std::lock_guard<std::mutex> lk(m);
+        std::vector<void*>& lista = wolne[k];
+        if (!lista.empty()) {
+            void* p = lista.back();
+            lista.pop_back();
+            zatrzymanych -= bajtow;
+            return p;
+        }
+    }
+    return zrodlo.przydziel(bajtow);
+}
+
+/**
+ * @brief Zatrzymuje blok na liście wolnych bloków jego klasy (albo oddaje go
+ *        źródłu, jeśli pula osiągnęła limit).
+ */
+void pula_pamieci::zwolnij(void* p, std::size_t bajtow) noexcept {
+    if (p == nullptr) return;
+    const int k = klasa(bajtow);
+    {
+        std::lock_guard<std::mutex> lk(m);
+        if (bajtow <= limit - std::min(limit, zatrzymanych)) {
+            try {
+                wolne[k].push_back(p);
+                zatrzymanych += bajtow;
+                return;
+            }
+            catch (const std::bad_alloc&) {
+                // Brak miejsca na liście – blok wraca do źródła.
+            }
+        }
+    }
+    zrodlo.zwolnij(p, bajtow);
+}
+
+/**
+ * @brief Oddaje źródłu wszystkie zatrzymane bloki.
+ */
+void pula_pamieci::oproznij() noexcept {
+    std::lock_guard<std::mutex> lk(m);
+    for (int k = 0; k < KLAS; ++k) {
+        for (void* p : wolne[k]) zrodlo.zwolnij(p, rozmiar_klasy(k));
+        wolne[k].clear();
+        wolne[k].shrink_to_fit();
+    }
+    zatrzymanych = 0;
+}
+
+/**
+ * @brief Zwraca łączną wielkość zatrzymanych bloków.
+ */
+std::size_t pula_pamieci::zatrzymane() const {
+    std::lock_guard<std::mutex> lk(m);
+    return zatrzymanych;
+}
+
+/**
+ * @brief Zwraca globalną pulę (celowo nigdy nieniszczoną).
+ */
+pula_pamieci& pula_pamieci::globalna() {
+    static pula_pamieci* pula = new pula_pamieci();
+    return *pula;
+}
+
+} // namespace jadra
@@ -0,0 +1,230 @@
+#pragma once
+
+/**
+ * @file pamiec.h
+ * @brief Alokacja pamięci na dane macierzy.
+ *
+ * Macierz pobiera pamięć z obiektu @ref jadra::alokator podanego przy
+ * konstrukcji (domyślnie – z @ref jadra::domyslny_alokator). Biblioteka
+ * dostarcza dwie implementacje:
+ * - @ref jadra::alokator_wyrownany – każdy blok prosto od systemu,
+ * - @ref jadra::pula_pamieci – pula bloków w klasach rozmiarów; zwolnione
+ *   bloki są zatrzymywane i oddawane przy kolejnym przydziale tej samej
+ *   klasy, więc powtarzające się macierze tymczasowe nie wywołują malloc/free
+ *   ani nie powodują nowych błędów stron.
+ *
+ * Bloki są wyrównane do @ref jadra::WYROWNANIE bajtów (linia pamięci
+ * podręcznej, pełny rejestr AVX-512). Duże bloki (od
+ * @ref jadra::PROG_DUZYCH_STRON) są mapowane bezpośrednio od systemu
+ * i w miarę możliwości umieszczane na dużych stronach, co zmniejsza liczbę
+ * chybień TLB przy przechodzeniu po macierzach wielu GiB:
+ * - Linux – jawne strony @c MAP_HUGETLB (jeśli administrator zarezerwował
+ *   ich pulę), w przeciwnym razie przezroczyste duże strony
+ *   (@c madvise(MADV_HUGEPAGE)) na obszarze wyrównanym do 2 MiB,
+ * - Windows – @c MEM_LARGE_PAGES (wymaga uprawnienia
+ *   SeLockMemoryPrivilege), w przeciwnym razie zwykłe @c VirtualAlloc.
+ *
+ * Duże strony można wyłączyć zmienną środowiskową @c MACIERZE_DUZE_STRONY=0
+ * (odczytywaną przy pierwszej dużej alokacji).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jadra {
+
+/// Wyrównanie (w bajtach) bloków zwracanych przez @ref przydziel.
+constexpr std::size_t WYROWNANIE = 64;
+
+/// Rozmiar bloku (w bajtach), od którego pamięć jest mapowana na dużych stronach.
+constexpr std::size_t PROG_DUZYCH_STRON = std::size_t(32) << 20;
+
+/**
+ * @brief Mnoży dwa nieujemne rozmiary, sprawdzając przepełnienie.
+ *
+ * @param a Pierwszy czynnik.
+ * @param b Drugi czynnik.
+ * @return Iloczyn @p a * @p b.
+ * @throw std::length_error jeśli iloczyn nie mieści się w @c std::ptrdiff_t.
+ */
+std::ptrdiff_t pomnoz_rozmiary(std::ptrdiff_t a, std::ptrdiff_t b);
+
+/**
+ * @brief Przydziela od systemu blok @p bajtow bajtów wyrównany do
+ *        @ref WYROWNANIE (zawartość nieokreślona).
+ *
+ * @param bajtow Rozmiar bloku (może być 0).
+ * @return Wskaźnik na blok; zwalniany przez @ref zwolnij z tym samym rozmiarem.
+ * @throw std::bad_alloc jeśli brakuje pamięci.
+ */
+void* przydziel(std::size_t bajtow);
+
+/**
+ * @brief Zwalnia blok przydzielony przez @ref przydziel.
+ *
+ * @param p Wskaźnik na blok (nullptr jest ignorowany).
+ * @param bajtow Rozmiar podany przy przydziale.
+ */
+void zwolnij(void* p, std::size_t bajtow) noexcept;
+
+/**
+ * @brief Zwraca rodzaj stron ostatniej dużej alokacji: "hugetlb",
+ *        "przezroczyste", "large pages", "zwykle" albo "brak" (jeśli żadnej
+ *        jeszcze nie było).
+ */
+const char* rodzaj_duzych_stron();
+
+/**
+ * @class alokator
+ * @brief Polityka przydziału pamięci na dane macierzy.
+ *
+ * Zwracane bloki muszą być wyrównane do @ref WYROWNANIE; ich zawartość
+ * jest nieokreślona. Blok jest zwalniany przez ten sam alokator, z tym samym
+ * rozmiarem. Implementacje muszą być bezpieczne wielowątkowo.
+ */
+class alokator {
+public:
+    virtual ~alokator() = default;
+
+    /**
+     * @brief Przydziela blok @p bajtow bajtów.
+     *
+     * @throw std::bad_alloc jeśli brakuje pamięci.
+     */
+    virtual void* przydziel(std::size_t bajtow) = 0;
+
+    /**
+     * @brief Zwalnia blok @p p o rozmiarze @p bajtow (nullptr jest ignorowany).
+     */
+    virtual void zwolnij(void* p, std::size_t bajtow) noexcept = 0;
+};
+
+/**
+ * @brief Zwraca alokator przydzielający każdy blok od systemu
+ *        (@ref przydziel / @ref zwolnij).
+ */
+alokator& alokator_wyrownany();
+
+/**
+ * @class pula_pamieci
+ * @brief Alokator z pulą bloków w klasach rozmiarów.
+ *
+ * Rozmiary są zaokrąglane w górę do klasy: 4 klasy na każdą potęgę dwójki
+ * (2^k, 1.25 * 2^k, 1.5 * 2^k, 1.75 * 2^k), więc nadmiar nie przekracza 25%.
+ * Zwolniony blok trafia na listę wolnych bloków swojej klasy (o ile pula
+ * nie przekracza @c limitu zatrzymanych bajtów) i jest oddawany przy
+ * następnym przydziale tej klasy bez wołania alokatora źródłowego.
+ *
+ * Pula musi żyć dłużej niż macierze korzystające z jej pamięci.
+ */
+class pula_pamieci : public alokator {
+public:
+    /**
+     * @brief Tworzy pustą pulę.
+     *
+     * @param zrodlo Alokator, z którego pobierane są nowe bloki.
+     * @param limit Maksymalna łączna wielkość (w bajtach) zatrzymanych bloków.
+     */
+    explicit pula_pamieci(alokator& zrodlo = alokator_wyrownany(), std::size_t limit = SIZE_MAX);
+
+    /**
+     * @brief Destruktor. Oddaje zatrzymane bloki alokatorowi źródłowemu.
+     */
+    ~pula_pamieci() override;
+
+    pula_pamieci(const pula_pamieci&) = delete;
+    pula_pamieci& operator=(const pula_pamieci&) = delete;
+
+    void* przydziel(std::size_t bajtow) override;
+    void zwolnij(void* p, std::size_t bajtow) noexcept override;
+
+    /**
+     * @brief Oddaje wszystkie zatrzymane bloki alokatorowi źródłowemu.
+     */
+    void oproznij() noexcept;
+
+    /**
+     * @brief Zwraca łączną wielkość (w bajtach) zatrzymanych wolnych bloków.
+     */
+    std::size_t zatrzymane() const;
+
+    /**
+     * @brief Zwraca globalną pulę biblioteki (tworzoną przy pierwszym użyciu
+     *        i nigdy nieniszczoną, więc mogą z niej korzystać także macierze
+     *        statyczne).
+     */
+    static pula_pamieci& globalna();
+
+private:
+    /// Liczba klas rozmiarów (4 na każdy bit rozmiaru).
+    static constexpr int KLAS = 4 * 64;
+
+    alokator& zrodlo;               ///< Źródło nowych bloków.
+    std::size_t limit;              ///< Maksymalna wielkość zatrzymanych bloków.
+    std::size_t zatrzymanych;       ///< Bieżąca wielkość zatrzymanych bloków.
+    mutable std::mutex m;           ///< Chroni listy wolnych bloków.
+    std::vector<void*> wolne[KLAS]; ///< Wolne bloki każdej klasy.
+
+    /// Wyznacza klasę bloku @p bajtow i zaokrągla @p bajtow do jej rozmiaru.
+    static int klasa(std::size_t& bajtow);
+    /// Zwraca rozmiar bloków klasy @p k.
+    static std::size_t rozmiar_klasy(int k);
+};
+
+/**
+ * @brief Zwraca alokator używany przez nowo tworzone macierze, którym nie
+ *        podano alokatora (początkowo @ref alokator_wyrownany).
+ */
+alokator& domyslny_alokator();
+
+/**
+ * @brief Ustawia alokator używany przez nowo tworzone macierze, np.
+ *        @c ustaw_domyslny_alokator(pula_pamieci::globalna()).
+ *
+ * Istniejące macierze zachowują swój alokator. Alokator musi żyć dłużej
+ * niż korzystające z niego macierze.
+ *
+ * @param a Nowy domyślny alokator.
+ */
+void ustaw_domyslny_alokator(alokator& a);
+
+/**
+ * @struct zwalniacz
+ * @brief Deleter dla @c std::unique_ptr oddający pamięć alokatorowi, z którego
+ *        pochodzi.
+ */
+struct zwalniacz {
+    alokator* zrodlo = nullptr; ///< Alokator bloku.
+    std::size_t bajtow = 0;     ///< Rozmiar bloku.
+
+    void operator()(void* p) const noexcept {
+        if (zrodlo != nullptr) zrodlo->zwolnij(p, bajtow);
+    }
+};
+
+/// Tablica elementów @p T w pamięci z @ref alokator.
+template <typename T>
+using tablica = std::unique_ptr<T[], zwalniacz>;
+
+/**
+ * @brief Przydziela z alokatora @p a tablicę @p liczba elementów typu @p T
+ *        (niezainicjowaną).
+ *
+ * @tparam T Typ elementów (arytmetyczny).
+ * @param a Alokator.
+ * @param liczba Liczba elementów.
+ * @return Tablica.
+ * @throw std::length_error jeśli rozmiar w bajtach przekracza zakres.
+ * @throw std::bad_alloc jeśli brakuje pamięci.
+ */
+template <typename T>
+tablica<T> przydziel_tablice(alokator& a, std::ptrdiff_t liczba) {
+    const std::size_t bajtow =
+        static_cast<std::size_t>(pomnoz_rozmiary(liczba, static_cast<std::ptrdiff_t>(sizeof(T))));
+    return tablica<T>(static_cast<T*>(a.przydziel(bajtow)), zwalniacz{ &a, bajtow });
+}
+
+} // namespace jadra
@@ -0,0 +1,515 @@
+#include "partia.h"
+#include "cpu.h"
+#include "thread_pool.h"
+#include "transpozycja.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+/// Liczba macierzy partii liczonych razem przez jądro iloczynu (długość wektora akumulatorów).
+constexpr ptrdiff_t PASMO = 32;
+
+/**
+ * @brief Zwraca długość płaszczyzny dla @p liczba macierzy: nieparzystą
+ *        liczbę linii 64-bajtowych.
+ *
+ * Przy długości będącej wielokrotnością strony wszystkie płaszczyzny
+ * trafiałyby w ten sam zbiór pamięci podręcznej, a jądro iloczynu czyta
+ * naraz po kilkanaście płaszczyzn.
+ */
+template <typename T>
+ptrdiff_t dlugosc_plaszczyzny(ptrdiff_t liczba) {
+    constexpr ptrdiff_t w_linii = max<ptrdiff_t>(1, 64 / static_cast<ptrdiff_t>(sizeof(T)));
+    ptrdiff_t linii = (liczba + w_linii - 1) / w_linii;
+    if (linii > 1 && linii % 2 == 0) ++linii;
+    return linii * w_linii;
+}
+
+/**
+ * @brief Liczy C[l] = A[l] * B[l] dla macierzy partii l z [@p od, @p do_).
+ *
+ * Pełne pasma po @ref PASMO macierzy mają akumulatory w tablicy o stałej
+ * długości – kompilator trzyma je w rejestrach wektorowych, a każdy krok
+ * pętli p to jedno mnożenie z dodawaniem na całym paśmie. Reszta partii
+ * jest liczona skalarnie. Sumy całkowite zawijają się modulo 2^N
+ * (@ref jadra::dodaj_iloczyn), jak w iloczynie pojedynczych macierzy.
+ */
+template <typename T, typename W>
+MACIERZ_WSTAW void pomnoz_pasma(ptrdiff_t m, ptrdiff_t n, ptrdiff_t k, const T* a, ptrdiff_t lda, const T* b, ptrdiff_t ldb,
+                         W* c, ptrdiff_t ldc, ptrdiff_t od, ptrdiff_t do_) {
+    ptrdiff_t l = od;
+    for (; l + PASMO <= do_; l += PASMO) {
+        for (ptrdiff_t i = 0; i < m; ++i) {
+            for (ptrdiff_t j = 0; j < n; ++j) {
+                W s[PASMO] = {};
+                for (ptrdiff_t p = 0; p < k; ++p) {
+                    const T* x = a + (i * k + p) * lda + l;
+                    const T* y = b + (p * n + j) * ldb + l;
+                    for (ptrdiff_t q = 0; q < PASMO; ++q) {
+                        s[q] = jadra::dodaj_iloczyn(s[q], static_cast<W>(x[q]), static_cast<W>(y[q]));
+                    }
+                }
+                W* w = c + (i * n + j) * ldc + l;
+                for (ptrdiff_t q = 0; q < PASMO; ++q) w[q] = s[q];
+            }
+        }
+    }
+    for (; l < do_; ++l) {
+        for (ptrdiff_t i = 0; i < m; ++i) {
+            for (ptrdiff_t j = 0; j < n; ++j) {
+                W s = 0;
+                for (ptrdiff_t p = 0; p < k; ++p) {
+                    s = jadra::dodaj_iloczyn(s, static_cast<W>(a[(i * k + p) * lda + l]), static_cast<W>(b[(p * n + j) * ldb + l]));
+                }
+                c[(i * n + j) * ldc + l] = s;
+            }
+        }
+    }
+}
+
+/// Sygnatura jądra iloczynu partii (parametry jak w @ref pomnoz_pasma).
+template <typename T>
+using jadro_partii = void (*)(ptrdiff_t, ptrdiff_t, ptrdiff_t, const T*, ptrdiff_t, const T*, ptrdiff_t,
+                              jadra::iloczyn_t<T>*, ptrdiff_t, ptrdiff_t, ptrdiff_t);
+
+/**
+ * @brief Jądro iloczynu partii bez rozszerzeń wektorowych.
+ */
+template <typename T>
+void pomnoz_partie_skalarnie(ptrdiff_t m, ptrdiff_t n, ptrdiff_t k, const T* a, ptrdiff_t lda, const T* b,
+                             ptrdiff_t ldb, jadra::iloczyn_t<T>* c, ptrdiff_t ldc, ptrdiff_t od, ptrdiff_t do_) {
+    pomnoz_pasma(m, n, k, a, lda, b, ldb, c, ldc, od, do_);
+}
+
+#ifdef MACIERZ_X86
+
+/**
+ * @brief Jądro iloczynu partii kompilowane z AVX2 i FMA.
+ */
+template <typename T>
+MACIERZ_CEL("avx2,fma")
+void pomnoz_partie_avx2(ptrdiff_t m, ptrdiff_t n, ptrdiff_t k, const T* a, ptrdiff_t lda, const T* b, ptrdiff_t ldb,
+                        jadra::iloczyn_t<T>* c, ptrdiff_t ldc, ptrdiff_t od, ptrdiff_t do_) {
+    pomnoz_pasma(m, n, k, a, lda, b, ldb, c, ldc, od, do_);
+}
+
+/**
+ * @brief Jądro iloczynu partii kompilowane z AVX-512 (F, BW, DQ) i FMA.
+ */
+template <typename T>
+MACIERZ_CEL("avx512f,avx512bw,avx512dq,fma")
+void pomnoz_partie_avx512(ptrdiff_t m, ptrdiff_t n, ptrdiff_t k, const T* a, ptrdiff_t lda, const T* b,
+                          ptrdiff_t ldb, jadra::iloczyn_t<T>* c, ptrdiff_t ldc, ptrdiff_t od, ptrdiff_t do_) {
+    pomnoz_pasma(m, n, k, a, lda, b, ldb, c, ldc, od, do_);
+}
+
+#endif // MACIERZ_X86
+
+/// Zwraca nazwę najlepszego wariantu obsługiwanego przez procesor.
+const char* wybierz_wariant_partii() {
+#ifdef MACIERZ_X86
+    const cpu_info& cpu = procesor();
+    if (cpu.avx512f && cpu.avx512bw && cpu.avx512dq && cpu.fma) return "avx512";
+    if (cpu.avx2 && cpu.fma) return "avx2";
+#endif
+    return "skalarny";
+}
+
+/// Zwraca jądro iloczynu partii wybranego wariantu (wybierane raz).
+template <typename T>
+jadro_partii<T> jadro_iloczynu_partii() {
+    static const jadro_partii<T> wybrane = [] {
+        const string_view wariant = jadra::wariant_partii();
+#ifdef MACIERZ_X86
+        if (wariant == "avx512") return pomnoz_partie_avx512<T>;
+        if (wariant == "avx2") return pomnoz_partie_avx2<T>;
+#endif
+        return pomnoz_partie_skalarnie<T>;
+    }();
+    return wybrane;
+}
+
+/**
+ * @brief Liczy @p d[e] = @p f(@p x[e], @p y[e]) na płaszczyznach partii.
+ *
+ * Płaszczyzny mają długość będącą wielokrotnością linii pamięci podręcznej,
+ * więc pętla wewnętrzna ma stałą liczbę obrotów i jest wektoryzowana.
+ */
+template <typename T, typename F>
+void po_plaszczyznach(T* d, const T* x, const T* y, ptrdiff_t plaszczyzn, ptrdiff_t ld, F f) {
+    constexpr ptrdiff_t L = max<ptrdiff_t>(1, 64 / static_cast<ptrdiff_t>(sizeof(T)));
+    const long long liczba = static_cast<long long>(plaszczyzn) * ld / L;
+    rownolegle_dla(0, liczba, max(1LL, PROG_ROWNOLEGLY / L), [=](long long b, long long e) {
+        for (long long i = b * L; i < e * L; i += L) {
+            MACIERZ_IVDEP
+            for (ptrdiff_t q = 0; q < L; ++q) d[i + q] = f(x[i + q], y[i + q]);
+        }
+    });
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy pustą partię (0 macierzy 0 x 0).
+ */
+template <typename T>
+matrix_batch<T>::matrix_batch() : alok(&jadra::domyslny_alokator()) {}
+
+/**
+ * @brief Tworzy partię @p liczba zerowych macierzy @p wiersze x @p kolumny
+ *        w pamięci z alokatora @p a.
+ */
+template <typename T>
+matrix_batch<T>::matrix_batch(size_type liczba, size_type wiersze, size_type kolumny, jadra::alokator& a) : alok(&a) {
+    alokuj(liczba, wiersze, kolumny);
+}
+
+/**
+ * @brief Tworzy partię z kopii macierzy.
+ *
+ * Elementy są rozpraszane do płaszczyzn macierz po macierzy; dla dużych
+ * partii danych ciągłych szybsze jest @ref wczytaj.
+ */
+template <typename T>
+matrix_batch<T>::matrix_batch(const vector<basic_matrix<T>>& macierze) : matrix_batch() {
+    const size_type w = macierze.empty() ? 0 : macierze.front().rows();
+    const size_type k = macierze.empty() ? 0 : macierze.front().cols();
+    for (const basic_matrix<T>& m : macierze) {
+        if (m.rows() != w || m.cols() != k) throw invalid_argument("Rozne wymiary macierzy!");
+    }
+    alokuj(static_cast<size_type>(macierze.size()), w, k, bez_zerowania);
+    for (size_type l = 0; l < liczba; ++l) {
+        const basic_matrix<T>& m = macierze[static_cast<size_t>(l)];
+        for (size_type i = 0; i < wierszy; ++i) {
+            const T* z = m.row_ptr(i);
+            for (size_type j = 0; j < kolumn; ++j) element_ptr(i, j)[l] = z[j];
+        }
+    }
+}
+
+/**
+ * @brief Konstruktor kopiujący: kopiuje płaszczyzny razem z końcówkami.
+ */
+template <typename T>
+matrix_batch<T>::matrix_batch(const matrix_batch& p) : alok(p.alok) {
+    alokuj(p.liczba, p.wierszy, p.kolumn, bez_zerowania);
+    copy(p.dane.get(), p.dane.get() + wierszy * kolumn * ld, dane.get());
+}
+
+/**
+ * @brief Konstruktor przenoszący: przejmuje dane, @p p zostaje pusta.
+ */
+template <typename T>
+matrix_batch<T>::matrix_batch(matrix_batch&& p) noexcept
+    : dane(std::move(p.dane)), liczba(p.liczba), wierszy(p.wierszy), kolumn(p.kolumn), ld(p.ld), alok(p.alok) {
+    p.liczba = p.wierszy = p.kolumn = p.ld = 0;
+}
+
+/**
+ * @brief Przypisanie kopiujące; pamięć jest używana ponownie przy tych
+ *        samych wymiarach.
+ */
+template <typename T>
+matrix_batch<T>& matrix_batch<T>::operator=(const matrix_batch& p) {
+    if (this == &p) return *this;
+    alokuj(p.liczba, p.wierszy, p.kolumn, bez_zerowania);
+    copy(p.dane.get(), p.dane.get() + wierszy * kolumn * ld, dane.get());
+    return *this;
+}
+
+/**
+ * @brief Przypisanie przenoszące; dotychczasowe dane są zwalniane.
+ */
+template <typename T>
+matrix_batch<T>& matrix_batch<T>::operator=(matrix_batch&& p) noexcept {
+    matrix_batch t(std::move(p));
+    swap(t);
+    return *this;
+}
+
+/**
+ * @brief Zamienia zawartość (w tym alokatory) z partią @p p.
+ */
+template <typename T>
+void matrix_batch<T>::swap(matrix_batch& p) noexcept {
+    std::swap(dane, p.dane);
+    std::swap(liczba, p.liczba);
+    std::swap(wierszy, p.wierszy);
+    std::swap(kolumn, p.kolumn);
+    std::swap(ld, p.ld);
+    std::swap(alok, p.alok);
+}
+
+/**
+ * @brief Ustawia rozmiar i zeruje wszystkie płaszczyzny.
+ */
+template <typename T>
+matrix_batch<T>& matrix_batch<T>::alokuj(size_type n, size_type w, size_type k) {
+    alokuj(n, w, k, bez_zerowania);
+    T* d = dane.get();
+    rownolegle_dla(0, w * k * ld, PROG_ROWNOLEGLY, [d](long long b, long long e) { fill(d + b, d + e, T(0)); });
+    return *this;
+}
+
+/**
+ * @brief Ustawia rozmiar; przy zmianie rozmiaru przydziela nową pamięć
+ *        i zeruje w niej tylko końcówki płaszczyzn.
+ */
+template <typename T>
+matrix_batch<T>& matrix_batch<T>::alokuj(size_type n, size_type w, size_type k, bez_zerowania_t) {
+    if (n < 0 || w < 0 || k < 0) throw invalid_argument("Rozmiar ujemny");
+    if (n == liczba && w == wierszy && k == kolumn) return *this;
+
+    const size_type nowe_ld = dlugosc_plaszczyzny<T>(n);
+    const size_type elementow = jadra::pomnoz_rozmiary(jadra::pomnoz_rozmiary(w, k), nowe_ld);
+    dane.reset();
+    liczba = wierszy = kolumn = ld = 0;
+    if (elementow > 0) dane = jadra::przydziel_tablice<T>(*alok, elementow);
+    liczba = n;
+    wierszy = w;
+    kolumn = k;
+    ld = nowe_ld;
+    for (size_type e = 0; e < w * k; ++e) fill(dane.get() + e * ld + n, dane.get() + (e + 1) * ld, T(0));
+    return *this;
+}
+
+/**
+ * @brief Zgłasza @c std::out_of_range dla niepoprawnego numeru macierzy.
+ */
+template <typename T>
+void matrix_batch<T>::poza_zakresem() {
+    throw out_of_range("Indeks poza zakresem");
+}
+
+/**
+ * @brief Zwraca kopię macierzy numer @p k zebraną z płaszczyzn.
+ */
+template <typename T>
+basic_matrix<T> matrix_batch<T>::macierz(size_type k) const {
+    if (k < 0 || k >= liczba) poza_zakresem();
+    basic_matrix<T> m(wierszy, kolumn, bez_zerowania);
+    for (size_type i = 0; i < wierszy; ++i) {
+        T* w = m.row_ptr(i);
+        for (size_type j = 0; j < kolumn; ++j) w[j] = element_ptr(i, j)[k];
+    }
+    return m;
+}
+
+/**
+ * @brief Zapisuje macierz @p m jako macierz numer @p k partii.
+ */
+template <typename T>
+void matrix_batch<T>::ustaw(size_type k, const basic_matrix<T>& m) {
+    if (k < 0 || k >= liczba) poza_zakresem();
+    if (m.rows() != wierszy || m.cols() != kolumn) throw invalid_argument("Rozne wymiary macierzy!");
+    for (size_type i = 0; i < wierszy; ++i) {
+        const T* z = m.row_ptr(i);
+        for (size_type j = 0; j < kolumn; ++j) element_ptr(i, j)[k] = z[j];
+    }
+}
+
+/**
+ * @brief Wczytuje macierze z układu "tablica struktur".
+ *
+ * Tablica to macierz @c size() x (rows() * cols()) zapisana wierszami,
+ * a płaszczyzny – jej transpozycja; przestawia je jądro transpozycji.
+ */
+template <typename T>
+void matrix_batch<T>::wczytaj(const T* t) {
+    const size_type elementow = wierszy * kolumn;
+    if (liczba == 0 || elementow == 0) return;
+    jadra::transponuj(liczba, elementow, t, elementow, dane.get(), ld);
+}
+
+/**
+ * @brief Zapisuje macierze w układzie "tablica struktur" (odwrotność
+ *        @ref wczytaj).
+ */
+template <typename T>
+void matrix_batch<T>::zapisz(T* t) const {
+    const size_type elementow = wierszy * kolumn;
+    if (liczba == 0 || elementow == 0) return;
+    jadra::transponuj(elementow, liczba, dane.get(), ld, t, elementow);
+}
+
+/**
+ * @brief Porównuje wymiary i elementy (końcówki płaszczyzn są zawsze zerowe).
+ */
+template <typename T>
+bool matrix_batch<T>::operator==(const matrix_batch& p) const {
+    if (liczba != p.liczba || wierszy != p.wierszy || kolumn != p.kolumn) return false;
+    return equal(dane.get(), dane.get() + wierszy * kolumn * ld, p.dane.get());
+}
+
+/**
+ * @brief Iloczyny odpowiadających sobie macierzy dwóch partii.
+ *
+ * Partia jest dzielona na pasma po @ref PASMO macierzy; grupy pasm są
+ * liczone równolegle jądrem wybranym dla procesora.
+ */
+template <typename T>
+matrix_batch<jadra::iloczyn_t<T>>& pomnoz_do(matrix_batch<jadra::iloczyn_t<T>>& c, const matrix_batch<T>& a,
+                                             const matrix_batch<T>& b) {
+    using W = jadra::iloczyn_t<T>;
+    if (a.size() != b.size() || a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    if (static_cast<const void*>(&c) == &a || static_cast<const void*>(&c) == &b) {
+        matrix_batch<W> wynik(0, 0, 0, c.get_allocator());
+        pomnoz_do(wynik, a, b);
+        c.swap(wynik);
+        return c;
+    }
+
+    const ptrdiff_t m = a.rows(), n = b.cols(), k = a.cols();
+    c.alokuj(a.size(), m, n, bez_zerowania);
+    if (c.size() == 0 || m == 0 || n == 0) return c;
+
+    const jadro_partii<T> jadro = jadro_iloczynu_partii<T>();
+    const T* da = a.element_ptr(0, 0);
+    const T* db = b.element_ptr(0, 0);
+    W* dc = c.element_ptr(0, 0);
+    const ptrdiff_t lda = a.stride(), ldb = b.stride(), ldc = c.stride(), liczba = a.size();
+    const long long pasm = (liczba + PASMO - 1) / PASMO;
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / (PASMO * max<long long>(1, m * n * max<ptrdiff_t>(k, 1))));
+    rownolegle_dla(0, pasm, ziarno, [=](long long p0, long long p1) {
+        jadro(m, n, k, da, lda, db, ldb, dc, ldc, p0 * PASMO, min<ptrdiff_t>(p1 * PASMO, liczba));
+    });
+    return c;
+}
+
+/**
+ * @brief Zwraca iloczyny odpowiadających sobie macierzy jako nową partię.
+ */
+template <typename T>
+matrix_batch<jadra::iloczyn_t<T>> pomnoz(const matrix_batch<T>& a, const matrix_batch<T>& b) {
+    matrix_batch<jadra::iloczyn_t<T>> c(0, 0, 0, a.get_allocator());
+    pomnoz_do(c, a, b);
+    return c;
+}
+
+/**
+ * @brief Sumy odpowiadających sobie macierzy (jedna pętla po wszystkich
+ *        płaszczyznach).
+ */
+template <typename T>
+matrix_batch<T>& dodaj_do(matrix_batch<T>& c, const matrix_batch<T>& a, const matrix_batch<T>& b) {
+    if (a.size() != b.size() || a.rows() != b.rows() || a.cols() != b.cols()) {
+        throw invalid_argument("Rozne wymiary macierzy!");
+    }
+    c.alokuj(a.size(), a.rows(), a.cols(), bez_zerowania);
+    if (c.size() == 0) return c;
+    po_plaszczyznach(c.element_ptr(0, 0), a.element_ptr(0, 0), b.element_ptr(0, 0), a.rows() * a.cols(), a.stride(),
+                     [](T x, T y) { return static_cast<T>(x + y); });
+    return c;
+}
+
+/**
+ * @brief Różnice odpowiadających sobie macierzy.
+ */
+template <typename T>
+matrix_batch<T>& odejmij_do(matrix_batch<T>& c, const matrix_batch<T>& a, const matrix_batch<T>& b) {
+    if (a.size() != b.size() || a.rows() != b.rows() || a.cols() != b.cols()) {
+        throw invalid_argument("Rozne wymiary macierzy!");
+    }
+    c.alokuj(a.size(), a.rows(), a.cols(), bez_zerowania);
+    if (c.size() == 0) return c;
+    po_plaszczyznach(c.element_ptr(0, 0), a.element_ptr(0, 0), b.element_ptr(0, 0), a.rows() * a.cols(), a.stride(),
+                     [](T x, T y) { return static_cast<T>(x - y); });
+    return c;
+}
+
+/**
+ * @brief Zwraca sumy odpowiadających sobie macierzy jako nową partię.
+ */
+template <typename T>
+matrix_batch<T> dodaj(const matrix_batch<T>& a, const matrix_batch<T>& b) {
+    matrix_batch<T> c(0, 0, 0, a.get_allocator());
+    dodaj_do(c, a, b);
+    return c;
+}
+
+/**
+ * @brief Zwraca różnice odpowiadających sobie macierzy jako nową partię.
+ */
+template <typename T>
+matrix_batch<T> odejmij(const matrix_batch<T>& a, const matrix_batch<T>& b) {
+    matrix_batch<T> c(0, 0, 0, a.get_allocator());
+    odejmij_do(c, a, b);
+    return c;
+}
+
+/**
+ * @brief Transpozycje macierzy partii: płaszczyzna (i, j) staje się
+ *        płaszczyzną (j, i).
+ */
+template <typename T>
+matrix_batch<T>& transponuj_do(matrix_batch<T>& c, const matrix_batch<T>& a) {
+    if (&c == &a) {
+        matrix_batch<T> wynik(0, 0, 0, c.get_allocator());
+        transponuj_do(wynik, a);
+        c.swap(wynik);
+        return c;
+    }
+    c.alokuj(a.size(), a.cols(), a.rows(), bez_zerowania);
+    if (c.size() == 0) return c;
+    const ptrdiff_t w = a.rows(), k = a.cols(), ld = a.stride();
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(ld, 1));
+    rownolegle_dla(0, w * k, ziarno, [&](long long e0, long long e1) {
+        for (long long e = e0; e < e1; ++e) {
+            const ptrdiff_t i = static_cast<ptrdiff_t>(e) / k, j = static_cast<ptrdiff_t>(e) % k;
+            copy(a.element_ptr(i, j), a.element_ptr(i, j) + ld, c.element_ptr(j, i));
+        }
+    });
+    return c;
+}
+
+/**
+ * @brief Zwraca transpozycje macierzy partii jako nową partię.
+ */
+template <typename T>
+matrix_batch<T> transponuj(const matrix_batch<T>& a) {
+    matrix_batch<T> c(0, 0, 0, a.get_allocator());
+    transponuj_do(c, a);
+    return c;
+}
+
+namespace jadra {
+
+/**
+ * @brief Zwraca nazwę wariantu jądra iloczynu partii (wybieranego raz).
+ */
+const char* wariant_partii() {
+    static const char* const wybrany = wybierz_wariant_partii();
+    return wybrany;
+}
+
+} // namespace jadra
+
+/**
+ * @brief Jawne konkretyzacje partii macierzy dla typu @p T.
+ */
+#define MACIERZ_INSTANCJA_PARTII(T)                                                                            \
+    template class matrix_batch<T>;                                                                            \
+    template matrix_batch<jadra::iloczyn_t<T>>& pomnoz_do<T>(matrix_batch<jadra::iloczyn_t<T>>&,               \
+                                                             const matrix_batch<T>&, const matrix_batch<T>&);  \
+    template matrix_batch<jadra::iloczyn_t<T>> pomnoz<T>(const matrix_batch<T>&, const matrix_batch<T>&);      \
+    template matrix_batch<T>& dodaj_do<T>(matrix_batch<T>&, const matrix_batch<T>&, const matrix_batch<T>&);   \
+    template matrix_batch<T>& odejmij_do<T>(matrix_batch<T>&, const matrix_batch<T>&, const matrix_batch<T>&); \
+    template matrix_batch<T> dodaj<T>(const matrix_batch<T>&, const matrix_batch<T>&);                         \
+    template matrix_batch<T> odejmij<T>(const matrix_batch<T>&, const matrix_batch<T>&);                       \
+    template matrix_batch<T>& transponuj_do<T>(matrix_batch<T>&, const matrix_batch<T>&);                      \
+    template matrix_batch<T> transponuj<T>(const matrix_batch<T>&);
+
+MACIERZ_INSTANCJA_PARTII(int8_t)
+MACIERZ_INSTANCJA_PARTII(int16_t)
+MACIERZ_INSTANCJA_PARTII(int32_t)
+MACIERZ_INSTANCJA_PARTII(int64_t)
+MACIERZ_INSTANCJA_PARTII(float)
+MACIERZ_INSTANCJA_PARTII(double)
+
+#undef MACIERZ_INSTANCJA_PARTII
@@ -0,0 +1,261 @@
+#pragma once
+
+/**
+ * @file partia.h
+ * @brief Partie wielu małych macierzy tego samego rozmiaru, przetwarzane
+ *        jednym wywołaniem.
+ *
+ * Dla macierzy 2 x 2 ... 16 x 16 koszt obiektu @ref basic_matrix (przydział
+ * pamięci, wywołania, pętle o kilku obrotach) przewyższa samo liczenie.
+ * @ref matrix_batch przechowuje @c size() macierzy @c rows() x @c cols()
+ * w układzie "struktura tablic": dla każdej pozycji (i, j) elementy
+ * wszystkich macierzy partii leżą obok siebie (płaszczyzna elementu,
+ * @c stride() elementów, wielokrotność 64 bajtów). Element (i, j) macierzy
+ * @p k to @c element_ptr(i, j)[k].
+ *
+ * W tym układzie iloczyn, suma i transpozycja całej partii to te same
+ * działania co dla jednej macierzy, tylko każda operacja skalarna staje się
+ * operacją na płaszczyznach – wektorową wzdłuż partii, bez przestawiania
+ * danych w rejestrach. Partia jest dzielona na pasma przetwarzane
+ * równolegle.
+ *
+ * @ref matrix_batch::wczytaj i @ref matrix_batch::zapisz przenoszą dane
+ * z i do układu "tablica struktur" (macierze jedna za drugą, każda
+ * wierszami).
+ */
+
+#include "matrix.h"
+#include "gemm.h"
+#include "pamiec.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class matrix_batch
+ * @brief Partia macierzy tego samego rozmiaru w układzie płaszczyzn.
+ *
+ * Elementy za ostatnią macierzą płaszczyzny (do @c stride()) są zawsze
+ * zerami.
+ *
+ * @tparam T Typ elementów.
+ */
+template <typename T>
+class matrix_batch {
+public:
+    /// Typ elementów macierzy.
+    using value_type = T;
+
+    /// Typ liczby macierzy, wymiarów i indeksów.
+    using size_type = std::ptrdiff_t;
+
+    /// Tworzy pustą partię.
+    matrix_batch();
+
+    /**
+     * @brief Tworzy partię @p liczba macierzy zerowych @p wiersze x @p kolumny.
+     *
+     * @param a Alokator pamięci partii.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     * @throw std::length_error jeśli rozmiar przekracza zakres.
+     */
+    matrix_batch(size_type liczba, size_type wiersze, size_type kolumny,
+                 jadra::alokator& a = jadra::domyslny_alokator());
+
+    /**
+     * @brief Tworzy partię z kopii macierzy @p macierze.
+     *
+     * @throw std::invalid_argument jeśli macierze mają różne wymiary.
+     */
+    explicit matrix_batch(const std::vector<basic_matrix<T>>& macierze);
+
+    /// Konstruktor kopiujący.
+    matrix_batch(const matrix_batch& p);
+
+    /// Konstruktor przenoszący.
+    matrix_batch(matrix_batch&& p) noexcept;
+
+    /// Przypisanie kopiujące.
+    matrix_batch& operator=(const matrix_batch& p);
+
+    /// Przypisanie przenoszące.
+    matrix_batch& operator=(matrix_batch&& p) noexcept;
+
+    /// Zamienia zawartość z partią @p p.
+    void swap(matrix_batch& p) noexcept;
+
+    /**
+     * @brief Ustawia rozmiar partii; wszystkie elementy są zerowane.
+     *
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    matrix_batch& alokuj(size_type liczba, size_type wiersze, size_type kolumny);
+
+    /**
+     * @brief Ustawia rozmiar partii bez zerowania elementów (przy tym samym
+     *        rozmiarze – bez przydziału pamięci).
+     *
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    matrix_batch& alokuj(size_type liczba, size_type wiersze, size_type kolumny, bez_zerowania_t);
+
+    /// Zwraca liczbę macierzy partii.
+    size_type size() const noexcept { return liczba; }
+
+    /// Zwraca liczbę wierszy każdej macierzy.
+    size_type rows() const noexcept { return wierszy; }
+
+    /// Zwraca liczbę kolumn każdej macierzy.
+    size_type cols() const noexcept { return kolumn; }
+
+    /// Zwraca długość płaszczyzny (odległość między płaszczyznami kolejnych elementów).
+    size_type stride() const noexcept { return ld; }
+
+    /// Zwraca alokator partii.
+    jadra::alokator& get_allocator() const noexcept { return *alok; }
+
+    /// Zwraca wskaźnik na płaszczyznę elementu (@p i, @p j).
+    T* element_ptr(size_type i, size_type j) noexcept { return dane.get() + (i * kolumn + j) * ld; }
+
+    /// Zwraca wskaźnik na płaszczyznę elementu (@p i, @p j) (wersja const).
+    const T* element_ptr(size_type i, size_type j) const noexcept { return dane.get() + (i * kolumn + j) * ld; }
+
+    /**
+     * @brief Zwraca element (@p i, @p j) macierzy @p k.
+     *
+     * Indeksy są sprawdzane zgodnie z @ref MACIERZ_SPRAWDZAJ_INDEKSY.
+     */
+    T& operator()(size_type k, size_type i, size_type j);
+
+    /// Zwraca element (@p i, @p j) macierzy @p k (wersja const).
+    const T& operator()(size_type k, size_type i, size_type j) const;
+
+    /**
+     * @brief Zwraca kopię macierzy @p k.
+     *
+     * @throw std::out_of_range jeśli @p k jest poza zakresem.
+     */
+    basic_matrix<T> macierz(size_type k) const;
+
+    /**
+     * @brief Zastępuje macierz @p k macierzą @p m.
+     *
+     * @throw std::out_of_range jeśli @p k jest poza zakresem.
+     * @throw std::invalid_argument jeśli wymiary @p m są inne niż partii.
+     */
+    void ustaw(size_type k, const basic_matrix<T>& m);
+
+    /**
+     * @brief Wczytuje wszystkie macierze z tablicy @p t, w której leżą one
+     *        jedna za drugą, każda wierszami (@c size() * rows() * cols()
+     *        elementów).
+     */
+    void wczytaj(const T* t);
+
+    /**
+     * @brief Zapisuje wszystkie macierze do tablicy @p t w układzie jak
+     *        w @ref wczytaj.
+     */
+    void zapisz(T* t) const;
+
+    /// Porównuje partie element po elemencie.
+    bool operator==(const matrix_batch& p) const;
+
+private:
+    jadra::tablica<T> dane;  ///< Płaszczyzny elementów.
+    size_type liczba = 0;    ///< Liczba macierzy.
+    size_type wierszy = 0;   ///< Liczba wierszy.
+    size_type kolumn = 0;    ///< Liczba kolumn.
+    size_type ld = 0;        ///< Długość płaszczyzny.
+    jadra::alokator* alok;   ///< Alokator pamięci.
+
+    /// Zgłasza wyjątek dla nieprawidłowego indeksu.
+    [[noreturn]] static void poza_zakresem();
+};
+
+template <typename T>
+inline T& matrix_batch<T>::operator()(size_type k, size_type i, size_type j) {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+    if (k < 0 || k >= liczba || i < 0 || i >= wierszy || j < 0 || j >= kolumn) poza_zakresem();
+#endif
+    return element_ptr(i, j)[k];
+}
+
+template <typename T>
+inline const T& matrix_batch<T>::operator()(size_type k, size_type i, size_type j) const {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+    if (k < 0 || k >= liczba || i < 0 || i >= wierszy || j < 0 || j >= kolumn) poza_zakresem();
+#endif
+    return element_ptr(i, j)[k];
+}
+
+/**
+ * @brief Zapisuje do @p c iloczyny odpowiadających sobie macierzy:
+ *        C[k] = A[k] * B[k] dla każdego k.
+ *
+ * Iloczyny macierzy 8- i 16-bitowych są liczone w 32 bitach (jak
+ * @ref pomnoz). @p c może być jedną z partii @p a, @p b.
+ *
+ * @return Referencja do @p c.
+ * @throw std::invalid_argument jeśli liczby macierzy są różne lub
+ *        A[k].cols() != B[k].rows().
+ */
+template <typename T>
+matrix_batch<jadra::iloczyn_t<T>>& pomnoz_do(matrix_batch<jadra::iloczyn_t<T>>& c, const matrix_batch<T>& a,
+                                             const matrix_batch<T>& b);
+
+/**
+ * @brief Zwraca partię iloczynów A[k] * B[k].
+ */
+template <typename T>
+matrix_batch<jadra::iloczyn_t<T>> pomnoz(const matrix_batch<T>& a, const matrix_batch<T>& b);
+
+/**
+ * @brief Zapisuje do @p c sumy A[k] + B[k].
+ *
+ * @return Referencja do @p c.
+ * @throw std::invalid_argument jeśli rozmiary partii są różne.
+ */
+template <typename T>
+matrix_batch<T>& dodaj_do(matrix_batch<T>& c, const matrix_batch<T>& a, const matrix_batch<T>& b);
+
+/**
+ * @brief Zapisuje do @p c różnice A[k] - B[k].
+ *
+ * @return Referencja do @p c.
+ * @throw std::invalid_argument jeśli rozmiary partii są różne.
+ */
+template <typename T>
+matrix_batch<T>& odejmij_do(matrix_batch<T>& c, const matrix_batch<T>& a, const matrix_batch<T>& b);
+
+/// Zwraca partię sum A[k] + B[k].
+template <typename T>
+matrix_batch<T> dodaj(const matrix_batch<T>& a, const matrix_batch<T>& b);
+
+/// Zwraca partię różnic A[k] - B[k].
+template <typename T>
+matrix_batch<T> odejmij(const matrix_batch<T>& a, const matrix_batch<T>& b);
+
+/**
+ * @brief Zapisuje do @p c transpozycje macierzy partii @p a (przestawienie
+ *        płaszczyzn).
+ *
+ * @return Referencja do @p c.
+ */
+template <typename T>
+matrix_batch<T>& transponuj_do(matrix_batch<T>& c, const matrix_batch<T>& a);
+
+/// Zwraca partię transpozycji macierzy partii @p a.
+template <typename T>
+matrix_batch<T> transponuj(const matrix_batch<T>& a);
+
+namespace jadra {
+
+/**
+ * @brief Zwraca nazwę wariantu jądra iloczynu partii ("avx512", "avx2"
+ *        lub "skalarny").
+ */
+const char* wariant_partii();
+
+} // namespace jadra
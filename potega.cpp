@@ -0,0 +1,156 @@
+#include "potega.h"
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Zwraca iloczyn czynników @p i .. @p j łańcucha @p c w kolejności
+ *        z tablicy @p podzial (zob. @ref kolejnosc_mnozenia).
+ *
+ * Czynniki, które nie wymagają rozszerzenia typu, są mnożone bez kopii.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> oblicz_lancuch(const vector<const basic_matrix<T>*>& c,
+                                                 const vector<ptrdiff_t>& podzial, ptrdiff_t i, ptrdiff_t j) {
+    using W = jadra::iloczyn_t<T>;
+    if (i == j) return basic_matrix<W>(*c[static_cast<size_t>(i)]);
+
+    const ptrdiff_t n = static_cast<ptrdiff_t>(c.size());
+    const ptrdiff_t s = podzial[static_cast<size_t>(i * n + j)];
+    const basic_matrix<T>& pierwszy = *c[static_cast<size_t>(i)];
+    const basic_matrix<T>& ostatni = *c[static_cast<size_t>(j)];
+    basic_matrix<W> wynik(pierwszy.get_allocator());
+    if (i == s && s + 1 == j) {
+        pomnoz_do(wynik, pierwszy, ostatni);
+        return wynik;
+    }
+    if constexpr (is_same_v<W, T>) {
+        if (i == s) {
+            pomnoz_do(wynik, pierwszy, oblicz_lancuch(c, podzial, s + 1, j));
+            return wynik;
+        }
+        if (s + 1 == j) {
+            pomnoz_do(wynik, oblicz_lancuch(c, podzial, i, s), ostatni);
+            return wynik;
+        }
+    }
+    pomnoz_do(wynik, oblicz_lancuch(c, podzial, i, s), oblicz_lancuch(c, podzial, s + 1, j));
+    return wynik;
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca @p a podniesioną do potęgi @p k.
+ *
+ * Dla k = 2^t * (2u + 1) najpierw t razy podnosi @p a do kwadratu, a wynik
+ * inicjuje kopią tej potęgi (zamiast mnożyć przez macierz jednostkową).
+ * Dalej dla każdego bitu k: kwadrat bazy i – dla bitu 1 – iloczyn
+ * z wynikiem. Każde mnożenie zapisuje do bufora @c temp, który jest potem
+ * zamieniany (swap) z bazą albo wynikiem.
+ *
+ * @throw std::invalid_argument jeśli @p a nie jest kwadratowa.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> potega(const basic_matrix<T>& a, unsigned long long k) {
+    using W = jadra::iloczyn_t<T>;
+    if (a.rows() != a.cols()) throw invalid_argument("Macierz nie jest kwadratowa");
+    if (k == 0) {
+        basic_matrix<W> e(a.rows(), a.cols());
+        e.przekatna();
+        return e;
+    }
+
+    basic_matrix<W> baza(a);
+    basic_matrix<W> temp(baza.get_allocator());
+    for (; (k & 1) == 0; k >>= 1) {
+        pomnoz_do(temp, baza, baza);
+        baza.swap(temp);
+    }
+    basic_matrix<W> wynik(baza);
+    for (k >>= 1; k != 0; k >>= 1) {
+        pomnoz_do(temp, baza, baza);
+        baza.swap(temp);
+        if (k & 1) {
+            pomnoz_do(temp, wynik, baza);
+            wynik.swap(temp);
+        }
+    }
+    return wynik;
+}
+
+/**
+ * @brief Wyznacza optymalną kolejność mnożenia łańcucha macierzy.
+ *
+ * koszt(i, j) = min po s z koszt(i, s) + koszt(s + 1, j)
+ *               + wymiary[i] * wymiary[s + 1] * wymiary[j + 1].
+ * Koszty są liczone w @c double, więc duże wymiary nie powodują
+ * przepełnienia.
+ *
+ * @throw std::invalid_argument jeśli podano mniej niż dwie liczby.
+ */
+vector<ptrdiff_t> kolejnosc_mnozenia(const vector<ptrdiff_t>& wymiary) {
+    if (wymiary.size() < 2) throw invalid_argument("Pusty lancuch macierzy");
+    const ptrdiff_t n = static_cast<ptrdiff_t>(wymiary.size()) - 1;
+    const auto indeks = [n](ptrdiff_t i, ptrdiff_t j) { return static_cast<size_t>(i * n + j); };
+    vector<double> koszt(static_cast<size_t>(n * n), 0.0);
+    vector<ptrdiff_t> podzial(static_cast<size_t>(n * n), 0);
+    for (ptrdiff_t dlugosc = 2; dlugosc <= n; ++dlugosc) {
+        for (ptrdiff_t i = 0; i + dlugosc <= n; ++i) {
+            const ptrdiff_t j = i + dlugosc - 1;
+            double najlepszy = numeric_limits<double>::infinity();
+            for (ptrdiff_t s = i; s < j; ++s) {
+                const double k = koszt[indeks(i, s)] + koszt[indeks(s + 1, j)] +
+                                 static_cast<double>(wymiary[static_cast<size_t>(i)]) *
+                                     static_cast<double>(wymiary[static_cast<size_t>(s + 1)]) *
+                                     static_cast<double>(wymiary[static_cast<size_t>(j + 1)]);
+                if (k < najlepszy) {
+                    najlepszy = k;
+                    podzial[indeks(i, j)] = s;
+                }
+            }
+            koszt[indeks(i, j)] = najlepszy;
+        }
+    }
+    return podzial;
+}
+
+/**
+ * @brief Zwraca iloczyn łańcucha macierzy w optymalnej kolejności.
+ *
+ * @throw std::invalid_argument jeśli lista jest pusta, zawiera nullptr
+ *        lub wymiary sąsiednich czynników są niezgodne.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz_lancuch(const vector<const basic_matrix<T>*>& czynniki) {
+    if (czynniki.empty()) throw invalid_argument("Pusty lancuch macierzy");
+    vector<ptrdiff_t> wymiary;
+    wymiary.reserve(czynniki.size() + 1);
+    for (size_t i = 0; i < czynniki.size(); ++i) {
+        if (czynniki[i] == nullptr) throw invalid_argument("Czynnik jest null");
+        if (i > 0 && czynniki[i - 1]->cols() != czynniki[i]->rows()) throw invalid_argument("Rozne wymiary macierzy!");
+        wymiary.push_back(czynniki[i]->rows());
+    }
+    wymiary.push_back(czynniki.back()->cols());
+    return oblicz_lancuch(czynniki, kolejnosc_mnozenia(wymiary), 0, static_cast<ptrdiff_t>(czynniki.size()) - 1);
+}
+
+/**
+ * @brief Jawne konkretyzacje potęgowania i łańcuchów dla typu @p T.
+ */
+#define MACIERZ_INSTANCJA_POTEGI(T)                                                                      \
+    template basic_matrix<jadra::iloczyn_t<T>> potega<T>(const basic_matrix<T>&, unsigned long long);    \
+    template basic_matrix<jadra::iloczyn_t<T>> pomnoz_lancuch<T>(const vector<const basic_matrix<T>*>&);
+
+MACIERZ_INSTANCJA_POTEGI(int8_t)
+MACIERZ_INSTANCJA_POTEGI(int16_t)
+MACIERZ_INSTANCJA_POTEGI(int32_t)
+MACIERZ_INSTANCJA_POTEGI(int64_t)
+MACIERZ_INSTANCJA_POTEGI(float)
+MACIERZ_INSTANCJA_POTEGI(double)
+
+#undef MACIERZ_INSTANCJA_POTEGI
@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @file potega.h
+ * @brief Potęgowanie macierzy i iloczyny łańcuchów macierzy.
+ *
+ * @ref potega liczy A^k przez podnoszenie do kwadratu – O(log k) mnożeń
+ * zamiast k - 1. Wyniki pośrednie krążą między trzema buforami, więc po
+ * pierwszych krokach kolejne mnożenia nie przydzielają pamięci.
+ *
+ * @ref pomnoz_lancuch mnoży ciąg macierzy w kolejności o najmniejszej
+ * liczbie operacji (programowanie dynamiczne, O(n^3) dla n czynników).
+ *
+ * Typ elementów wyniku – jak dla @ref pomnoz (@ref jadra::iloczyn_t);
+ * czynniki 8- i 16-bitowe są w razie potrzeby rozszerzane do tego typu.
+ */
+
+#include "matrix.h"
+#include <vector>
+
+/**
+ * @brief Zwraca @p a podniesioną do potęgi @p k (dla k == 0 – macierz
+ *        jednostkową).
+ *
+ * @param a Macierz kwadratowa.
+ * @param k Wykładnik.
+ * @return A^k.
+ * @throw std::invalid_argument jeśli @p a nie jest kwadratowa.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> potega(const basic_matrix<T>& a, unsigned long long k);
+
+/**
+ * @brief Zwraca iloczyn czynniki[0] * czynniki[1] * ... w optymalnej
+ *        kolejności nawiasowania.
+ *
+ * Koszt iloczynu macierzy p x q i q x r to p * q * r; kolejność
+ * minimalizuje sumę tych kosztów.
+ *
+ * @param czynniki Wskaźniki na kolejne czynniki (co najmniej jeden).
+ * @return Iloczyn wszystkich czynników.
+ * @throw std::invalid_argument jeśli lista jest pusta, zawiera nullptr
+ *        lub wymiary sąsiednich czynników są niezgodne.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz_lancuch(const std::vector<const basic_matrix<T>*>& czynniki);
+
+/**
+ * @brief Zwraca iloczyn @p a * @p reszta... w optymalnej kolejności
+ *        nawiasowania (zob. wyżej).
+ */
+template <typename T, typename... R>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz_lancuch(const basic_matrix<T>& a, const R&... reszta) {
+    return pomnoz_lancuch(std::vector<const basic_matrix<T>*>{ &a, &reszta... });
+}
+
+/**
+ * @brief Zwraca kolejność mnożenia łańcucha macierzy o wymiarach
+ *        @p wymiary[0] x @p wymiary[1], @p wymiary[1] x @p wymiary[2], ...
+ *
+ * @param wymiary Wymiary czynników (n + 1 liczb dla n czynników).
+ * @return Tablica podziałów n x n: element [i * n + j] (i < j) to indeks s
+ *         ostatniego czynnika lewej części iloczynu czynników i..j.
+ * @throw std::invalid_argument jeśli podano mniej niż dwie liczby.
+ */
+std::vector<std::ptrdiff_t> kolejnosc_mnozenia(const std::vector<std::ptrdiff_t>& wymiary);
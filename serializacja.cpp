@@ -0,0 +1,303 @@
+#include "serializacja.h"
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define MACIERZ_MAPOWANIE 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MACIERZ_MAPOWANIE 1
+#endif
+
+using namespace std;
+
+namespace {
+
+constexpr char SYGNATURA[8] = { 'M', 'A', 'C', 'I', 'E', 'R', 'Z', '\0' };
+constexpr uint32_t WERSJA_FORMATU = 1;
+constexpr uint16_t ZNACZNIK_KOLEJNOSCI = 0x0102;
+
+/**
+ * @brief Sprawdza sygnaturę, wersję, kolejność bajtów i wymiary nagłówka.
+ *
+ * @throw std::runtime_error jeśli nagłówek jest niepoprawny.
+ */
+void sprawdz_naglowek(const naglowek_macierzy& h) {
+    if (memcmp(h.sygnatura, SYGNATURA, sizeof(SYGNATURA)) != 0) throw runtime_error("Niepoprawny format pliku");
+    if (h.wersja != WERSJA_FORMATU) throw runtime_error("Nieobslugiwana wersja formatu");
+    if (h.kolejnosc != ZNACZNIK_KOLEJNOSCI) throw runtime_error("Niezgodna kolejnosc bajtow");
+    if (h.wierszy < 0 || h.kolumn < 0 || h.odstep < h.kolumn) throw runtime_error("Niepoprawne wymiary w pliku");
+    if (h.przesuniecie < sizeof(naglowek_macierzy)) throw runtime_error("Niepoprawny format pliku");
+}
+
+/**
+ * @brief Sprawdza, czy plik zawiera elementy typu @p T, i zwraca rozmiar
+ *        danych w bajtach.
+ *
+ * @throw std::runtime_error jeśli typ jest inny lub rozmiar przekracza zakres.
+ */
+template <typename T>
+uint64_t bajty_danych(const naglowek_macierzy& h) {
+    if (h.typ != kod_typu<T>() || h.rozmiar_elementu != sizeof(T)) throw runtime_error("Niezgodny typ elementow");
+    try {
+        const ptrdiff_t elementow = jadra::pomnoz_rozmiary(static_cast<ptrdiff_t>(h.wierszy),
+                                                           static_cast<ptrdiff_t>(h.odstep));
+        return static_cast<uint64_t>(jadra::pomnoz_rozmiary(elementow, static_cast<ptrdiff_t>(sizeof(T))));
+    } catch (const length_error&) {
+        throw runtime_error("Niepoprawne wymiary w pliku");
+    }
+}
+
+#ifdef MACIERZ_MAPOWANIE
+
+/// Zwraca wielokrotność, od której może zaczynać się mapowanie pliku.
+size_t ziarnistosc_mapowania() {
+    static const size_t z = [] {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<size_t>(info.dwAllocationGranularity);
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }();
+    return z;
+}
+
+/**
+ * @brief "Alokator" zmapowanych plików – służy jedynie do usuwania
+ *        mapowania, gdy macierz zwalnia dane.
+ *
+ * Dane zaczynają się mniej niż @ref ziarnistosc_mapowania bajtów za
+ * początkiem mapowania, więc początek jest odtwarzany przez zaokrąglenie
+ * adresu w dół; @p bajtow to długość całego mapowania.
+ */
+class alokator_mapowania : public jadra::alokator {
+public:
+    void* przydziel(size_t) override { throw bad_alloc(); }
+
+    void zwolnij(void* p, size_t bajtow) noexcept override {
+        if (p == nullptr) return;
+        const uintptr_t adres = reinterpret_cast<uintptr_t>(p);
+        void* poczatek = reinterpret_cast<void*>(adres - adres % ziarnistosc_mapowania());
+#if defined(_WIN32)
+        (void)bajtow;
+        UnmapViewOfFile(poczatek);
+#else
+        munmap(poczatek, bajtow);
+#endif
+    }
+};
+
+alokator_mapowania mapowanie; ///< Zwalniacz danych macierzy zmapowanych z plików.
+
+#endif // MACIERZ_MAPOWANIE
+
+} // namespace
+
+/**
+ * @brief Zapisuje nagłówek i wiersze macierzy.
+ *
+ * W pliku wiersze są ciągłe (odstep = liczba kolumn), więc dla macierzy
+ * z większym @c stride() zapis odbywa się wiersz po wierszu.
+ *
+ * @throw std::runtime_error jeśli zapis się nie powiódł.
+ */
+template <typename T>
+void zapisz_binarnie(const basic_matrix<T>& m, ostream& o) {
+    naglowek_macierzy h{};
+    memcpy(h.sygnatura, SYGNATURA, sizeof(SYGNATURA));
+    h.wersja = WERSJA_FORMATU;
+    h.kolejnosc = ZNACZNIK_KOLEJNOSCI;
+    h.typ = kod_typu<T>();
+    h.rozmiar_elementu = sizeof(T);
+    h.wierszy = m.rows();
+    h.kolumn = m.cols();
+    h.odstep = m.cols();
+    h.przesuniecie = sizeof(naglowek_macierzy);
+    h.wyrownanie = jadra::WYROWNANIE;
+    o.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    const streamsize wiersz = static_cast<streamsize>(m.cols()) * static_cast<streamsize>(sizeof(T));
+    if (m.stride() == m.cols()) {
+        if (m.rows() > 0) o.write(reinterpret_cast<const char*>(m.data()), wiersz * m.rows());
+    } else {
+        for (ptrdiff_t i = 0; i < m.rows() && o; ++i) o.write(reinterpret_cast<const char*>(m.row_ptr(i)), wiersz);
+    }
+    if (!o) throw runtime_error("Blad zapisu pliku");
+}
+
+/**
+ * @brief Zapisuje macierz do pliku.
+ *
+ * @throw std::runtime_error jeśli nie można utworzyć pliku lub zapis się
+ *        nie powiódł.
+ */
+template <typename T>
+void zapisz_binarnie(const basic_matrix<T>& m, const string& sciezka) {
+    ofstream o(sciezka, ios::binary | ios::trunc);
+    if (!o) throw runtime_error("Nie mozna otworzyc pliku");
+    zapisz_binarnie(m, o);
+    o.close();
+    if (!o) throw runtime_error("Blad zapisu pliku");
+}
+
+/**
+ * @brief Odczytuje i sprawdza nagłówek.
+ *
+ * @throw std::runtime_error jeśli nagłówek jest niepełny lub niepoprawny.
+ */
+naglowek_macierzy odczytaj_naglowek(istream& i) {
+    naglowek_macierzy h;
+    if (!i.read(reinterpret_cast<char*>(&h), sizeof(h))) throw runtime_error("Niepoprawny format pliku");
+    sprawdz_naglowek(h);
+    return h;
+}
+
+/**
+ * @brief Wczytuje macierz: nagłówek, pominięcie bajtów do @c przesuniecie
+ *        i wiersze (ciągłe – jednym wywołaniem @c read).
+ *
+ * @throw std::runtime_error jeśli dane są niepoprawne lub niepełne.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_binarnie(istream& i) {
+    const naglowek_macierzy h = odczytaj_naglowek(i);
+    bajty_danych<T>(h);
+    i.ignore(static_cast<streamsize>(h.przesuniecie - sizeof(h)));
+
+    basic_matrix<T> m(h.wierszy, h.kolumn, bez_zerowania);
+    const streamsize wiersz = static_cast<streamsize>(m.cols()) * static_cast<streamsize>(sizeof(T));
+    const streamsize przerwa = static_cast<streamsize>(h.odstep - h.kolumn) * static_cast<streamsize>(sizeof(T));
+    if (przerwa == 0 && m.stride() == m.cols()) {
+        if (m.rows() > 0) i.read(reinterpret_cast<char*>(m.data()), wiersz * m.rows());
+    } else {
+        for (ptrdiff_t w = 0; w < m.rows() && i; ++w) {
+            i.read(reinterpret_cast<char*>(m.row_ptr(w)), wiersz);
+            if (w + 1 < m.rows()) i.ignore(przerwa);
+        }
+    }
+    if (!i) throw runtime_error("Plik jest za krotki");
+    return m;
+}
+
+/**
+ * @brief Wczytuje macierz z pliku.
+ *
+ * @throw std::runtime_error jeśli nie można otworzyć pliku lub dane są
+ *        niepoprawne.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_binarnie(const string& sciezka) {
+    ifstream i(sciezka, ios::binary);
+    if (!i) throw runtime_error("Nie mozna otworzyc pliku");
+    return wczytaj_binarnie<T>(i);
+}
+
+/**
+ * @brief Mapuje plik do pamięci i zwraca macierz przejmującą mapowanie.
+ *
+ * Mapowanie zaczyna się od największej wielokrotności
+ * @ref ziarnistosc_mapowania nie większej niż @c przesuniecie i obejmuje
+ * dane do końca ostatniego wiersza. Strony są prywatne (kopiowane przy
+ * zapisie), więc macierz można modyfikować bez zmiany pliku.
+ *
+ * @throw std::runtime_error jeśli nie można otworzyć lub zmapować pliku
+ *        albo jest on za krótki lub niepoprawny.
+ */
+template <typename T>
+basic_matrix<T> mapuj_macierz(const string& sciezka, jadra::alokator& a) {
+#ifdef MACIERZ_MAPOWANIE
+    naglowek_macierzy h;
+    uint64_t rozmiar_pliku = 0;
+#if defined(_WIN32)
+    HANDLE plik = CreateFileA(sciezka.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (plik == INVALID_HANDLE_VALUE) throw runtime_error("Nie mozna otworzyc pliku");
+    struct zamknij_plik {
+        HANDLE u;
+        ~zamknij_plik() { CloseHandle(u); }
+    } zamykacz{ plik };
+    LARGE_INTEGER rozmiar;
+    DWORD przeczytane = 0;
+    if (!GetFileSizeEx(plik, &rozmiar) || !ReadFile(plik, &h, sizeof(h), &przeczytane, nullptr) ||
+        przeczytane != sizeof(h)) {
+        throw runtime_error("Niepoprawny format pliku");
+    }
+    rozmiar_pliku = static_cast<uint64_t>(rozmiar.QuadPart);
+#else
+    const int plik = open(sciezka.c_str(), O_RDONLY);
+    if (plik < 0) throw runtime_error("Nie mozna otworzyc pliku");
+    struct zamknij_plik {
+        int u;
+        ~zamknij_plik() { close(u); }
+    } zamykacz{ plik };
+    struct stat st;
+    if (fstat(plik, &st) != 0 || pread(plik, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h))) {
+        throw runtime_error("Niepoprawny format pliku");
+    }
+    rozmiar_pliku = static_cast<uint64_t>(st.st_size);
+#endif
+    sprawdz_naglowek(h);
+    const uint64_t bajtow = bajty_danych<T>(h);
+    if (h.przesuniecie > rozmiar_pliku || bajtow > rozmiar_pliku - h.przesuniecie) {
+        throw runtime_error("Plik jest za krotki");
+    }
+    if (h.przesuniecie % alignof(T) != 0) throw runtime_error("Niewyrownane dane w pliku");
+    if (bajtow == 0) return basic_matrix<T>(h.wierszy, h.kolumn, h.odstep, jadra::tablica<T>(), a);
+
+    const uint64_t poczatek = h.przesuniecie - h.przesuniecie % ziarnistosc_mapowania();
+    const size_t dlugosc = static_cast<size_t>(h.przesuniecie - poczatek + bajtow);
+#if defined(_WIN32)
+    HANDLE odwzorowanie = CreateFileMappingA(plik, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (odwzorowanie == nullptr) throw runtime_error("Nie mozna zmapowac pliku");
+    void* p = MapViewOfFile(odwzorowanie, FILE_MAP_COPY, static_cast<DWORD>(poczatek >> 32),
+                            static_cast<DWORD>(poczatek & 0xFFFFFFFFu), dlugosc);
+    CloseHandle(odwzorowanie); // widok utrzymuje odwzorowanie
+    if (p == nullptr) throw runtime_error("Nie mozna zmapowac pliku");
+#else
+    void* p = mmap(nullptr, dlugosc, PROT_READ | PROT_WRITE, MAP_PRIVATE, plik, static_cast<off_t>(poczatek));
+    if (p == MAP_FAILED) throw runtime_error("Nie mozna zmapowac pliku");
+#endif
+    T* dane = reinterpret_cast<T*>(static_cast<char*>(p) + (h.przesuniecie - poczatek));
+    return basic_matrix<T>(h.wierszy, h.kolumn, h.odstep, jadra::tablica<T>(dane, jadra::zwalniacz{ &mapowanie, dlugosc }),
+                           a);
+#else
+    (void)a;
+    return wczytaj_binarnie<T>(sciezka);
+#endif
+}
+
+/**
+ * @brief Jawne konkretyzacje zapisu i odczytu dla typu @p T.
+ */
+#define MACIERZ_INSTANCJA_SERIALIZACJI(T)                                          \
+    template void zapisz_binarnie<T>(const basic_matrix<T>&, ostream&);            \
+    template void zapisz_binarnie<T>(const basic_matrix<T>&, const string&);       \
+    template basic_matrix<T> wczytaj_binarnie<T>(istream&);                        \
+    template basic_matrix<T> wczytaj_binarnie<T>(const string&);                   \
+    template basic_matrix<T> mapuj_macierz<T>(const string&, jadra::alokator&);
+
+MACIERZ_INSTANCJA_SERIALIZACJI(int8_t)
+MACIERZ_INSTANCJA_SERIALIZACJI(int16_t)
+MACIERZ_INSTANCJA_SERIALIZACJI(int32_t)
+MACIERZ_INSTANCJA_SERIALIZACJI(int64_t)
+MACIERZ_INSTANCJA_SERIALIZACJI(float)
+MACIERZ_INSTANCJA_SERIALIZACJI(double)
+
+#undef MACIERZ_INSTANCJA_SERIALIZACJI
+
+#undef MACIERZ_MAPOWANIE
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file serializacja.h
+ * @brief Zapis macierzy do pliku binarnego, odczyt i mapowanie pliku
+ *        do pamięci bez kopiowania.
+ *
+ * Plik składa się z 64-bajtowego nagłówka (@ref naglowek_macierzy) i danych
+ * – wierszy po @c odstep elementów, w kolejności bajtów procesora, który
+ * plik zapisał. Dane zaczynają się od bajtu @c przesuniecie, wielokrotności
+ * @c wyrownanie (64), więc plik zmapowany do pamięci spełnia te same
+ * wymagania wyrównania co bloki z @ref jadra::alokator.
+ *
+ * @ref mapuj_macierz zwraca zwykłą macierz, której dane są stronami pliku
+ * zmapowanymi w trybie kopiowania przy zapisie: system wczytuje strony
+ * dopiero przy pierwszym dostępie, a zmiany macierzy nie trafiają do
+ * pliku. Zniszczenie macierzy (lub jej realokacja) usuwa mapowanie.
+ */
+
+#include "matrix.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+
+/**
+ * @struct naglowek_macierzy
+ * @brief Nagłówek pliku binarnego macierzy (64 bajty).
+ */
+struct naglowek_macierzy {
+    char sygnatura[8];             ///< "MACIERZ\0".
+    std::uint32_t wersja;          ///< Wersja formatu (1).
+    std::uint16_t kolejnosc;       ///< 0x0102 zapisane w kolejności bajtów autora pliku.
+    std::uint8_t typ;              ///< Kod typu elementów (zob. @ref kod_typu).
+    std::uint8_t rozmiar_elementu; ///< @c sizeof typu elementów.
+    std::int64_t wierszy;          ///< Liczba wierszy.
+    std::int64_t kolumn;           ///< Liczba kolumn.
+    std::int64_t odstep;           ///< Odległość między początkami wierszy (w elementach).
+    std::uint64_t przesuniecie;    ///< Położenie danych w pliku (w bajtach).
+    std::uint64_t wyrownanie;      ///< Wyrównanie @c przesuniecie (w bajtach).
+    std::uint8_t zarezerwowane[8]; ///< Zera.
+};
+
+static_assert(sizeof(naglowek_macierzy) == 64, "Naglowek pliku musi miec 64 bajty");
+
+/**
+ * @brief Zwraca kod typu @p T zapisywany w nagłówku: 1 – int8, 2 – int16,
+ *        3 – int32, 4 – int64, 5 – float, 6 – double.
+ */
+template <typename T>
+constexpr std::uint8_t kod_typu() {
+    if constexpr (std::is_same_v<T, std::int8_t>) return 1;
+    else if constexpr (std::is_same_v<T, std::int16_t>) return 2;
+    else if constexpr (std::is_same_v<T, std::int32_t>) return 3;
+    else if constexpr (std::is_same_v<T, std::int64_t>) return 4;
+    else if constexpr (std::is_same_v<T, float>) return 5;
+    else if constexpr (std::is_same_v<T, double>) return 6;
+    else static_assert(sizeof(T) == 0, "Nieobslugiwany typ elementow");
+}
+
+/**
+ * @brief Zapisuje macierz @p m do strumienia binarnego @p o.
+ *
+ * Wiersze są zapisywane kolejno, bez kopii pośredniej (macierz ciągła –
+ * jednym wywołaniem @c write).
+ *
+ * @throw std::runtime_error jeśli zapis się nie powiódł.
+ */
+template <typename T>
+void zapisz_binarnie(const basic_matrix<T>& m, std::ostream& o);
+
+/**
+ * @brief Zapisuje macierz @p m do pliku @p sciezka (zastępując go).
+ *
+ * @throw std::runtime_error jeśli nie można utworzyć pliku lub zapis się
+ *        nie powiódł.
+ */
+template <typename T>
+void zapisz_binarnie(const basic_matrix<T>& m, const std::string& sciezka);
+
+/**
+ * @brief Odczytuje nagłówek pliku macierzy ze strumienia @p i (np. by
+ *        sprawdzić typ elementów przed wczytaniem).
+ *
+ * @throw std::runtime_error jeśli nagłówek jest niepoprawny.
+ */
+naglowek_macierzy odczytaj_naglowek(std::istream& i);
+
+/**
+ * @brief Wczytuje macierz ze strumienia binarnego @p i.
+ *
+ * @throw std::runtime_error jeśli dane są niepoprawne, niepełne lub typ
+ *        elementów w pliku jest inny niż @p T.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_binarnie(std::istream& i);
+
+/**
+ * @brief Wczytuje macierz z pliku @p sciezka (kopiując dane do pamięci).
+ *
+ * @throw std::runtime_error jak wyżej lub jeśli nie można otworzyć pliku.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_binarnie(const std::string& sciezka);
+
+/**
+ * @brief Zwraca macierz, której danymi są strony pliku @p sciezka
+ *        zmapowane do pamięci (bez kopiowania).
+ *
+ * Na systemach bez mapowania plików (innych niż Windows i POSIX) dane są
+ * wczytywane jak przez @ref wczytaj_binarnie.
+ *
+ * @param sciezka Plik zapisany przez @ref zapisz_binarnie.
+ * @param a Alokator dla późniejszych realokacji macierzy.
+ * @throw std::runtime_error jeśli nie można otworzyć lub zmapować pliku,
+ *        jest za krótki, niepoprawny lub typ elementów jest inny niż @p T.
+ */
+template <typename T>
+basic_matrix<T> mapuj_macierz(const std::string& sciezka, jadra::alokator& a = jadra::domyslny_alokator());
@@ -0,0 +1,342 @@
+#include "simd.h"
+#include "cpu.h"
+#include <cstdint>
+
+#ifdef MACIERZ_X86
+#include <immintrin.h>
+#endif
+
+namespace jadra {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Wariant skalarny
+// ---------------------------------------------------------------------------
+
+void dodaj_skalar_skalarny(int* d, long long liczba, int a) {
+    for (long long i = 0; i < liczba; ++i) d[i] += a;
+}
+
+void mnoz_skalar_skalarny(int* d, long long liczba, int a) {
+    for (long long i = 0; i < liczba; ++i) d[i] *= a;
+}
+
+void dodaj_skalarny(int* d, const int* z, long long liczba) {
+    for (long long i = 0; i < liczba; ++i) d[i] += z[i];
+}
+
+void skalar_minus_skalarny(int* d, const int* z, long long liczba, int a) {
+    for (long long i = 0; i < liczba; ++i) d[i] = a - z[i];
+}
+
+#ifdef MACIERZ_X86
+
+// ---------------------------------------------------------------------------
+// Wariant SSE4.2 (4 liczby int na rejestr)
+// ---------------------------------------------------------------------------
+
+MACIERZ_CEL("sse4.2")
+void dodaj_skalar_sse42(int* d, long long liczba, int a) {
+    const __m128i va = _mm_set1_epi32(a);
+    long long i = 0;
+    for (; i + 4 <= liczba; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_add_epi32(x, va));
+    }
+    for (; i < liczba; ++i) d[i] += a;
+}
+
+MACIERZ_CEL("sse4.2")
+void mnoz_skalar_sse42(int* d, long long liczba, int a) {
+    const __m128i va = _mm_set1_epi32(a);
+    long long i = 0;
+    for (; i + 4 <= liczba; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_mullo_epi32(x, va));
+    }
+    for (; i < liczba; ++i) d[i] *= a;
+}
+
+MACIERZ_CEL("sse4.2")
+void dodaj_sse42(int* d, const int* z, long long liczba) {
+    long long i = 0;
+    for (; i + 4 <= liczba; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(z + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_add_epi32(x, y));
+    }
+    for (; i < liczba; ++i) d[i] += z[i];
+}
+
+MACIERZ_CEL("sse4.2")
+void skalar_minus_sse42(int* d, const int* z, long long liczba, int a) {
+    const __m128i va = _mm_set1_epi32(a);
+    long long i = 0;
+    for (; i + 4 <= liczba; i += 4) {
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(z + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_sub_epi32(va, y));
+    }
+    for (; i < liczba; ++i) d[i] = a - z[i];
+}
+
+// ---------------------------------------------------------------------------
+// Wariant AVX2 (8 liczb int na rejestr, pętle rozwinięte dwukrotnie)
+// ---------------------------------------------------------------------------
+
+MACIERZ_CEL("avx2")
+void dodaj_skalar_avx2(int* d, long long liczba, int a) {
+    const __m256i va = _mm256_set1_epi32(a);
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_add_epi32(x0, va));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 8), _mm256_add_epi32(x1, va));
+    }
+    for (; i < liczba; ++i) d[i] += a;
+}
+
+MACIERZ_CEL("avx2")
+void mnoz_skalar_avx2(int* d, long long liczba, int a) {
+    const __m256i va = _mm256_set1_epi32(a);
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_mullo_epi32(x0, va));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 8), _mm256_mullo_epi32(x1, va));
+    }
+    for (; i < liczba; ++i) d[i] *= a;
+}
+
+MACIERZ_CEL("avx2")
+void dodaj_avx2(int* d, const int* z, long long liczba) {
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + 8));
+        __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(z + i));
+        __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(z + i + 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_add_epi32(x0, y0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 8), _mm256_add_epi32(x1, y1));
+    }
+    for (; i < liczba; ++i) d[i] += z[i];
+}
+
+MACIERZ_CEL("avx2")
+void skalar_minus_avx2(int* d, const int* z, long long liczba, int a) {
+    const __m256i va = _mm256_set1_epi32(a);
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(z + i));
+        __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(z + i + 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_sub_epi32(va, y0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 8), _mm256_sub_epi32(va, y1));
+    }
+    for (; i < liczba; ++i) d[i] = a - z[i];
+}
+
+// ---------------------------------------------------------------------------
+// Wariant AVX-512 (16 liczb int na rejestr, końcówka przez maskę)
+// ---------------------------------------------------------------------------
+
+/// Maska pierwszych @p reszta (< 16) elementów rejestru.
+inline __mmask16 maska_konca(long long reszta) {
+    return static_cast<__mmask16>((1u << reszta) - 1);
+}
+
+MACIERZ_CEL("avx512f")
+void dodaj_skalar_avx512(int* d, long long liczba, int a) {
+    const __m512i va = _mm512_set1_epi32(a);
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m512i x = _mm512_loadu_si512(d + i);
+        _mm512_storeu_si512(d + i, _mm512_add_epi32(x, va));
+    }
+    if (i < liczba) {
+        const __mmask16 m = maska_konca(liczba - i);
+        __m512i x = _mm512_maskz_loadu_epi32(m, d + i);
+        _mm512_mask_storeu_epi32(d + i, m, _mm512_add_epi32(x, va));
+    }
+}
+
+MACIERZ_CEL("avx512f")
+void mnoz_skalar_avx512(int* d, long long liczba, int a) {
+    const __m512i va = _mm512_set1_epi32(a);
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m512i x = _mm512_loadu_si512(d + i);
+        _mm512_storeu_si512(d + i, _mm512_mullo_epi32(x, va));
+    }
+    if (i < liczba) {
+        const __mmask16 m = maska_konca(liczba - i);
+        __m512i x = _mm512_maskz_loadu_epi32(m, d + i);
+        _mm512_mask_storeu_epi32(d + i, m, _mm512_mullo_epi32(x, va));
+    }
+}
+
+MACIERZ_CEL("avx512f")
+void dodaj_avx512(int* d, const int* z, long long liczba) {
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m512i x = _mm512_loadu_si512(d + i);
+        __m512i y = _mm512_loadu_si512(z + i);
+        _mm512_storeu_si512(d + i, _mm512_add_epi32(x, y));
+    }
+    if (i < liczba) {
+        const __mmask16 m = maska_konca(liczba - i);
+        __m512i x = _mm512_maskz_loadu_epi32(m, d + i);
+        __m512i y = _mm512_maskz_loadu_epi32(m, z + i);
+        _mm512_mask_storeu_epi32(d + i, m, _mm512_add_epi32(x, y));
+    }
+}
+
+MACIERZ_CEL("avx512f")
+void skalar_minus_avx512(int* d, const int* z, long long liczba, int a) {
+    const __m512i va = _mm512_set1_epi32(a);
+    long long i = 0;
+    for (; i + 16 <= liczba; i += 16) {
+        __m512i y = _mm512_loadu_si512(z + i);
+        _mm512_storeu_si512(d + i, _mm512_sub_epi32(va, y));
+    }
+    if (i < liczba) {
+        const __mmask16 m = maska_konca(liczba - i);
+        __m512i y = _mm512_maskz_loadu_epi32(m, z + i);
+        _mm512_mask_storeu_epi32(d + i, m, _mm512_sub_epi32(va, y));
+    }
+}
+
+#endif // MACIERZ_X86
+
+// ---------------------------------------------------------------------------
+// Jądra ogólne dla pozostałych typów elementów
+//
+// Pętle przetwarzają stałe paczki po PACZKA elementów: przy stałej liczbie
+// iteracji kompilator wektoryzuje je także przy -O2. Warianty "_avx2" to te
+// same pętle skompilowane z rozszerzeniem AVX2.
+// ---------------------------------------------------------------------------
+
+/// Liczba elementów jednej paczki w jądrach ogólnych.
+constexpr long long PACZKA = 32;
+
+template <typename T>
+inline void dodaj_skalar_ogolne(T* d, long long liczba, T a) {
+    long long i = 0;
+    for (; i + PACZKA <= liczba; i += PACZKA) {
+        for (long long j = 0; j < PACZKA; ++j) d[i + j] = static_cast<T>(d[i + j] + a);
+    }
+    for (; i < liczba; ++i) d[i] = static_cast<T>(d[i] + a);
+}
+
+template <typename T>
+inline void mnoz_skalar_ogolne(T* d, long long liczba, T a) {
+    long long i = 0;
+    for (; i + PACZKA <= liczba; i += PACZKA) {
+        for (long long j = 0; j < PACZKA; ++j) d[i + j] = static_cast<T>(d[i + j] * a);
+    }
+    for (; i < liczba; ++i) d[i] = static_cast<T>(d[i] * a);
+}
+
+template <typename T>
+inline void dodaj_ogolne(T* d, const T* z, long long liczba) {
+    long long i = 0;
+    for (; i + PACZKA <= liczba; i += PACZKA) {
+        MACIERZ_IVDEP
+        for (long long j = 0; j < PACZKA; ++j) d[i + j] = static_cast<T>(d[i + j] + z[i + j]);
+    }
+    for (; i < liczba; ++i) d[i] = static_cast<T>(d[i] + z[i]);
+}
+
+template <typename T>
+inline void skalar_minus_ogolne(T* d, const T* z, long long liczba, T a) {
+    long long i = 0;
+    for (; i + PACZKA <= liczba; i += PACZKA) {
+        MACIERZ_IVDEP
+        for (long long j = 0; j < PACZKA; ++j) d[i + j] = static_cast<T>(a - z[i + j]);
+    }
+    for (; i < liczba; ++i) d[i] = static_cast<T>(a - z[i]);
+}
+
+#ifdef MACIERZ_X86
+
+template <typename T>
+MACIERZ_CEL("avx2")
+void dodaj_skalar_ogolne_avx2(T* d, long long liczba, T a) {
+    dodaj_skalar_ogolne(d, liczba, a);
+}
+
+template <typename T>
+MACIERZ_CEL("avx2")
+void mnoz_skalar_ogolne_avx2(T* d, long long liczba, T a) {
+    mnoz_skalar_ogolne(d, liczba, a);
+}
+
+template <typename T>
+MACIERZ_CEL("avx2")
+void dodaj_ogolne_avx2(T* d, const T* z, long long liczba) {
+    dodaj_ogolne(d, z, liczba);
+}
+
+template <typename T>
+MACIERZ_CEL("avx2")
+void skalar_minus_ogolne_avx2(T* d, const T* z, long long liczba, T a) {
+    skalar_minus_ogolne(d, z, liczba, a);
+}
+
+#endif // MACIERZ_X86
+
+/**
+ * @brief Wybiera najlepszy wariant jąder obsługiwany przez procesor.
+ *
+ * @return Tablica jąder wybranego wariantu.
+ */
+template <typename T>
+jadra_elementowe<T> wybierz() {
+#ifdef MACIERZ_X86
+    if (procesor().avx2) {
+        return { dodaj_skalar_ogolne_avx2<T>, mnoz_skalar_ogolne_avx2<T>, dodaj_ogolne_avx2<T>,
+                 skalar_minus_ogolne_avx2<T>, "avx2" };
+    }
+#endif
+    return { dodaj_skalar_ogolne<T>, mnoz_skalar_ogolne<T>, dodaj_ogolne<T>, skalar_minus_ogolne<T>, "skalarny" };
+}
+
+template <>
+jadra_elementowe<int> wybierz<int>() {
+#ifdef MACIERZ_X86
+    const cpu_info& cpu = procesor();
+    if (cpu.avx512f) {
+        return { dodaj_skalar_avx512, mnoz_skalar_avx512, dodaj_avx512, skalar_minus_avx512, "avx512" };
+    }
+    if (cpu.avx2) {
+        return { dodaj_skalar_avx2, mnoz_skalar_avx2, dodaj_avx2, skalar_minus_avx2, "avx2" };
+    }
+    if (cpu.sse42) {
+        return { dodaj_skalar_sse42, mnoz_skalar_sse42, dodaj_sse42, skalar_minus_sse42, "sse4.2" };
+    }
+#endif
+    return { dodaj_skalar_skalarny, mnoz_skalar_skalarny, dodaj_skalarny, skalar_minus_skalarny, "skalarny" };
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca jądra najlepszego wariantu (wybieranego raz, przy pierwszym wywołaniu).
+ *
+ * @return Referencja do statycznej tablicy jąder.
+ */
+template <typename T>
+const jadra_elementowe<T>& elementowe() {
+    static const jadra_elementowe<T> wybrane = wybierz<T>();
+    return wybrane;
+}
+
+template const jadra_elementowe<std::int8_t>& elementowe<std::int8_t>();
+template const jadra_elementowe<std::int16_t>& elementowe<std::int16_t>();
+template const jadra_elementowe<std::int32_t>& elementowe<std::int32_t>();
+template const jadra_elementowe<std::int64_t>& elementowe<std::int64_t>();
+template const jadra_elementowe<float>& elementowe<float>();
+template const jadra_elementowe<double>& elementowe<double>();
+
+} // namespace jadra
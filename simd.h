@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+ * @file simd.h
+ * @brief Wektorowe jądra operacji element po elemencie z wyborem wariantu
+ *        w czasie działania programu.
+ *
+ * Dostępne są warianty AVX-512, AVX2, SSE4.2 oraz skalarny. Wariant jest
+ * wybierany raz (przy pierwszym wywołaniu @ref jadra::elementowe) na podstawie
+ * rozszerzeń wykrytych instrukcją CPUID, dzięki czemu jeden plik wykonywalny
+ * działa na różnych procesorach.
+ */
+
+namespace jadra {
+
+/**
+ * @struct jadra_elementowe
+ * @brief Tablica wskaźników na jądra wybranego wariantu SIMD.
+ *
+ * Wszystkie jądra działają na ciągłych tablicach o długości @c liczba.
+ *
+ * @tparam T Typ elementów (int8/16/32/64, float lub double).
+ */
+template <typename T>
+struct jadra_elementowe {
+    /// d[i] += a
+    void (*dodaj_skalar)(T* d, long long liczba, T a);
+    /// d[i] *= a
+    void (*mnoz_skalar)(T* d, long long liczba, T a);
+    /// d[i] += z[i]
+    void (*dodaj)(T* d, const T* z, long long liczba);
+    /// d[i] = a - z[i]
+    void (*skalar_minus)(T* d, const T* z, long long liczba, T a);
+    /// Nazwa wariantu ("avx512", "avx2", "sse4.2" lub "skalarny").
+    const char* nazwa;
+};
+
+/**
+ * @brief Zwraca jądra najlepszego wariantu obsługiwanego przez procesor.
+ *
+ * Dla @c int jądra są pisane ręcznie (AVX-512 / AVX2 / SSE4.2); dla
+ * pozostałych typów są to pętle zwektoryzowane przez kompilator, w wariancie
+ * AVX2 lub podstawowym.
+ *
+ * @tparam T Typ elementów.
+ * @return Referencja do statycznej tablicy jąder.
+ */
+template <typename T>
+const jadra_elementowe<T>& elementowe();
+
+} // namespace jadra
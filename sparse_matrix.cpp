@@ -0,0 +1,522 @@
+#include "sparse_matrix.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Kompresuje trójki (@p glowne[e], @p poboczne[e], @p v[e]) do
+ *        formatu ze wskaźnikami po indeksie głównym (wiersz dla CSR,
+ *        kolumna dla CSC).
+ *
+ * Elementy są rozkładane sortowaniem przez zliczanie według indeksu
+ * głównego, a w obrębie wiersza sortowane po indeksie pobocznym
+ * (stabilnie, więc powtórzenia są sumowane w kolejności dodania).
+ * Zera są pomijane.
+ */
+template <typename T>
+void kompresuj_trojki(ptrdiff_t glownych, const vector<ptrdiff_t>& glowne, const vector<ptrdiff_t>& poboczne,
+                      const vector<T>& v, vector<ptrdiff_t>& wsk, vector<ptrdiff_t>& ind, vector<T>& wart) {
+    const size_t liczba = v.size();
+    wsk.assign(static_cast<size_t>(glownych) + 1, 0);
+    for (ptrdiff_t g : glowne) ++wsk[g + 1];
+    partial_sum(wsk.begin(), wsk.end(), wsk.begin());
+
+    vector<pair<ptrdiff_t, T>> rozlozone(liczba);
+    {
+        vector<ptrdiff_t> pozycja(wsk.begin(), wsk.end() - 1);
+        for (size_t e = 0; e < liczba; ++e) rozlozone[pozycja[glowne[e]]++] = { poboczne[e], v[e] };
+    }
+
+    ind.resize(liczba);
+    wart.resize(liczba);
+    ptrdiff_t zapis = 0;
+    for (ptrdiff_t g = 0; g < glownych; ++g) {
+        const auto poczatek = rozlozone.begin() + wsk[g];
+        const auto koniec = rozlozone.begin() + wsk[g + 1];
+        stable_sort(poczatek, koniec, [](const auto& x, const auto& y) { return x.first < y.first; });
+        wsk[g] = zapis;
+        for (auto it = poczatek; it != koniec;) {
+            const ptrdiff_t indeks = it->first;
+            T suma = T(0);
+            for (; it != koniec && it->first == indeks; ++it) suma = static_cast<T>(suma + it->second);
+            if (suma != T(0)) {
+                ind[zapis] = indeks;
+                wart[zapis] = suma;
+                ++zapis;
+            }
+        }
+    }
+    wsk[glownych] = zapis;
+    ind.resize(static_cast<size_t>(zapis));
+    wart.resize(static_cast<size_t>(zapis));
+}
+
+/**
+ * @brief Przestawia macierz skompresowaną po indeksie głównym na
+ *        skompresowaną po indeksie pobocznym (CSR <-> CSC).
+ *
+ * Elementy są przechodzone w kolejności głównych indeksów, więc w wyniku
+ * pozostają posortowane.
+ */
+template <typename T>
+void przestaw_skompresowana(ptrdiff_t glownych, ptrdiff_t pobocznych, const vector<ptrdiff_t>& wsk,
+                            const vector<ptrdiff_t>& ind, const vector<T>& wart, vector<ptrdiff_t>& nowe_wsk,
+                            vector<ptrdiff_t>& nowe_ind, vector<T>& nowe_wart) {
+    nowe_wsk.assign(static_cast<size_t>(pobocznych) + 1, 0);
+    for (ptrdiff_t p : ind) ++nowe_wsk[p + 1];
+    partial_sum(nowe_wsk.begin(), nowe_wsk.end(), nowe_wsk.begin());
+
+    nowe_ind.resize(ind.size());
+    nowe_wart.resize(wart.size());
+    vector<ptrdiff_t> pozycja(nowe_wsk.begin(), nowe_wsk.end() - 1);
+    for (ptrdiff_t g = 0; g < glownych; ++g) {
+        for (ptrdiff_t e = wsk[g]; e < wsk[g + 1]; ++e) {
+            const ptrdiff_t cel = pozycja[ind[e]]++;
+            nowe_ind[cel] = g;
+            nowe_wart[cel] = wart[e];
+        }
+    }
+}
+
+/**
+ * @brief Zwraca ziarno podziału wierszy między wątki, gdy wiersz kosztuje
+ *        około @p praca_wiersza operacji.
+ */
+long long ziarno_wierszy(double praca_wiersza) {
+    return max(1LL, static_cast<long long>(PROG_ROWNOLEGLY / max(praca_wiersza, 1.0)));
+}
+
+/**
+ * @brief Zwraca @p a w formacie CSR – samą macierz albo jej przekonwertowaną
+ *        kopię w @p kopia.
+ */
+template <typename T>
+const basic_sparse_matrix<T>& jako_csr(const basic_sparse_matrix<T>& a, basic_sparse_matrix<T>& kopia) {
+    if (a.format() == format_rzadki::csr) return a;
+    kopia = a;
+    kopia.konwertuj(format_rzadki::csr);
+    return kopia;
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor domyślny: pusta macierz 0 x 0 w formacie CSR.
+ */
+template <typename T>
+basic_sparse_matrix<T>::basic_sparse_matrix() : basic_sparse_matrix(0, 0, format_rzadki::csr) {
+}
+
+/**
+ * @brief Tworzy macierz bez niezerowych elementów.
+ *
+ * @param wiersze Liczba wierszy.
+ * @param kolumny Liczba kolumn.
+ * @param f Format.
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ */
+template <typename T>
+basic_sparse_matrix<T>::basic_sparse_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, format_rzadki f)
+    : wierszy(wiersze), kolumn(kolumny), fmt(f) {
+    if (wiersze < 0 || kolumny < 0) throw invalid_argument("Rozmiar ujemny");
+    if (f == format_rzadki::csr) wsk.assign(static_cast<size_t>(wiersze) + 1, 0);
+    if (f == format_rzadki::csc) wsk.assign(static_cast<size_t>(kolumny) + 1, 0);
+}
+
+/**
+ * @brief Tworzy macierz CSR lub CSC z gotowych tablic, sprawdzając ich spójność.
+ *
+ * @throw std::invalid_argument jeśli format to COO, rozmiary tablic się nie
+ *        zgadzają, wskaźniki maleją lub wychodzą poza tablicę indeksów
+ *        albo indeks jest poza zakresem lub
+ *        indeksy wiersza (kolumny) nie rosną.
+ */
+template <typename T>
+basic_sparse_matrix<T>::basic_sparse_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, format_rzadki f,
+                                            vector<ptrdiff_t> wskazniki, vector<ptrdiff_t> indeksy,
+                                            vector<T> wartosci)
+    : basic_sparse_matrix(wiersze, kolumny, f) {
+    if (f == format_rzadki::coo) throw invalid_argument("Format COO nie ma tablicy wskaznikow");
+    const ptrdiff_t glownych = f == format_rzadki::csr ? wiersze : kolumny;
+    const ptrdiff_t pobocznych = f == format_rzadki::csr ? kolumny : wiersze;
+    if (static_cast<ptrdiff_t>(wskazniki.size()) != glownych + 1 || indeksy.size() != wartosci.size() ||
+        wskazniki.front() != 0 || wskazniki.back() != static_cast<ptrdiff_t>(indeksy.size())) {
+        throw invalid_argument("Niespojne tablice macierzy rzadkiej");
+    }
+    // najpierw same wskaźniki: dopiero gdy rosną i mieszczą się w tablicy indeksów, wolno po niej chodzić
+    const ptrdiff_t wpisow = static_cast<ptrdiff_t>(indeksy.size());
+    for (ptrdiff_t g = 0; g < glownych; ++g) {
+        if (wskazniki[g] > wskazniki[g + 1]) throw invalid_argument("Malejace wskazniki macierzy rzadkiej");
+        if (wskazniki[g] < 0 || wskazniki[g + 1] > wpisow) throw invalid_argument("Niespojne tablice macierzy rzadkiej");
+    }
+    for (ptrdiff_t g = 0; g < glownych; ++g) {
+        for (ptrdiff_t e = wskazniki[g]; e < wskazniki[g + 1]; ++e) {
+            if (indeksy[e] < 0 || indeksy[e] >= pobocznych) throw invalid_argument("Indeks poza zakresem");
+            if (e > wskazniki[g] && indeksy[e] <= indeksy[e - 1]) {
+                throw invalid_argument("Indeksy macierzy rzadkiej nie sa rosnace");
+            }
+        }
+    }
+    wsk = std::move(wskazniki);
+    (f == format_rzadki::csr ? ind_k : ind_w) = std::move(indeksy);
+    wart = std::move(wartosci);
+}
+
+/**
+ * @brief Tworzy macierz rzadką z niezerowych elementów macierzy gęstej.
+ *
+ * Liczby elementów wierszy są zliczane równolegle, a po wyznaczeniu
+ * wskaźników wiersze są równolegle przepisywane.
+ */
+template <typename T>
+basic_sparse_matrix<T>::basic_sparse_matrix(const basic_matrix<T>& m, format_rzadki f)
+    : basic_sparse_matrix(m.rows(), m.cols(), format_rzadki::csr) {
+    const ptrdiff_t w = m.rows(), k = m.cols();
+    const long long ziarno = ziarno_wierszy(static_cast<double>(k));
+    rownolegle_dla(0, w, ziarno, [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const T* z = m.row_ptr(static_cast<ptrdiff_t>(i));
+            wsk[i + 1] = count_if(z, z + k, [](T x) { return x != T(0); });
+        }
+    });
+    partial_sum(wsk.begin(), wsk.end(), wsk.begin());
+    ind_k.resize(static_cast<size_t>(wsk.back()));
+    wart.resize(static_cast<size_t>(wsk.back()));
+    rownolegle_dla(0, w, ziarno, [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const T* z = m.row_ptr(static_cast<ptrdiff_t>(i));
+            ptrdiff_t e = wsk[i];
+            for (ptrdiff_t j = 0; j < k; ++j) {
+                if (z[j] != T(0)) {
+                    ind_k[e] = j;
+                    wart[e] = z[j];
+                    ++e;
+                }
+            }
+        }
+    });
+    konwertuj(f);
+}
+
+/**
+ * @brief Rezerwuje miejsce na @p liczba elementów.
+ */
+template <typename T>
+void basic_sparse_matrix<T>::reserve(ptrdiff_t liczba) {
+    if (liczba < 0) throw invalid_argument("Rozmiar ujemny");
+    const size_t n = static_cast<size_t>(liczba);
+    if (fmt != format_rzadki::csr) ind_w.reserve(n);
+    if (fmt != format_rzadki::csc) ind_k.reserve(n);
+    wart.reserve(n);
+}
+
+/**
+ * @brief Dodaje element (@p x, @p y) o wartości @p wartosc (w formacie COO).
+ *
+ * @throw std::out_of_range jeśli indeksy są poza zakresem.
+ */
+template <typename T>
+basic_sparse_matrix<T>& basic_sparse_matrix<T>::dodaj_element(ptrdiff_t x, ptrdiff_t y, T wartosc) {
+    if (x < 0 || x >= wierszy || y < 0 || y >= kolumn) throw out_of_range("Indeks poza zakresem");
+    konwertuj(format_rzadki::coo);
+    ind_w.push_back(x);
+    ind_k.push_back(y);
+    wart.push_back(wartosc);
+    return *this;
+}
+
+/**
+ * @brief Konwertuje macierz do formatu @p f.
+ *
+ * CSR i CSC są przestawiane nawzajem bez sortowania; COO jest
+ * kompresowane bezpośrednio do formatu docelowego.
+ */
+template <typename T>
+basic_sparse_matrix<T>& basic_sparse_matrix<T>::konwertuj(format_rzadki f) {
+    if (f == fmt) return *this;
+
+    if (f == format_rzadki::coo) {
+        // Rozwinięcie wskaźników do indeksów głównych.
+        vector<ptrdiff_t>& glowne = fmt == format_rzadki::csr ? ind_w : ind_k;
+        const ptrdiff_t glownych = static_cast<ptrdiff_t>(wsk.size()) - 1;
+        glowne.resize(wart.size());
+        for (ptrdiff_t g = 0; g < glownych; ++g) {
+            fill(glowne.begin() + wsk[g], glowne.begin() + wsk[g + 1], g);
+        }
+        wsk.clear();
+        wsk.shrink_to_fit();
+    }
+    else if (fmt == format_rzadki::coo) {
+        vector<ptrdiff_t> nowe_wsk, nowe_ind;
+        vector<T> nowe_wart;
+        if (f == format_rzadki::csr) kompresuj_trojki(wierszy, ind_w, ind_k, wart, nowe_wsk, nowe_ind, nowe_wart);
+        else kompresuj_trojki(kolumn, ind_k, ind_w, wart, nowe_wsk, nowe_ind, nowe_wart);
+        wsk = std::move(nowe_wsk);
+        ind_w.clear();
+        ind_k.clear();
+        (f == format_rzadki::csr ? ind_k : ind_w) = std::move(nowe_ind);
+        wart = std::move(nowe_wart);
+    }
+    else {
+        vector<ptrdiff_t> nowe_wsk, nowe_ind;
+        vector<T> nowe_wart;
+        if (f == format_rzadki::csc) {
+            przestaw_skompresowana(wierszy, kolumn, wsk, ind_k, wart, nowe_wsk, nowe_ind, nowe_wart);
+            ind_k.clear();
+            ind_w = std::move(nowe_ind);
+        }
+        else {
+            przestaw_skompresowana(kolumn, wierszy, wsk, ind_w, wart, nowe_wsk, nowe_ind, nowe_wart);
+            ind_w.clear();
+            ind_k = std::move(nowe_ind);
+        }
+        wsk = std::move(nowe_wsk);
+        wart = std::move(nowe_wart);
+    }
+    fmt = f;
+    return *this;
+}
+
+/**
+ * @brief Zwraca macierz gęstą o tej samej zawartości (powtórzenia w COO
+ *        są sumowane).
+ */
+template <typename T>
+basic_matrix<T> basic_sparse_matrix<T>::gesta() const {
+    basic_matrix<T> m(wierszy, kolumn);
+    const ptrdiff_t liczba = nnz();
+    switch (fmt) {
+    case format_rzadki::csr:
+        rownolegle_dla(0, wierszy, ziarno_wierszy(static_cast<double>(kolumn)), [&](long long i0, long long i1) {
+            for (long long i = i0; i < i1; ++i) {
+                T* d = m.row_ptr(static_cast<ptrdiff_t>(i));
+                for (ptrdiff_t e = wsk[i]; e < wsk[i + 1]; ++e) d[ind_k[e]] = wart[e];
+            }
+        });
+        break;
+    case format_rzadki::csc:
+        for (ptrdiff_t j = 0; j < kolumn; ++j) {
+            for (ptrdiff_t e = wsk[j]; e < wsk[j + 1]; ++e) m(ind_w[e], j) = wart[e];
+        }
+        break;
+    case format_rzadki::coo:
+        for (ptrdiff_t e = 0; e < liczba; ++e) m(ind_w[e], ind_k[e]) = static_cast<T>(m(ind_w[e], ind_k[e]) + wart[e]);
+        break;
+    }
+    return m;
+}
+
+/**
+ * @brief Zwraca element (@p x, @p y).
+ *
+ * @throw std::out_of_range jeśli indeksy są poza zakresem.
+ */
+template <typename T>
+T basic_sparse_matrix<T>::operator()(ptrdiff_t x, ptrdiff_t y) const {
+    if (x < 0 || x >= wierszy || y < 0 || y >= kolumn) throw out_of_range("Indeks poza zakresem");
+    if (fmt == format_rzadki::coo) {
+        T suma = T(0);
+        for (size_t e = 0; e < wart.size(); ++e) {
+            if (ind_w[e] == x && ind_k[e] == y) suma = static_cast<T>(suma + wart[e]);
+        }
+        return suma;
+    }
+    const bool csr = fmt == format_rzadki::csr;
+    const ptrdiff_t g = csr ? x : y;
+    const vector<ptrdiff_t>& ind = csr ? ind_k : ind_w;
+    const auto poczatek = ind.begin() + wsk[g];
+    const auto koniec = ind.begin() + wsk[g + 1];
+    const auto it = lower_bound(poczatek, koniec, csr ? y : x);
+    return it != koniec && *it == (csr ? y : x) ? wart[it - ind.begin()] : T(0);
+}
+
+/**
+ * @brief Zwraca macierz transponowaną: te same tablice z zamienionymi
+ *        rolami wierszy i kolumn.
+ */
+template <typename T>
+basic_sparse_matrix<T> basic_sparse_matrix<T>::transponowana() const {
+    basic_sparse_matrix<T> t;
+    t.wierszy = kolumn;
+    t.kolumn = wierszy;
+    t.fmt = fmt == format_rzadki::csr ? format_rzadki::csc
+          : fmt == format_rzadki::csc ? format_rzadki::csr
+                                      : format_rzadki::coo;
+    t.wsk = wsk;
+    t.ind_w = ind_k;
+    t.ind_k = ind_w;
+    t.wart = wart;
+    return t;
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy rzadkiej i gęstej.
+ *
+ * Każdy wiersz wyniku jest sumą wierszy @p b ważonych elementami wiersza
+ * @p a w formacie CSR; dla wektora (jedna kolumna) – iloczynem skalarnym.
+ * Wiersze są dzielone między wątki według średniej liczby operacji.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_sparse_matrix<T>& a, const basic_matrix<T>& b) {
+    using W = jadra::iloczyn_t<T>;
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    if constexpr (is_same_v<W, T>) {
+        if (&wynik == &b) {
+            basic_matrix<W> temp(b.get_allocator());
+            pomnoz_do(temp, a, b);
+            wynik.swap(temp);
+            return wynik;
+        }
+    }
+
+    basic_sparse_matrix<T> kopia;
+    const basic_sparse_matrix<T>& csr = jako_csr(a, kopia);
+    const span<const ptrdiff_t> wsk = csr.wskazniki();
+    const span<const ptrdiff_t> ind = csr.indeksy_kolumn();
+    const span<const T> wart = csr.wartosci();
+    const ptrdiff_t m = a.rows(), n = b.cols();
+
+    wynik.alokuj(m, n, bez_zerowania);
+    const double na_wiersz = static_cast<double>(csr.nnz()) / static_cast<double>(max<ptrdiff_t>(m, 1));
+    rownolegle_dla(0, m, ziarno_wierszy(na_wiersz * static_cast<double>(n)), [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            W* c = wynik.row_ptr(static_cast<ptrdiff_t>(i));
+            if (n == 1) {
+                W s = W(0);
+                for (ptrdiff_t e = wsk[i]; e < wsk[i + 1]; ++e) s = jadra::dodaj_iloczyn(s, static_cast<W>(wart[e]), static_cast<W>(b.row_ptr(ind[e])[0]));
+                c[0] = s;
+                continue;
+            }
+            fill(c, c + n, W(0));
+            for (ptrdiff_t e = wsk[i]; e < wsk[i + 1]; ++e) {
+                const W v = static_cast<W>(wart[e]);
+                const T* z = b.row_ptr(ind[e]);
+                for (ptrdiff_t j = 0; j < n; ++j) c[j] = jadra::dodaj_iloczyn(c[j], v, static_cast<W>(z[j]));
+            }
+        }
+    });
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy rzadkiej @p a i gęstej @p b jako nową macierz.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_sparse_matrix<T>& a, const basic_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(b.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy rzadkich (algorytm Gustavsona, CSR).
+ *
+ * Przebieg symboliczny liczy różne kolumny każdego wiersza wyniku
+ * (tablica znaczników z numerem ostatniego wiersza, który ustawił
+ * kolumnę); przebieg numeryczny zbiera wartości w gęstym akumulatorze,
+ * zapisuje kolumny w kolejności napotkania i sortuje je. Tablice robocze
+ * (po @c b.cols() elementów) są tworzone raz na fragment wierszy.
+ */
+template <typename T>
+basic_sparse_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_sparse_matrix<T>& a, const basic_sparse_matrix<T>& b) {
+    using W = jadra::iloczyn_t<T>;
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+
+    basic_sparse_matrix<T> kopia_a, kopia_b;
+    const basic_sparse_matrix<T>& ca = jako_csr(a, kopia_a);
+    const basic_sparse_matrix<T>& cb = jako_csr(b, kopia_b);
+    const span<const ptrdiff_t> wsk_a = ca.wskazniki(), ind_a = ca.indeksy_kolumn();
+    const span<const ptrdiff_t> wsk_b = cb.wskazniki(), ind_b = cb.indeksy_kolumn();
+    const span<const T> wart_a = ca.wartosci(), wart_b = cb.wartosci();
+    const ptrdiff_t m = a.rows(), n = b.cols();
+
+    const double na_wiersz_a = static_cast<double>(ca.nnz()) / static_cast<double>(max<ptrdiff_t>(m, 1));
+    const double na_wiersz_b = static_cast<double>(cb.nnz()) / static_cast<double>(max<ptrdiff_t>(b.rows(), 1));
+    const long long ziarno = max(ziarno_wierszy(na_wiersz_a * na_wiersz_b), 64LL);
+
+    vector<ptrdiff_t> wsk(static_cast<size_t>(m) + 1, 0);
+    rownolegle_dla(0, m, ziarno, [&](long long i0, long long i1) {
+        vector<ptrdiff_t> znacznik(static_cast<size_t>(n), -1);
+        for (long long i = i0; i < i1; ++i) {
+            ptrdiff_t liczba = 0;
+            for (ptrdiff_t e = wsk_a[i]; e < wsk_a[i + 1]; ++e) {
+                const ptrdiff_t p = ind_a[e];
+                for (ptrdiff_t f = wsk_b[p]; f < wsk_b[p + 1]; ++f) {
+                    const ptrdiff_t j = ind_b[f];
+                    if (znacznik[j] != i) {
+                        znacznik[j] = i;
+                        ++liczba;
+                    }
+                }
+            }
+            wsk[i + 1] = liczba;
+        }
+    });
+    partial_sum(wsk.begin(), wsk.end(), wsk.begin());
+
+    vector<ptrdiff_t> ind(static_cast<size_t>(wsk.back()));
+    vector<W> wart(static_cast<size_t>(wsk.back()));
+    rownolegle_dla(0, m, ziarno, [&](long long i0, long long i1) {
+        vector<ptrdiff_t> znacznik(static_cast<size_t>(n), -1);
+        vector<W> akumulator(static_cast<size_t>(n));
+        for (long long i = i0; i < i1; ++i) {
+            ptrdiff_t zapis = wsk[i];
+            for (ptrdiff_t e = wsk_a[i]; e < wsk_a[i + 1]; ++e) {
+                const ptrdiff_t p = ind_a[e];
+                const W v = static_cast<W>(wart_a[e]);
+                for (ptrdiff_t f = wsk_b[p]; f < wsk_b[p + 1]; ++f) {
+                    const ptrdiff_t j = ind_b[f];
+                    if (znacznik[j] != i) {
+                        znacznik[j] = i;
+                        ind[zapis++] = j;
+                        akumulator[j] = jadra::dodaj_iloczyn(W(0), v, static_cast<W>(wart_b[f]));
+                    }
+                    else {
+                        akumulator[j] = jadra::dodaj_iloczyn(akumulator[j], v, static_cast<W>(wart_b[f]));
+                    }
+                }
+            }
+            sort(ind.begin() + wsk[i], ind.begin() + zapis);
+            for (ptrdiff_t e = wsk[i]; e < zapis; ++e) wart[e] = akumulator[ind[e]];
+        }
+    });
+
+    return basic_sparse_matrix<W>(m, n, format_rzadki::csr, std::move(wsk), std::move(ind), std::move(wart));
+}
+
+/**
+ * @brief Zwraca macierz transponowaną do @p a.
+ */
+template <typename T>
+basic_sparse_matrix<T> transponuj(const basic_sparse_matrix<T>& a) {
+    return a.transponowana();
+}
+
+/**
+ * @brief Jawne konkretyzacje klasy i funkcji dla obsługiwanych typów elementów.
+ */
+#define MACIERZ_INSTANCJA_RZADKA(T)                                                                             \
+    template class basic_sparse_matrix<T>;                                                                      \
+    template basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do<T>(basic_matrix<jadra::iloczyn_t<T>>&,                \
+                                                             const basic_sparse_matrix<T>&, const basic_matrix<T>&); \
+    template basic_matrix<jadra::iloczyn_t<T>> pomnoz<T>(const basic_sparse_matrix<T>&, const basic_matrix<T>&);  \
+    template basic_sparse_matrix<jadra::iloczyn_t<T>> pomnoz<T>(const basic_sparse_matrix<T>&,                  \
+                                                                const basic_sparse_matrix<T>&);                 \
+    template basic_sparse_matrix<T> transponuj<T>(const basic_sparse_matrix<T>&);
+
+MACIERZ_INSTANCJA_RZADKA(int8_t)
+MACIERZ_INSTANCJA_RZADKA(int16_t)
+MACIERZ_INSTANCJA_RZADKA(int32_t)
+MACIERZ_INSTANCJA_RZADKA(int64_t)
+MACIERZ_INSTANCJA_RZADKA(float)
+MACIERZ_INSTANCJA_RZADKA(double)
+
+#undef MACIERZ_INSTANCJA_RZADKA
@@ -0,0 +1,250 @@
+#pragma once
+
+/**
+ * @file sparse_matrix.h
+ * @brief Macierze rzadkie w formatach COO, CSR i CSC.
+ *
+ * Macierz rzadka przechowuje tylko niezerowe elementy, więc jej rozmiar
+ * w pamięci i koszt mnożenia zależą od liczby tych elementów (@c nnz()),
+ * a nie od @c rows() * @c cols(). Formaty:
+ * - COO – lista trójek (wiersz, kolumna, wartość); wygodny do budowania
+ *   macierzy (@ref basic_sparse_matrix::dodaj_element), powtórzone pozycje
+ *   są sumowane przy konwersji,
+ * - CSR – elementy kolejnych wierszy leżą obok siebie, posortowane po
+ *   kolumnach; @c wskazniki()[i] to indeks pierwszego elementu wiersza i,
+ * - CSC – analogicznie dla kolumn.
+ *
+ * Mnożenie (@ref pomnoz) jest równoległe po wierszach wyniku i korzysta
+ * z formatu CSR – argumenty w innych formatach są do niego najpierw
+ * kopiowane z konwersją.
+ */
+
+#include "matrix.h"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * @enum format_rzadki
+ * @brief Format przechowywania macierzy rzadkiej.
+ */
+enum class format_rzadki {
+    coo, ///< Lista trójek (wiersz, kolumna, wartość).
+    csr, ///< Skompresowane wiersze.
+    csc  ///< Skompresowane kolumny.
+};
+
+/**
+ * @class basic_sparse_matrix
+ * @brief Macierz rzadka o elementach typu @p T.
+ *
+ * W formatach CSR i CSC elementy są posortowane, bez powtórzeń i bez zer
+ * (poza jawnymi zerami powstałymi przy mnożeniu, gdy składniki się znoszą).
+ *
+ * Obsługiwane typy elementów – jak dla @ref basic_matrix.
+ *
+ * @tparam T Typ elementów.
+ */
+template <typename T>
+class basic_sparse_matrix {
+public:
+    /// Typ elementów macierzy.
+    using value_type = T;
+
+    /// Typ wymiarów i indeksów.
+    using size_type = std::ptrdiff_t;
+
+    /**
+     * @brief Konstruktor domyślny: pusta macierz 0 x 0 w formacie CSR.
+     */
+    basic_sparse_matrix();
+
+    /**
+     * @brief Tworzy macierz @p wiersze x @p kolumny bez niezerowych elementów.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param f Format.
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    basic_sparse_matrix(size_type wiersze, size_type kolumny, format_rzadki f = format_rzadki::coo);
+
+    /**
+     * @brief Tworzy macierz w formacie CSR lub CSC z gotowych tablic.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param f Format (@c csr lub @c csc).
+     * @param wskazniki Początki wierszy (CSR) lub kolumn (CSC); rozmiar
+     *        o 1 większy niż liczba wierszy (kolumn), ostatni element = nnz.
+     * @param indeksy Indeksy kolumn (CSR) lub wierszy (CSC) elementów,
+     *        rosnące w obrębie wiersza (kolumny).
+     * @param wartosci Wartości elementów.
+     * @throw std::invalid_argument jeśli format to COO lub tablice są
+     *        niespójne.
+     */
+    basic_sparse_matrix(size_type wiersze, size_type kolumny, format_rzadki f,
+                        std::vector<size_type> wskazniki, std::vector<size_type> indeksy,
+                        std::vector<T> wartosci);
+
+    /**
+     * @brief Tworzy macierz rzadką z niezerowych elementów macierzy gęstej.
+     *
+     * @param m Macierz gęsta.
+     * @param f Format wyniku.
+     */
+    explicit basic_sparse_matrix(const basic_matrix<T>& m, format_rzadki f = format_rzadki::csr);
+
+    /// Zwraca liczbę wierszy.
+    size_type rows() const noexcept { return wierszy; }
+
+    /// Zwraca liczbę kolumn.
+    size_type cols() const noexcept { return kolumn; }
+
+    /// Zwraca liczbę przechowywanych elementów (w COO – razem z powtórzeniami).
+    size_type nnz() const noexcept { return static_cast<size_type>(wart.size()); }
+
+    /// Zwraca bieżący format.
+    format_rzadki format() const noexcept { return fmt; }
+
+    /**
+     * @brief Rezerwuje miejsce na @p liczba elementów.
+     *
+     * @param liczba Przewidywana liczba elementów.
+     */
+    void reserve(size_type liczba);
+
+    /**
+     * @brief Dodaje element (@p x, @p y) o wartości @p wartosc.
+     *
+     * Macierz w formacie CSR lub CSC jest najpierw konwertowana do COO.
+     * Elementy o tej samej pozycji są sumowane przy konwersji do CSR/CSC.
+     *
+     * @param x Indeks wiersza.
+     * @param y Indeks kolumny.
+     * @param wartosc Wartość.
+     * @return Referencja do *this.
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    basic_sparse_matrix& dodaj_element(size_type x, size_type y, T wartosc);
+
+    /**
+     * @brief Konwertuje macierz do formatu @p f.
+     *
+     * Konwersja z COO sortuje elementy, sumuje powtórzenia i usuwa zera
+     * (O(nnz log nnz)); konwersje CSR <-> CSC kosztują O(nnz + wymiar).
+     *
+     * @param f Format docelowy.
+     * @return Referencja do *this.
+     */
+    basic_sparse_matrix& konwertuj(format_rzadki f);
+
+    /**
+     * @brief Zwraca macierz gęstą o tej samej zawartości.
+     */
+    basic_matrix<T> gesta() const;
+
+    /**
+     * @brief Zwraca element (@p x, @p y) (zero, jeśli nie jest przechowywany).
+     *
+     * W CSR i CSC wyszukiwanie binarne w wierszu (kolumnie), w COO – liniowe.
+     *
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    T operator()(size_type x, size_type y) const;
+
+    /**
+     * @brief Zwraca tablicę początków wierszy (CSR) lub kolumn (CSC);
+     *        w COO – pustą.
+     */
+    std::span<const size_type> wskazniki() const noexcept { return wsk; }
+
+    /// Zwraca indeksy wierszy elementów (COO, CSC; w CSR – pustą tablicę).
+    std::span<const size_type> indeksy_wierszy() const noexcept { return ind_w; }
+
+    /// Zwraca indeksy kolumn elementów (COO, CSR; w CSC – pustą tablicę).
+    std::span<const size_type> indeksy_kolumn() const noexcept { return ind_k; }
+
+    /// Zwraca wartości elementów.
+    std::span<const T> wartosci() const noexcept { return wart; }
+
+    /**
+     * @brief Zwraca macierz transponowaną (CSR staje się CSC i odwrotnie,
+     *        bez przestawiania elementów).
+     */
+    basic_sparse_matrix transponowana() const;
+
+private:
+    size_type wierszy;            ///< Liczba wierszy.
+    size_type kolumn;             ///< Liczba kolumn.
+    format_rzadki fmt;            ///< Bieżący format.
+    std::vector<size_type> wsk;   ///< Początki wierszy (CSR) lub kolumn (CSC).
+    std::vector<size_type> ind_w; ///< Indeksy wierszy elementów (COO, CSC).
+    std::vector<size_type> ind_k; ///< Indeksy kolumn elementów (COO, CSR).
+    std::vector<T> wart;          ///< Wartości elementów.
+};
+
+/**
+ * @name Aliasy typów macierzy rzadkich
+ * @{
+ */
+using sparse_matrix = basic_sparse_matrix<int>;              ///< Macierz rzadka liczb @c int.
+using sparse_matrix_i8 = basic_sparse_matrix<std::int8_t>;   ///< Macierz rzadka liczb 8-bitowych.
+using sparse_matrix_i16 = basic_sparse_matrix<std::int16_t>; ///< Macierz rzadka liczb 16-bitowych.
+using sparse_matrix_i32 = basic_sparse_matrix<std::int32_t>; ///< Macierz rzadka liczb 32-bitowych.
+using sparse_matrix_i64 = basic_sparse_matrix<std::int64_t>; ///< Macierz rzadka liczb 64-bitowych.
+using sparse_matrix_f32 = basic_sparse_matrix<float>;        ///< Macierz rzadka liczb @c float.
+using sparse_matrix_f64 = basic_sparse_matrix<double>;       ///< Macierz rzadka liczb @c double.
+/** @} */
+
+/**
+ * @name Mnożenie macierzy rzadkich
+ *
+ * Typ elementów wyniku – jak dla mnożenia macierzy gęstych
+ * (@ref jadra::iloczyn_t).
+ * @{
+ */
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy rzadkiej @p a i gęstej @p b
+ *        (dla @p b o jednej kolumnie – iloczyn macierz-wektor).
+ *
+ * @param wynik Macierz wynikowa (może być @p b).
+ * @param a Macierz rzadka.
+ * @param b Macierz gęsta.
+ * @return Referencja do @p wynik.
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_sparse_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zwraca iloczyn macierzy rzadkiej @p a i gęstej @p b.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_sparse_matrix<T>& a, const basic_matrix<T>& b);
+
+/**
+ * @brief Zwraca iloczyn macierzy rzadkich @p a i @p b (w formacie CSR).
+ *
+ * Algorytm Gustavsona: każdy wiersz wyniku jest sumą wierszy @p b
+ * ważonych elementami wiersza @p a, zbieraną w gęstym akumulatorze.
+ * Najpierw liczona jest struktura wyniku (liczba elementów w wierszach),
+ * potem wartości; oba przebiegi są równoległe po wierszach.
+ *
+ * @throw std::invalid_argument jeśli @c a.cols() != @c b.rows().
+ */
+template <typename T>
+basic_sparse_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_sparse_matrix<T>& a, const basic_sparse_matrix<T>& b);
+
+/**
+ * @brief Zwraca macierz transponowaną do @p a
+ *        (zob. @ref basic_sparse_matrix::transponowana).
+ */
+template <typename T>
+basic_sparse_matrix<T> transponuj(const basic_sparse_matrix<T>& a);
+
+/** @} */
@@ -0,0 +1,266 @@
+#include "strassen.h"
+#include "gemm.h"
+#include "pamiec.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace jadra {
+
+namespace {
+
+std::atomic<algorytm_mnozenia> algorytm{ algorytm_mnozenia::automatyczny }; ///< Zob. ustaw_algorytm_mnozenia().
+std::atomic<std::ptrdiff_t> prog{ 512 };                                     ///< Zob. ustaw_prog_strassena().
+
+/**
+ * @brief Typ, w którym liczone są sumy ćwiartek: dla liczb całkowitych –
+ *        typ bez znaku (przepełnienie modulo 2^bitów zamiast niezdefiniowanego).
+ */
+template <typename T, bool = std::is_integral_v<T>>
+struct typ_sumy {
+    using typ = T;
+};
+
+template <typename T>
+struct typ_sumy<T, true> {
+    using typ = std::make_unsigned_t<T>;
+};
+
+/**
+ * @brief Zapisuje do Z (@p w x @p k) sumę lub różnicę X i Y element po
+ *        elemencie; wiersze są dzielone między wątki.
+ *
+ * Z może być jedną z macierzy X, Y (działanie w miejscu).
+ */
+template <bool ODEJMIJ, typename T>
+void polacz_cwiartki(std::ptrdiff_t w, std::ptrdiff_t k,
+                     const T* x, std::ptrdiff_t ldx,
+                     const T* y, std::ptrdiff_t ldy,
+                     T* z, std::ptrdiff_t ldz) {
+    using U = typename typ_sumy<T>::typ;
+    const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / std::max<long long>(k, 1));
+    rownolegle_dla(0, w, ziarno, [=](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const T* wx = x + i * ldx;
+            const T* wy = y + i * ldy;
+            T* wz = z + i * ldz;
+            for (std::ptrdiff_t j = 0; j < k; ++j) {
+                const U s = ODEJMIJ ? U(wx[j]) - U(wy[j]) : U(wx[j]) + U(wy[j]);
+                wz[j] = static_cast<T>(s);
+            }
+        }
+    });
+}
+
+/// Z = X + Y (zob. @ref polacz_cwiartki).
+template <typename T>
+void suma_cwiartek(std::ptrdiff_t w, std::ptrdiff_t k, const T* x, std::ptrdiff_t ldx,
+                   const T* y, std::ptrdiff_t ldy, T* z, std::ptrdiff_t ldz) {
+    polacz_cwiartki<false>(w, k, x, ldx, y, ldy, z, ldz);
+}
+
+/// Z = X - Y (zob. @ref polacz_cwiartki).
+template <typename T>
+void roznica_cwiartek(std::ptrdiff_t w, std::ptrdiff_t k, const T* x, std::ptrdiff_t ldx,
+                      const T* y, std::ptrdiff_t ldy, T* z, std::ptrdiff_t ldz) {
+    polacz_cwiartki<true>(w, k, x, ldx, y, ldy, z, ldz);
+}
+
+/**
+ * @brief Zwraca rozmiar przestrzeni roboczej wszystkich poziomów rekurencji
+ *        przy progu @p p.
+ *
+ * Poziom z ćwiartkami hm x hk (A) i hk x hn (B) potrzebuje bufora X na
+ * hm x max(hk, hn) elementów (sumy ćwiartek A, potem iloczyn P1) oraz Y na
+ * hk x hn (sumy ćwiartek B). Mnożenia ćwiartek wykonywane są kolejno, więc
+ * każde korzysta z tej samej dalszej części przestrzeni.
+ */
+std::ptrdiff_t przestrzen_poziomow(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k, std::ptrdiff_t p) {
+    std::ptrdiff_t razem = 0;
+    while (std::min({ m, n, k }) > p) {
+        m /= 2;
+        n /= 2;
+        k /= 2;
+        razem += m * std::max(k, n) + k * n;
+    }
+    return razem;
+}
+
+/**
+ * @brief Jeden poziom rekurencji: C = A * B.
+ *
+ * Parzyste części wymiarów są dzielone na ćwiartki i mnożone według
+ * schematu Winograda; ostatni wiersz A, ostatnia kolumna B i ostatnia
+ * wartość k (przy wymiarach nieparzystych) są doliczane klasycznie.
+ *
+ * @param przestrzen Przestrzeń robocza tego i głębszych poziomów.
+ * @param p Próg rekurencji.
+ */
+template <typename T>
+void strassen_poziom(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+                     const T* a, std::ptrdiff_t lda,
+                     const T* b, std::ptrdiff_t ldb,
+                     T* c, std::ptrdiff_t ldc,
+                     T* przestrzen, std::ptrdiff_t p) {
+    if (std::min({ m, n, k }) <= p) {
+        gemm_klasyczny(m, n, k, a, lda, b, ldb, c, ldc);
+        return;
+    }
+
+    const std::ptrdiff_t hm = m / 2, hn = n / 2, hk = k / 2;
+    const T* a11 = a;
+    const T* a12 = a + hk;
+    const T* a21 = a + hm * lda;
+    const T* a22 = a21 + hk;
+    const T* b11 = b;
+    const T* b12 = b + hn;
+    const T* b21 = b + hk * ldb;
+    const T* b22 = b21 + hn;
+    T* c11 = c;
+    T* c12 = c + hn;
+    T* c21 = c + hm * ldc;
+    T* c22 = c21 + hn;
+
+    T* x = przestrzen;
+    T* y = x + hm * std::max(hk, hn);
+    T* dalej = y + hk * hn;
+    auto iloczyn = [&](const T* l, std::ptrdiff_t ldl, const T* r, std::ptrdiff_t ldr, T* w, std::ptrdiff_t ldw) {
+        strassen_poziom(hm, hn, hk, l, ldl, r, ldr, w, ldw, dalej, p);
+    };
+
+    // S (hm x hk) leżą w X z odstępem hk, T (hk x hn) w Y z odstępem hn,
+    // P1 (hm x hn) w X z odstępem hn.
+    roznica_cwiartek(hm, hk, a11, lda, a21, lda, x, hk);    // S3 = A11 - A21
+    roznica_cwiartek(hk, hn, b22, ldb, b12, ldb, y, hn);    // T3 = B22 - B12
+    iloczyn(x, hk, y, hn, c21, ldc);                        // P7 = S3 * T3
+    suma_cwiartek(hm, hk, a21, lda, a22, lda, x, hk);       // S1 = A21 + A22
+    roznica_cwiartek(hk, hn, b12, ldb, b11, ldb, y, hn);    // T1 = B12 - B11
+    iloczyn(x, hk, y, hn, c22, ldc);                        // P5 = S1 * T1
+    roznica_cwiartek(hm, hk, x, hk, a11, lda, x, hk);       // S2 = S1 - A11
+    roznica_cwiartek(hk, hn, b22, ldb, y, hn, y, hn);       // T2 = B22 - T1
+    iloczyn(x, hk, y, hn, c12, ldc);                        // P6 = S2 * T2
+    roznica_cwiartek(hm, hk, a12, lda, x, hk, x, hk);       // S4 = A12 - S2
+    iloczyn(x, hk, b22, ldb, c11, ldc);                     // P3 = S4 * B22
+    iloczyn(a11, lda, b11, ldb, x, hn);                     // P1 = A11 * B11
+    suma_cwiartek(hm, hn, x, hn, c12, ldc, c12, ldc);       // U2 = P1 + P6
+    suma_cwiartek(hm, hn, c12, ldc, c21, ldc, c21, ldc);    // U3 = U2 + P7
+    suma_cwiartek(hm, hn, c12, ldc, c22, ldc, c12, ldc);    // U4 = U2 + P5
+    suma_cwiartek(hm, hn, c21, ldc, c22, ldc, c22, ldc);    // U7 = U3 + P5 (C22)
+    suma_cwiartek(hm, hn, c12, ldc, c11, ldc, c12, ldc);    // U5 = U4 + P3 (C12)
+    roznica_cwiartek(hk, hn, y, hn, b21, ldb, y, hn);       // T4 = T2 - B21
+    iloczyn(a22, lda, y, hn, c11, ldc);                     // P4 = A22 * T4
+    roznica_cwiartek(hm, hn, c21, ldc, c11, ldc, c21, ldc); // U6 = U3 - P4 (C21)
+    iloczyn(a12, lda, b21, ldb, c11, ldc);                  // P2 = A12 * B21
+    suma_cwiartek(hm, hn, x, hn, c11, ldc, c11, ldc);       // U1 = P1 + P2 (C11)
+
+    const std::ptrdiff_t me = 2 * hm, ne = 2 * hn, ke = 2 * hk;
+    if (k > ke) gemm_klasyczny(me, ne, 1, a + ke, lda, b + ke * ldb, ldb, c, ldc, true);
+    if (n > ne) gemm_klasyczny(me, 1, k, a, lda, b + ne, ldb, c + ne, ldc);
+    if (m > me) gemm_klasyczny(1, n, k, a + me * lda, lda, b, ldb, c + me * ldc, ldc);
+}
+
+} // namespace
+
+/**
+ * @brief Ustawia algorytm mnożenia macierzy.
+ */
+void ustaw_algorytm_mnozenia(algorytm_mnozenia a) {
+    algorytm.store(a);
+}
+
+/**
+ * @brief Zwraca ustawiony algorytm mnożenia macierzy.
+ */
+algorytm_mnozenia wybrany_algorytm_mnozenia() {
+    return algorytm.load();
+}
+
+/**
+ * @brief Ustawia próg rekurencji Strassena.
+ */
+void ustaw_prog_strassena(std::ptrdiff_t n) {
+    if (n < 16) throw std::invalid_argument("Prog Strassena mniejszy niz 16");
+    prog.store(n);
+}
+
+/**
+ * @brief Zwraca próg rekurencji Strassena.
+ */
+std::ptrdiff_t prog_strassena() {
+    return prog.load();
+}
+
+/**
+ * @brief Sprawdza, czy @ref gemm użyje algorytmu Strassena.
+ *
+ * W trybie automatycznym rekurencja musi mieć co najmniej jeden pełny
+ * poziom (każdy wymiar >= 2 * próg), by zysk z 7 zamiast 8 mnożeń
+ * przeważył koszt dodawań.
+ */
+template <typename T>
+bool uzyj_strassena(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k) {
+    if constexpr (!std::is_same_v<iloczyn_t<T>, T>) {
+        return false;
+    }
+    else {
+        const std::ptrdiff_t p = prog.load();
+        const std::ptrdiff_t najmniejszy = std::min({ m, n, k });
+        switch (algorytm.load()) {
+        case algorytm_mnozenia::klasyczny: return false;
+        case algorytm_mnozenia::strassen: return najmniejszy > p;
+        default: return std::is_integral_v<T> && najmniejszy >= 2 * p;
+        }
+    }
+}
+
+/**
+ * @brief Zwraca rozmiar przestrzeni roboczej dla bieżącego progu.
+ */
+std::ptrdiff_t przestrzen_strassena(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k) {
+    return przestrzen_poziomow(m, n, k, prog.load());
+}
+
+/**
+ * @brief Mnożenie C = A * B algorytmem Strassena-Winograda.
+ *
+ * Próg jest odczytywany raz, więc przestrzeń robocza odpowiada
+ * rzeczywistej głębokości rekurencji.
+ */
+template <typename T>
+void strassen(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+              const T* a, std::ptrdiff_t lda,
+              const T* b, std::ptrdiff_t ldb,
+              T* c, std::ptrdiff_t ldc,
+              T* przestrzen) {
+    if (m <= 0 || n <= 0) return;
+    const std::ptrdiff_t p = prog.load();
+    tablica<T> bufor;
+    if (przestrzen == nullptr) {
+        bufor = przydziel_tablice<T>(domyslny_alokator(), przestrzen_poziomow(m, n, k, p));
+        przestrzen = bufor.get();
+    }
+    strassen_poziom(m, n, k, a, lda, b, ldb, c, ldc, przestrzen, p);
+}
+
+#define MACIERZ_INSTANCJA_STRASSEN(T)                                                                     \
+    template void strassen<T>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t, const T*, std::ptrdiff_t,   \
+                              const T*, std::ptrdiff_t, T*, std::ptrdiff_t, T*);
+
+template bool uzyj_strassena<std::int8_t>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t);
+template bool uzyj_strassena<std::int16_t>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t);
+template bool uzyj_strassena<std::int32_t>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t);
+template bool uzyj_strassena<std::int64_t>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t);
+template bool uzyj_strassena<float>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t);
+template bool uzyj_strassena<double>(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t);
+
+MACIERZ_INSTANCJA_STRASSEN(std::int32_t)
+MACIERZ_INSTANCJA_STRASSEN(std::int64_t)
+MACIERZ_INSTANCJA_STRASSEN(float)
+MACIERZ_INSTANCJA_STRASSEN(double)
+
+#undef MACIERZ_INSTANCJA_STRASSEN
+
+} // namespace jadra
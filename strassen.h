@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file strassen.h
+ * @brief Mnożenie macierzy algorytmem Strassena-Winograda.
+ *
+ * Wariant Winograda wykonuje na każdym poziomie rekurencji 7 mnożeń
+ * ćwiartek i 15 dodawań (złożoność O(n^2.807)). Rekurencja kończy się, gdy
+ * najmniejszy wymiar nie przekracza progu (@ref jadra::prog_strassena) –
+ * wtedy mnoży klasyczny algorytm blokowy (@ref jadra::gemm_klasyczny).
+ * Nieparzyste wymiary są obsługiwane przez odcięcie ostatniego wiersza,
+ * kolumny lub wartości k, których udział jest liczony klasycznie.
+ *
+ * Kolejność działań pochodzi z pracy Boyer, Dumas, Pernet, Zhou (2009):
+ * każdy poziom potrzebuje tylko dwóch buforów tymczasowych, a wyniki
+ * pośrednie trafiają do ćwiartek C. Bufory wszystkich poziomów są wycinane
+ * z jednej przestrzeni roboczej przydzielanej raz na całe mnożenie.
+ *
+ * Dla liczb całkowitych wynik jest dokładny (dodawania są wykonywane
+ * modulo 2^bitów, tak jak przepełnienie w algorytmie klasycznym). Dla liczb
+ * zmiennoprzecinkowych błąd zaokrągleń jest większy niż w algorytmie
+ * klasycznym, dlatego wybór automatyczny dotyczy tylko liczb całkowitych.
+ *
+ * Funkcje są dostępne dla @c int32_t, @c int64_t, @c float i @c double
+ * (typy 8- i 16-bitowe mnożone są zawsze klasycznie, bo sumy ćwiartek
+ * nie mieściłyby się w typie elementów).
+ */
+
+#include <cstddef>
+
+namespace jadra {
+
+/**
+ * @enum algorytm_mnozenia
+ * @brief Algorytm używany przez @ref gemm do mnożenia dużych macierzy.
+ */
+enum class algorytm_mnozenia {
+    automatyczny, ///< Strassen dla liczb całkowitych, gdy każdy wymiar >= 2 * próg.
+    klasyczny,    ///< Zawsze algorytm klasyczny (blokowy).
+    strassen      ///< Strassen dla wszystkich obsługiwanych typów, gdy wymiary > próg.
+};
+
+/**
+ * @brief Ustawia algorytm mnożenia macierzy (domyślnie
+ *        @ref algorytm_mnozenia::automatyczny).
+ *
+ * @param a Algorytm.
+ */
+void ustaw_algorytm_mnozenia(algorytm_mnozenia a);
+
+/**
+ * @brief Zwraca ustawiony algorytm mnożenia macierzy.
+ */
+algorytm_mnozenia wybrany_algorytm_mnozenia();
+
+/**
+ * @brief Ustawia próg rekurencji Strassena: ćwiartki, których najmniejszy
+ *        wymiar nie przekracza @p n, są mnożone klasycznie.
+ *
+ * @param n Próg (domyślnie 512).
+ * @throw std::invalid_argument jeśli @p n < 16.
+ */
+void ustaw_prog_strassena(std::ptrdiff_t n);
+
+/**
+ * @brief Zwraca próg rekurencji Strassena.
+ */
+std::ptrdiff_t prog_strassena();
+
+/**
+ * @brief Sprawdza, czy @ref gemm użyje algorytmu Strassena dla mnożenia
+ *        @p m x @p k razy @p k x @p n elementów typu @p T.
+ */
+template <typename T>
+bool uzyj_strassena(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k);
+
+/**
+ * @brief Zwraca rozmiar (w elementach) przestrzeni roboczej potrzebnej
+ *        @ref strassen dla podanych wymiarów.
+ */
+std::ptrdiff_t przestrzen_strassena(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k);
+
+/**
+ * @brief Mnożenie macierzy C = A * B algorytmem Strassena-Winograda.
+ *
+ * Macierze są przechowywane wierszami; @p lda, @p ldb, @p ldc to odległości
+ * między początkami wierszy. Bufor @p c nie może nachodzić na @p a ani @p b.
+ *
+ * @tparam T Typ elementów.
+ * @param m Liczba wierszy A i C.
+ * @param n Liczba kolumn B i C.
+ * @param k Liczba kolumn A i wierszy B.
+ * @param a Dane macierzy A (m x k).
+ * @param lda Odległość między wierszami A.
+ * @param b Dane macierzy B (k x n).
+ * @param ldb Odległość między wierszami B.
+ * @param c Dane macierzy wynikowej C (m x n).
+ * @param ldc Odległość między wierszami C.
+ * @param przestrzen Przestrzeń robocza o co najmniej
+ *        @ref przestrzen_strassena(m, n, k) elementach; jeśli nullptr,
+ *        jest przydzielana (raz) z @ref domyslny_alokator.
+ */
+template <typename T>
+void strassen(std::ptrdiff_t m, std::ptrdiff_t n, std::ptrdiff_t k,
+              const T* a, std::ptrdiff_t lda,
+              const T* b, std::ptrdiff_t ldb,
+              T* c, std::ptrdiff_t ldc,
+              T* przestrzen = nullptr);
+
+} // namespace jadra
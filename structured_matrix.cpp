@@ -0,0 +1,589 @@
+#include "structured_matrix.h"
+#include "gemm.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Zwraca ziarno podziału wierszy wyniku między wątki, gdy wiersz
+ *        kosztuje około @p praca operacji.
+ */
+long long ziarno_strukturalnej(double praca) {
+    return max(1LL, static_cast<long long>(PROG_ROWNOLEGLY / max(praca, 1.0)));
+}
+
+/**
+ * @brief Zwraca referencję do elementu (@p x, @p y) wewnątrz struktury
+ *        macierzy @p s albo zgłasza wyjątek.
+ *
+ * @throw std::out_of_range jeśli komórka jest poza macierzą lub strukturą.
+ */
+template <typename S>
+typename S::value_type& element_struktury(S& s, ptrdiff_t x, ptrdiff_t y) {
+    if (x < 0 || x >= s.rows() || y < 0 || y >= s.cols()) throw out_of_range("Indeks poza zakresem");
+    const auto f = s.fragment(x);
+    if (y < f.kolumna || y >= f.kolumna + f.dlugosc) throw out_of_range("Element poza struktura macierzy");
+    return const_cast<typename S::value_type&>(f.wartosci[y - f.kolumna]);
+}
+
+/**
+ * @brief Zwraca element (@p x, @p y) macierzy strukturalnej @p s (zero poza
+ *        strukturą).
+ *
+ * @throw std::out_of_range jeśli indeksy są poza zakresem.
+ */
+template <typename S>
+typename S::value_type odczytaj_element(const S& s, ptrdiff_t x, ptrdiff_t y) {
+    using T = typename S::value_type;
+    if (x < 0 || x >= s.rows() || y < 0 || y >= s.cols()) throw out_of_range("Indeks poza zakresem");
+    const auto f = s.fragment(x);
+    return y >= f.kolumna && y < f.kolumna + f.dlugosc ? f.wartosci[y - f.kolumna] : T(0);
+}
+
+/**
+ * @brief Przepisuje elementy struktury @p s z macierzy gęstej @p m.
+ */
+template <typename S, typename T>
+void kopiuj_strukture(S& s, const basic_matrix<T>& m) {
+    rownolegle_dla(0, s.rows(), ziarno_strukturalnej(static_cast<double>(s.cols())), [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const auto f = s.fragment(static_cast<ptrdiff_t>(i));
+            T* d = const_cast<T*>(f.wartosci);
+            const T* z = m.row_ptr(static_cast<ptrdiff_t>(i)) + f.kolumna;
+            copy(z, z + f.dlugosc, d);
+        }
+    });
+}
+
+/**
+ * @brief Zwraca macierz gęstą o zawartości macierzy strukturalnej @p s.
+ */
+template <typename S>
+basic_matrix<typename S::value_type> rozwin_strukture(const S& s) {
+    basic_matrix<typename S::value_type> m(s.rows(), s.cols());
+    rownolegle_dla(0, s.rows(), ziarno_strukturalnej(static_cast<double>(s.cols())), [&](long long i0, long long i1) {
+        for (long long i = i0; i < i1; ++i) {
+            const auto f = s.fragment(static_cast<ptrdiff_t>(i));
+            copy(f.wartosci, f.wartosci + f.dlugosc, m.row_ptr(static_cast<ptrdiff_t>(i)) + f.kolumna);
+        }
+    });
+    return m;
+}
+
+/// Liczba wierszy macierzy strukturalnej rozwijanych naraz do bloku gęstego.
+constexpr ptrdiff_t BLOK_STRUKTURY = 256;
+
+/**
+ * @brief Rozwija wiersze [@p i0, @p i1) macierzy strukturalnej @p s do
+ *        gęstego bloku, jeśli jest on wypełniony co najmniej w połowie.
+ *
+ * @param blok Bufor na blok (i1 - i0) x (@p od_k - @p do_k), wierszami.
+ * @param od_k Zwracana pierwsza kolumna bloku.
+ * @param do_k Zwracany koniec zakresu kolumn bloku.
+ * @return true, jeśli blok został rozwinięty; false, jeśli lepiej
+ *         przetworzyć wiersze po fragmentach.
+ */
+template <typename S>
+bool rozwin_blok(const S& s, ptrdiff_t i0, ptrdiff_t i1, vector<typename S::value_type>& blok,
+                 ptrdiff_t& od_k, ptrdiff_t& do_k) {
+    using T = typename S::value_type;
+    od_k = s.cols();
+    do_k = 0;
+    ptrdiff_t suma = 0;
+    for (ptrdiff_t i = i0; i < i1; ++i) {
+        const auto f = s.fragment(i);
+        if (f.dlugosc == 0) continue;
+        od_k = min(od_k, f.kolumna);
+        do_k = max(do_k, f.kolumna + f.dlugosc);
+        suma += f.dlugosc;
+    }
+    const ptrdiff_t szerokosc = do_k - od_k;
+    if (szerokosc < jadra::NR || 2 * suma < (i1 - i0) * szerokosc) return false;
+
+    blok.assign(static_cast<size_t>((i1 - i0) * szerokosc), T(0));
+    for (ptrdiff_t i = i0; i < i1; ++i) {
+        const auto f = s.fragment(i);
+        copy(f.wartosci, f.wartosci + f.dlugosc, blok.data() + (i - i0) * szerokosc + (f.kolumna - od_k));
+    }
+    return true;
+}
+
+/**
+ * @brief Wynik = @p a (strukturalna) * @p b (gęsta).
+ *
+ * Wiersz i wyniku to suma wierszy @p b o numerach z fragmentu wiersza i
+ * macierzy @p a, ważonych jego elementami. Bloki wierszy @p a wypełnione
+ * co najmniej w połowie (np. macierzy trójkątnej lub szerokiej wstęgi) są
+ * rozwijane do postaci gęstej i mnożone przez @ref jadra::gemm – tylko
+ * po kolumnach, w których mają niezerowe elementy.
+ */
+template <typename S, typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_strukturalna_gesta(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                                             const S& a, const basic_matrix<T>& b) {
+    using W = jadra::iloczyn_t<T>;
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    if constexpr (is_same_v<W, T>) {
+        if (&wynik == &b) {
+            basic_matrix<W> temp(b.get_allocator());
+            pomnoz_strukturalna_gesta(temp, a, b);
+            wynik.swap(temp);
+            return wynik;
+        }
+    }
+
+    const ptrdiff_t m = a.rows(), n = b.cols();
+    wynik.alokuj(m, n, bez_zerowania);
+    if (n == 0) return wynik;
+    vector<T> blok;
+    for (ptrdiff_t i0 = 0; i0 < m; i0 += BLOK_STRUKTURY) {
+        const ptrdiff_t i1 = min(m, i0 + BLOK_STRUKTURY);
+        ptrdiff_t od_k, do_k;
+        if (rozwin_blok(a, i0, i1, blok, od_k, do_k)) {
+            jadra::gemm<T>(i1 - i0, n, do_k - od_k, blok.data(), do_k - od_k, b.row_ptr(od_k), b.stride(),
+                           wynik.row_ptr(i0), wynik.stride());
+            continue;
+        }
+        const double na_wiersz = static_cast<double>(a.nnz()) / static_cast<double>(m);
+        rownolegle_dla(i0, i1, ziarno_strukturalnej(na_wiersz * static_cast<double>(n)), [&](long long r0, long long r1) {
+            for (long long i = r0; i < r1; ++i) {
+                W* c = wynik.row_ptr(static_cast<ptrdiff_t>(i));
+                const auto f = a.fragment(static_cast<ptrdiff_t>(i));
+                fill(c, c + n, W(0));
+                for (ptrdiff_t t = 0; t < f.dlugosc; ++t) {
+                    const W v = static_cast<W>(f.wartosci[t]);
+                    const T* z = b.row_ptr(f.kolumna + t);
+                    for (ptrdiff_t j = 0; j < n; ++j) c[j] = jadra::dodaj_iloczyn(c[j], v, static_cast<W>(z[j]));
+                }
+            }
+        });
+    }
+    return wynik;
+}
+
+/**
+ * @brief Wynik = @p a (gęsta) * @p b (strukturalna).
+ *
+ * Do wiersza i wyniku dodawane są fragmenty wierszy p macierzy @p b
+ * ważone elementami a(i, p), każdy tylko w swoim zakresie kolumn. Gęsto
+ * wypełnione bloki wierszy @p b są, jak w @ref pomnoz_strukturalna_gesta,
+ * mnożone przez @ref jadra::gemm.
+ */
+template <typename S, typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_gesta_strukturalna(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                                             const basic_matrix<T>& a, const S& b) {
+    using W = jadra::iloczyn_t<T>;
+    if (a.cols() != b.rows()) throw invalid_argument("Rozne wymiary macierzy!");
+    if constexpr (is_same_v<W, T>) {
+        if (&wynik == &a) {
+            basic_matrix<W> temp(a.get_allocator());
+            pomnoz_gesta_strukturalna(temp, a, b);
+            wynik.swap(temp);
+            return wynik;
+        }
+    }
+
+    const ptrdiff_t m = a.rows(), k = a.cols(), n = b.cols();
+    wynik.alokuj(m, n, bez_zerowania);
+    if (m == 0) return wynik;
+    // wynik może mieć odstęp między wierszami większy niż n (alokuj zachowuje go przy tych samych wymiarach)
+    for (ptrdiff_t i = 0; i < m; ++i) fill(wynik.row_ptr(i), wynik.row_ptr(i) + n, W(0));
+    vector<T> blok;
+    for (ptrdiff_t p0 = 0; p0 < k; p0 += BLOK_STRUKTURY) {
+        const ptrdiff_t p1 = min(k, p0 + BLOK_STRUKTURY);
+        ptrdiff_t od_k, do_k;
+        if (rozwin_blok(b, p0, p1, blok, od_k, do_k)) {
+            jadra::gemm<T>(m, do_k - od_k, p1 - p0, a.row_ptr(0) + p0, a.stride(), blok.data(), do_k - od_k,
+                           wynik.row_ptr(0) + od_k, wynik.stride(), true);
+            continue;
+        }
+        const double praca = static_cast<double>(b.nnz()) * static_cast<double>(p1 - p0) / static_cast<double>(k);
+        rownolegle_dla(0, m, ziarno_strukturalnej(praca), [&](long long i0, long long i1) {
+            for (long long i = i0; i < i1; ++i) {
+                W* c = wynik.row_ptr(static_cast<ptrdiff_t>(i));
+                const T* w = a.row_ptr(static_cast<ptrdiff_t>(i));
+                for (ptrdiff_t p = p0; p < p1; ++p) {
+                    const auto f = b.fragment(p);
+                    const W v = static_cast<W>(w[p]);
+                    W* d = c + f.kolumna;
+                    for (ptrdiff_t t = 0; t < f.dlugosc; ++t) d[t] = jadra::dodaj_iloczyn(d[t], v, static_cast<W>(f.wartosci[t]));
+                }
+            }
+        });
+    }
+    return wynik;
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy pustą macierz przekątniową 0 x 0.
+ */
+template <typename T>
+basic_diagonal_matrix<T>::basic_diagonal_matrix() : basic_diagonal_matrix(0, 0, 0) {
+}
+
+/**
+ * @brief Tworzy kwadratową macierz przekątniową @p n x @p n.
+ */
+template <typename T>
+basic_diagonal_matrix<T>::basic_diagonal_matrix(ptrdiff_t n) : basic_diagonal_matrix(n, n, 0) {
+}
+
+/**
+ * @brief Tworzy macierz @p wiersze x @p kolumny z zerową przekątną @p k.
+ *
+ * Długość przekątnej to liczba komórek (i, i + k) wewnątrz macierzy.
+ *
+ * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+ */
+template <typename T>
+basic_diagonal_matrix<T>::basic_diagonal_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, ptrdiff_t k)
+    : wierszy(wiersze), kolumn(kolumny), k(k) {
+    if (wiersze < 0 || kolumny < 0) throw invalid_argument("Rozmiar ujemny");
+    const ptrdiff_t dlugosc = k >= 0 ? min(wiersze, kolumny - k) : min(wiersze + k, kolumny);
+    dane.assign(static_cast<size_t>(max<ptrdiff_t>(dlugosc, 0)), T(0));
+}
+
+/**
+ * @brief Tworzy macierz z przekątnej @p k macierzy gęstej @p m.
+ */
+template <typename T>
+basic_diagonal_matrix<T>::basic_diagonal_matrix(const basic_matrix<T>& m, ptrdiff_t k)
+    : basic_diagonal_matrix(m.rows(), m.cols(), k) {
+    kopiuj_strukture(*this, m);
+}
+
+/**
+ * @brief Ustawia przekątną na jedynki.
+ */
+template <typename T>
+basic_diagonal_matrix<T>& basic_diagonal_matrix<T>::przekatna() {
+    return wypelnij(T(1));
+}
+
+/**
+ * @brief Ustawia przekątną zgodnie z tablicą @p t.
+ *
+ * @throw std::invalid_argument jeśli @p t == nullptr.
+ */
+template <typename T>
+basic_diagonal_matrix<T>& basic_diagonal_matrix<T>::diagonalna(const T* t) {
+    if (t == nullptr) throw invalid_argument("Tablica zrodlowa jest null");
+    copy(t, t + dane.size(), dane.begin());
+    return *this;
+}
+
+/**
+ * @brief Ustawia wszystkie elementy przekątnej na @p wartosc.
+ */
+template <typename T>
+basic_diagonal_matrix<T>& basic_diagonal_matrix<T>::wypelnij(T wartosc) {
+    fill(dane.begin(), dane.end(), wartosc);
+    return *this;
+}
+
+/**
+ * @brief Zwraca element (@p x, @p y).
+ */
+template <typename T>
+T basic_diagonal_matrix<T>::operator()(ptrdiff_t x, ptrdiff_t y) const {
+    return odczytaj_element(*this, x, y);
+}
+
+/**
+ * @brief Wstawia wartość do komórki (@p x, @p y) na przekątnej.
+ */
+template <typename T>
+basic_diagonal_matrix<T>& basic_diagonal_matrix<T>::wstaw(ptrdiff_t x, ptrdiff_t y, T wartosc) {
+    element_struktury(*this, x, y) = wartosc;
+    return *this;
+}
+
+/**
+ * @brief Zwraca macierz gęstą o tej samej zawartości.
+ */
+template <typename T>
+basic_matrix<T> basic_diagonal_matrix<T>::gesta() const {
+    return rozwin_strukture(*this);
+}
+
+/**
+ * @brief Tworzy pustą macierz wstęgową 0 x 0.
+ */
+template <typename T>
+basic_band_matrix<T>::basic_band_matrix() : basic_band_matrix(0, 0, 0, 0) {
+}
+
+/**
+ * @brief Tworzy zerową macierz wstęgową.
+ *
+ * @throw std::invalid_argument jeśli któryś parametr jest ujemny.
+ * @throw std::length_error jeśli rozmiar przekracza zakres.
+ */
+template <typename T>
+basic_band_matrix<T>::basic_band_matrix(ptrdiff_t wiersze, ptrdiff_t kolumny, ptrdiff_t kl, ptrdiff_t ku)
+    : wierszy(wiersze), kolumn(kolumny), dolnych(kl), gornych(ku) {
+    if (wiersze < 0 || kolumny < 0) throw invalid_argument("Rozmiar ujemny");
+    if (kl < 0 || ku < 0) throw invalid_argument("Ujemna szerokosc wstegi");
+    dane.assign(static_cast<size_t>(jadra::pomnoz_rozmiary(wiersze, kl + ku + 1)), T(0));
+}
+
+/**
+ * @brief Tworzy macierz z wstęgi macierzy gęstej @p m.
+ */
+template <typename T>
+basic_band_matrix<T>::basic_band_matrix(const basic_matrix<T>& m, ptrdiff_t kl, ptrdiff_t ku)
+    : basic_band_matrix(m.rows(), m.cols(), kl, ku) {
+    kopiuj_strukture(*this, m);
+}
+
+/**
+ * @brief Ustawia wszystkie elementy wstęgi na @p wartosc.
+ */
+template <typename T>
+basic_band_matrix<T>& basic_band_matrix<T>::wypelnij(T wartosc) {
+    fill(dane.begin(), dane.end(), wartosc);
+    return *this;
+}
+
+/**
+ * @brief Zwraca element (@p x, @p y).
+ */
+template <typename T>
+T basic_band_matrix<T>::operator()(ptrdiff_t x, ptrdiff_t y) const {
+    return odczytaj_element(*this, x, y);
+}
+
+/**
+ * @brief Wstawia wartość do komórki (@p x, @p y) we wstędze.
+ */
+template <typename T>
+basic_band_matrix<T>& basic_band_matrix<T>::wstaw(ptrdiff_t x, ptrdiff_t y, T wartosc) {
+    element_struktury(*this, x, y) = wartosc;
+    return *this;
+}
+
+/**
+ * @brief Zwraca macierz gęstą o tej samej zawartości.
+ */
+template <typename T>
+basic_matrix<T> basic_band_matrix<T>::gesta() const {
+    return rozwin_strukture(*this);
+}
+
+/**
+ * @brief Tworzy pustą macierz trójkątną 0 x 0.
+ */
+template <typename T>
+basic_triangular_matrix<T>::basic_triangular_matrix() : basic_triangular_matrix(0, trojkat::dolna) {
+}
+
+/**
+ * @brief Tworzy zerową macierz trójkątną @p n x @p n.
+ *
+ * Przechowywanych jest n(n+1)/2 elementów (n(n-1)/2 dla macierzy ściśle
+ * trójkątnej).
+ *
+ * @throw std::invalid_argument jeśli @p n < 0.
+ */
+template <typename T>
+basic_triangular_matrix<T>::basic_triangular_matrix(ptrdiff_t n, trojkat t, bool scisla)
+    : n(n), rodzaj(t), bez_przekatnej(scisla ? 1 : 0) {
+    if (n < 0) throw invalid_argument("Rozmiar ujemny");
+    const ptrdiff_t dl = n - bez_przekatnej;
+    dane.assign(static_cast<size_t>(jadra::pomnoz_rozmiary(max<ptrdiff_t>(dl, 0), dl + 1) / 2), T(0));
+}
+
+/**
+ * @brief Tworzy macierz z części trójkątnej macierzy gęstej @p m.
+ *
+ * @throw std::invalid_argument jeśli @p m nie jest kwadratowa.
+ */
+template <typename T>
+basic_triangular_matrix<T>::basic_triangular_matrix(const basic_matrix<T>& m, trojkat t, bool scisla)
+    : basic_triangular_matrix(m.rows(), t, scisla) {
+    if (m.rows() != m.cols()) throw invalid_argument("Macierz nie jest kwadratowa");
+    kopiuj_strukture(*this, m);
+}
+
+/**
+ * @brief Ustawia wszystkie elementy przechowywanej części na @p wartosc.
+ */
+template <typename T>
+basic_triangular_matrix<T>& basic_triangular_matrix<T>::wypelnij(T wartosc) {
+    fill(dane.begin(), dane.end(), wartosc);
+    return *this;
+}
+
+/**
+ * @brief Zwraca element (@p x, @p y).
+ */
+template <typename T>
+T basic_triangular_matrix<T>::operator()(ptrdiff_t x, ptrdiff_t y) const {
+    return odczytaj_element(*this, x, y);
+}
+
+/**
+ * @brief Wstawia wartość do komórki (@p x, @p y) przechowywanej części.
+ */
+template <typename T>
+basic_triangular_matrix<T>& basic_triangular_matrix<T>::wstaw(ptrdiff_t x, ptrdiff_t y, T wartosc) {
+    element_struktury(*this, x, y) = wartosc;
+    return *this;
+}
+
+/**
+ * @brief Zwraca macierz gęstą o tej samej zawartości.
+ */
+template <typename T>
+basic_matrix<T> basic_triangular_matrix<T>::gesta() const {
+    return rozwin_strukture(*this);
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy przekątniowej i gęstej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_diagonal_matrix<T>& a, const basic_matrix<T>& b) {
+    return pomnoz_strukturalna_gesta(wynik, a, b);
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy gęstej i przekątniowej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_matrix<T>& a, const basic_diagonal_matrix<T>& b) {
+    return pomnoz_gesta_strukturalna(wynik, a, b);
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy wstęgowej i gęstej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_band_matrix<T>& a, const basic_matrix<T>& b) {
+    return pomnoz_strukturalna_gesta(wynik, a, b);
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy gęstej i wstęgowej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_matrix<T>& a, const basic_band_matrix<T>& b) {
+    return pomnoz_gesta_strukturalna(wynik, a, b);
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy trójkątnej i gęstej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_triangular_matrix<T>& a, const basic_matrix<T>& b) {
+    return pomnoz_strukturalna_gesta(wynik, a, b);
+}
+
+/**
+ * @brief Zapisuje do @p wynik iloczyn macierzy gęstej i trójkątnej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_matrix<T>& a, const basic_triangular_matrix<T>& b) {
+    return pomnoz_gesta_strukturalna(wynik, a, b);
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy przekątniowej i gęstej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_diagonal_matrix<T>& a, const basic_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(b.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy gęstej i przekątniowej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_diagonal_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(a.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy wstęgowej i gęstej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_band_matrix<T>& a, const basic_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(b.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy gęstej i wstęgowej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_band_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(a.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy trójkątnej i gęstej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_triangular_matrix<T>& a, const basic_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(b.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Zwraca iloczyn macierzy gęstej i trójkątnej.
+ */
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_triangular_matrix<T>& b) {
+    basic_matrix<jadra::iloczyn_t<T>> wynik(a.get_allocator());
+    pomnoz_do(wynik, a, b);
+    return wynik;
+}
+
+/**
+ * @brief Jawne konkretyzacje klas i funkcji dla typu strukturalnego @p S
+ *        o elementach @p T.
+ */
+#define MACIERZ_INSTANCJA_STRUKTURY(S, T)                                                                      \
+    template class S<T>;                                                                                       \
+    template basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do<T>(basic_matrix<jadra::iloczyn_t<T>>&, const S<T>&,  \
+                                                             const basic_matrix<T>&);                          \
+    template basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do<T>(basic_matrix<jadra::iloczyn_t<T>>&,               \
+                                                             const basic_matrix<T>&, const S<T>&);             \
+    template basic_matrix<jadra::iloczyn_t<T>> pomnoz<T>(const S<T>&, const basic_matrix<T>&);                 \
+    template basic_matrix<jadra::iloczyn_t<T>> pomnoz<T>(const basic_matrix<T>&, const S<T>&);
+
+#define MACIERZ_INSTANCJA_STRUKTURALNA(T)                   \
+    MACIERZ_INSTANCJA_STRUKTURY(basic_diagonal_matrix, T)   \
+    MACIERZ_INSTANCJA_STRUKTURY(basic_band_matrix, T)       \
+    MACIERZ_INSTANCJA_STRUKTURY(basic_triangular_matrix, T)
+
+MACIERZ_INSTANCJA_STRUKTURALNA(int8_t)
+MACIERZ_INSTANCJA_STRUKTURALNA(int16_t)
+MACIERZ_INSTANCJA_STRUKTURALNA(int32_t)
+MACIERZ_INSTANCJA_STRUKTURALNA(int64_t)
+MACIERZ_INSTANCJA_STRUKTURALNA(float)
+MACIERZ_INSTANCJA_STRUKTURALNA(double)
+
+#undef MACIERZ_INSTANCJA_STRUKTURALNA
+#undef MACIERZ_INSTANCJA_STRUKTURY
@@ -0,0 +1,424 @@
+#pragma once
+
+/**
+ * @file structured_matrix.h
+ * @brief Macierze o znanej strukturze zer: przekątniowe, wstęgowe
+ *        i trójkątne.
+ *
+ * Przechowywane są tylko elementy wewnątrz struktury, a każdy wiersz
+ * ma niezerowe elementy w jednym ciągłym zakresie kolumn
+ * (@ref fragment_wiersza). Mnożenie przez macierz gęstą pomija znane zera:
+ * - przekątniowa x gęsta – O(n^2) (każdy wiersz wyniku to przeskalowany
+ *   wiersz drugiego czynnika),
+ * - wstęgowa x gęsta – O(n^2 * (kl + ku + 1)),
+ * - trójkątna x gęsta – połowa pracy mnożenia gęstego.
+ *
+ * Odpowiedniki wzorców @ref basic_matrix: @c przekatna i @c diagonalna
+ * (@ref basic_diagonal_matrix z przesunięciem 0), @c diagonalna_k
+ * (z przesunięciem k), @c pod_przekatna / @c nad_przekatna
+ * (ściśle trójkątne @ref basic_triangular_matrix wypełnione jedynkami).
+ */
+
+#include "matrix.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct fragment_wiersza
+ * @brief Niezerowy fragment wiersza macierzy strukturalnej: kolumny
+ *        [@c kolumna, @c kolumna + @c dlugosc) o wartościach @c wartosci.
+ */
+template <typename T>
+struct fragment_wiersza {
+    std::ptrdiff_t kolumna; ///< Pierwsza kolumna fragmentu.
+    std::ptrdiff_t dlugosc; ///< Liczba elementów fragmentu (może być 0).
+    const T* wartosci;      ///< Wartości elementów fragmentu.
+};
+
+/**
+ * @class basic_diagonal_matrix
+ * @brief Macierz @c rows() x @c cols() z jedną niezerową przekątną,
+ *        przesuniętą o @c przesuniecie() względem głównej.
+ *
+ * Dla k >= 0 przechowywane są elementy (i, i + k), dla k < 0 –
+ * elementy (i - k, i) (jak w @ref basic_matrix::diagonalna_k).
+ *
+ * @tparam T Typ elementów.
+ */
+template <typename T>
+class basic_diagonal_matrix {
+public:
+    /// Typ elementów macierzy.
+    using value_type = T;
+
+    /// Typ wymiarów i indeksów.
+    using size_type = std::ptrdiff_t;
+
+    /// Tworzy pustą macierz 0 x 0.
+    basic_diagonal_matrix();
+
+    /**
+     * @brief Tworzy kwadratową macierz @p n x @p n z zerową przekątną główną.
+     *
+     * @throw std::invalid_argument jeśli @p n < 0.
+     */
+    explicit basic_diagonal_matrix(size_type n);
+
+    /**
+     * @brief Tworzy macierz @p wiersze x @p kolumny z zerową przekątną
+     *        przesuniętą o @p k.
+     *
+     * @throw std::invalid_argument jeśli któryś wymiar jest ujemny.
+     */
+    basic_diagonal_matrix(size_type wiersze, size_type kolumny, size_type k = 0);
+
+    /**
+     * @brief Tworzy macierz z przekątnej @p k macierzy gęstej @p m
+     *        (pozostałe elementy @p m są pomijane).
+     */
+    explicit basic_diagonal_matrix(const basic_matrix<T>& m, size_type k = 0);
+
+    /// Zwraca liczbę wierszy.
+    size_type rows() const noexcept { return wierszy; }
+
+    /// Zwraca liczbę kolumn.
+    size_type cols() const noexcept { return kolumn; }
+
+    /// Zwraca przesunięcie przekątnej względem głównej.
+    size_type przesuniecie() const noexcept { return k; }
+
+    /// Zwraca liczbę przechowywanych elementów (długość przekątnej).
+    size_type nnz() const noexcept { return static_cast<size_type>(dane.size()); }
+
+    /// Zwraca wskaźnik na elementy przekątnej.
+    T* data() noexcept { return dane.data(); }
+
+    /// Zwraca wskaźnik na elementy przekątnej (wersja const).
+    const T* data() const noexcept { return dane.data(); }
+
+    /**
+     * @brief Ustawia przekątną na jedynki (dla k == 0 – macierz jednostkowa).
+     *
+     * @return Referencja do *this.
+     */
+    basic_diagonal_matrix& przekatna();
+
+    /**
+     * @brief Ustawia przekątną zgodnie z tablicą @p t (o długości @c nnz()).
+     *
+     * @return Referencja do *this.
+     * @throw std::invalid_argument jeśli @p t == nullptr.
+     */
+    basic_diagonal_matrix& diagonalna(const T* t);
+
+    /// Ustawia wszystkie elementy przekątnej na @p wartosc.
+    basic_diagonal_matrix& wypelnij(T wartosc);
+
+    /**
+     * @brief Zwraca element (@p x, @p y) (zero poza przekątną).
+     *
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    T operator()(size_type x, size_type y) const;
+
+    /**
+     * @brief Wstawia wartość do komórki (@p x, @p y) na przekątnej.
+     *
+     * @throw std::out_of_range jeśli komórka jest poza macierzą lub przekątną.
+     */
+    basic_diagonal_matrix& wstaw(size_type x, size_type y, T wartosc);
+
+    /// Zwraca macierz gęstą o tej samej zawartości.
+    basic_matrix<T> gesta() const;
+
+    /// Zwraca niezerowy fragment wiersza @p i (0 lub 1 element).
+    fragment_wiersza<T> fragment(size_type i) const noexcept {
+        const size_type d = k >= 0 ? i : i + k;
+        if (d < 0 || d >= nnz()) return { 0, 0, nullptr };
+        return { d + (k >= 0 ? k : 0), 1, dane.data() + d };
+    }
+
+private:
+    size_type wierszy;   ///< Liczba wierszy.
+    size_type kolumn;    ///< Liczba kolumn.
+    size_type k;         ///< Przesunięcie przekątnej.
+    std::vector<T> dane; ///< Elementy przekątnej.
+};
+
+/**
+ * @class basic_band_matrix
+ * @brief Macierz wstęgowa z @c kl() przekątnymi pod i @c ku() nad
+ *        przekątną główną.
+ *
+ * Wiersz i przechowuje elementy (i, j) dla i - kl <= j <= i + ku pod
+ * indeksem i * stride() + (j - i + kl), gdzie stride() = kl + ku + 1
+ * (pozycje wychodzące poza macierz pozostają nieużywane).
+ *
+ * @tparam T Typ elementów.
+ */
+template <typename T>
+class basic_band_matrix {
+public:
+    /// Typ elementów macierzy.
+    using value_type = T;
+
+    /// Typ wymiarów i indeksów.
+    using size_type = std::ptrdiff_t;
+
+    /// Tworzy pustą macierz 0 x 0.
+    basic_band_matrix();
+
+    /**
+     * @brief Tworzy zerową macierz wstęgową @p wiersze x @p kolumny.
+     *
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param kl Liczba przekątnych pod główną.
+     * @param ku Liczba przekątnych nad główną.
+     * @throw std::invalid_argument jeśli któryś parametr jest ujemny.
+     * @throw std::length_error jeśli rozmiar przekracza zakres.
+     */
+    basic_band_matrix(size_type wiersze, size_type kolumny, size_type kl, size_type ku);
+
+    /**
+     * @brief Tworzy macierz z wstęgi macierzy gęstej @p m (elementy poza
+     *        wstęgą są pomijane).
+     */
+    basic_band_matrix(const basic_matrix<T>& m, size_type kl, size_type ku);
+
+    /// Zwraca liczbę wierszy.
+    size_type rows() const noexcept { return wierszy; }
+
+    /// Zwraca liczbę kolumn.
+    size_type cols() const noexcept { return kolumn; }
+
+    /// Zwraca liczbę przekątnych pod główną.
+    size_type kl() const noexcept { return dolnych; }
+
+    /// Zwraca liczbę przekątnych nad główną.
+    size_type ku() const noexcept { return gornych; }
+
+    /// Zwraca odległość między początkami wierszy w @c data() (kl + ku + 1).
+    size_type stride() const noexcept { return dolnych + gornych + 1; }
+
+    /// Zwraca liczbę przechowywanych elementów (@c rows() * @c stride()).
+    size_type nnz() const noexcept { return static_cast<size_type>(dane.size()); }
+
+    /// Zwraca wskaźnik na dane wstęgi.
+    T* data() noexcept { return dane.data(); }
+
+    /// Zwraca wskaźnik na dane wstęgi (wersja const).
+    const T* data() const noexcept { return dane.data(); }
+
+    /// Ustawia wszystkie elementy wstęgi na @p wartosc.
+    basic_band_matrix& wypelnij(T wartosc);
+
+    /**
+     * @brief Zwraca element (@p x, @p y) (zero poza wstęgą).
+     *
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    T operator()(size_type x, size_type y) const;
+
+    /**
+     * @brief Wstawia wartość do komórki (@p x, @p y) we wstędze.
+     *
+     * @throw std::out_of_range jeśli komórka jest poza macierzą lub wstęgą.
+     */
+    basic_band_matrix& wstaw(size_type x, size_type y, T wartosc);
+
+    /// Zwraca macierz gęstą o tej samej zawartości.
+    basic_matrix<T> gesta() const;
+
+    /// Zwraca niezerowy fragment wiersza @p i (część wstęgi wewnątrz macierzy).
+    fragment_wiersza<T> fragment(size_type i) const noexcept {
+        const size_type od = std::max<size_type>(0, i - dolnych);
+        const size_type dl = std::min(kolumn, i + gornych + 1) - od;
+        if (dl <= 0) return { 0, 0, nullptr };
+        return { od, dl, dane.data() + i * stride() + (od - i + dolnych) };
+    }
+
+private:
+    size_type wierszy;   ///< Liczba wierszy.
+    size_type kolumn;    ///< Liczba kolumn.
+    size_type dolnych;   ///< Liczba przekątnych pod główną (kl).
+    size_type gornych;   ///< Liczba przekątnych nad główną (ku).
+    std::vector<T> dane; ///< Wstęga zapisana wierszami.
+};
+
+/**
+ * @enum trojkat
+ * @brief Część macierzy przechowywana przez @ref basic_triangular_matrix.
+ */
+enum class trojkat {
+    dolna, ///< Elementy (i, j) dla j <= i.
+    gorna  ///< Elementy (i, j) dla j >= i.
+};
+
+/**
+ * @class basic_triangular_matrix
+ * @brief Kwadratowa macierz trójkątna w upakowanym formacie wierszowym.
+ *
+ * Macierz ściśle trójkątna nie przechowuje przekątnej głównej (np. wzorce
+ * @ref basic_matrix::pod_przekatna i @ref basic_matrix::nad_przekatna).
+ * Wiersze przechowywanej części leżą w pamięci jeden za drugim.
+ *
+ * @tparam T Typ elementów.
+ */
+template <typename T>
+class basic_triangular_matrix {
+public:
+    /// Typ elementów macierzy.
+    using value_type = T;
+
+    /// Typ wymiarów i indeksów.
+    using size_type = std::ptrdiff_t;
+
+    /// Tworzy pustą macierz 0 x 0 (dolną).
+    basic_triangular_matrix();
+
+    /**
+     * @brief Tworzy zerową macierz trójkątną @p n x @p n.
+     *
+     * @param n Rozmiar.
+     * @param t Przechowywana część.
+     * @param scisla Czy macierz jest ściśle trójkątna (bez przekątnej).
+     * @throw std::invalid_argument jeśli @p n < 0.
+     */
+    basic_triangular_matrix(size_type n, trojkat t, bool scisla = false);
+
+    /**
+     * @brief Tworzy macierz z części trójkątnej kwadratowej macierzy gęstej
+     *        @p m (pozostałe elementy są pomijane).
+     *
+     * @throw std::invalid_argument jeśli @p m nie jest kwadratowa.
+     */
+    basic_triangular_matrix(const basic_matrix<T>& m, trojkat t, bool scisla = false);
+
+    /// Zwraca liczbę wierszy.
+    size_type rows() const noexcept { return n; }
+
+    /// Zwraca liczbę kolumn.
+    size_type cols() const noexcept { return n; }
+
+    /// Zwraca przechowywaną część.
+    trojkat czesc() const noexcept { return rodzaj; }
+
+    /// Sprawdza, czy macierz jest ściśle trójkątna.
+    bool scisla() const noexcept { return bez_przekatnej != 0; }
+
+    /// Zwraca liczbę przechowywanych elementów.
+    size_type nnz() const noexcept { return static_cast<size_type>(dane.size()); }
+
+    /// Zwraca wskaźnik na upakowane dane.
+    T* data() noexcept { return dane.data(); }
+
+    /// Zwraca wskaźnik na upakowane dane (wersja const).
+    const T* data() const noexcept { return dane.data(); }
+
+    /// Ustawia wszystkie elementy przechowywanej części na @p wartosc.
+    basic_triangular_matrix& wypelnij(T wartosc);
+
+    /**
+     * @brief Zwraca element (@p x, @p y) (zero poza przechowywaną częścią).
+     *
+     * @throw std::out_of_range jeśli indeksy są poza zakresem.
+     */
+    T operator()(size_type x, size_type y) const;
+
+    /**
+     * @brief Wstawia wartość do komórki (@p x, @p y) przechowywanej części.
+     *
+     * @throw std::out_of_range jeśli komórka jest poza macierzą lub jej
+     *        przechowywaną częścią.
+     */
+    basic_triangular_matrix& wstaw(size_type x, size_type y, T wartosc);
+
+    /// Zwraca macierz gęstą o tej samej zawartości.
+    basic_matrix<T> gesta() const;
+
+    /// Zwraca niezerowy fragment wiersza @p i.
+    fragment_wiersza<T> fragment(size_type i) const noexcept {
+        const size_type d = bez_przekatnej;
+        if (rodzaj == trojkat::dolna) {
+            return { 0, std::max<size_type>(0, i + 1 - d), dane.data() + (i * (i + 1) / 2 - d * i) };
+        }
+        return { i + d, std::max<size_type>(0, n - i - d), dane.data() + (i * n - i * (i - 1) / 2 - d * i) };
+    }
+
+private:
+    size_type n;              ///< Rozmiar macierzy.
+    trojkat rodzaj;           ///< Przechowywana część.
+    size_type bez_przekatnej; ///< 1 dla macierzy ściśle trójkątnej, 0 w przeciwnym razie.
+    std::vector<T> dane;      ///< Upakowane wiersze przechowywanej części.
+};
+
+/**
+ * @name Aliasy typów macierzy strukturalnych
+ * @{
+ */
+using diagonal_matrix = basic_diagonal_matrix<int>;            ///< Macierz przekątniowa liczb @c int.
+using diagonal_matrix_f64 = basic_diagonal_matrix<double>;     ///< Macierz przekątniowa liczb @c double.
+using band_matrix = basic_band_matrix<int>;                    ///< Macierz wstęgowa liczb @c int.
+using band_matrix_f64 = basic_band_matrix<double>;             ///< Macierz wstęgowa liczb @c double.
+using triangular_matrix = basic_triangular_matrix<int>;        ///< Macierz trójkątna liczb @c int.
+using triangular_matrix_f64 = basic_triangular_matrix<double>; ///< Macierz trójkątna liczb @c double.
+/** @} */
+
+/**
+ * @name Mnożenie macierzy strukturalnych przez gęste
+ *
+ * Każdy wiersz wyniku (lub wkład wiersza macierzy strukturalnej) dotyczy
+ * tylko fragmentu z @ref fragment_wiersza, więc znane zera są pomijane.
+ * Wiersze wyniku są liczone równolegle. Typ elementów wyniku – jak dla
+ * mnożenia macierzy gęstych (@ref jadra::iloczyn_t). Macierz @p wynik może
+ * być czynnikiem gęstym (wtedy używany jest bufor tymczasowy).
+ * @{
+ */
+
+/// Zapisuje do @p wynik iloczyn a * b; @throw std::invalid_argument przy niezgodnych wymiarach.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_diagonal_matrix<T>& a, const basic_matrix<T>& b);
+/// Zapisuje do @p wynik iloczyn a * b; @throw std::invalid_argument przy niezgodnych wymiarach.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_matrix<T>& a, const basic_diagonal_matrix<T>& b);
+/// Zapisuje do @p wynik iloczyn a * b; @throw std::invalid_argument przy niezgodnych wymiarach.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_band_matrix<T>& a, const basic_matrix<T>& b);
+/// Zapisuje do @p wynik iloczyn a * b; @throw std::invalid_argument przy niezgodnych wymiarach.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_matrix<T>& a, const basic_band_matrix<T>& b);
+/// Zapisuje do @p wynik iloczyn a * b; @throw std::invalid_argument przy niezgodnych wymiarach.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_triangular_matrix<T>& a, const basic_matrix<T>& b);
+/// Zapisuje do @p wynik iloczyn a * b; @throw std::invalid_argument przy niezgodnych wymiarach.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>>& pomnoz_do(basic_matrix<jadra::iloczyn_t<T>>& wynik,
+                                             const basic_matrix<T>& a, const basic_triangular_matrix<T>& b);
+
+/// Zwraca iloczyn a * b jako nową macierz.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_diagonal_matrix<T>& a, const basic_matrix<T>& b);
+/// Zwraca iloczyn a * b jako nową macierz.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_diagonal_matrix<T>& b);
+/// Zwraca iloczyn a * b jako nową macierz.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_band_matrix<T>& a, const basic_matrix<T>& b);
+/// Zwraca iloczyn a * b jako nową macierz.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_band_matrix<T>& b);
+/// Zwraca iloczyn a * b jako nową macierz.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_triangular_matrix<T>& a, const basic_matrix<T>& b);
+/// Zwraca iloczyn a * b jako nową macierz.
+template <typename T>
+basic_matrix<jadra::iloczyn_t<T>> pomnoz(const basic_matrix<T>& a, const basic_triangular_matrix<T>& b);
+
+/** @} */
@@ -0,0 +1,566 @@
+#include "tekst.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+/// Przybliżona długość fragmentu tekstu parsowanego przez jedno zadanie.
+constexpr size_t FRAGMENT_TEKSTU = size_t(1) << 18;
+
+/// Przybliżona liczba elementów formatowanych przez jedno zadanie.
+constexpr ptrdiff_t ELEMENTOW_PORCJI = 1 << 14;
+
+/// Sprawdza, czy @p c jest białym znakiem innym niż koniec linii.
+inline bool bialy(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// Przesuwa @p p za białe znaki (bez końców linii), nie dalej niż do @p e.
+inline const char* pomin_biale(const char* p, const char* e) {
+    while (p < e && bialy(*p)) ++p;
+    return p;
+}
+
+/// Sprawdza, czy linia [@p p, @p e) zawiera tylko białe znaki.
+inline bool pusta_linia(const char* p, const char* e) {
+    return pomin_biale(p, e) == e;
+}
+
+/**
+ * @brief Odczytuje liczbę typu @p T zaczynającą się w @p p (dopuszcza znak
+ *        '+') i przesuwa @p p za nią.
+ *
+ * @throw std::runtime_error jeśli w @p p nie zaczyna się liczba typu @p T.
+ */
+template <typename T>
+inline T czytaj_liczbe(const char*& p, const char* e) {
+    if (p < e && *p == '+') ++p;
+    T x{};
+    const from_chars_result r = from_chars(p, e, x);
+    if (r.ec != errc()) throw runtime_error("Niepoprawna liczba w tekscie");
+    p = r.ptr;
+    return x;
+}
+
+/**
+ * @brief Wywołuje @p f(początek, koniec) dla każdej linii tekstu
+ *        [@p b, @p e) (bez znaku '\n').
+ */
+template <typename F>
+void dla_linii(const char* b, const char* e, F&& f) {
+    while (b < e) {
+        const char* nl = static_cast<const char*>(memchr(b, '\n', static_cast<size_t>(e - b)));
+        const char* k = nl != nullptr ? nl : e;
+        f(b, k);
+        b = k + 1;
+    }
+}
+
+/**
+ * @brief Dzieli tekst [@p od, @p t.size()) na fragmenty zaczynające się na
+ *        początku linii.
+ *
+ * @return Granice fragmentów (pierwsza @p od, ostatnia @c t.size()).
+ */
+vector<size_t> podziel_na_linie(string_view t, size_t od) {
+    const size_t n = t.size();
+    const size_t czesci =
+        max<size_t>(1, min<size_t>((n - od) / FRAGMENT_TEKSTU, static_cast<size_t>(liczba_watkow()) * 4));
+    vector<size_t> granice{ od };
+    for (size_t k = 1; k < czesci; ++k) {
+        const size_t nl = t.find('\n', max(granice.back(), od + (n - od) / czesci * k));
+        if (nl == string_view::npos) break;
+        granice.push_back(nl + 1);
+    }
+    granice.push_back(n);
+    return granice;
+}
+
+/**
+ * @brief Liczy liczby w linii [@p p, @p e) – rozdzielone białymi znakami
+ *        lub (dla @p sep != 0) separatorem @p sep.
+ */
+ptrdiff_t licz_pola(const char* p, const char* e, char sep) {
+    if (sep != 0) return 1 + count(p, e, sep);
+    ptrdiff_t pola = 0;
+    for (p = pomin_biale(p, e); p < e; p = pomin_biale(p, e)) {
+        ++pola;
+        while (p < e && !bialy(*p)) ++p;
+    }
+    return pola;
+}
+
+/**
+ * @brief Odczytuje linię [@p p, @p e) z dokładnie @p n liczbami do @p d.
+ *
+ * @throw std::runtime_error jeśli linia ma inną liczbę pól lub pole nie
+ *        jest liczbą.
+ */
+template <typename T>
+void czytaj_wiersz(const char* p, const char* e, char sep, T* d, ptrdiff_t n) {
+    for (ptrdiff_t j = 0; j < n; ++j) {
+        p = pomin_biale(p, e);
+        if (p == e) throw runtime_error("Niezgodna liczba kolumn");
+        d[j] = czytaj_liczbe<T>(p, e);
+        p = pomin_biale(p, e);
+        if (sep != 0 && j + 1 < n) {
+            if (p == e || *p != sep) throw runtime_error(p == e ? "Niezgodna liczba kolumn" : "Niepoprawna liczba w tekscie");
+            ++p;
+        } else if (sep == 0 && p < e && j + 1 < n && !bialy(p[-1])) {
+            throw runtime_error("Niepoprawna liczba w tekscie");
+        }
+    }
+    if (p != e) {
+        const bool nadmiar = sep != 0 ? *p == sep : bialy(p[-1]);
+        throw runtime_error(nadmiar ? "Niezgodna liczba kolumn" : "Niepoprawna liczba w tekscie");
+    }
+}
+
+/**
+ * @brief Parsuje formaty wierszowe (@c odstepy, @c csv).
+ *
+ * Liczba kolumn pochodzi z pierwszej niepustej linii. Fragmenty tekstu są
+ * przetwarzane równolegle dwa razy: najpierw liczone są w nich niepuste
+ * linie (co daje numer pierwszego wiersza każdego fragmentu), potem linie
+ * są parsowane prosto do wierszy macierzy.
+ */
+template <typename T>
+basic_matrix<T> parsuj_wiersze(string_view t, char sep) {
+    const char* d = t.data();
+    // liczba kolumn z pierwszej niepustej linii – bez przeglądania reszty tekstu
+    ptrdiff_t kolumn = -1;
+    for (const char *p = d, *koniec = d + t.size(); p < koniec && kolumn < 0;) {
+        const char* nl = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(koniec - p)));
+        const char* e = nl != nullptr ? nl : koniec;
+        if (!pusta_linia(p, e)) kolumn = licz_pola(p, e, sep);
+        p = e + 1;
+    }
+    if (kolumn < 0) return basic_matrix<T>();
+
+    const vector<size_t> granice = podziel_na_linie(t, 0);
+    const long long fragmentow = static_cast<long long>(granice.size()) - 1;
+    vector<ptrdiff_t> pierwszy(granice.size(), 0);
+    rownolegle_dla(0, fragmentow, 1, [&](long long f0, long long f1) {
+        for (long long f = f0; f < f1; ++f) {
+            ptrdiff_t linii = 0;
+            dla_linii(d + granice[static_cast<size_t>(f)], d + granice[static_cast<size_t>(f) + 1],
+                      [&](const char* p, const char* e) { linii += !pusta_linia(p, e); });
+            pierwszy[static_cast<size_t>(f) + 1] = linii;
+        }
+    });
+    for (size_t f = 1; f < pierwszy.size(); ++f) pierwszy[f] += pierwszy[f - 1];
+
+    basic_matrix<T> m(pierwszy.back(), kolumn, bez_zerowania);
+    rownolegle_dla(0, fragmentow, 1, [&](long long f0, long long f1) {
+        for (long long f = f0; f < f1; ++f) {
+            ptrdiff_t i = pierwszy[static_cast<size_t>(f)];
+            dla_linii(d + granice[static_cast<size_t>(f)], d + granice[static_cast<size_t>(f) + 1],
+                      [&](const char* p, const char* e) {
+                          if (!pusta_linia(p, e)) czytaj_wiersz(p, e, sep, m.row_ptr(i++), kolumn);
+                      });
+        }
+    });
+    return m;
+}
+
+// ---------------------------------------------------------------------------
+// Matrix Market
+// ---------------------------------------------------------------------------
+
+/// Nagłówek i rozmiary z pliku Matrix Market.
+struct opis_mm {
+    bool wspolrzedne;    ///< @c coordinate (true) lub @c array (false).
+    bool wzorzec;        ///< Pole @c pattern (bez wartości, same jedynki).
+    int symetria;        ///< 0 – general, 1 – symmetric, -1 – skew-symmetric.
+    ptrdiff_t wierszy;   ///< Liczba wierszy.
+    ptrdiff_t kolumn;    ///< Liczba kolumn.
+    ptrdiff_t wpisow;    ///< Liczba wpisów (@c coordinate).
+    size_t dane;         ///< Położenie pierwszej linii danych.
+};
+
+/// Zwraca kolejne słowo linii [@p p, @p e) małymi literami.
+string slowo_mm(const char*& p, const char* e) {
+    p = pomin_biale(p, e);
+    string s;
+    for (; p < e && !bialy(*p); ++p) s += static_cast<char>(tolower(static_cast<unsigned char>(*p)));
+    return s;
+}
+
+/**
+ * @brief Odczytuje nagłówek, komentarze i linię rozmiarów Matrix Market.
+ *
+ * @throw std::runtime_error jeśli nagłówek jest niepoprawny lub opisuje
+ *        nieobsługiwany wariant (complex, hermitian).
+ */
+opis_mm czytaj_opis_mm(string_view t) {
+    const char* d = t.data();
+    const char* e = d + t.size();
+    const char* nl = static_cast<const char*>(memchr(d, '\n', t.size()));
+    const char* k = nl != nullptr ? nl : e;
+    const char* p = d;
+    if (slowo_mm(p, k) != "%%matrixmarket" || slowo_mm(p, k) != "matrix") {
+        throw runtime_error("Niepoprawny naglowek Matrix Market");
+    }
+    opis_mm o{};
+    const string uklad = slowo_mm(p, k), pole = slowo_mm(p, k), symetria = slowo_mm(p, k);
+    if (uklad != "array" && uklad != "coordinate") throw runtime_error("Niepoprawny naglowek Matrix Market");
+    if (pole != "real" && pole != "integer" && pole != "double" && pole != "pattern") {
+        throw runtime_error("Nieobslugiwany format Matrix Market");
+    }
+    if (symetria != "general" && symetria != "symmetric" && symetria != "skew-symmetric") {
+        throw runtime_error("Nieobslugiwany format Matrix Market");
+    }
+    o.wspolrzedne = uklad == "coordinate";
+    o.wzorzec = pole == "pattern";
+    o.symetria = symetria == "general" ? 0 : symetria == "symmetric" ? 1 : -1;
+    if (o.wzorzec && !o.wspolrzedne) throw runtime_error("Niepoprawny naglowek Matrix Market");
+
+    // Komentarze i puste linie, potem linia rozmiarów.
+    for (p = k; p < e;) {
+        const char* b = p + 1;
+        nl = b < e ? static_cast<const char*>(memchr(b, '\n', static_cast<size_t>(e - b))) : nullptr;
+        k = nl != nullptr ? nl : e;
+        p = k;
+        if (b >= e || pusta_linia(b, k) || *pomin_biale(b, k) == '%') continue;
+
+        const char* q = pomin_biale(b, k);
+        o.wierszy = czytaj_liczbe<ptrdiff_t>(q, k);
+        q = pomin_biale(q, k);
+        o.kolumn = czytaj_liczbe<ptrdiff_t>(q, k);
+        if (o.wspolrzedne) {
+            q = pomin_biale(q, k);
+            o.wpisow = czytaj_liczbe<ptrdiff_t>(q, k);
+        }
+        if (pomin_biale(q, k) != k || o.wierszy < 0 || o.kolumn < 0 || o.wpisow < 0) {
+            throw runtime_error("Niepoprawny naglowek Matrix Market");
+        }
+        if (o.symetria != 0 && o.wierszy != o.kolumn) throw runtime_error("Niepoprawny naglowek Matrix Market");
+        o.dane = static_cast<size_t>(min(k + 1, e) - d);
+        return o;
+    }
+    throw runtime_error("Niepoprawny naglowek Matrix Market");
+}
+
+/**
+ * @brief Wywołuje @p f(p, e) dla każdego słowa (ciągu znaków innych niż
+ *        białe i '\n') tekstu [@p b, @p e).
+ */
+template <typename F>
+void dla_slow(const char* b, const char* e, F&& f) {
+    const auto odstep = [](char c) { return bialy(c) || c == '\n'; };
+    while (true) {
+        while (b < e && odstep(*b)) ++b;
+        if (b == e) return;
+        const char* k = b;
+        while (k < e && !odstep(*k)) ++k;
+        f(b, k);
+        b = k;
+    }
+}
+
+/// Odczytuje słowo [@p p, @p e) jako jedną liczbę.
+template <typename T>
+T liczba_ze_slowa(const char* p, const char* e) {
+    const T x = czytaj_liczbe<T>(p, e);
+    if (p != e) throw runtime_error("Niepoprawna liczba w tekscie");
+    return x;
+}
+
+/**
+ * @brief Parsuje dane Matrix Market w układzie @c array (kolumnami; dla
+ *        macierzy symetrycznych – dolny trójkąt).
+ *
+ * Fragmenty są przetwarzane równolegle: liczenie słów, potem parsowanie
+ * słowa numer k prosto do elementu, któremu odpowiada.
+ */
+template <typename T>
+basic_matrix<T> parsuj_mm_gesta(string_view t, const opis_mm& o) {
+    const ptrdiff_t n = o.kolumn, w = o.wierszy;
+    // Dla symetrii: kolumna j ma wpisy w wierszach j..n-1 (bez przekątnej dla skew).
+    const ptrdiff_t pomin = o.symetria == -1 ? 1 : 0;
+    const ptrdiff_t oczekiwanych = o.symetria == 0 ? jadra::pomnoz_rozmiary(w, n) : (n - pomin) * (n - pomin + 1) / 2;
+
+    const char* d = t.data();
+    const vector<size_t> granice = podziel_na_linie(t, o.dane);
+    const long long fragmentow = static_cast<long long>(granice.size()) - 1;
+    vector<ptrdiff_t> pierwszy(granice.size(), 0);
+    rownolegle_dla(0, fragmentow, 1, [&](long long f0, long long f1) {
+        for (long long f = f0; f < f1; ++f) {
+            ptrdiff_t slow = 0;
+            dla_slow(d + granice[static_cast<size_t>(f)], d + granice[static_cast<size_t>(f) + 1],
+                     [&](const char*, const char*) { ++slow; });
+            pierwszy[static_cast<size_t>(f) + 1] = slow;
+        }
+    });
+    for (size_t f = 1; f < pierwszy.size(); ++f) pierwszy[f] += pierwszy[f - 1];
+    if (pierwszy.back() != oczekiwanych) throw runtime_error("Niezgodna liczba elementow");
+
+    basic_matrix<T> m(w, n, bez_zerowania);
+    if (o.symetria == -1) {
+        for (ptrdiff_t i = 0; i < n; ++i) m(i, i) = T(0);
+    }
+    rownolegle_dla(0, fragmentow, 1, [&](long long f0, long long f1) {
+        for (long long f = f0; f < f1; ++f) {
+            // Pozycja (i, j) słowa numer pierwszy[f].
+            ptrdiff_t k = pierwszy[static_cast<size_t>(f)], i = 0, j = 0;
+            if (o.symetria == 0) {
+                i = w > 0 ? k % w : 0;
+                j = w > 0 ? k / w : 0;
+            } else {
+                while (j < n && k >= n - j - pomin) k -= n - j - pomin, ++j;
+                i = j + pomin + k;
+            }
+            dla_slow(d + granice[static_cast<size_t>(f)], d + granice[static_cast<size_t>(f) + 1],
+                     [&](const char* p, const char* e) {
+                         const T x = liczba_ze_slowa<T>(p, e);
+                         m.row_ptr(i)[j] = x;
+                         if (o.symetria != 0 && i != j) m.row_ptr(j)[i] = o.symetria == 1 ? x : static_cast<T>(-x);
+                         if (++i == w) {
+                             ++j;
+                             i = o.symetria == 0 ? 0 : j + pomin;
+                         }
+                     });
+        }
+    });
+    return m;
+}
+
+/// Wpis Matrix Market w układzie @c coordinate (indeksy od 0).
+template <typename T>
+struct wpis_mm {
+    ptrdiff_t i, j;
+    T x;
+};
+
+/**
+ * @brief Parsuje dane Matrix Market w układzie @c coordinate.
+ *
+ * Linie są parsowane równolegle do list wpisów poszczególnych fragmentów,
+ * które są następnie wpisywane do wyzerowanej macierzy (kolejno, więc
+ * powtórzone wpisy nie powodują wyścigu – wygrywa ostatni).
+ */
+template <typename T>
+basic_matrix<T> parsuj_mm_wspolrzedne(string_view t, const opis_mm& o) {
+    const char* d = t.data();
+    const vector<size_t> granice = podziel_na_linie(t, o.dane);
+    const long long fragmentow = static_cast<long long>(granice.size()) - 1;
+    vector<vector<wpis_mm<T>>> wpisy(static_cast<size_t>(fragmentow));
+    rownolegle_dla(0, fragmentow, 1, [&](long long f0, long long f1) {
+        for (long long f = f0; f < f1; ++f) {
+            vector<wpis_mm<T>>& lista = wpisy[static_cast<size_t>(f)];
+            dla_linii(d + granice[static_cast<size_t>(f)], d + granice[static_cast<size_t>(f) + 1],
+                      [&](const char* p, const char* e) {
+                          p = pomin_biale(p, e);
+                          if (p == e) return;
+                          const ptrdiff_t i = czytaj_liczbe<ptrdiff_t>(p, e);
+                          p = pomin_biale(p, e);
+                          const ptrdiff_t j = czytaj_liczbe<ptrdiff_t>(p, e);
+                          p = pomin_biale(p, e);
+                          const T x = o.wzorzec ? T(1) : czytaj_liczbe<T>(p, e);
+                          if (pomin_biale(p, e) != e) throw runtime_error("Niepoprawna liczba w tekscie");
+                          if (i < 1 || i > o.wierszy || j < 1 || j > o.kolumn) {
+                              throw runtime_error("Indeks poza zakresem w pliku");
+                          }
+                          lista.push_back({ i - 1, j - 1, x });
+                      });
+        }
+    });
+    ptrdiff_t razem = 0;
+    for (const auto& lista : wpisy) razem += static_cast<ptrdiff_t>(lista.size());
+    if (razem != o.wpisow) throw runtime_error("Niezgodna liczba elementow");
+
+    basic_matrix<T> m(o.wierszy, o.kolumn);
+    for (const auto& lista : wpisy) {
+        for (const wpis_mm<T>& w : lista) {
+            m.row_ptr(w.i)[w.j] = w.x;
+            if (o.symetria != 0 && w.i != w.j) m.row_ptr(w.j)[w.i] = o.symetria == 1 ? w.x : static_cast<T>(-w.x);
+        }
+    }
+    return m;
+}
+
+// ---------------------------------------------------------------------------
+// Zapis
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Zapisuje @p porcji porcji tekstu w kolejności: porcja k jest
+ *        składana przez @p formatuj(k, bufor).
+ *
+ * Porcje są formatowane równolegle falami po kilka na wątek i zapisywane
+ * w kolejności, więc pamięć pomocnicza jest ograniczona do jednej fali.
+ */
+template <typename F>
+void zapisz_porcje(ostream& o, ptrdiff_t porcji, F&& formatuj) {
+    const ptrdiff_t fala = max<ptrdiff_t>(1, static_cast<ptrdiff_t>(liczba_watkow()) * 4);
+    vector<string> bufory(static_cast<size_t>(min(fala, max<ptrdiff_t>(porcji, 1))));
+    for (ptrdiff_t p0 = 0; p0 < porcji && o; p0 += fala) {
+        const ptrdiff_t ile = min(fala, porcji - p0);
+        rownolegle_dla(0, ile, 1, [&](long long b, long long e) {
+            for (long long k = b; k < e; ++k) {
+                string& s = bufory[static_cast<size_t>(k)];
+                s.clear();
+                formatuj(p0 + static_cast<ptrdiff_t>(k), s);
+            }
+        });
+        for (ptrdiff_t k = 0; k < ile; ++k) {
+            o.write(bufory[static_cast<size_t>(k)].data(), static_cast<streamsize>(bufory[static_cast<size_t>(k)].size()));
+        }
+    }
+}
+
+/// Dopisuje do @p s liczbę @p x i znak @p po.
+template <typename T>
+inline void dopisz(string& s, T x, char po) {
+    char liczba[jadra::MAKS_DLUGOSC_LICZBY + 1];
+    char* k = jadra::formatuj_liczbe(liczba, +x);
+    *k++ = po;
+    s.append(liczba, k);
+}
+
+/// Zwraca nazwę pola Matrix Market dla typu @p T.
+template <typename T>
+const char* pole_mm() {
+    return is_integral_v<T> ? "integer" : "real";
+}
+
+/**
+ * @brief Wczytuje całą zawartość strumienia.
+ */
+string wczytaj_calosc(istream& i) {
+    constexpr size_t KAWALEK = size_t(1) << 20;
+    string s;
+    for (;;) {
+        const size_t stary = s.size();
+        s.resize(stary + KAWALEK);
+        i.read(s.data() + stary, static_cast<streamsize>(KAWALEK));
+        s.resize(stary + static_cast<size_t>(i.gcount()));
+        if (!i) break;
+    }
+    if (i.bad()) throw runtime_error("Blad odczytu pliku");
+    return s;
+}
+
+} // namespace
+
+/**
+ * @brief Zapisuje macierz w formacie @p f.
+ *
+ * Formaty wierszowe są dzielone na porcje po kilku wierszach; Matrix Market
+ * (kolumnami) – na porcje po kilku kolumnach.
+ *
+ * @throw std::runtime_error jeśli zapis się nie powiódł.
+ */
+template <typename T>
+void zapisz_tekstowo(const basic_matrix<T>& m, ostream& o, format_tekstu f) {
+    if (f == format_tekstu::matrix_market) {
+        string naglowek = string("%%MatrixMarket matrix array ") + pole_mm<T>() + " general\n";
+        naglowek += to_string(m.rows()) + " " + to_string(m.cols()) + "\n";
+        o.write(naglowek.data(), static_cast<streamsize>(naglowek.size()));
+        const ptrdiff_t kolumn_porcji = max<ptrdiff_t>(1, ELEMENTOW_PORCJI / max<ptrdiff_t>(m.rows(), 1));
+        zapisz_porcje(o, (m.cols() + kolumn_porcji - 1) / kolumn_porcji, [&](ptrdiff_t k, string& s) {
+            const ptrdiff_t j1 = min(m.cols(), (k + 1) * kolumn_porcji);
+            for (ptrdiff_t j = k * kolumn_porcji; j < j1; ++j) {
+                for (ptrdiff_t i = 0; i < m.rows(); ++i) dopisz(s, m.row_ptr(i)[j], '\n');
+            }
+        });
+    } else {
+        const char sep = f == format_tekstu::csv ? ',' : ' ';
+        const ptrdiff_t wierszy_porcji = max<ptrdiff_t>(1, ELEMENTOW_PORCJI / max<ptrdiff_t>(m.cols(), 1));
+        zapisz_porcje(o, (m.rows() + wierszy_porcji - 1) / wierszy_porcji, [&](ptrdiff_t k, string& s) {
+            const ptrdiff_t i1 = min(m.rows(), (k + 1) * wierszy_porcji);
+            for (ptrdiff_t i = k * wierszy_porcji; i < i1; ++i) {
+                const T* w = m.row_ptr(i);
+                for (ptrdiff_t j = 0; j < m.cols(); ++j) dopisz(s, w[j], j + 1 < m.cols() ? sep : '\n');
+                if (m.cols() == 0) s += '\n';
+            }
+        });
+    }
+    if (!o) throw runtime_error("Blad zapisu pliku");
+}
+
+/**
+ * @brief Zapisuje macierz do pliku.
+ *
+ * @throw std::runtime_error jeśli nie można utworzyć pliku lub zapis się
+ *        nie powiódł.
+ */
+template <typename T>
+void zapisz_tekstowo(const basic_matrix<T>& m, const string& sciezka, format_tekstu f) {
+    ofstream o(sciezka, ios::binary | ios::trunc);
+    if (!o) throw runtime_error("Nie mozna otworzyc pliku");
+    zapisz_tekstowo(m, o, f);
+    o.close();
+    if (!o) throw runtime_error("Blad zapisu pliku");
+}
+
+/**
+ * @brief Parsuje macierz z tekstu.
+ *
+ * @throw std::runtime_error jeśli tekst jest niepoprawny.
+ */
+template <typename T>
+basic_matrix<T> parsuj_tekst(string_view tekst, format_tekstu f) {
+    switch (f) {
+    case format_tekstu::csv:
+        return parsuj_wiersze<T>(tekst, ',');
+    case format_tekstu::matrix_market: {
+        const opis_mm o = czytaj_opis_mm(tekst);
+        return o.wspolrzedne ? parsuj_mm_wspolrzedne<T>(tekst, o) : parsuj_mm_gesta<T>(tekst, o);
+    }
+    default:
+        return parsuj_wiersze<T>(tekst, 0);
+    }
+}
+
+/**
+ * @brief Wczytuje cały strumień i parsuje go.
+ *
+ * @throw std::runtime_error jeśli odczyt się nie powiódł lub tekst jest
+ *        niepoprawny.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_tekstowo(istream& i, format_tekstu f) {
+    return parsuj_tekst<T>(wczytaj_calosc(i), f);
+}
+
+/**
+ * @brief Wczytuje plik i parsuje go.
+ *
+ * @throw std::runtime_error jeśli nie można otworzyć pliku lub tekst jest
+ *        niepoprawny.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_tekstowo(const string& sciezka, format_tekstu f) {
+    ifstream i(sciezka, ios::binary);
+    if (!i) throw runtime_error("Nie mozna otworzyc pliku");
+    return wczytaj_tekstowo<T>(i, f);
+}
+
+/**
+ * @brief Jawne konkretyzacje zapisu i odczytu tekstowego dla typu @p T.
+ */
+#define MACIERZ_INSTANCJA_TEKSTU(T)                                                      \
+    template void zapisz_tekstowo<T>(const basic_matrix<T>&, ostream&, format_tekstu);   \
+    template void zapisz_tekstowo<T>(const basic_matrix<T>&, const string&, format_tekstu); \
+    template basic_matrix<T> parsuj_tekst<T>(string_view, format_tekstu);                \
+    template basic_matrix<T> wczytaj_tekstowo<T>(istream&, format_tekstu);               \
+    template basic_matrix<T> wczytaj_tekstowo<T>(const string&, format_tekstu);
+
+MACIERZ_INSTANCJA_TEKSTU(int8_t)
+MACIERZ_INSTANCJA_TEKSTU(int16_t)
+MACIERZ_INSTANCJA_TEKSTU(int32_t)
+MACIERZ_INSTANCJA_TEKSTU(int64_t)
+MACIERZ_INSTANCJA_TEKSTU(float)
+MACIERZ_INSTANCJA_TEKSTU(double)
+
+#undef MACIERZ_INSTANCJA_TEKSTU
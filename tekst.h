@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file tekst.h
+ * @brief Szybki zapis i odczyt macierzy w formatach tekstowych.
+ *
+ * Obsługiwane formaty (@ref format_tekstu):
+ * - @c odstepy – wiersz macierzy w linii, liczby rozdzielone spacjami
+ *   (przy odczycie – dowolnymi białymi znakami),
+ * - @c csv – wiersz w linii, liczby rozdzielone przecinkami,
+ * - @c matrix_market – format Matrix Market (NIST): zapis jako
+ *   @c array (kolumnami), odczyt @c array i @c coordinate, pól
+ *   @c integer / @c real / @c pattern, symetrii @c general, @c symmetric
+ *   i @c skew-symmetric.
+ *
+ * Liczby są formatowane i parsowane funkcjami @c std::to_chars /
+ * @c std::from_chars (niezależnie od locale; liczby zmiennoprzecinkowe –
+ * najkrótszy zapis, który odczytany daje tę samą wartość). Zapis składa
+ * całe wiersze w buforach formatowanych równolegle i wysyła je do strumienia
+ * dużymi porcjami. Odczyt dzieli tekst na fragmenty na granicach linii,
+ * równolegle liczy w nich wiersze (lub liczby), a następnie równolegle
+ * parsuje każdy fragment prosto do danych macierzy.
+ */
+
+#include "matrix.h"
+#include <charconv>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+/**
+ * @brief Format tekstowy macierzy.
+ */
+enum class format_tekstu {
+    odstepy,      ///< Liczby rozdzielone białymi znakami, wiersz w linii.
+    csv,          ///< Liczby rozdzielone przecinkami, wiersz w linii.
+    matrix_market ///< Format Matrix Market.
+};
+
+/**
+ * @brief Zapisuje macierz @p m do strumienia @p o w formacie @p f.
+ *
+ * @throw std::runtime_error jeśli zapis się nie powiódł.
+ */
+template <typename T>
+void zapisz_tekstowo(const basic_matrix<T>& m, std::ostream& o, format_tekstu f = format_tekstu::odstepy);
+
+/**
+ * @brief Zapisuje macierz @p m do pliku @p sciezka w formacie @p f.
+ *
+ * @throw std::runtime_error jeśli nie można utworzyć pliku lub zapis się
+ *        nie powiódł.
+ */
+template <typename T>
+void zapisz_tekstowo(const basic_matrix<T>& m, const std::string& sciezka, format_tekstu f = format_tekstu::odstepy);
+
+/**
+ * @brief Tworzy macierz z tekstu @p tekst w formacie @p f.
+ *
+ * Puste linie są pomijane; w formacie Matrix Market – także komentarze
+ * (linie zaczynające się od '%').
+ *
+ * @throw std::runtime_error jeśli tekst jest niepoprawny (liczba, której
+ *        nie da się odczytać jako @p T, różne długości wierszy, błędny
+ *        nagłówek lub indeks Matrix Market).
+ */
+template <typename T>
+basic_matrix<T> parsuj_tekst(std::string_view tekst, format_tekstu f = format_tekstu::odstepy);
+
+/**
+ * @brief Wczytuje macierz ze strumienia @p i (do jego końca).
+ *
+ * @throw std::runtime_error jak @ref parsuj_tekst.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_tekstowo(std::istream& i, format_tekstu f = format_tekstu::odstepy);
+
+/**
+ * @brief Wczytuje macierz z pliku @p sciezka.
+ *
+ * @throw std::runtime_error jak @ref parsuj_tekst lub jeśli nie można
+ *        otworzyć pliku.
+ */
+template <typename T>
+basic_matrix<T> wczytaj_tekstowo(const std::string& sciezka, format_tekstu f = format_tekstu::odstepy);
+
+namespace jadra {
+
+/// Maksymalna długość liczby sformatowanej przez @ref formatuj_liczbe.
+constexpr int MAKS_DLUGOSC_LICZBY = 32;
+
+/**
+ * @brief Zapisuje @p x od @p p i zwraca wskaźnik za ostatnim znakiem.
+ *
+ * Bufor musi mieć co najmniej @ref MAKS_DLUGOSC_LICZBY znaków. Liczby
+ * zmiennoprzecinkowe – w najkrótszym zapisie dokładnym albo, dla
+ * @p precyzja > 0, jak @c printf("%.*g").
+ */
+template <typename T>
+inline char* formatuj_liczbe(char* p, T x, int precyzja = 0) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (precyzja > 0) return std::to_chars(p, p + MAKS_DLUGOSC_LICZBY, x, std::chars_format::general, precyzja).ptr;
+    }
+    return std::to_chars(p, p + MAKS_DLUGOSC_LICZBY, x).ptr;
+}
+
+} // namespace jadra
@@ -0,0 +1,276 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+namespace {
+
+thread_local thread_pool* biezaca_pula = nullptr; ///< Pula, do której należy bieżący wątek.
+thread_local int biezacy_id = -1;                 ///< Numer bieżącego wątku roboczego w puli.
+
+/**
+ * @brief Wyznacza domyślną liczbę wątków.
+ *
+ * Pierwszeństwo ma zmienna środowiskowa @c MACIERZE_WATKI, potem liczba
+ * rdzeni logicznych procesora.
+ *
+ * @return Liczba wątków (co najmniej 1).
+ */
+int domyslna_liczba_watkow() {
+    int n = 0;
+#ifdef _MSC_VER
+    char* wartosc = nullptr;
+    size_t dlugosc = 0;
+    if (_dupenv_s(&wartosc, &dlugosc, "MACIERZE_WATKI") == 0 && wartosc != nullptr) {
+        n = std::atoi(wartosc);
+        std::free(wartosc);
+    }
+#else
+    if (const char* wartosc = std::getenv("MACIERZE_WATKI")) n = std::atoi(wartosc);
+#endif
+    if (n <= 0) n = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(n, 1);
+}
+
+/**
+ * @brief Stan jednego wywołania @ref thread_pool::wykonaj.
+ */
+struct grupa_zadan {
+    std::atomic<long long> pozostalo{ 0 }; ///< Liczba niezakończonych fragmentów.
+    std::mutex m;                          ///< Chroni @c blad.
+    std::exception_ptr blad;               ///< Pierwszy zgłoszony wyjątek.
+};
+
+} // namespace
+
+/**
+ * @brief Tworzy pulę i uruchamia wątki robocze.
+ *
+ * @param liczba_watkow Łączna liczba wątków (<= 0 – wartość domyślna).
+ */
+thread_pool::thread_pool(int liczba_watkow) : oczekujace(0), stop(false) {
+    uruchom(liczba_watkow);
+}
+
+/**
+ * @brief Destruktor. Zatrzymuje i dołącza wszystkie wątki robocze.
+ */
+thread_pool::~thread_pool() {
+    zatrzymaj();
+}
+
+/**
+ * @brief Zwraca łączną liczbę wątków wykonujących pracę.
+ *
+ * @return Liczba wątków roboczych + 1.
+ */
+int thread_pool::liczba_watkow() const {
+    return static_cast<int>(watki.size()) + 1;
+}
+
+/**
+ * @brief Zmienia liczbę wątków puli (zatrzymuje stare, uruchamia nowe).
+ *
+ * @param liczba_watkow Nowa łączna liczba wątków.
+ */
+void thread_pool::zmien_liczbe_watkow(int liczba_watkow) {
+    zatrzymaj();
+    uruchom(liczba_watkow);
+}
+
+/**
+ * @brief Tworzy @p liczba_watkow - 1 wątków roboczych wraz z ich kolejkami.
+ *
+ * @param liczba_watkow Łączna liczba wątków (<= 0 – wartość domyślna).
+ */
+void thread_pool::uruchom(int liczba_watkow) {
+    if (liczba_watkow <= 0) liczba_watkow = domyslna_liczba_watkow();
+    stop = false;
+    kolejki.clear();
+    for (int i = 0; i + 1 < liczba_watkow; ++i) {
+        kolejki.push_back(std::make_unique<kolejka>());
+    }
+    for (int i = 0; i + 1 < liczba_watkow; ++i) {
+        watki.emplace_back(&thread_pool::petla, this, i);
+    }
+}
+
+/**
+ * @brief Zatrzymuje wątki robocze. Zadania pozostałe w kolejkach są wykonywane
+ *        przed zakończeniem wątków.
+ */
+void thread_pool::zatrzymaj() {
+    {
+        std::lock_guard<std::mutex> lk(m_sen);
+        stop = true;
+    }
+    sen.notify_all();
+    for (std::thread& w : watki) w.join();
+    watki.clear();
+}
+
+/**
+ * @brief Pętla główna wątku roboczego.
+ *
+ * Wątek wykonuje zadania z własnej kolejki lub podkradzione z innych,
+ * a gdy żadnych nie ma – czeka na @c sen.
+ *
+ * @param id Numer wątku roboczego.
+ */
+void thread_pool::petla(int id) {
+    biezaca_pula = this;
+    biezacy_id = id;
+
+    std::function<void()> z;
+    for (;;) {
+        if (pobierz(id, z)) {
+            z();
+            z = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lk(m_sen);
+        sen.wait(lk, [this] { return stop || oczekujace.load() > 0; });
+        if (stop && oczekujace.load() == 0) return;
+    }
+}
+
+/**
+ * @brief Wstawia zadanie na koniec kolejki wątku @p id.
+ *
+ * @param id Numer wątku roboczego.
+ * @param z Zadanie.
+ */
+void thread_pool::dodaj(int id, std::function<void()> z) {
+    kolejka& k = *kolejki[id];
+    std::lock_guard<std::mutex> lk(k.m);
+    k.zadania.push_back(std::move(z));
+    ++oczekujace;
+}
+
+/**
+ * @brief Pobiera zadanie do wykonania.
+ *
+ * Najpierw z końca własnej kolejki (jeśli @p id >= 0), potem podkrada
+ * z początku kolejek pozostałych wątków.
+ *
+ * @param id Numer wątku roboczego lub -1 dla wątku spoza puli.
+ * @param z Miejsce na pobrane zadanie.
+ * @return true jeśli pobrano zadanie.
+ */
+bool thread_pool::pobierz(int id, std::function<void()>& z) {
+    if (oczekujace.load() == 0) return false;
+
+    const int liczba = static_cast<int>(kolejki.size());
+    if (id >= 0) {
+        kolejka& k = *kolejki[id];
+        std::lock_guard<std::mutex> lk(k.m);
+        if (!k.zadania.empty()) {
+            z = std::move(k.zadania.back());
+            k.zadania.pop_back();
+            --oczekujace;
+            return true;
+        }
+    }
+    const int start = id >= 0 ? id + 1 : 0;
+    for (int i = 0; i < liczba; ++i) {
+        kolejka& k = *kolejki[(start + i) % liczba];
+        std::lock_guard<std::mutex> lk(k.m);
+        if (!k.zadania.empty()) {
+            z = std::move(k.zadania.front());
+            k.zadania.pop_front();
+            --oczekujace;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Wykonuje @p f równolegle na przedziale [@p poczatek, @p koniec).
+ *
+ * Przedział jest dzielony na co najwyżej 8 fragmentów na wątek. Wątek
+ * wywołujący, czekając na zakończenie, sam wykonuje oczekujące zadania.
+ */
+void thread_pool::wykonaj(long long poczatek, long long koniec, long long ziarno,
+                          const std::function<void(long long, long long)>& f) {
+    const long long dlugosc = koniec - poczatek;
+    if (dlugosc <= 0) return;
+    ziarno = std::max(ziarno, 1LL);
+    if (dlugosc <= ziarno || watki.empty()) {
+        f(poczatek, koniec);
+        return;
+    }
+
+    const long long fragmentow = std::min((dlugosc + ziarno - 1) / ziarno,
+                                          8LL * liczba_watkow());
+    const long long krok = (dlugosc + fragmentow - 1) / fragmentow;
+
+    grupa_zadan grupa;
+    grupa.pozostalo = (dlugosc + krok - 1) / krok;
+
+    const bool wlasny = biezaca_pula == this;
+    const int liczba_kolejek = static_cast<int>(kolejki.size());
+    int nastepna = 0;
+    for (long long b = poczatek; b < koniec; b += krok) {
+        const long long e = std::min(b + krok, koniec);
+        auto zadanie = [&f, &grupa, b, e] {
+            try {
+                f(b, e);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lk(grupa.m);
+                if (!grupa.blad) grupa.blad = std::current_exception();
+            }
+            --grupa.pozostalo;
+        };
+        // Zagnieżdżone wywołanie trafia do własnej kolejki (inne wątki je
+        // podkradną), zewnętrzne jest rozkładane równo między wątki.
+        dodaj(wlasny ? biezacy_id : nastepna++ % liczba_kolejek, zadanie);
+    }
+    {
+        std::lock_guard<std::mutex> lk(m_sen);
+    }
+    sen.notify_all();
+
+    const int id = wlasny ? biezacy_id : -1;
+    std::function<void()> z;
+    while (grupa.pozostalo.load() > 0) {
+        if (pobierz(id, z)) {
+            z();
+            z = nullptr;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (grupa.blad) std::rethrow_exception(grupa.blad);
+}
+
+/**
+ * @brief Zwraca globalną pulę biblioteki.
+ *
+ * @return Referencja do globalnej puli.
+ */
+thread_pool& thread_pool::globalna() {
+    static thread_pool pula;
+    return pula;
+}
+
+/**
+ * @brief Ustawia liczbę wątków globalnej puli.
+ *
+ * @param n Łączna liczba wątków (<= 0 – wartość domyślna).
+ */
+void ustaw_liczbe_watkow(int n) {
+    thread_pool::globalna().zmien_liczbe_watkow(n);
+}
+
+/**
+ * @brief Zwraca liczbę wątków globalnej puli.
+ *
+ * @return Łączna liczba wątków wykonujących pracę.
+ */
+int liczba_watkow() {
+    return thread_pool::globalna().liczba_watkow();
+}
\ No newline at end of file
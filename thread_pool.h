@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file thread_pool.h
+ * @brief Pula wątków z podkradaniem zadań, używana przez operacje na macierzach.
+ *
+ * Biblioteka posiada jedną globalną pulę (@ref thread_pool::globalna), tworzoną
+ * przy pierwszym użyciu. Liczbę wątków można ustawić:
+ * - zmienną środowiskową @c MACIERZE_WATKI (odczytywaną przy tworzeniu puli),
+ * - w czasie działania funkcją @ref ustaw_liczbe_watkow.
+ *
+ * Domyślnie używanych jest tyle wątków, ile rdzeni logicznych ma procesor.
+ */
+
+/// Liczba elementów, od której pętle po całej macierzy są dzielone między wątki puli.
+constexpr long long PROG_ROWNOLEGLY = 1 << 16;
+
+/**
+ * @class thread_pool
+ * @brief Trwała pula wątków z kolejką zadań na każdy wątek i podkradaniem zadań.
+ *
+ * Każdy wątek roboczy ma własną kolejkę: zadania pobiera z jej końca, a gdy
+ * jest pusta – podkrada je z początku kolejek innych wątków. Wątek zlecający
+ * pracę (także wątek roboczy, przy zagnieżdżonym wywołaniu) nie czeka
+ * bezczynnie, tylko sam wykonuje oczekujące zadania.
+ */
+class thread_pool {
+public:
+    /**
+     * @brief Tworzy pulę.
+     *
+     * @param liczba_watkow Łączna liczba wątków wykonujących pracę (wliczając
+     *        wątek zlecający). Wartość <= 0 oznacza wartość domyślną.
+     */
+    explicit thread_pool(int liczba_watkow = 0);
+
+    /**
+     * @brief Destruktor. Zatrzymuje i dołącza wszystkie wątki robocze.
+     */
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /**
+     * @brief Zwraca łączną liczbę wątków wykonujących pracę.
+     *
+     * @return Liczba wątków roboczych + 1 (wątek zlecający).
+     */
+    int liczba_watkow() const;
+
+    /**
+     * @brief Zmienia liczbę wątków puli.
+     *
+     * Istniejące wątki robocze są zatrzymywane i tworzone są nowe.
+     * Nie wolno wywoływać tej metody w trakcie obliczeń korzystających z puli.
+     *
+     * @param liczba_watkow Nowa łączna liczba wątków (<= 0 – wartość domyślna).
+     */
+    void zmien_liczbe_watkow(int liczba_watkow);
+
+    /**
+     * @brief Wykonuje @p f równolegle na przedziale [@p poczatek, @p koniec).
+     *
+     * Przedział jest dzielony na fragmenty o długości co najmniej @p ziarno;
+     * dla każdego fragmentu wywoływane jest @c f(b, e). Metoda wraca po
+     * zakończeniu wszystkich fragmentów. Jeśli któryś fragment zgłosi wyjątek,
+     * pierwszy z nich jest zgłaszany ponownie w wątku wywołującym.
+     *
+     * Jeżeli przedział nie jest dłuższy niż @p ziarno lub pula ma jeden wątek,
+     * @p f jest wywoływane bezpośrednio dla całego przedziału.
+     *
+     * @param poczatek Początek przedziału.
+     * @param koniec Koniec przedziału (wyłącznie).
+     * @param ziarno Minimalna długość fragmentu.
+     * @param f Funkcja wywoływana dla fragmentów.
+     */
+    void wykonaj(long long poczatek, long long koniec, long long ziarno,
+                 const std::function<void(long long, long long)>& f);
+
+    /**
+     * @brief Zwraca globalną pulę biblioteki (tworzoną przy pierwszym użyciu).
+     *
+     * @return Referencja do globalnej puli.
+     */
+    static thread_pool& globalna();
+
+private:
+    /// Kolejka zadań jednego wątku roboczego.
+    struct kolejka {
+        std::mutex m;                             ///< Chroni @c zadania.
+        std::deque<std::function<void()>> zadania; ///< Oczekujące zadania.
+    };
+
+    std::vector<std::thread> watki;                ///< Wątki robocze.
+    std::vector<std::unique_ptr<kolejka>> kolejki; ///< Kolejki (po jednej na wątek roboczy).
+    std::atomic<long long> oczekujace;             ///< Liczba zadań we wszystkich kolejkach.
+    std::atomic<bool> stop;                        ///< Sygnał zakończenia dla wątków.
+    std::mutex m_sen;                              ///< Mutex dla @c sen.
+    std::condition_variable sen;                   ///< Budzi wątki, gdy pojawiają się zadania.
+
+    /// Tworzy @p liczba_watkow - 1 wątków roboczych.
+    void uruchom(int liczba_watkow);
+    /// Zatrzymuje i dołącza wszystkie wątki robocze.
+    void zatrzymaj();
+    /// Pętla główna wątku roboczego o numerze @p id.
+    void petla(int id);
+    /// Wstawia zadanie na koniec kolejki wątku @p id.
+    void dodaj(int id, std::function<void()> z);
+    /// Pobiera zadanie z własnej kolejki (@p id >= 0) lub podkrada je z innej.
+    bool pobierz(int id, std::function<void()>& z);
+};
+
+/**
+ * @brief Ustawia liczbę wątków globalnej puli.
+ *
+ * Nie wolno wywoływać w trakcie obliczeń korzystających z puli.
+ *
+ * @param n Łączna liczba wątków (<= 0 – wartość domyślna).
+ */
+void ustaw_liczbe_watkow(int n);
+
+/**
+ * @brief Zwraca liczbę wątków globalnej puli.
+ *
+ * @return Łączna liczba wątków wykonujących pracę.
+ */
+int liczba_watkow();
+
+/**
+ * @brief Wykonuje @p f równolegle na przedziale [@p poczatek, @p koniec)
+ *        w globalnej puli.
+ *
+ * @see thread_pool::wykonaj
+ */
+template <typename F>
+void rownolegle_dla(long long poczatek, long long koniec, long long ziarno, F&& f) {
+    if (koniec - poczatek <= ziarno) {
+        if (koniec > poczatek) f(poczatek, koniec);
+        return;
+    }
+    thread_pool::globalna().wykonaj(poczatek, koniec, ziarno, std::forward<F>(f));
+}
\ No newline at end of file
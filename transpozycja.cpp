@@ -0,0 +1,312 @@
+#include "transpozycja.h"
+#include "cpu.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#ifdef MACIERZ_X86
+#include <immintrin.h>
+#endif
+
+namespace jadra {
+
+namespace {
+
+/// Bok bloku, poniżej którego rekurencja przechodzi do jąder 8 x 8.
+constexpr int BAZA = 32;
+
+/// Bok kafelka, na które dzielona jest macierz w wersji równoległej.
+constexpr int KAFELEK = 128;
+
+/**
+ * @brief Jądra transpozycji bloku 8 x 8 wybranego wariantu.
+ */
+template <typename T>
+struct jadra_transpozycji {
+    /// Zamienia blok p z blokiem q, transponując oba (p == q – transpozycja bloku).
+    void (*zamien_8x8)(T* p, T* q, long long ld);
+    /// b = a^T dla bloku 8 x 8.
+    void (*kopiuj_8x8)(const T* a, long long lda, T* b, long long ldb);
+    /// Nazwa wariantu.
+    const char* nazwa;
+};
+
+// ---------------------------------------------------------------------------
+// Wariant skalarny
+// ---------------------------------------------------------------------------
+
+template <typename T>
+void zamien_8x8_skalarny(T* p, T* q, long long ld) {
+    if (p == q) {
+        for (int i = 0; i < 8; ++i) {
+            for (int j = i + 1; j < 8; ++j) std::swap(p[i * ld + j], p[j * ld + i]);
+        }
+        return;
+    }
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) std::swap(p[i * ld + j], q[j * ld + i]);
+    }
+}
+
+template <typename T>
+void kopiuj_8x8_skalarny(const T* a, long long lda, T* b, long long ldb) {
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) b[j * ldb + i] = a[i * lda + j];
+    }
+}
+
+#ifdef MACIERZ_X86
+
+// ---------------------------------------------------------------------------
+// Wariant AVX2 (blok 8 x 8 w ośmiu rejestrach, elementy 4-bajtowe)
+// ---------------------------------------------------------------------------
+
+/// Transponuje w rejestrach blok 8 x 8 (r[i] – wiersz i).
+MACIERZ_CEL("avx2")
+inline void transponuj_rejestry(__m256i r[8]) {
+    __m256i t[8], u[8];
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        r[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+        r[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+    }
+}
+
+template <typename T>
+MACIERZ_CEL("avx2")
+inline void wczytaj_8x8(const T* a, long long ld, __m256i r[8]) {
+    for (int i = 0; i < 8; ++i) r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * ld));
+}
+
+template <typename T>
+MACIERZ_CEL("avx2")
+inline void zapisz_8x8(T* a, long long ld, const __m256i r[8]) {
+    for (int i = 0; i < 8; ++i) _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i * ld), r[i]);
+}
+
+template <typename T>
+MACIERZ_CEL("avx2")
+void zamien_8x8_avx2(T* p, T* q, long long ld) {
+    __m256i x[8], y[8];
+    wczytaj_8x8(p, ld, x);
+    transponuj_rejestry(x);
+    if (p == q) {
+        zapisz_8x8(p, ld, x);
+        return;
+    }
+    wczytaj_8x8(q, ld, y);
+    transponuj_rejestry(y);
+    zapisz_8x8(q, ld, x);
+    zapisz_8x8(p, ld, y);
+}
+
+template <typename T>
+MACIERZ_CEL("avx2")
+void kopiuj_8x8_avx2(const T* a, long long lda, T* b, long long ldb) {
+    __m256i x[8];
+    wczytaj_8x8(a, lda, x);
+    transponuj_rejestry(x);
+    zapisz_8x8(b, ldb, x);
+}
+
+#endif // MACIERZ_X86
+
+/**
+ * @brief Wybiera wariant jąder obsługiwany przez procesor.
+ *
+ * Jądro AVX2 przestawia 32-bitowe słowa, więc nadaje się dla każdego
+ * typu 4-bajtowego.
+ */
+template <typename T>
+jadra_transpozycji<T> wybierz_transpozycje() {
+#ifdef MACIERZ_X86
+    if constexpr (sizeof(T) == 4) {
+        if (procesor().avx2) return { zamien_8x8_avx2<T>, kopiuj_8x8_avx2<T>, "avx2" };
+    }
+#endif
+    return { zamien_8x8_skalarny<T>, kopiuj_8x8_skalarny<T>, "skalarny" };
+}
+
+/**
+ * @brief Zwraca jądra wybrane przy pierwszym wywołaniu.
+ */
+template <typename T>
+const jadra_transpozycji<T>& jadra_t() {
+    static const jadra_transpozycji<T> wybrane = wybierz_transpozycje<T>();
+    return wybrane;
+}
+
+/// Dzieli bok @p x na dwie części; pierwsza jest wielokrotnością 8.
+inline int polowa(int x) {
+    return (x / 2 + 7) / 8 * 8;
+}
+
+/**
+ * @brief Zamienia blok h x w o początku (r0, c0) z blokiem w x h o początku
+ *        (c0, r0), transponując oba (bloki leżą po przeciwnych stronach
+ *        przekątnej).
+ */
+template <typename T>
+void zamien_bloki(const jadra_transpozycji<T>& j, T* a, long long ld, std::ptrdiff_t r0, std::ptrdiff_t c0, int h, int w) {
+    if (h > BAZA || w > BAZA) {
+        if (h >= w) {
+            const int h1 = polowa(h);
+            zamien_bloki(j, a, ld, r0, c0, h1, w);
+            zamien_bloki(j, a, ld, r0 + h1, c0, h - h1, w);
+        }
+        else {
+            const int w1 = polowa(w);
+            zamien_bloki(j, a, ld, r0, c0, h, w1);
+            zamien_bloki(j, a, ld, r0, c0 + w1, h, w - w1);
+        }
+        return;
+    }
+    const int h8 = h / 8 * 8;
+    const int w8 = w / 8 * 8;
+    for (int i = 0; i < h8; i += 8) {
+        for (int k = 0; k < w8; k += 8) {
+            j.zamien_8x8(a + (r0 + i) * ld + c0 + k, a + (c0 + k) * ld + r0 + i, ld);
+        }
+    }
+    for (int i = 0; i < h; ++i) {
+        for (int k = i < h8 ? w8 : 0; k < w; ++k) {
+            std::swap(a[(r0 + i) * ld + c0 + k], a[(c0 + k) * ld + r0 + i]);
+        }
+    }
+}
+
+/**
+ * @brief Transponuje w miejscu blok przekątny s x s o początku (d, d).
+ */
+template <typename T>
+void transponuj_przekatny(const jadra_transpozycji<T>& j, T* a, long long ld, std::ptrdiff_t d, int s) {
+    if (s > BAZA) {
+        const int s1 = polowa(s);
+        transponuj_przekatny(j, a, ld, d, s1);
+        transponuj_przekatny(j, a, ld, d + s1, s - s1);
+        zamien_bloki(j, a, ld, d + s1, d, s - s1, s1);
+        return;
+    }
+    const int s8 = s / 8 * 8;
+    for (int bi = 0; bi < s8; bi += 8) {
+        for (int bk = bi; bk < s8; bk += 8) {
+            j.zamien_8x8(a + (d + bi) * ld + d + bk, a + (d + bk) * ld + d + bi, ld);
+        }
+    }
+    for (int i = 0; i < s; ++i) {
+        for (int k = std::max(i + 1, s8); k < s; ++k) {
+            std::swap(a[(d + i) * ld + d + k], a[(d + k) * ld + d + i]);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Transponuje w miejscu kwadratową macierz.
+ *
+ * Małe macierze (lub praca na jednym wątku) – jedna rekurencja od całej
+ * macierzy. Duże – podział na kafelki @c KAFELEK x @c KAFELEK; każda para
+ * kafelków (I, J), J >= I, jest osobnym zadaniem puli.
+ */
+template <typename T>
+void transponuj(std::ptrdiff_t n, T* a) {
+    if (n <= 1) return;
+    const long long ld = n;
+    if (n * n < PROG_ROWNOLEGLY || liczba_watkow() == 1) {
+        transponuj_przekatny(jadra_t<T>(), a, ld, 0, static_cast<int>(n));
+        return;
+    }
+
+    const long long t = (n + KAFELEK - 1) / KAFELEK;
+    rownolegle_dla(0, t * (t + 1) / 2, 1, [=](long long p0, long long p1) {
+        const jadra_transpozycji<T>& j = jadra_t<T>();
+        // Numer pary p odpowiada (I, J) w kolejności wierszami nad przekątną.
+        long long I = 0, reszta = p0;
+        while (reszta >= t - I) {
+            reszta -= t - I;
+            ++I;
+        }
+        long long J = I + reszta;
+        for (long long p = p0; p < p1; ++p) {
+            const std::ptrdiff_t r = I * KAFELEK;
+            const std::ptrdiff_t c = J * KAFELEK;
+            const int h = static_cast<int>(std::min<std::ptrdiff_t>(KAFELEK, n - r));
+            if (I == J) {
+                transponuj_przekatny(j, a, ld, r, h);
+            }
+            else {
+                zamien_bloki(j, a, ld, c, r, static_cast<int>(std::min<std::ptrdiff_t>(KAFELEK, n - c)), h);
+            }
+            if (++J == t) J = ++I;
+        }
+    });
+}
+
+/**
+ * @brief Zapisuje do @p b transpozycję @p a.
+ *
+ * Kopiowanie odbywa się blokami @c BAZA x @c BAZA (jądro 8 x 8 dla pełnych
+ * bloków), a pasy wierszy @p a są rozdzielane między wątki.
+ */
+template <typename T>
+void transponuj(std::ptrdiff_t m, std::ptrdiff_t n, const T* a, std::ptrdiff_t lda, T* b, std::ptrdiff_t ldb) {
+    const long long blokow = (m + BAZA - 1) / BAZA;
+    const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / (BAZA * std::max<long long>(n, 1)));
+    rownolegle_dla(0, blokow, ziarno, [=](long long b0, long long b1) {
+        const jadra_transpozycji<T>& j = jadra_t<T>();
+        const std::ptrdiff_t i_kon = std::min<std::ptrdiff_t>(m, b1 * BAZA);
+        for (std::ptrdiff_t ib = b0 * BAZA; ib < i_kon; ib += BAZA) {
+            const int h = static_cast<int>(std::min<std::ptrdiff_t>(BAZA, m - ib));
+            for (std::ptrdiff_t jb = 0; jb < n; jb += BAZA) {
+                const int w = static_cast<int>(std::min<std::ptrdiff_t>(BAZA, n - jb));
+                const int h8 = h / 8 * 8;
+                const int w8 = w / 8 * 8;
+                for (int i = 0; i < h8; i += 8) {
+                    for (int k = 0; k < w8; k += 8) {
+                        j.kopiuj_8x8(a + (ib + i) * lda + jb + k, lda, b + (jb + k) * ldb + ib + i, ldb);
+                    }
+                }
+                for (int i = 0; i < h; ++i) {
+                    for (int k = i < h8 ? w8 : 0; k < w; ++k) {
+                        b[(jb + k) * ldb + ib + i] = a[(ib + i) * lda + jb + k];
+                    }
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief Zwraca nazwę wariantu jądra transpozycji wybranego dla typu @p T.
+ */
+template <typename T>
+const char* wariant_transpozycji() {
+    return jadra_t<T>().nazwa;
+}
+
+#define MACIERZ_INSTANCJA_TRANSPOZYCJI(T)                                                                      \
+    template void transponuj<T>(std::ptrdiff_t, T*);                                                           \
+    template void transponuj<T>(std::ptrdiff_t, std::ptrdiff_t, const T*, std::ptrdiff_t, T*, std::ptrdiff_t); \
+    template const char* wariant_transpozycji<T>();
+
+MACIERZ_INSTANCJA_TRANSPOZYCJI(std::int8_t)
+MACIERZ_INSTANCJA_TRANSPOZYCJI(std::int16_t)
+MACIERZ_INSTANCJA_TRANSPOZYCJI(std::int32_t)
+MACIERZ_INSTANCJA_TRANSPOZYCJI(std::int64_t)
+MACIERZ_INSTANCJA_TRANSPOZYCJI(float)
+MACIERZ_INSTANCJA_TRANSPOZYCJI(double)
+
+#undef MACIERZ_INSTANCJA_TRANSPOZYCJI
+
+} // namespace jadra
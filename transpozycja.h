@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @file transpozycja.h
+ * @brief Transpozycja macierzy: w miejscu (macierze kwadratowe) oraz do
+ *        osobnego bufora.
+ *
+ * Transpozycja w miejscu jest rekurencyjna (niezależna od rozmiarów pamięci
+ * podręcznej): macierz jest dzielona na ćwiartki, bloki przekątne są
+ * transponowane rekurencyjnie, a bloki pozadiagonalne – zamieniane
+ * z jednoczesną transpozycją. Najniższy poziom korzysta z jądra
+ * transponującego w rejestrach bloki 8 x 8 (AVX2, wybierane w czasie
+ * działania programu) dla elementów 4-bajtowych; pozostałe typy korzystają
+ * z wersji skalarnej. Dla dużych macierzy pary kafelków są rozdzielane
+ * między wątki puli.
+ *
+ * Funkcje są dostępne dla @c int8_t, @c int16_t, @c int32_t, @c int64_t,
+ * @c float i @c double.
+ */
+
+#include <cstddef>
+
+namespace jadra {
+
+/**
+ * @brief Transponuje w miejscu kwadratową macierz @p n x @p n.
+ *
+ * @tparam T Typ elementów.
+ * @param n Rozmiar macierzy.
+ * @param a Dane macierzy (wierszami, ciągłe).
+ */
+template <typename T>
+void transponuj(std::ptrdiff_t n, T* a);
+
+/**
+ * @brief Zapisuje do @p b transpozycję macierzy @p a (m x n).
+ *
+ * Bufory nie mogą na siebie nachodzić.
+ *
+ * @tparam T Typ elementów.
+ * @param m Liczba wierszy A (i kolumn B).
+ * @param n Liczba kolumn A (i wierszy B).
+ * @param a Dane macierzy A.
+ * @param lda Odległość między wierszami A.
+ * @param b Dane macierzy wynikowej B (n x m).
+ * @param ldb Odległość między wierszami B.
+ */
+template <typename T>
+void transponuj(std::ptrdiff_t m, std::ptrdiff_t n, const T* a, std::ptrdiff_t lda, T* b, std::ptrdiff_t ldb);
+
+/**
+ * @brief Zwraca nazwę wariantu jądra transpozycji wybranego dla typu @p T
+ *        ("avx2" lub "skalarny").
+ */
+template <typename T = int>
+const char* wariant_transpozycji();
+
+} // namespace jadra
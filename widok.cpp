@@ -0,0 +1,349 @@
+#include "widok.h"
+#include "gemm.h"
+#include "thread_pool.h"
+#include "transpozycja.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+/// Zgłasza wyjątek, jeśli widoki @p c i @p a mają różne wymiary.
+template <typename C, typename A>
+void sprawdz_wymiary(const matrix_view<C>& c, const matrix_view<A>& a) {
+    if (c.rows() != a.rows() || c.cols() != a.cols()) throw invalid_argument("Rozne wymiary macierzy!");
+}
+
+/**
+ * @brief Sprawdza, czy obszary pamięci widoków @p x i @p y mogą się
+ *        nakładać (porównanie zakresów adresów od pierwszego do ostatniego
+ *        elementu).
+ */
+template <typename X, typename Y>
+bool nachodza(const matrix_view<X>& x, const matrix_view<Y>& y) {
+    if (x.empty() || y.empty()) return false;
+    const auto zakres = [](const auto& v) {
+        const uintptr_t p = reinterpret_cast<uintptr_t>(v.data());
+        const auto koniec = (v.rows() - 1) * v.stride() + (v.cols() - 1) * v.col_stride() + 1;
+        return pair<uintptr_t, uintptr_t>(p, p + static_cast<uintptr_t>(koniec) * sizeof(*v.data()));
+    };
+    const auto [x0, x1] = zakres(x);
+    const auto [y0, y1] = zakres(y);
+    return x0 < y1 && y0 < x1;
+}
+
+/**
+ * @brief Sprawdza, czy widoki @p x i @p y (o tych samych wymiarach)
+ *        opisują te same elementy w tym samym układzie.
+ */
+template <typename X, typename Y>
+bool te_same(const matrix_view<X>& x, const matrix_view<Y>& y) {
+    return x.data() == y.data() && x.stride() == y.stride() && x.col_stride() == y.col_stride();
+}
+
+/**
+ * @brief Sprawdza, czy wynik @p c nachodzi na argument @p a inaczej niż
+ *        jako ten sam widok – wtedy argument trzeba najpierw skopiować.
+ */
+template <typename T>
+bool nachodzi_czesciowo(const matrix_view<T>& c, const matrix_view<const T>& a) {
+    return !te_same(c, a) && nachodza(c, a);
+}
+
+/**
+ * @brief Liczy @p c(i, j) = @p f(@p a(i, j)) dla wszystkich elementów.
+ *
+ * Widoki ciągłe są przetwarzane jedną płaską pętlą, pozostałe wierszami;
+ * oba warianty równolegle. Argument częściowo nachodzący na wynik jest
+ * najpierw kopiowany.
+ */
+template <typename T, typename F>
+void elementowo(matrix_view<T> c, matrix_view<const T> a, F f) {
+    sprawdz_wymiary(c, a);
+    if (c.empty()) return;
+    if (nachodzi_czesciowo(c, a)) {
+        const basic_matrix<T> kopia = kopiuj(a);
+        elementowo(c, widok(kopia), f);
+        return;
+    }
+    T* dc = c.data();
+    const T* da = a.data();
+    if (c.ciagla() && a.ciagla()) {
+        rownolegle_dla(0, c.rows() * c.cols(), PROG_ROWNOLEGLY, [=](long long b, long long e) {
+            for (long long x = b; x < e; ++x) dc[x] = f(da[x]);
+        });
+        return;
+    }
+    const ptrdiff_t n = c.cols(), ldc = c.stride(), kc = c.col_stride(), lda = a.stride(), ka = a.col_stride();
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(n, 1));
+    rownolegle_dla(0, c.rows(), ziarno, [=](long long b, long long e) {
+        for (long long i = b; i < e; ++i) {
+            T* w = dc + i * ldc;
+            const T* x = da + i * lda;
+            if (kc == 1 && ka == 1) {
+                for (ptrdiff_t j = 0; j < n; ++j) w[j] = f(x[j]);
+            } else {
+                for (ptrdiff_t j = 0; j < n; ++j) w[j * kc] = f(x[j * ka]);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Liczy @p c(i, j) = @p f(@p a(i, j), @p b(i, j)) dla wszystkich
+ *        elementów (zob. wersję jednoargumentową).
+ */
+template <typename T, typename F>
+void elementowo(matrix_view<T> c, matrix_view<const T> a, matrix_view<const T> b, F f) {
+    sprawdz_wymiary(c, a);
+    sprawdz_wymiary(c, b);
+    if (c.empty()) return;
+    if (nachodzi_czesciowo(c, a)) {
+        const basic_matrix<T> kopia = kopiuj(a);
+        elementowo(c, widok(kopia), b, f);
+        return;
+    }
+    if (nachodzi_czesciowo(c, b)) {
+        const basic_matrix<T> kopia = kopiuj(b);
+        elementowo(c, a, widok(kopia), f);
+        return;
+    }
+    T* dc = c.data();
+    const T* da = a.data();
+    const T* db = b.data();
+    if (c.ciagla() && a.ciagla() && b.ciagla()) {
+        rownolegle_dla(0, c.rows() * c.cols(), PROG_ROWNOLEGLY, [=](long long p, long long e) {
+            for (long long x = p; x < e; ++x) dc[x] = f(da[x], db[x]);
+        });
+        return;
+    }
+    const ptrdiff_t n = c.cols(), ldc = c.stride(), kc = c.col_stride();
+    const ptrdiff_t lda = a.stride(), ka = a.col_stride(), ldb = b.stride(), kb = b.col_stride();
+    const long long ziarno = max(1LL, PROG_ROWNOLEGLY / max<long long>(n, 1));
+    rownolegle_dla(0, c.rows(), ziarno, [=](long long p, long long e) {
+        for (long long i = p; i < e; ++i) {
+            T* w = dc + i * ldc;
+            const T* x = da + i * lda;
+            const T* y = db + i * ldb;
+            if (kc == 1 && ka == 1 && kb == 1) {
+                for (ptrdiff_t j = 0; j < n; ++j) w[j] = f(x[j], y[j]);
+            } else {
+                for (ptrdiff_t j = 0; j < n; ++j) w[j * kc] = f(x[j * ka], y[j * kb]);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Zwraca dane czynnika @p a z jednostkowym odstępem elementów:
+ *        wprost z widoku albo – po skopiowaniu – z @p bufor.
+ */
+template <typename T>
+matrix_view<const T> czynnik_ciagly(matrix_view<const T> a, basic_matrix<T>& bufor) {
+    if (a.col_stride() == 1 || a.cols() <= 1) return a;
+    bufor.alokuj(a.rows(), a.cols(), bez_zerowania);
+    kopiuj_do(widok(bufor), a);
+    return widok(as_const(bufor));
+}
+
+/**
+ * @brief Wspólna część obu wersji @ref pomnoz_do dla widoków.
+ */
+template <typename T>
+void pomnoz_widoki(matrix_view<jadra::iloczyn_t<T>> c, matrix_view<const T> a, matrix_view<const T> b, bool akumuluj) {
+    using W = jadra::iloczyn_t<T>;
+    if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols()) {
+        throw invalid_argument("Rozne wymiary macierzy!");
+    }
+    if (c.empty()) return;
+
+    // Wynik transponowany: C^T = B^T * A^T ma znów jednostkowy odstęp elementów.
+    if (c.col_stride() != 1 && c.cols() > 1 && (c.stride() == 1 || c.rows() == 1)) {
+        pomnoz_widoki<T>(c.transpozycja(), b.transpozycja(), a.transpozycja(), akumuluj);
+        return;
+    }
+    if ((c.col_stride() != 1 && c.cols() > 1) || nachodza(c, a) || nachodza(c, b)) {
+        basic_matrix<W> wynik(c.rows(), c.cols(), bez_zerowania);
+        if (akumuluj) kopiuj_do(widok(wynik), c);
+        pomnoz_widoki<T>(widok(wynik), a, b, akumuluj);
+        kopiuj_do(c, widok(as_const(wynik)));
+        return;
+    }
+
+    basic_matrix<T> ba, bb;
+    const matrix_view<const T> pa = czynnik_ciagly(a, ba);
+    const matrix_view<const T> pb = czynnik_ciagly(b, bb);
+    // Odstęp wierszy widoku jednowierszowego bywa dowolny (np. 0 lub 1) – GEMM wymaga co najmniej liczby kolumn.
+    const auto odstep = [](const auto& v) { return v.rows() == 1 ? max(v.stride(), v.cols()) : v.stride(); };
+    jadra::gemm(c.rows(), c.cols(), a.cols(), pa.data(), odstep(pa), pb.data(), odstep(pb), c.data(), odstep(c),
+                akumuluj);
+}
+
+} // namespace
+
+/**
+ * @brief Zwraca nową macierz z kopią elementów widoku.
+ */
+template <typename T>
+basic_matrix<remove_const_t<T>> kopiuj(matrix_view<T> a) {
+    basic_matrix<remove_const_t<T>> wynik(a.rows(), a.cols(), bez_zerowania);
+    kopiuj_do(widok(wynik), a);
+    return wynik;
+}
+
+/**
+ * @brief Kopiuje elementy widoku do widoku.
+ *
+ * Jeśli dokładnie jeden z widoków ma jednostkowy odstęp wierszy, a drugi
+ * jednostkowy odstęp elementów, kopia jest transpozycją danych i wykonuje
+ * ją jądro transpozycji blokami; w pozostałych przypadkach – pętla
+ * element po elemencie. Źródło nachodzące na cel jest najpierw kopiowane
+ * do macierzy tymczasowej.
+ */
+template <typename T>
+matrix_view<T> kopiuj_do(matrix_view<T> c, type_identity_t<matrix_view<const T>> a) {
+    sprawdz_wymiary(c, a);
+    if (c.empty() || te_same(c, a)) return c;
+    if (nachodza(c, a)) {
+        const basic_matrix<T> kopia = kopiuj(a);
+        return kopiuj_do(c, widok(kopia));
+    }
+    if (c.rows() > 1 && c.cols() > 1) {
+        if (c.col_stride() == 1 && a.stride() == 1) {
+            jadra::transponuj(a.cols(), a.rows(), a.data(), a.col_stride(), c.data(), c.stride());
+            return c;
+        }
+        if (c.stride() == 1 && a.col_stride() == 1) {
+            jadra::transponuj(a.rows(), a.cols(), a.data(), a.stride(), c.data(), c.col_stride());
+            return c;
+        }
+    }
+    elementowo(c, a, [](T x) { return x; });
+    return c;
+}
+
+/**
+ * @brief Zapisuje transpozycję widoku do widoku.
+ */
+template <typename T>
+matrix_view<T> transponuj_do(matrix_view<T> c, type_identity_t<matrix_view<const T>> a) {
+    return kopiuj_do(c, a.transpozycja());
+}
+
+/**
+ * @brief Wypełnia widok wartością.
+ */
+template <typename T>
+matrix_view<T> wypelnij(matrix_view<T> c, type_identity_t<T> x) {
+    elementowo(c, matrix_view<const T>(c), [x](T) { return x; });
+    return c;
+}
+
+/**
+ * @brief Dodaje widoki element po elemencie.
+ */
+template <typename T>
+matrix_view<T> dodaj_do(matrix_view<T> c, type_identity_t<matrix_view<const T>> a, type_identity_t<matrix_view<const T>> b) {
+    elementowo(c, a, b, [](T x, T y) { return static_cast<T>(x + y); });
+    return c;
+}
+
+/**
+ * @brief Odejmuje widoki element po elemencie.
+ */
+template <typename T>
+matrix_view<T> odejmij_do(matrix_view<T> c, type_identity_t<matrix_view<const T>> a, type_identity_t<matrix_view<const T>> b) {
+    elementowo(c, a, b, [](T x, T y) { return static_cast<T>(x - y); });
+    return c;
+}
+
+/**
+ * @brief Dodaje stałą do każdego elementu widoku.
+ */
+template <typename T>
+matrix_view<T> dodaj_do(matrix_view<T> c, type_identity_t<matrix_view<const T>> a, type_identity_t<T> s) {
+    elementowo(c, a, [s](T x) { return static_cast<T>(x + s); });
+    return c;
+}
+
+/**
+ * @brief Mnoży każdy element widoku przez stałą.
+ */
+template <typename T>
+matrix_view<T> pomnoz_do(matrix_view<T> c, type_identity_t<matrix_view<const T>> a, type_identity_t<T> s) {
+    elementowo(c, a, [s](T x) { return static_cast<T>(x * s); });
+    return c;
+}
+
+/**
+ * @brief Mnożenie macierzowe widoków (typ wyniku równy typowi argumentów).
+ */
+template <typename T>
+    requires std::is_same_v<jadra::iloczyn_t<T>, T>
+matrix_view<T> pomnoz_do(matrix_view<T> c, type_identity_t<matrix_view<const T>> a,
+                         type_identity_t<matrix_view<const T>> b, bool akumuluj) {
+    pomnoz_widoki<T>(c, a, b, akumuluj);
+    return c;
+}
+
+/**
+ * @brief Mnożenie macierzowe widoków 8- i 16-bitowych.
+ */
+template <typename A, typename T>
+    requires(!std::is_same_v<jadra::iloczyn_t<T>, T>)
+matrix_view<jadra::iloczyn_t<T>> pomnoz_do(matrix_view<jadra::iloczyn_t<T>> c, matrix_view<A> a,
+                                           type_identity_t<matrix_view<const T>> b, bool akumuluj) {
+    pomnoz_widoki<T>(c, a, b, akumuluj);
+    return c;
+}
+
+/**
+ * @brief Jawne konkretyzacje funkcji na widokach dla typu @p T.
+ */
+#define MACIERZ_INSTANCJA_WIDOKU(T)                                                                                  \
+    template basic_matrix<T> kopiuj<T>(matrix_view<T>);                                                              \
+    template basic_matrix<T> kopiuj<const T>(matrix_view<const T>);                                                  \
+    template matrix_view<T> kopiuj_do<T>(matrix_view<T>, matrix_view<const T>);                                      \
+    template matrix_view<T> transponuj_do<T>(matrix_view<T>, matrix_view<const T>);                                  \
+    template matrix_view<T> wypelnij<T>(matrix_view<T>, T);                                                          \
+    template matrix_view<T> dodaj_do<T>(matrix_view<T>, matrix_view<const T>, matrix_view<const T>);                 \
+    template matrix_view<T> odejmij_do<T>(matrix_view<T>, matrix_view<const T>, matrix_view<const T>);               \
+    template matrix_view<T> dodaj_do<T>(matrix_view<T>, matrix_view<const T>, T);                                    \
+    template matrix_view<T> pomnoz_do<T>(matrix_view<T>, matrix_view<const T>, T);
+
+/**
+ * @brief Jawne konkretyzacje mnożenia macierzowego widoków dla typu @p T.
+ */
+#define MACIERZ_INSTANCJA_ILOCZYNU_WIDOKOW(T)                                                                        \
+    template matrix_view<T> pomnoz_do<T>(matrix_view<T>, matrix_view<const T>, matrix_view<const T>, bool);
+
+/**
+ * @brief Jawne konkretyzacje szerokiego mnożenia macierzowego widoków dla
+ *        typu @p T.
+ */
+#define MACIERZ_INSTANCJA_SZEROKIEGO_ILOCZYNU_WIDOKOW(T)                                                             \
+    template matrix_view<jadra::iloczyn_t<T>> pomnoz_do<T, T>(matrix_view<jadra::iloczyn_t<T>>, matrix_view<T>,      \
+                                                              matrix_view<const T>, bool);                           \
+    template matrix_view<jadra::iloczyn_t<T>> pomnoz_do<const T, T>(matrix_view<jadra::iloczyn_t<T>>,               \
+                                                                    matrix_view<const T>, matrix_view<const T>, bool);
+
+MACIERZ_INSTANCJA_WIDOKU(int8_t)
+MACIERZ_INSTANCJA_WIDOKU(int16_t)
+MACIERZ_INSTANCJA_WIDOKU(int32_t)
+MACIERZ_INSTANCJA_WIDOKU(int64_t)
+MACIERZ_INSTANCJA_WIDOKU(float)
+MACIERZ_INSTANCJA_WIDOKU(double)
+
+MACIERZ_INSTANCJA_SZEROKIEGO_ILOCZYNU_WIDOKOW(int8_t)
+MACIERZ_INSTANCJA_SZEROKIEGO_ILOCZYNU_WIDOKOW(int16_t)
+MACIERZ_INSTANCJA_ILOCZYNU_WIDOKOW(int32_t)
+MACIERZ_INSTANCJA_ILOCZYNU_WIDOKOW(int64_t)
+MACIERZ_INSTANCJA_ILOCZYNU_WIDOKOW(float)
+MACIERZ_INSTANCJA_ILOCZYNU_WIDOKOW(double)
+
+#undef MACIERZ_INSTANCJA_WIDOKU
+#undef MACIERZ_INSTANCJA_ILOCZYNU_WIDOKOW
+#undef MACIERZ_INSTANCJA_SZEROKIEGO_ILOCZYNU_WIDOKOW
@@ -0,0 +1,305 @@
+#pragma once
+
+/**
+ * @file widok.h
+ * @brief Widoki macierzy: prostokątne fragmenty cudzych danych bez
+ *        kopiowania.
+ *
+ * @ref matrix_view nie jest właścicielem danych – to wskaźnik na element
+ * (0, 0), wymiary i dwa odstępy: między wierszami (@c stride()) i między
+ * kolejnymi elementami wiersza (@c col_stride()). Element (i, j) leży pod
+ * adresem @c data() + i * stride() + j * col_stride(), więc podmacierz,
+ * pojedynczy wiersz lub kolumna i transpozycja są znów widokami tych samych
+ * danych – tworzenie ich nic nie kosztuje.
+ *
+ * Widok tworzy się z macierzy (@ref widok) lub z zewnętrznego bufora
+ * (konstruktor ze wskaźnikiem). Typ @c matrix_view<const T> pozwala tylko
+ * czytać dane (jak @c std::span<const T>); widok @c matrix_view<T>
+ * i macierz są do niego niejawnie konwertowane.
+ *
+ * Funkcje @c *_do z tego pliku zapisują wynik do widoku o właściwych
+ * wymiarach (nie zmieniają rozmiaru danych, do których widok należy):
+ * @code
+ * matrix C(512, 512);
+ * auto c = widok(C);
+ * // Lewy górny blok C += A[0:256, 0:128] * B[0:128, 0:256], bez kopiowania bloków.
+ * pomnoz_do(c.podmacierz(0, 0, 256, 256), widok(A).podmacierz(0, 0, 256, 128),
+ *           widok(B).podmacierz(0, 0, 128, 256), true);
+ * @endcode
+ *
+ * Widok musi być używany tylko, dopóki żyją dane, do których należy
+ * (realokacja macierzy unieważnia jej widoki).
+ */
+
+#include "matrix.h"
+#include "gemm.h"
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @class matrix_view
+ * @brief Widok prostokątnego fragmentu danych macierzy (bez własności).
+ *
+ * @tparam T Typ elementów; @c const T – widok tylko do odczytu.
+ */
+template <typename T>
+class matrix_view {
+public:
+    /// Typ elementów (bez @c const).
+    using value_type = std::remove_const_t<T>;
+
+    /// Typ elementów widoku (z ewentualnym @c const).
+    using element_type = T;
+
+    /// Typ wymiarów, indeksów i odstępów.
+    using size_type = std::ptrdiff_t;
+
+    /// Tworzy pusty widok 0 x 0.
+    matrix_view() noexcept = default;
+
+    /**
+     * @brief Tworzy widok bufora @p dane: @p wiersze x @p kolumny, element
+     *        (i, j) pod adresem dane + i * odstep + j * krok.
+     *
+     * @param dane Wskaźnik na element (0, 0).
+     * @param wiersze Liczba wierszy.
+     * @param kolumny Liczba kolumn.
+     * @param odstep Odległość (w elementach) między początkami wierszy.
+     * @param krok Odległość (w elementach) między elementami wiersza.
+     * @throw std::invalid_argument jeśli wymiar lub odstęp jest ujemny albo
+     *        @p dane == nullptr dla niepustego widoku.
+     */
+    matrix_view(T* dane, size_type wiersze, size_type kolumny, size_type odstep, size_type krok = 1)
+        : d(dane), wierszy(wiersze), kolumn(kolumny), ld(odstep), inc(krok) {
+        if (wiersze < 0 || kolumny < 0 || odstep < 0 || krok < 0) throw std::invalid_argument("Rozmiar ujemny");
+        if (dane == nullptr && wiersze > 0 && kolumny > 0) throw std::invalid_argument("Tablica zrodlowa jest null");
+    }
+
+    /**
+     * @brief Tworzy widok ciągłego bufora @p dane (wiersze jeden za drugim).
+     *
+     * @throw std::invalid_argument jak wyżej.
+     */
+    matrix_view(T* dane, size_type wiersze, size_type kolumny) : matrix_view(dane, wiersze, kolumny, kolumny) {}
+
+    /// Tworzy widok całej macierzy @p m.
+    matrix_view(basic_matrix<value_type>& m) noexcept
+        : d(m.data()), wierszy(m.rows()), kolumn(m.cols()), ld(m.stride()), inc(1) {}
+
+    /// Tworzy widok tylko do odczytu całej macierzy @p m.
+    matrix_view(const basic_matrix<value_type>& m) noexcept requires std::is_const_v<T>
+        : d(m.data()), wierszy(m.rows()), kolumn(m.cols()), ld(m.stride()), inc(1) {}
+
+    /// Tworzy widok tylko do odczytu z widoku @p v.
+    template <typename U>
+        requires(std::is_const_v<T> && std::is_same_v<U, value_type>)
+    matrix_view(const matrix_view<U>& v) noexcept
+        : d(v.data()), wierszy(v.rows()), kolumn(v.cols()), ld(v.stride()), inc(v.col_stride()) {}
+
+    /// Zwraca liczbę wierszy.
+    size_type rows() const noexcept { return wierszy; }
+
+    /// Zwraca liczbę kolumn.
+    size_type cols() const noexcept { return kolumn; }
+
+    /// Zwraca odległość (w elementach) między początkami wierszy.
+    size_type stride() const noexcept { return ld; }
+
+    /// Zwraca odległość (w elementach) między elementami wiersza.
+    size_type col_stride() const noexcept { return inc; }
+
+    /// Sprawdza, czy widok nie ma elementów.
+    bool empty() const noexcept { return wierszy == 0 || kolumn == 0; }
+
+    /// Sprawdza, czy elementy leżą w pamięci jeden za drugim, wierszami.
+    bool ciagla() const noexcept { return inc == 1 && (ld == kolumn || wierszy <= 1); }
+
+    /// Zwraca wskaźnik na element (0, 0).
+    T* data() const noexcept { return d; }
+
+    /// Zwraca wskaźnik na pierwszy element wiersza @p i.
+    T* row_ptr(size_type i) const noexcept { return d + i * ld; }
+
+    /**
+     * @brief Zwraca element (@p i, @p j).
+     *
+     * Indeksy są sprawdzane zgodnie z @ref MACIERZ_SPRAWDZAJ_INDEKSY.
+     */
+    T& operator()(size_type i, size_type j) const {
+#if MACIERZ_SPRAWDZAJ_INDEKSY
+        if (i < 0 || i >= wierszy || j < 0 || j >= kolumn) throw std::out_of_range("Indeks poza zakresem");
+#endif
+        return d[i * ld + j * inc];
+    }
+
+    /**
+     * @brief Zwraca widok @p wiersze x @p kolumny zaczynający się od
+     *        elementu (@p i, @p j).
+     *
+     * @throw std::out_of_range jeśli fragment wychodzi poza widok.
+     */
+    matrix_view podmacierz(size_type i, size_type j, size_type wiersze, size_type kolumny) const {
+        if (i < 0 || j < 0 || wiersze < 0 || kolumny < 0 || i > wierszy - wiersze || j > kolumn - kolumny) {
+            throw std::out_of_range("Indeks poza zakresem");
+        }
+        matrix_view v(*this);
+        if (wiersze > 0 && kolumny > 0) v.d = d + i * ld + j * inc;
+        v.wierszy = wiersze;
+        v.kolumn = kolumny;
+        return v;
+    }
+
+    /**
+     * @brief Zwraca wiersz @p i jako widok 1 x @c cols().
+     *
+     * @throw std::out_of_range jeśli @p i jest poza zakresem.
+     */
+    matrix_view wiersz(size_type i) const { return podmacierz(i, 0, 1, kolumn); }
+
+    /**
+     * @brief Zwraca kolumnę @p j jako widok @c rows() x 1.
+     *
+     * @throw std::out_of_range jeśli @p j jest poza zakresem.
+     */
+    matrix_view kolumna(size_type j) const { return podmacierz(0, j, wierszy, 1); }
+
+    /// Zwraca widok transponowany (@c cols() x @c rows(), te same dane).
+    matrix_view transpozycja() const noexcept {
+        matrix_view v;
+        v.d = d;
+        v.wierszy = kolumn;
+        v.kolumn = wierszy;
+        v.ld = inc;
+        v.inc = ld;
+        return v;
+    }
+
+private:
+    T* d = nullptr;        ///< Element (0, 0).
+    size_type wierszy = 0; ///< Liczba wierszy.
+    size_type kolumn = 0;  ///< Liczba kolumn.
+    size_type ld = 0;      ///< Odstęp wierszy.
+    size_type inc = 1;     ///< Odstęp elementów wiersza.
+};
+
+/// Zwraca widok całej macierzy @p m.
+template <typename T>
+matrix_view<T> widok(basic_matrix<T>& m) noexcept {
+    return matrix_view<T>(m);
+}
+
+/// Zwraca widok tylko do odczytu całej macierzy @p m.
+template <typename T>
+matrix_view<const T> widok(const basic_matrix<T>& m) noexcept {
+    return matrix_view<const T>(m);
+}
+
+/**
+ * @brief Zwraca nową macierz z kopią elementów widoku @p a.
+ */
+template <typename T>
+basic_matrix<std::remove_const_t<T>> kopiuj(matrix_view<T> a);
+
+/**
+ * @brief Kopiuje elementy @p a do @p c.
+ *
+ * Kopia z widoku transponowanego do zwykłego (lub odwrotnie) korzysta
+ * z jądra transpozycji (@ref jadra::transponuj). @p a może nachodzić na
+ * @p c (np. przesunięta podmacierz tej samej macierzy albo jej
+ * transpozycja) – wtedy jest najpierw kopiowany do macierzy tymczasowej.
+ *
+ * @return @p c.
+ * @throw std::invalid_argument jeśli wymiary są różne.
+ */
+template <typename T>
+matrix_view<T> kopiuj_do(matrix_view<T> c, std::type_identity_t<matrix_view<const T>> a);
+
+/**
+ * @brief Zapisuje do @p c transpozycję @p a (@p c: a.cols() x a.rows()).
+ *
+ * @p a może nachodzić na @p c, także być tym samym widokiem (transpozycja
+ * macierzy kwadratowej w miejscu) – jak w @ref kopiuj_do, przez macierz
+ * tymczasową.
+ *
+ * @return @p c.
+ * @throw std::invalid_argument jeśli wymiary są niezgodne.
+ */
+template <typename T>
+matrix_view<T> transponuj_do(matrix_view<T> c, std::type_identity_t<matrix_view<const T>> a);
+
+/**
+ * @brief Wypełnia widok @p c wartością @p x.
+ *
+ * @return @p c.
+ */
+template <typename T>
+matrix_view<T> wypelnij(matrix_view<T> c, std::type_identity_t<T> x);
+
+/**
+ * @name Działania element po elemencie na widokach
+ *
+ * Wynik @p c może być tym samym widokiem co argument (działanie w miejscu,
+ * bez kopii). Argument, który nachodzi na @p c w inny sposób (przesunięta
+ * podmacierz, transpozycja), jest najpierw kopiowany do macierzy
+ * tymczasowej. Widoki ciągłe są przetwarzane jedną płaską pętlą,
+ * pozostałe – wierszami (równolegle).
+ *
+ * @return @p c.
+ * @throw std::invalid_argument jeśli wymiary są różne.
+ * @{
+ */
+
+/// @p c = @p a + @p b.
+template <typename T>
+matrix_view<T> dodaj_do(matrix_view<T> c, std::type_identity_t<matrix_view<const T>> a,
+                        std::type_identity_t<matrix_view<const T>> b);
+
+/// @p c = @p a - @p b.
+template <typename T>
+matrix_view<T> odejmij_do(matrix_view<T> c, std::type_identity_t<matrix_view<const T>> a,
+                          std::type_identity_t<matrix_view<const T>> b);
+
+/// @p c = @p a + @p s.
+template <typename T>
+matrix_view<T> dodaj_do(matrix_view<T> c, std::type_identity_t<matrix_view<const T>> a, std::type_identity_t<T> s);
+
+/// @p c = @p a * @p s.
+template <typename T>
+matrix_view<T> pomnoz_do(matrix_view<T> c, std::type_identity_t<matrix_view<const T>> a, std::type_identity_t<T> s);
+
+/** @} */
+
+/**
+ * @brief Mnożenie macierzowe na widokach: C = A * B lub C += A * B.
+ *
+ * Widoki z jednostkowym @c col_stride() trafiają do @ref jadra::gemm bez
+ * kopiowania (podmacierze – z odstępem wierszy macierzy, do której
+ * należą). Dla transponowanego @p c liczone jest C^T = B^T * A^T;
+ * pozostałe czynniki z niejednostkowym @c col_stride() (np. transponowane)
+ * są najpierw kopiowane do ciągłego bufora, tak samo wynik nachodzący na
+ * czynnik.
+ *
+ * Wersja dla typów, których iloczyn ma typ argumentów (zob.
+ * @ref jadra::iloczyn_t).
+ *
+ * @param c Wynik (a.rows() x b.cols()).
+ * @param a Lewy czynnik.
+ * @param b Prawy czynnik.
+ * @param akumuluj Czy dodawać iloczyn do @p c.
+ * @return @p c.
+ * @throw std::invalid_argument jeśli wymiary są niezgodne.
+ */
+template <typename T>
+    requires std::is_same_v<jadra::iloczyn_t<T>, T>
+matrix_view<T> pomnoz_do(matrix_view<T> c, std::type_identity_t<matrix_view<const T>> a,
+                         std::type_identity_t<matrix_view<const T>> b, bool akumuluj = false);
+
+/**
+ * @brief Mnożenie macierzowe widoków 8- i 16-bitowych z wynikiem 32-bitowym
+ *        (zob. wyżej; typ elementów jest wyznaczany z widoku @p a).
+ */
+template <typename A, typename T = std::remove_const_t<A>>
+    requires(!std::is_same_v<jadra::iloczyn_t<T>, T>)
+matrix_view<jadra::iloczyn_t<T>> pomnoz_do(matrix_view<jadra::iloczyn_t<T>> c, matrix_view<A> a,
+                                           std::type_identity_t<matrix_view<const T>> b, bool akumuluj = false);
@@ -0,0 +1,544 @@
+#pragma once
+
+#include "matrix.h"
+#include "gemm.h"
+#include "thread_pool.h"
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @file wyrazenie.h
+ * @brief Leniwe wyrażenia macierzowe (szablony wyrażeń).
+ *
+ * Operatory klasy @ref matrix modyfikują lewy argument, więc łańcuch
+ * @c (A + B) * 3 + 1 wykonuje osobny przebieg po pamięci dla każdego
+ * operatora. Funkcja @ref wyrazenia::wyr opakowuje macierz w liść drzewa
+ * wyrażenia; operatory na wyrażeniach nie liczą niczego, tylko budują
+ * drzewo w czasie kompilacji. Obliczenie następuje przy przypisaniu do
+ * macierzy – jedną, zwektoryzowaną i zrównolegloną pętlą, bez buforów
+ * pośrednich:
+ * @code
+ * using wyrazenia::wyr;
+ * matrix C = (wyr(A) + B) * 3 + 1;  // jeden przebieg po pamięci
+ * C = wyr(A) * B + C;               // mnożenie z akumulacją w jednym wywołaniu GEMM
+ * C += wyr(A) * B;                  // j.w.
+ * @endcode
+ *
+ * Operator @c * między dwoma wyrażeniami macierzowymi oznacza mnożenie
+ * macierzowe, a między wyrażeniem i liczbą – mnożenie przez skalar.
+ * Iloczyny macierzowe są liczone przez @ref jadra::gemm; wzorce
+ * @c P + X i @c X + P (P – iloczyn) przy przypisaniu trafiają do GEMM jako
+ * jedna operacja z akumulacją, po wpisaniu X do wyniku.
+ *
+ * Wyrażenie przechowuje wskaźniki na macierze – nie wolno go używać
+ * po zniszczeniu macierzy, z których zostało zbudowane. Wszystkie macierze
+ * wyrażenia muszą mieć ten sam typ elementów (@c typ węzła); iloczyny
+ * macierzy 8- i 16-bitowych są akumulowane w 32 bitach i zawężane do tego
+ * typu (pełny wynik daje @ref pomnoz).
+ */
+
+namespace wyrazenia {
+
+/**
+ * @brief Klasa bazowa wszystkich węzłów (CRTP).
+ *
+ * Każdy węzeł @c E udostępnia:
+ * - @c typ – typ elementów wyniku,
+ * - @c wiersze(), @c kolumny() – wymiary wyniku (-1 dla stałej, pasującej
+ *   do każdego),
+ * - @c przygotuj() – oblicza iloczyny w poddrzewie i ustala wskaźniki danych,
+ * - @c ciagle() – czy wszystkie macierze poddrzewa są ciągłe (po
+ *   @c przygotuj()); wtedy element (0, i) oznacza i-ty element w płaskiej
+ *   numeracji wierszami,
+ * - @c operator()(i, j) – element (i, j) wyniku (po @c przygotuj()),
+ * - @c zalezy_od(m) – czy wynik zależy od macierzy @p m.
+ *
+ * @tparam E Typ węzła pochodnego.
+ */
+template <typename E>
+struct wyrazenie {
+    /// Zwraca węzeł jako typ pochodny.
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+/**
+ * @brief Liść: macierz.
+ *
+ * @tparam T Typ elementów macierzy.
+ */
+template <typename T>
+struct lisc : wyrazenie<lisc<T>> {
+    using typ = T;
+
+    const basic_matrix<T>* m;     ///< Opakowana macierz.
+    mutable const T* d = nullptr; ///< Dane macierzy (ustalane w przygotuj()).
+    mutable long long ld = 0;     ///< Odstęp wierszy macierzy.
+
+    explicit lisc(const basic_matrix<T>& macierz) : m(&macierz) {}
+
+    std::ptrdiff_t wiersze() const { return m->rows(); }
+    std::ptrdiff_t kolumny() const { return m->cols(); }
+    void przygotuj() const { d = m->data(); ld = m->stride(); }
+    bool ciagle() const { return m->ciagla(); }
+    T operator()(long long i, long long j) const { return d[i * ld + j]; }
+    bool zalezy_od(const void* x) const { return m == x; }
+};
+
+/**
+ * @brief Liść: stała (skalar) rozgłaszana na wszystkie elementy.
+ *
+ * @tparam T Typ stałej.
+ */
+template <typename T>
+struct stala : wyrazenie<stala<T>> {
+    using typ = T;
+
+    T v; ///< Wartość stałej.
+
+    explicit stala(T wartosc) : v(wartosc) {}
+
+    std::ptrdiff_t wiersze() const { return -1; }
+    std::ptrdiff_t kolumny() const { return -1; }
+    void przygotuj() const {}
+    bool ciagle() const { return true; }
+    T operator()(long long, long long) const { return v; }
+    bool zalezy_od(const void*) const { return false; }
+};
+
+/// Dodawanie element po elemencie.
+struct dodawanie {
+    template <typename T>
+    static T zastosuj(T a, T b) { return static_cast<T>(a + b); }
+};
+
+/// Odejmowanie element po elemencie.
+struct odejmowanie {
+    template <typename T>
+    static T zastosuj(T a, T b) { return static_cast<T>(a - b); }
+};
+
+/// Mnożenie element po elemencie (używane z jednym argumentem stałym).
+struct mnozenie {
+    template <typename T>
+    static T zastosuj(T a, T b) { return static_cast<T>(a * b); }
+};
+
+/**
+ * @brief Węzeł dwuargumentowej operacji element po elemencie.
+ *
+ * @tparam L Typ lewego argumentu.
+ * @tparam R Typ prawego argumentu.
+ * @tparam Op Operacja (@ref dodawanie, @ref odejmowanie, @ref mnozenie).
+ */
+template <typename L, typename R, typename Op>
+struct dzialanie : wyrazenie<dzialanie<L, R, Op>> {
+    static_assert(std::is_same_v<typename L::typ, typename R::typ>, "Rozne typy elementow w wyrazeniu");
+    using typ = typename L::typ;
+
+    L l; ///< Lewy argument.
+    R r; ///< Prawy argument.
+
+    /**
+     * @throw std::invalid_argument jeśli wymiary argumentów są różne.
+     */
+    dzialanie(const L& lewy, const R& prawy) : l(lewy), r(prawy) {
+        if (l.wiersze() >= 0 && r.wiersze() >= 0 &&
+            (l.wiersze() != r.wiersze() || l.kolumny() != r.kolumny())) {
+            throw std::invalid_argument("Rozne wymiary macierzy!");
+        }
+    }
+
+    std::ptrdiff_t wiersze() const { return l.wiersze() >= 0 ? l.wiersze() : r.wiersze(); }
+    std::ptrdiff_t kolumny() const { return l.wiersze() >= 0 ? l.kolumny() : r.kolumny(); }
+    void przygotuj() const { l.przygotuj(); r.przygotuj(); }
+    bool ciagle() const { return l.ciagle() && r.ciagle(); }
+    typ operator()(long long i, long long j) const { return Op::zastosuj(l(i, j), r(i, j)); }
+    bool zalezy_od(const void* x) const { return l.zalezy_od(x) || r.zalezy_od(x); }
+};
+
+template <typename T, typename E>
+void przypisz(basic_matrix<T>& c, const E& e);
+
+/// Sprawdza, czy typ jest liściem z macierzą.
+template <typename E>
+struct czy_lisc : std::false_type {};
+
+template <typename T>
+struct czy_lisc<lisc<T>> : std::true_type {};
+
+/**
+ * @brief Węzeł mnożenia macierzowego.
+ *
+ * Przy użyciu wewnątrz wyrażenia element po elemencie iloczyn jest
+ * obliczany (raz, w @c przygotuj()) do własnego bufora. Bezpośrednio
+ * przypisywany lub akumulowany – trafia do GEMM z macierzą docelową.
+ * Dla elementów 8- i 16-bitowych GEMM liczy iloczyn w 32 bitach do bufora,
+ * a wynik jest zawężany do typu elementów.
+ *
+ * @tparam L Typ lewego czynnika.
+ * @tparam R Typ prawego czynnika.
+ */
+template <typename L, typename R>
+struct iloczyn : wyrazenie<iloczyn<L, R>> {
+    static_assert(std::is_same_v<typename L::typ, typename R::typ>, "Rozne typy elementow w wyrazeniu");
+    using typ = typename L::typ;
+
+    L l; ///< Lewy czynnik.
+    R r; ///< Prawy czynnik.
+    mutable basic_matrix<typ> wynik; ///< Obliczony iloczyn (po przygotuj()).
+    mutable const typ* d = nullptr;  ///< Dane @c wynik.
+    mutable long long ld = 0;        ///< Odstęp wierszy @c wynik.
+
+    /**
+     * @throw std::invalid_argument jeśli liczba kolumn lewego czynnika jest
+     *        różna od liczby wierszy prawego.
+     */
+    iloczyn(const L& lewy, const R& prawy) : l(lewy), r(prawy) {
+        if (l.kolumny() != r.wiersze()) throw std::invalid_argument("Rozne wymiary macierzy!");
+    }
+
+    iloczyn(const iloczyn& x) : l(x.l), r(x.r) {}
+
+    std::ptrdiff_t wiersze() const { return l.wiersze(); }
+    std::ptrdiff_t kolumny() const { return r.kolumny(); }
+
+    void przygotuj() const {
+        wykonaj(wynik, false);
+        d = wynik.data();
+        ld = wynik.stride();
+    }
+
+    bool ciagle() const { return wynik.ciagla(); }
+    typ operator()(long long i, long long j) const { return d[i * ld + j]; }
+    bool zalezy_od(const void* x) const { return l.zalezy_od(x) || r.zalezy_od(x); }
+
+    /**
+     * @brief Liczy C = L * R (lub C += L * R).
+     *
+     * Czynniki niebędące liśćmi są najpierw obliczane do macierzy
+     * tymczasowych. Macierz @p c nie może być czynnikiem iloczynu.
+     *
+     * @param c Macierz docelowa (przy @p akumuluj musi mieć właściwe wymiary).
+     * @param akumuluj Czy dodawać iloczyn do @p c.
+     */
+    void wykonaj(basic_matrix<typ>& c, bool akumuluj) const {
+        basic_matrix<typ> tl, tr;
+        const basic_matrix<typ>& a = czynnik(l, tl);
+        const basic_matrix<typ>& b = czynnik(r, tr);
+        if constexpr (std::is_same_v<jadra::iloczyn_t<typ>, typ>) {
+            if (!akumuluj) c.alokuj(a.rows(), b.cols(), bez_zerowania);
+            jadra::gemm(a.rows(), b.cols(), a.cols(), a.data(), a.stride(), b.data(), b.stride(),
+                        c.data(), c.stride(), akumuluj);
+        }
+        else {
+            basic_matrix<jadra::iloczyn_t<typ>> szeroki(c.get_allocator());
+            szeroki.alokuj(a.rows(), b.cols(), bez_zerowania);
+            jadra::gemm(a.rows(), b.cols(), a.cols(), a.data(), a.stride(), b.data(), b.stride(),
+                        szeroki.data(), szeroki.stride());
+            if (!akumuluj) c.alokuj(a.rows(), b.cols(), bez_zerowania);
+            for (std::ptrdiff_t i = 0; i < c.rows(); ++i) {
+                const jadra::iloczyn_t<typ>* z = szeroki.row_ptr(i);
+                typ* w = c.row_ptr(i);
+                for (std::ptrdiff_t j = 0; j < c.cols(); ++j) {
+                    w[j] = static_cast<typ>(akumuluj ? w[j] + z[j] : z[j]);
+                }
+            }
+        }
+    }
+
+private:
+    /// Zwraca macierz czynnika: opakowaną (liść) lub obliczoną do @p bufor.
+    template <typename X>
+    static const basic_matrix<typ>& czynnik(const X& x, basic_matrix<typ>& bufor) {
+        if constexpr (czy_lisc<X>::value) {
+            return *x.m;
+        }
+        else {
+            przypisz(bufor, x);
+            return bufor;
+        }
+    }
+};
+
+/// Sprawdza, czy typ jest węzłem mnożenia macierzowego.
+template <typename E>
+struct czy_iloczyn : std::false_type {};
+
+template <typename L, typename R>
+struct czy_iloczyn<iloczyn<L, R>> : std::true_type {};
+
+/// Sprawdza, czy typ jest macierzą (@ref basic_matrix).
+template <typename M>
+struct czy_macierz : std::false_type {};
+
+template <typename T>
+struct czy_macierz<basic_matrix<T>> : std::true_type {};
+
+/// Typ macierzy (dowolnie kwalifikowanej), dla operatorów z macierzą po lewej.
+template <typename M>
+concept macierz_argument = czy_macierz<std::remove_cvref_t<M>>::value;
+
+/// Liść dla macierzy typu @p M (dowolnie kwalifikowanego).
+template <typename M>
+using lisc_dla = lisc<typename std::remove_cvref_t<M>::value_type>;
+
+/**
+ * @brief Oblicza wyrażenie element po elemencie do @p c (jedna pętla).
+ *
+ * Jeśli wynik i wszystkie macierze wyrażenia są ciągłe, pętla przechodzi
+ * po płaskiej tablicy; w przeciwnym razie – po wierszach.
+ *
+ * @param c Macierz docelowa (może występować w wyrażeniu).
+ * @param e Wyrażenie.
+ * @param wiersze Liczba wierszy wyniku (potrzebna, gdy @p e jest stałą).
+ * @param kolumny Liczba kolumn wyniku.
+ */
+template <typename T, typename E>
+void przypisz_elementowo(basic_matrix<T>& c, const E& e, std::ptrdiff_t wiersze, std::ptrdiff_t kolumny) {
+    static_assert(std::is_same_v<typename E::typ, T>, "Typ elementow wyrazenia rozny od typu macierzy");
+    e.przygotuj();
+    c.alokuj(wiersze, kolumny, bez_zerowania);
+    T* d = c.data();
+    if (c.ciagla() && e.ciagle()) {
+        rownolegle_dla(0, wiersze * kolumny, PROG_ROWNOLEGLY, [d, &e](long long b, long long k) {
+            for (long long i = b; i < k; ++i) d[i] = e(0, i);
+        });
+        return;
+    }
+    const long long ld = c.stride();
+    const long long ziarno = std::max(1LL, PROG_ROWNOLEGLY / std::max<long long>(kolumny, 1));
+    rownolegle_dla(0, wiersze, ziarno, [d, ld, kolumny, &e](long long b, long long k) {
+        for (long long i = b; i < k; ++i) {
+            T* w = d + i * ld;
+            for (long long j = 0; j < kolumny; ++j) w[j] = e(i, j);
+        }
+    });
+}
+
+/**
+ * @brief Oblicza wyrażenie element po elemencie do @p c (jedna pętla).
+ *
+ * @param c Macierz docelowa (może występować w wyrażeniu).
+ * @param e Wyrażenie.
+ * @throw std::invalid_argument jeśli wyrażenie nie zawiera żadnej macierzy.
+ */
+template <typename T, typename E>
+void przypisz_elementowo(basic_matrix<T>& c, const E& e) {
+    if (e.wiersze() < 0) throw std::invalid_argument("Wyrazenie bez macierzy");
+    przypisz_elementowo(c, e, e.wiersze(), e.kolumny());
+}
+
+/**
+ * @brief Oblicza wyrażenie do macierzy @p c.
+ *
+ * Rozpoznaje wzorce:
+ * - @c P (iloczyn) – GEMM bezpośrednio do @p c,
+ * - @c P + X oraz @c X + P – wpisanie X do @p c i GEMM z akumulacją,
+ * pozostałe wyrażenia liczone są jedną pętlą element po elemencie.
+ * Jeśli @p c jest czynnikiem iloczynu, używana jest ogólna ścieżka.
+ *
+ * @param c Macierz docelowa.
+ * @param e Wyrażenie.
+ */
+template <typename T, typename E>
+void przypisz(basic_matrix<T>& c, const E& e) {
+    if constexpr (czy_iloczyn<E>::value) {
+        static_assert(std::is_same_v<typename E::typ, T>, "Typ elementow wyrazenia rozny od typu macierzy");
+        if (!e.zalezy_od(&c)) {
+            e.wykonaj(c, false);
+        }
+        else {
+            basic_matrix<T> wynik(c.get_allocator());
+            e.wykonaj(wynik, false);
+            c.swap(wynik);
+        }
+    }
+    else if constexpr (czy_lisc<E>::value && std::is_same_v<typename E::typ, T>) {
+        if (e.m != &c) c = *e.m;
+    }
+    else {
+        przypisz_elementowo(c, e);
+    }
+}
+
+/**
+ * @brief Specjalizacja dla sumy: rozpoznaje P + X oraz X + P.
+ */
+template <typename T, typename L, typename R>
+void przypisz(basic_matrix<T>& c, const dzialanie<L, R, dodawanie>& e) {
+    if constexpr (czy_iloczyn<L>::value) {
+        if (!e.l.zalezy_od(&c)) {
+            przypisz_elementowo(c, e.r, e.wiersze(), e.kolumny());
+            e.l.wykonaj(c, true);
+            return;
+        }
+    }
+    else if constexpr (czy_iloczyn<R>::value) {
+        if (!e.r.zalezy_od(&c)) {
+            przypisz_elementowo(c, e.l, e.wiersze(), e.kolumny());
+            e.r.wykonaj(c, true);
+            return;
+        }
+    }
+    przypisz_elementowo(c, e);
+}
+
+/**
+ * @brief Opakowuje macierz w liść wyrażenia.
+ *
+ * @param m Macierz.
+ * @return Liść wyrażenia odwołujący się do @p m.
+ */
+template <typename T>
+lisc<T> wyr(const basic_matrix<T>& m) {
+    return lisc<T>(m);
+}
+
+// ---------------------------------------------------------------------------
+// Dodawanie
+// ---------------------------------------------------------------------------
+
+template <typename A, typename B>
+dzialanie<A, B, dodawanie> operator+(const wyrazenie<A>& a, const wyrazenie<B>& b) {
+    return { a.self(), b.self() };
+}
+
+template <typename A>
+dzialanie<A, lisc<typename A::typ>, dodawanie> operator+(const wyrazenie<A>& a, const basic_matrix<typename A::typ>& b) {
+    return { a.self(), lisc<typename A::typ>(b) };
+}
+
+template <macierz_argument M, typename B>
+dzialanie<lisc_dla<M>, B, dodawanie> operator+(M&& a, const wyrazenie<B>& b) {
+    return { lisc_dla<M>(a), b.self() };
+}
+
+template <typename A>
+dzialanie<A, stala<typename A::typ>, dodawanie> operator+(const wyrazenie<A>& a, typename A::typ b) {
+    return { a.self(), stala<typename A::typ>(b) };
+}
+
+template <typename B>
+dzialanie<stala<typename B::typ>, B, dodawanie> operator+(typename B::typ a, const wyrazenie<B>& b) {
+    return { stala<typename B::typ>(a), b.self() };
+}
+
+// ---------------------------------------------------------------------------
+// Odejmowanie
+// ---------------------------------------------------------------------------
+
+template <typename A, typename B>
+dzialanie<A, B, odejmowanie> operator-(const wyrazenie<A>& a, const wyrazenie<B>& b) {
+    return { a.self(), b.self() };
+}
+
+template <typename A>
+dzialanie<A, lisc<typename A::typ>, odejmowanie> operator-(const wyrazenie<A>& a, const basic_matrix<typename A::typ>& b) {
+    return { a.self(), lisc<typename A::typ>(b) };
+}
+
+template <macierz_argument M, typename B>
+dzialanie<lisc_dla<M>, B, odejmowanie> operator-(M&& a, const wyrazenie<B>& b) {
+    return { lisc_dla<M>(a), b.self() };
+}
+
+template <typename A>
+dzialanie<A, stala<typename A::typ>, odejmowanie> operator-(const wyrazenie<A>& a, typename A::typ b) {
+    return { a.self(), stala<typename A::typ>(b) };
+}
+
+template <typename B>
+dzialanie<stala<typename B::typ>, B, odejmowanie> operator-(typename B::typ a, const wyrazenie<B>& b) {
+    return { stala<typename B::typ>(a), b.self() };
+}
+
+template <typename A>
+dzialanie<stala<typename A::typ>, A, odejmowanie> operator-(const wyrazenie<A>& a) {
+    return { stala<typename A::typ>(0), a.self() };
+}
+
+// ---------------------------------------------------------------------------
+// Mnożenie: przez skalar (element po elemencie) i macierzowe
+// ---------------------------------------------------------------------------
+
+template <typename A>
+dzialanie<A, stala<typename A::typ>, mnozenie> operator*(const wyrazenie<A>& a, typename A::typ b) {
+    return { a.self(), stala<typename A::typ>(b) };
+}
+
+template <typename B>
+dzialanie<stala<typename B::typ>, B, mnozenie> operator*(typename B::typ a, const wyrazenie<B>& b) {
+    return { stala<typename B::typ>(a), b.self() };
+}
+
+template <typename A, typename B>
+iloczyn<A, B> operator*(const wyrazenie<A>& a, const wyrazenie<B>& b) {
+    return { a.self(), b.self() };
+}
+
+template <typename A>
+iloczyn<A, lisc<typename A::typ>> operator*(const wyrazenie<A>& a, const basic_matrix<typename A::typ>& b) {
+    return { a.self(), lisc<typename A::typ>(b) };
+}
+
+template <macierz_argument M, typename B>
+iloczyn<lisc_dla<M>, B> operator*(M&& a, const wyrazenie<B>& b) {
+    return { lisc_dla<M>(a), b.self() };
+}
+
+} // namespace wyrazenia
+
+// ---------------------------------------------------------------------------
+// Składowe szablonowe klasy basic_matrix
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Tworzy macierz jako wynik wyrażenia.
+ *
+ * @param e Wyrażenie.
+ */
+template <typename T>
+template <typename E>
+basic_matrix<T>::basic_matrix(const wyrazenia::wyrazenie<E>& e) : basic_matrix() {
+    wyrazenia::przypisz(*this, e.self());
+}
+
+/**
+ * @brief Przypisuje macierzy wynik wyrażenia.
+ *
+ * @param e Wyrażenie.
+ * @return Referencja do *this.
+ */
+template <typename T>
+template <typename E>
+basic_matrix<T>& basic_matrix<T>::operator=(const wyrazenia::wyrazenie<E>& e) {
+    wyrazenia::przypisz(*this, e.self());
+    return *this;
+}
+
+/**
+ * @brief Dodaje do macierzy wynik wyrażenia.
+ *
+ * Iloczyn macierzowy jest akumulowany bezpośrednio przez GEMM.
+ *
+ * @param e Wyrażenie.
+ * @return Referencja do *this.
+ * @throw std::invalid_argument jeśli wymiary są różne.
+ */
+template <typename T>
+template <typename E>
+basic_matrix<T>& basic_matrix<T>::operator+=(const wyrazenia::wyrazenie<E>& e) {
+    if (e.self().wiersze() >= 0 && (e.self().wiersze() != wierszy || e.self().kolumny() != kolumn)) {
+        throw std::invalid_argument("Rozne wymiary macierzy!");
+    }
+    if constexpr (wyrazenia::czy_iloczyn<E>::value) {
+        if (!e.self().zalezy_od(this)) {
+            e.self().wykonaj(*this, true);
+            return *this;
+        }
+    }
+    wyrazenia::przypisz_elementowo(*this, wyrazenia::wyr(*this) + e.self());
+    return *this;
+}
\ No newline at end of file